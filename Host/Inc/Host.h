@@ -0,0 +1,45 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+// Host build board emulation (HostBoard.cpp)
+//
+// Interrupts are delivered by a 1ms host timer (SIGALRM) standing in for the systick, each tick services:
+//   SysTick_Handler		if the systick interrupt is enabled (LL_SYSTICK_EnableIT)
+//   LPTIM1_IRQHandler	at the compare match rate of the lp timer (32768Hz LSE / prescaler / (ARR + 1)) once started
+//											and the compare match interrupt + LPTIM1_IRQn are enabled
+//   DMA2_Stream3_IRQHandler	for the oled spi double buffer stream, a transfer completes on the tick after it is enabled
+// The memory to memory dma streams (6, 7) and the rng complete synchronously when enabled / requested and their
+// handler is called directly, the same as the DMA2D software engine. A handler is only called if its NVIC line is enabled.
+// __WFI() sleeps until the next tick, or services the pending transfers directly when it is called from an interrupt
+// (the oled send waiting on the spi stream from inside the lp timer interrupt, preempted by the dma interrupt on target)
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Host_WaitForInterrupt(void);
+uint32_t Host_Micros(void);
+void Host_DelayMs(uint32_t const Delay);
+
+void Host_SysTick_Enable(void);
+void Host_LPTIM_Start(void);
+void Host_DMA_EnableStream(void* const DMAx, uint32_t const Stream);
+void Host_RNG_Request(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_H*/
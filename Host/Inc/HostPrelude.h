@@ -0,0 +1,57 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_PRELUDE_H
+#define HOST_PRELUDE_H
+
+// force included first in every host translation unit (see CMakeLists.txt)
+// PreprocessorCore.h includes the device headers and <math.h> inside extern "C", the c++ standard headers
+// declare templates and overloads which can not have c linkage, so they are included once here beforehand
+#ifdef __cplusplus
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <climits>
+#include <cfloat>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#endif
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <float.h>
+#include <assert.h>
+
+#if defined(__SSE__)
+#include <immintrin.h>		// before core_cm7.h, the intrinsic headers use __I as a parameter name
+#endif
+
+// glibc declares these (math.h __MATHCALL), the repo defines its own in commonmath.h / arm_optimized_math.h
+#define __fmaxf	host_fmaxf
+#define __fminf	host_fminf
+#define __fabsf	host_fabsf
+#define __sqrtf	host_sqrtf
+#define __powf	host_powf
+
+// armclang math.h, selects the accurate sinf/cosf argument reduction (nothing to select on the host)
+#ifdef __cplusplus
+extern "C"
+#endif
+void __use_accurate_range_reduction(void);
+
+#endif /*HOST_PRELUDE_H*/
@@ -0,0 +1,17 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_ARM_ACLE_H
+#define HOST_ARM_ACLE_H
+
+// the firmware uses the CMSIS core (core_cm7.h) spellings of the intrinsics, nothing else needed from acle
+#include "core_cm7.h"
+
+#endif /*HOST_ARM_ACLE_H*/
@@ -0,0 +1,58 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_ARM_MATH_H
+#define HOST_ARM_MATH_H
+
+#include <stdint.h>
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the few CMSIS-DSP types and functions the firmware uses, plain c reference versions
+typedef int8_t		q7_t;
+typedef int16_t		q15_t;
+typedef int32_t		q31_t;
+typedef int64_t		q63_t;
+typedef float			float32_t;
+typedef double		float64_t;
+
+#ifndef PI
+#define PI				3.14159265358979f
+#endif
+
+static inline float32_t arm_cos_f32(float32_t const x) { return( cosf(x) ); }
+static inline float32_t arm_sin_f32(float32_t const x) { return( sinf(x) ); }
+
+static inline void arm_mult_f32(float32_t const* pSrcA, float32_t const* pSrcB, float32_t* pDst, uint32_t blockSize)
+{
+	while ( 0 != blockSize-- )
+		*pDst++ = (*pSrcA++) * (*pSrcB++);
+}
+
+static inline void arm_offset_f32(float32_t const* pSrc, float32_t const offset, float32_t* pDst, uint32_t blockSize)
+{
+	while ( 0 != blockSize-- )
+		*pDst++ = (*pSrc++) + offset;
+}
+
+static inline void arm_scale_f32(float32_t const* pSrc, float32_t const scale, float32_t* pDst, uint32_t blockSize)
+{
+	while ( 0 != blockSize-- )
+		*pDst++ = (*pSrc++) * scale;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_ARM_MATH_H*/
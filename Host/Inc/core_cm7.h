@@ -0,0 +1,341 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_CORE_CM7_H
+#define HOST_CORE_CM7_H
+
+// Host build replacement of the CMSIS Cortex-M7 core header
+// The core registers are plain structures in ram, the NVIC only keeps the enable / priority state the
+// interrupt emulation (Host.h) needs. The DSP / SIMD intrinsics are bit exact C versions of the instructions.
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef __cplusplus
+	#define __I			volatile
+#else
+	#define __I			volatile const
+#endif
+#define __O				volatile
+#define __IO			volatile
+#define __IM			volatile const
+#define __OM			volatile
+#define __IOM			volatile
+
+#define __SIMD32_TYPE	int32_t
+
+#define __ASM						__asm
+#define __INLINE				inline
+#define __STATIC_INLINE	static inline
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#define __NO_RETURN			__attribute__((__noreturn__))
+#define __USED					__attribute__((used))
+#define __WEAK					__attribute__((weak))
+#define __weak					__attribute__((weak))
+#define __PACKED				__attribute__((packed, aligned(1)))
+#define __ALIGNED(x)		__attribute__((aligned(x)))
+#define __RESTRICT			__restrict
+
+#define __CM7_REV					0x0100U
+#define __MPU_PRESENT			1
+#define __NVIC_PRIO_BITS	4
+#define __FPU_PRESENT			1
+#define __ICACHE_PRESENT	1
+#define __DCACHE_PRESENT	1
+#define __FPU_USED				1U
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---- core registers ---- //
+typedef struct
+{
+	__IOM uint32_t CTRL;
+	__IOM uint32_t LOAD;
+	__IOM uint32_t VAL;
+	__IM  uint32_t CALIB;
+} SysTick_Type;
+
+#define SysTick_CTRL_COUNTFLAG_Pos	16U
+#define SysTick_CTRL_COUNTFLAG_Msk	(1UL << SysTick_CTRL_COUNTFLAG_Pos)
+#define SysTick_CTRL_CLKSOURCE_Pos	2U
+#define SysTick_CTRL_CLKSOURCE_Msk	(1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_TICKINT_Pos		1U
+#define SysTick_CTRL_TICKINT_Msk		(1UL << SysTick_CTRL_TICKINT_Pos)
+#define SysTick_CTRL_ENABLE_Pos			0U
+#define SysTick_CTRL_ENABLE_Msk			(1UL)
+
+typedef struct
+{
+	__IM  uint32_t CPUID;
+	__IOM uint32_t ICSR;
+	__IOM uint32_t VTOR;
+	__IOM uint32_t AIRCR;
+	__IOM uint32_t SCR;
+	__IOM uint32_t CCR;
+	__IOM uint8_t  SHPR[12U];
+	__IOM uint32_t SHCSR;
+	__IOM uint32_t CFSR;
+	__IOM uint32_t HFSR;
+	__IOM uint32_t DFSR;
+	__IOM uint32_t MMFAR;
+	__IOM uint32_t BFAR;
+	__IOM uint32_t AFSR;
+	__IM  uint32_t ID_PFR[2U];
+	__IM  uint32_t ID_DFR;
+	__IM  uint32_t ID_AFR;
+	__IM  uint32_t ID_MFR[4U];
+	__IM  uint32_t ID_ISAR[5U];
+				uint32_t RESERVED0[1U];
+	__IM  uint32_t CLIDR;
+	__IM  uint32_t CTR;
+	__IM  uint32_t CCSIDR;
+	__IOM uint32_t CSSELR;
+	__IOM uint32_t CPACR;
+} SCB_Type;
+
+#define SCB_CCR_DC_Pos		16U
+#define SCB_CCR_DC_Msk		(1UL << SCB_CCR_DC_Pos)
+#define SCB_CCR_IC_Pos		17U
+#define SCB_CCR_IC_Msk		(1UL << SCB_CCR_IC_Pos)
+
+typedef struct
+{
+	__IM  uint32_t TYPE;
+	__IOM uint32_t CTRL;
+	__IOM uint32_t RNR;
+	__IOM uint32_t RBAR;
+	__IOM uint32_t RASR;
+} MPU_Type;
+
+#define MPU_CTRL_ENABLE_Msk		(1UL)
+
+extern SysTick_Type		Host_SysTick;
+extern SCB_Type				Host_SCB;
+extern MPU_Type				Host_MPU;
+
+#define SysTick		(&Host_SysTick)
+#define SCB				(&Host_SCB)
+#define MPU				(&Host_MPU)
+
+// ---- nvic, state only (see Host.h) ---- //
+void NVIC_SetPriorityGrouping(uint32_t PriorityGroup);
+uint32_t NVIC_GetPriorityGrouping(void);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type IRQn);
+void NVIC_SystemReset(void);
+
+__STATIC_INLINE uint32_t NVIC_EncodePriority(uint32_t PriorityGroup, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	uint32_t const PriorityGroupTmp = (PriorityGroup & (uint32_t)0x07UL);
+	uint32_t const PreemptPriorityBits = ((7UL - PriorityGroupTmp) > (uint32_t)(__NVIC_PRIO_BITS)) ? (uint32_t)(__NVIC_PRIO_BITS) : (uint32_t)(7UL - PriorityGroupTmp);
+	uint32_t const SubPriorityBits = ((PriorityGroupTmp + (uint32_t)(__NVIC_PRIO_BITS)) < (uint32_t)7UL) ? (uint32_t)0UL : (uint32_t)((PriorityGroupTmp - 7UL) + (uint32_t)(__NVIC_PRIO_BITS));
+
+	return( ((PreemptPriority & (uint32_t)((1UL << (PreemptPriorityBits)) - 1UL)) << SubPriorityBits) |
+					((SubPriority     & (uint32_t)((1UL << (SubPriorityBits    )) - 1UL))) );
+}
+
+// ---- caches, coherent on the host ---- //
+__STATIC_INLINE void SCB_EnableICache(void) { SCB->CCR |= SCB_CCR_IC_Msk; }
+__STATIC_INLINE void SCB_DisableICache(void) { SCB->CCR &= ~SCB_CCR_IC_Msk; }
+__STATIC_INLINE void SCB_InvalidateICache(void) {}
+__STATIC_INLINE void SCB_EnableDCache(void) { SCB->CCR |= SCB_CCR_DC_Msk; }
+__STATIC_INLINE void SCB_DisableDCache(void) { SCB->CCR &= ~SCB_CCR_DC_Msk; }
+__STATIC_INLINE void SCB_InvalidateDCache(void) {}
+__STATIC_INLINE void SCB_CleanDCache(void) {}
+__STATIC_INLINE void SCB_CleanInvalidateDCache(void) {}
+__STATIC_INLINE void SCB_InvalidateDCache_by_Addr(void const volatile* addr, int32_t dsize) { (void)addr; (void)dsize; }
+__STATIC_INLINE void SCB_CleanDCache_by_Addr(void const volatile* addr, int32_t dsize) { (void)addr; (void)dsize; }
+__STATIC_INLINE void SCB_CleanInvalidateDCache_by_Addr(void const volatile* addr, int32_t dsize) { (void)addr; (void)dsize; }
+
+// ---- core instructions ---- //
+#include "Host.h"
+
+#define __NOP()			__asm volatile ("nop")
+#define __WFI()			Host_WaitForInterrupt()
+#define __WFE()			Host_WaitForInterrupt()
+#define __SEV()
+#define __ISB()			__atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __DSB()			__atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __DMB()			__atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __BKPT(value)	__builtin_trap()
+
+__STATIC_INLINE void __enable_irq(void) {}
+__STATIC_INLINE void __disable_irq(void) {}
+__STATIC_INLINE uint32_t __get_PRIMASK(void) { return(0); }
+__STATIC_INLINE void __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+
+__STATIC_INLINE uint32_t __get_FPSCR(void) { return(0); }
+__STATIC_INLINE void __set_FPSCR(uint32_t fpscr) { (void)fpscr; }
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value) { return(__builtin_bswap32(value)); }
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value) { return( ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8) ); }
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+	uint32_t result(0);
+	for ( uint32_t i = 0 ; i < 32 ; ++i ) {
+		result = (result << 1) | (value & 1);
+		value >>= 1;
+	}
+	return(result);
+}
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value) { return( 0 == value ? 32 : __builtin_clz(value) ); }
+__STATIC_FORCEINLINE uint32_t __ROR(uint32_t op1, uint32_t op2) { op2 &= 31; return( 0 == op2 ? op1 : (op1 >> op2) | (op1 << (32 - op2)) ); }
+
+// ---- saturation ---- //
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t val, uint32_t sat)
+{
+	if ( (sat >= 1U) && (sat <= 32U) ) {
+		int32_t const max = (int32_t)((1U << (sat - 1U)) - 1U);
+		int32_t const min = -1 - max;
+		if ( val > max )
+			return(max);
+		else if ( val < min )
+			return(min);
+	}
+	return(val);
+}
+__STATIC_FORCEINLINE uint32_t __USAT(int32_t val, uint32_t sat)
+{
+	if ( sat <= 31U ) {
+		uint32_t const max = ((1U << sat) - 1U);
+		if ( val > (int32_t)max )
+			return(max);
+		else if ( val < 0 )
+			return(0U);
+	}
+	return((uint32_t)val);
+}
+
+// ---- dsp / simd, lane by lane ---- //
+#define HOST_LANE16(x, i)		((int32_t)(int16_t)((uint32_t)(x) >> ((i) * 16)))
+#define HOST_ULANE16(x, i)	((uint32_t)(uint16_t)((uint32_t)(x) >> ((i) * 16)))
+#define HOST_ULANE8(x, i)		((uint32_t)(uint8_t)((uint32_t)(x) >> ((i) * 8)))
+#define HOST_PACK16(lo, hi)	( ((uint32_t)(uint16_t)(lo)) | (((uint32_t)(uint16_t)(hi)) << 16) )
+
+__STATIC_FORCEINLINE int32_t __HOST_SAT16(int32_t const x) { return( x > 32767 ? 32767 : (x < -32768 ? -32768 : x) ); }
+__STATIC_FORCEINLINE uint32_t __HOST_USAT8(int32_t const x) { return( x > 255 ? 255 : (x < 0 ? 0 : x) ); }
+
+__STATIC_FORCEINLINE uint32_t __PKHBT(uint32_t const ARG1, uint32_t const ARG2, uint32_t const ARG3)
+{
+	return( (ARG1 & 0x0000FFFFUL) | ((ARG2 << ARG3) & 0xFFFF0000UL) );
+}
+__STATIC_FORCEINLINE uint32_t __PKHTB(uint32_t const ARG1, uint32_t const ARG2, uint32_t const ARG3)
+{
+	return( (ARG1 & 0xFFFF0000UL) | ((uint32_t)((int32_t)ARG2 >> ARG3) & 0x0000FFFFUL) );
+}
+__STATIC_FORCEINLINE int32_t __QADD(int32_t const op1, int32_t const op2)
+{
+	int64_t const r = (int64_t)op1 + op2;
+	return( r > INT32_MAX ? INT32_MAX : (r < INT32_MIN ? INT32_MIN : (int32_t)r) );
+}
+__STATIC_FORCEINLINE int32_t __QSUB(int32_t const op1, int32_t const op2)
+{
+	int64_t const r = (int64_t)op1 - op2;
+	return( r > INT32_MAX ? INT32_MAX : (r < INT32_MIN ? INT32_MIN : (int32_t)r) );
+}
+__STATIC_FORCEINLINE uint32_t __QADD16(uint32_t const op1, uint32_t const op2)
+{
+	return( HOST_PACK16(__HOST_SAT16(HOST_LANE16(op1, 0) + HOST_LANE16(op2, 0)), __HOST_SAT16(HOST_LANE16(op1, 1) + HOST_LANE16(op2, 1))) );
+}
+__STATIC_FORCEINLINE uint32_t __QSUB16(uint32_t const op1, uint32_t const op2)
+{
+	return( HOST_PACK16(__HOST_SAT16(HOST_LANE16(op1, 0) - HOST_LANE16(op2, 0)), __HOST_SAT16(HOST_LANE16(op1, 1) - HOST_LANE16(op2, 1))) );
+}
+__STATIC_FORCEINLINE uint32_t __SHADD16(uint32_t const op1, uint32_t const op2)
+{
+	return( HOST_PACK16((HOST_LANE16(op1, 0) + HOST_LANE16(op2, 0)) >> 1, (HOST_LANE16(op1, 1) + HOST_LANE16(op2, 1)) >> 1) );
+}
+__STATIC_FORCEINLINE uint32_t __SHSUB16(uint32_t const op1, uint32_t const op2)
+{
+	return( HOST_PACK16((HOST_LANE16(op1, 0) - HOST_LANE16(op2, 0)) >> 1, (HOST_LANE16(op1, 1) - HOST_LANE16(op2, 1)) >> 1) );
+}
+__STATIC_FORCEINLINE uint32_t __SADD16(uint32_t const op1, uint32_t const op2)
+{
+	return( HOST_PACK16(HOST_LANE16(op1, 0) + HOST_LANE16(op2, 0), HOST_LANE16(op1, 1) + HOST_LANE16(op2, 1)) );
+}
+__STATIC_FORCEINLINE uint32_t __SSUB16(uint32_t const op1, uint32_t const op2)
+{
+	return( HOST_PACK16(HOST_LANE16(op1, 0) - HOST_LANE16(op2, 0), HOST_LANE16(op1, 1) - HOST_LANE16(op2, 1)) );
+}
+__STATIC_FORCEINLINE uint32_t __SSAT16(uint32_t const op1, uint32_t const sat)
+{
+	return( HOST_PACK16(__SSAT(HOST_LANE16(op1, 0), sat), __SSAT(HOST_LANE16(op1, 1), sat)) );
+}
+__STATIC_FORCEINLINE uint32_t __USAT16(uint32_t const op1, uint32_t const sat)
+{
+	return( HOST_PACK16(__USAT(HOST_LANE16(op1, 0), sat), __USAT(HOST_LANE16(op1, 1), sat)) );
+}
+__STATIC_FORCEINLINE uint32_t __SMUAD(uint32_t const op1, uint32_t const op2)
+{
+	return( (uint32_t)(HOST_LANE16(op1, 0) * HOST_LANE16(op2, 0) + HOST_LANE16(op1, 1) * HOST_LANE16(op2, 1)) );
+}
+__STATIC_FORCEINLINE uint32_t __SMLAD(uint32_t const op1, uint32_t const op2, uint32_t const op3)
+{
+	return( __SMUAD(op1, op2) + op3 );
+}
+__STATIC_FORCEINLINE uint32_t __UADD8(uint32_t const op1, uint32_t const op2)
+{
+	uint32_t r(0);
+	for ( uint32_t i = 0 ; i < 4 ; ++i )
+		r |= ((HOST_ULANE8(op1, i) + HOST_ULANE8(op2, i)) & 0xFF) << (i * 8);
+	return(r);
+}
+__STATIC_FORCEINLINE uint32_t __UQADD8(uint32_t const op1, uint32_t const op2)
+{
+	uint32_t r(0);
+	for ( uint32_t i = 0 ; i < 4 ; ++i )
+		r |= __HOST_USAT8((int32_t)(HOST_ULANE8(op1, i) + HOST_ULANE8(op2, i))) << (i * 8);
+	return(r);
+}
+__STATIC_FORCEINLINE uint32_t __UQSUB8(uint32_t const op1, uint32_t const op2)
+{
+	uint32_t r(0);
+	for ( uint32_t i = 0 ; i < 4 ; ++i )
+		r |= __HOST_USAT8((int32_t)HOST_ULANE8(op1, i) - (int32_t)HOST_ULANE8(op2, i)) << (i * 8);
+	return(r);
+}
+__STATIC_FORCEINLINE uint32_t __UHADD8(uint32_t const op1, uint32_t const op2)
+{
+	uint32_t r(0);
+	for ( uint32_t i = 0 ; i < 4 ; ++i )
+		r |= ((HOST_ULANE8(op1, i) + HOST_ULANE8(op2, i)) >> 1) << (i * 8);
+	return(r);
+}
+__STATIC_FORCEINLINE uint32_t __UHSUB8(uint32_t const op1, uint32_t const op2)
+{
+	uint32_t r(0);
+	for ( uint32_t i = 0 ; i < 4 ; ++i )
+		r |= (((HOST_ULANE8(op1, i) - HOST_ULANE8(op2, i)) >> 1) & 0xFF) << (i * 8);
+	return(r);
+}
+__STATIC_FORCEINLINE uint32_t __USAD8(uint32_t const op1, uint32_t const op2)
+{
+	uint32_t r(0);
+	for ( uint32_t i = 0 ; i < 4 ; ++i ) {
+		int32_t const d = (int32_t)HOST_ULANE8(op1, i) - (int32_t)HOST_ULANE8(op2, i);
+		r += (d < 0 ? -d : d);
+	}
+	return(r);
+}
+__STATIC_FORCEINLINE uint32_t __UXTB16(uint32_t const op1) { return( op1 & 0x00FF00FFUL ); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_CORE_CM7_H*/
@@ -0,0 +1,19 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef FRACTALBOXES_H
+#define FRACTALBOXES_H
+
+// the effect source is not part of this source tree, World.cpp only references it from the disabled
+// fullscreen effect switch so the declaration is enough for the host build
+
+ void RenderFractalBoxes(float const tNow, float const fUVScalar);
+
+#endif
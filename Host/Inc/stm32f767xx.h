@@ -0,0 +1,433 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F767XX_H
+#define HOST_STM32F767XX_H
+
+// Host build replacement of the STM32F767 device header
+// Only the peripherals the firmware touches are declared, each instance is a register block in ram (HostBoard.cpp)
+// so the LL configuration writes land somewhere harmless. Peripherals with behaviour the firmware depends on
+// (DMA streams, RNG, LP timer, SysTick) are emulated in HostBoard.cpp, see Host.h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+	NonMaskableInt_IRQn         = -14,
+	MemoryManagement_IRQn       = -12,
+	BusFault_IRQn               = -11,
+	UsageFault_IRQn             = -10,
+	SVCall_IRQn                 = -5,
+	DebugMonitor_IRQn           = -4,
+	PendSV_IRQn                 = -2,
+	SysTick_IRQn                = -1,
+	EXTI0_IRQn                  = 6,
+	DMA1_Stream3_IRQn           = 14,
+	EXTI15_10_IRQn              = 40,
+	DMA2_Stream0_IRQn           = 56,
+	DMA2_Stream1_IRQn           = 57,
+	DMA2_Stream2_IRQn           = 58,
+	DMA2_Stream3_IRQn           = 59,
+	DMA2_Stream6_IRQn           = 69,
+	DMA2_Stream7_IRQn           = 70,
+	SPI1_IRQn                   = 35,
+	USART3_IRQn                 = 39,
+	HASH_RNG_IRQn               = 80,
+	DMA2D_IRQn                  = 90,
+	QUADSPI_IRQn                = 92,
+	LPTIM1_IRQn                 = 93,
+	JPEG_IRQn                   = 108,
+	HOST_NUM_IRQn               = 128
+} IRQn_Type;
+
+#include "core_cm7.h"
+
+// ---- memory map ---- //
+#define FLASH_BASE			0x08000000UL
+#define SRAM1_BASE			0x20020000UL
+#define SRAM2_BASE			0x2007C000UL
+#define QSPI_BASE				0x90000000UL		// the FRAM image is mapped here, see quadspi_soft.cpp
+extern uint8_t Host_BackupSRAM[4096];
+#define BKPSRAM_BASE		((uint32_t)(uintptr_t)Host_BackupSRAM)
+
+// ---- peripheral registers ---- //
+typedef struct
+{
+	__IO uint32_t CR;
+	__IO uint32_t ISR;
+	__IO uint32_t IFCR;
+	__IO uint32_t FGMAR;
+	__IO uint32_t FGOR;
+	__IO uint32_t BGMAR;
+	__IO uint32_t BGOR;
+	__IO uint32_t FGPFCCR;
+	__IO uint32_t FGCOLR;
+	__IO uint32_t BGPFCCR;
+	__IO uint32_t BGCOLR;
+	__IO uint32_t FGCMAR;
+	__IO uint32_t BGCMAR;
+	__IO uint32_t OPFCCR;
+	__IO uint32_t OCOLR;
+	__IO uint32_t OMAR;
+	__IO uint32_t OOR;
+	__IO uint32_t NLR;
+	__IO uint32_t LWR;
+	__IO uint32_t AMTCR;
+	uint32_t      RESERVED[236];
+	__IO uint32_t FGCLUT[256];
+	__IO uint32_t BGCLUT[256];
+} DMA2D_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR;
+	__IO uint32_t NDTR;
+	__IO uint32_t PAR;
+	__IO uint32_t M0AR;
+	__IO uint32_t M1AR;
+	__IO uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t LISR;
+	__IO uint32_t HISR;
+	__IO uint32_t LIFCR;
+	__IO uint32_t HIFCR;
+	DMA_Stream_TypeDef Stream[8];		// host only, the streams follow the controller registers
+} DMA_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t MODER;
+	__IO uint32_t OTYPER;
+	__IO uint32_t OSPEEDR;
+	__IO uint32_t PUPDR;
+	__IO uint32_t IDR;
+	__IO uint32_t ODR;
+	__IO uint32_t BSRR;
+	__IO uint32_t LCKR;
+	__IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR1;
+	__IO uint32_t CR2;
+	__IO uint32_t SR;
+	__IO uint32_t DR;
+	__IO uint32_t CRCPR;
+	__IO uint32_t RXCRCR;
+	__IO uint32_t TXCRCR;
+	__IO uint32_t I2SCFGR;
+	__IO uint32_t I2SPR;
+} SPI_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR1;
+	__IO uint32_t CR2;
+	__IO uint32_t CR3;
+	__IO uint32_t BRR;
+	__IO uint32_t GTPR;
+	__IO uint32_t RTOR;
+	__IO uint32_t RQR;
+	__IO uint32_t ISR;
+	__IO uint32_t ICR;
+	__IO uint32_t RDR;
+	__IO uint32_t TDR;
+} USART_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t ISR;
+	__IO uint32_t ICR;
+	__IO uint32_t IER;
+	__IO uint32_t CFGR;
+	__IO uint32_t CR;
+	__IO uint32_t CMP;
+	__IO uint32_t ARR;
+	__IO uint32_t CNT;
+} LPTIM_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR;
+	__IO uint32_t SR;
+	__IO uint32_t DR;
+} RNG_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR1;
+	__IO uint32_t CSR1;
+	__IO uint32_t CR2;
+	__IO uint32_t CSR2;
+} PWR_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t ACR;
+	__IO uint32_t KEYR;
+	__IO uint32_t OPTKEYR;
+	__IO uint32_t SR;
+	__IO uint32_t CR;
+	__IO uint32_t OPTCR;
+	__IO uint32_t OPTCR1;
+} FLASH_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR;
+	__IO uint32_t DCR;
+	__IO uint32_t SR;
+	__IO uint32_t FCR;
+	__IO uint32_t DLR;
+	__IO uint32_t CCR;
+	__IO uint32_t AR;
+	__IO uint32_t ABR;
+	__IO uint32_t DR;
+	__IO uint32_t PSMKR;
+	__IO uint32_t PSMAR;
+	__IO uint32_t PIR;
+	__IO uint32_t LPTR;
+} QUADSPI_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR;
+	__IO uint32_t PLLCFGR;
+	__IO uint32_t CFGR;
+	__IO uint32_t CIR;
+	__IO uint32_t AHB1ENR;
+	__IO uint32_t AHB2ENR;
+	__IO uint32_t AHB3ENR;
+	__IO uint32_t APB1ENR;
+	__IO uint32_t APB2ENR;
+	__IO uint32_t BDCR;
+	__IO uint32_t CSR;
+	__IO uint32_t PLLSAICFGR;
+	__IO uint32_t DCKCFGR1;
+	__IO uint32_t DCKCFGR2;
+} RCC_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t IMR;
+	__IO uint32_t EMR;
+	__IO uint32_t RTSR;
+	__IO uint32_t FTSR;
+	__IO uint32_t SWIER;
+	__IO uint32_t PR;
+} EXTI_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t MEMRMP;
+	__IO uint32_t PMC;
+	__IO uint32_t EXTICR[4];
+	__IO uint32_t CMPCR;
+} SYSCFG_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CONFR[8];
+	__IO uint32_t CR;
+	__IO uint32_t SR;
+	__IO uint32_t CFR;
+	__IO uint32_t DIR;
+	__IO uint32_t DOR;
+} JPEG_TypeDef;
+
+extern DMA_TypeDef		Host_DMA1, Host_DMA2;
+extern GPIO_TypeDef		Host_GPIO[11];
+extern SPI_TypeDef		Host_SPI1;
+extern USART_TypeDef	Host_USART3;
+extern LPTIM_TypeDef	Host_LPTIM1;
+extern RNG_TypeDef		Host_RNG;
+extern PWR_TypeDef		Host_PWR;
+extern FLASH_TypeDef	Host_FLASH;
+extern QUADSPI_TypeDef	Host_QUADSPI;
+extern RCC_TypeDef		Host_RCC;
+extern EXTI_TypeDef		Host_EXTI;
+extern SYSCFG_TypeDef	Host_SYSCFG;
+extern JPEG_TypeDef		Host_JPEG;
+extern DMA2D_TypeDef	Host_DMA2D;
+
+#define DMA1			(&Host_DMA1)
+#define DMA2			(&Host_DMA2)
+#define GPIOA			(&Host_GPIO[0])
+#define GPIOB			(&Host_GPIO[1])
+#define GPIOC			(&Host_GPIO[2])
+#define GPIOD			(&Host_GPIO[3])
+#define GPIOE			(&Host_GPIO[4])
+#define GPIOF			(&Host_GPIO[5])
+#define GPIOG			(&Host_GPIO[6])
+#define GPIOH			(&Host_GPIO[7])
+#define GPIOI			(&Host_GPIO[8])
+#define GPIOJ			(&Host_GPIO[9])
+#define GPIOK			(&Host_GPIO[10])
+#define SPI1			(&Host_SPI1)
+#define USART3		(&Host_USART3)
+#define LPTIM1		(&Host_LPTIM1)
+#define RNG				(&Host_RNG)
+#define PWR				(&Host_PWR)
+#define FLASH			(&Host_FLASH)
+#define QUADSPI		(&Host_QUADSPI)
+#define RCC				(&Host_RCC)
+#define EXTI			(&Host_EXTI)
+#define SYSCFG		(&Host_SYSCFG)
+#define JPEG			(&Host_JPEG)
+#define DMA2D			(&Host_DMA2D)
+
+#define DMA1_Stream3	(&Host_DMA1.Stream[3])
+#define DMA2_Stream0	(&Host_DMA2.Stream[0])
+#define DMA2_Stream1	(&Host_DMA2.Stream[1])
+#define DMA2_Stream2	(&Host_DMA2.Stream[2])
+#define DMA2_Stream3	(&Host_DMA2.Stream[3])
+#define DMA2_Stream6	(&Host_DMA2.Stream[6])
+#define DMA2_Stream7	(&Host_DMA2.Stream[7])
+
+// ---- register bits ---- //
+#define DMA2D_CR_START				(0x1UL << 0)
+#define DMA2D_CR_SUSP					(0x1UL << 1)
+#define DMA2D_CR_ABORT				(0x1UL << 2)
+#define DMA2D_CR_TEIE					(0x1UL << 8)
+#define DMA2D_CR_TCIE					(0x1UL << 9)
+#define DMA2D_CR_TWIE					(0x1UL << 10)
+#define DMA2D_CR_CAEIE				(0x1UL << 11)
+#define DMA2D_CR_CTCIE				(0x1UL << 12)
+#define DMA2D_CR_CEIE					(0x1UL << 13)
+#define DMA2D_CR_MODE_Pos			16U
+#define DMA2D_CR_MODE					(0x3UL << DMA2D_CR_MODE_Pos)
+
+#define DMA2D_ISR_TEIF				(0x1UL << 0)
+#define DMA2D_ISR_TCIF				(0x1UL << 1)
+#define DMA2D_ISR_TWIF				(0x1UL << 2)
+#define DMA2D_ISR_CAEIF				(0x1UL << 3)
+#define DMA2D_ISR_CTCIF				(0x1UL << 4)
+#define DMA2D_ISR_CEIF				(0x1UL << 5)
+
+#define DMA2D_IFCR_CTEIF			DMA2D_ISR_TEIF
+#define DMA2D_IFCR_CTCIF			DMA2D_ISR_TCIF
+#define DMA2D_IFCR_CTWIF			DMA2D_ISR_TWIF
+#define DMA2D_IFCR_CAECIF			DMA2D_ISR_CAEIF
+#define DMA2D_IFCR_CCTCIF			DMA2D_ISR_CTCIF
+#define DMA2D_IFCR_CCEIF			DMA2D_ISR_CEIF
+
+#define DMA2D_FGOR_LO					(0x3FFFUL)
+#define DMA2D_BGOR_LO					(0x3FFFUL)
+#define DMA2D_OOR_LO					(0x3FFFUL)
+
+#define DMA2D_FGPFCCR_CM			(0xFUL)
+#define DMA2D_FGPFCCR_CCM			(0x1UL << 4)
+#define DMA2D_FGPFCCR_START		(0x1UL << 5)
+#define DMA2D_FGPFCCR_CS_Pos	8U
+#define DMA2D_FGPFCCR_CS			(0xFFUL << DMA2D_FGPFCCR_CS_Pos)
+#define DMA2D_FGPFCCR_AM_Pos	16U
+#define DMA2D_FGPFCCR_AM			(0x3UL << DMA2D_FGPFCCR_AM_Pos)
+#define DMA2D_FGPFCCR_AI			(0x1UL << 20)
+#define DMA2D_FGPFCCR_RBS			(0x1UL << 21)
+#define DMA2D_FGPFCCR_ALPHA_Pos	24U
+#define DMA2D_FGPFCCR_ALPHA		(0xFFUL << DMA2D_FGPFCCR_ALPHA_Pos)
+
+#define DMA2D_BGPFCCR_CM			DMA2D_FGPFCCR_CM
+#define DMA2D_BGPFCCR_CCM			DMA2D_FGPFCCR_CCM
+#define DMA2D_BGPFCCR_START		DMA2D_FGPFCCR_START
+#define DMA2D_BGPFCCR_CS_Pos	DMA2D_FGPFCCR_CS_Pos
+#define DMA2D_BGPFCCR_CS			DMA2D_FGPFCCR_CS
+#define DMA2D_BGPFCCR_AM_Pos	DMA2D_FGPFCCR_AM_Pos
+#define DMA2D_BGPFCCR_AM			DMA2D_FGPFCCR_AM
+#define DMA2D_BGPFCCR_AI			DMA2D_FGPFCCR_AI
+#define DMA2D_BGPFCCR_RBS			DMA2D_FGPFCCR_RBS
+#define DMA2D_BGPFCCR_ALPHA_Pos	DMA2D_FGPFCCR_ALPHA_Pos
+#define DMA2D_BGPFCCR_ALPHA		DMA2D_FGPFCCR_ALPHA
+
+#define DMA2D_FGCOLR_BLUE			(0xFFUL)
+#define DMA2D_FGCOLR_GREEN_Pos	8U
+#define DMA2D_FGCOLR_GREEN		(0xFFUL << DMA2D_FGCOLR_GREEN_Pos)
+#define DMA2D_FGCOLR_RED_Pos	16U
+#define DMA2D_FGCOLR_RED			(0xFFUL << DMA2D_FGCOLR_RED_Pos)
+#define DMA2D_BGCOLR_BLUE			DMA2D_FGCOLR_BLUE
+#define DMA2D_BGCOLR_GREEN_Pos	DMA2D_FGCOLR_GREEN_Pos
+#define DMA2D_BGCOLR_GREEN		DMA2D_FGCOLR_GREEN
+#define DMA2D_BGCOLR_RED_Pos	DMA2D_FGCOLR_RED_Pos
+#define DMA2D_BGCOLR_RED			DMA2D_FGCOLR_RED
+
+#define DMA2D_OPFCCR_CM				(0x7UL)
+#define DMA2D_OPFCCR_AI				(0x1UL << 20)
+#define DMA2D_OPFCCR_RBS			(0x1UL << 21)
+
+#define DMA2D_NLR_NL					(0xFFFFUL)
+#define DMA2D_NLR_PL_Pos			16U
+#define DMA2D_NLR_PL					(0x3FFFUL << DMA2D_NLR_PL_Pos)
+
+#define DMA_SxCR_EN						(0x1UL << 0)
+#define DMA_SxCR_DMEIE				(0x1UL << 1)
+#define DMA_SxCR_TEIE					(0x1UL << 2)
+#define DMA_SxCR_HTIE					(0x1UL << 3)
+#define DMA_SxCR_TCIE					(0x1UL << 4)
+#define DMA_SxCR_PFCTRL				(0x1UL << 5)
+#define DMA_SxCR_DIR_Pos			6U
+#define DMA_SxCR_DIR					(0x3UL << DMA_SxCR_DIR_Pos)
+#define DMA_SxCR_CIRC					(0x1UL << 8)
+#define DMA_SxCR_PINC					(0x1UL << 9)
+#define DMA_SxCR_MINC					(0x1UL << 10)
+#define DMA_SxCR_PSIZE_Pos		11U
+#define DMA_SxCR_PSIZE				(0x3UL << DMA_SxCR_PSIZE_Pos)
+#define DMA_SxCR_MSIZE_Pos		13U
+#define DMA_SxCR_MSIZE				(0x3UL << DMA_SxCR_MSIZE_Pos)
+#define DMA_SxCR_PINCOS				(0x1UL << 15)
+#define DMA_SxCR_PL						(0x3UL << 16)
+#define DMA_SxCR_DBM					(0x1UL << 18)
+#define DMA_SxCR_CT						(0x1UL << 19)
+#define DMA_SxCR_PBURST				(0x3UL << 21)
+#define DMA_SxCR_MBURST				(0x3UL << 23)
+#define DMA_SxCR_CHSEL_Pos		25U
+#define DMA_SxCR_CHSEL				(0xFUL << DMA_SxCR_CHSEL_Pos)
+#define DMA_SxFCR_FTH					(0x3UL)
+#define DMA_SxFCR_DMDIS				(0x1UL << 2)
+
+#define FLASH_ACR_LATENCY			(0xFUL)
+#define FLASH_ACR_PRFTEN			(0x1UL << 8)
+#define FLASH_ACR_ARTEN				(0x1UL << 9)
+#define FLASH_ACR_ARTRST			(0x1UL << 11)
+
+#define RNG_CR_RNGEN					(0x1UL << 2)
+#define RNG_CR_IE							(0x1UL << 3)
+#define RNG_SR_DRDY						(0x1UL << 0)
+#define RNG_SR_CECS						(0x1UL << 1)
+#define RNG_SR_SECS						(0x1UL << 2)
+#define RNG_SR_CEIS						(0x1UL << 5)
+#define RNG_SR_SEIS						(0x1UL << 6)
+
+#define LPTIM_ISR_CMPM				(0x1UL << 0)
+#define LPTIM_ISR_ARRM				(0x1UL << 1)
+#define LPTIM_IER_CMPMIE			(0x1UL << 0)
+#define LPTIM_CR_ENABLE				(0x1UL << 0)
+#define LPTIM_CR_SNGSTRT			(0x1UL << 1)
+#define LPTIM_CR_CNTSTRT			(0x1UL << 2)
+#define LPTIM_CFGR_PRESC_Pos	9U
+#define LPTIM_CFGR_PRESC			(0x7UL << LPTIM_CFGR_PRESC_Pos)
+
+#define SPI_CR1_SPE						(0x1UL << 6)
+#define SPI_SR_TXE						(0x1UL << 1)
+#define SPI_SR_BSY						(0x1UL << 7)
+
+#define USART_CR1_UE					(0x1UL << 0)
+#define USART_ISR_TEACK				(0x1UL << 21)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F767XX_H*/
@@ -0,0 +1,43 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7XX_H
+#define HOST_STM32F7XX_H
+
+// Host build replacement of the STM32F7 family header, see stm32f767xx.h
+
+#include "stm32f767xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum { RESET = 0U, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0U, ENABLE = !DISABLE } FunctionalState;
+typedef enum { SUCCESS = 0U, ERROR = !SUCCESS } ErrorStatus;
+
+#define SET_BIT(REG, BIT)			((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)		((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)		((REG) & (BIT))
+#define CLEAR_REG(REG)				((REG) = (0x0))
+#define WRITE_REG(REG, VAL)		((REG) = (VAL))
+#define READ_REG(REG)					((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)	WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+#define POSITION_VAL(VAL)			(__CLZ(__RBIT(VAL)))
+
+#define UNUSED(X)							(void)X
+
+extern uint32_t SystemCoreClock;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7XX_H*/
@@ -0,0 +1,33 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_HAL_H
+#define HOST_STM32F7xx_HAL_H
+
+#include "stm32f7xx_hal_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+HAL_StatusTypeDef HAL_Init(void);
+void HAL_IncTick(void);
+uint32_t HAL_GetTick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+// the module headers stm32f7xx_hal_conf.h enables on the target
+#include "stm32f7xx_hal_dma.h"
+#include "stm32f7xx_hal_jpeg.h"
+#include "stm32f7xx_hal_qspi.h"
+
+#endif /*HOST_STM32F7xx_HAL_H*/
@@ -0,0 +1,39 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_HAL_DEF_H
+#define HOST_STM32F7xx_HAL_DEF_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// only the hal types the firmware shares with the ll drivers, the hal peripheral drivers are not used on the host
+typedef enum
+{
+	HAL_OK       = 0x00U,
+	HAL_ERROR    = 0x01U,
+	HAL_BUSY     = 0x02U,
+	HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+	HAL_UNLOCKED = 0x00U,
+	HAL_LOCKED   = 0x01U
+} HAL_LockTypeDef;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_HAL_DEF_H*/
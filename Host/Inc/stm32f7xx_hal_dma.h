@@ -0,0 +1,34 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_HAL_DMA_H
+#define HOST_STM32F7xx_HAL_DMA_H
+
+#include "stm32f7xx_hal_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct __DMA_HandleTypeDef
+{
+	DMA_Stream_TypeDef*		Instance;
+	HAL_LockTypeDef				Lock;
+	void*									Parent;
+	uint32_t							ErrorCode;
+} DMA_HandleTypeDef;
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_HAL_DMA_H*/
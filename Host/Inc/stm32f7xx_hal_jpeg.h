@@ -0,0 +1,66 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_HAL_JPEG_H
+#define HOST_STM32F7xx_HAL_JPEG_H
+
+#include "stm32f7xx_hal_dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// JPEG_SOFTWARE_DECODER only shares the image description with the hal, values as stm32f7xx_hal_jpeg.h
+#define JPEG_GRAYSCALE_COLORSPACE		0x00000000U
+#define JPEG_YCBCR_COLORSPACE				0x00000010U
+#define JPEG_CMYK_COLORSPACE				0x00000030U
+
+#define JPEG_444_SUBSAMPLING				0x00000000U
+#define JPEG_420_SUBSAMPLING				0x00000001U
+#define JPEG_422_SUBSAMPLING				0x00000002U
+
+typedef struct
+{
+	uint32_t ColorSpace;
+	uint32_t ChromaSubsampling;
+	uint32_t ImageHeight;
+	uint32_t ImageWidth;
+	uint32_t ImageQuality;
+} JPEG_ConfTypeDef;
+
+typedef enum
+{
+	HAL_JPEG_STATE_RESET							= 0x00U,
+	HAL_JPEG_STATE_READY							= 0x01U,
+	HAL_JPEG_STATE_BUSY								= 0x02U,
+	HAL_JPEG_STATE_BUSY_ENCODING			= 0x03U,
+	HAL_JPEG_STATE_BUSY_DECODING			= 0x04U,
+	HAL_JPEG_STATE_TIMEOUT						= 0x05U,
+	HAL_JPEG_STATE_ERROR							= 0x06U
+} HAL_JPEG_STATETypeDef;
+
+typedef struct
+{
+	JPEG_TypeDef*						Instance;
+	JPEG_ConfTypeDef				Conf;
+	DMA_HandleTypeDef*			hdmain;
+	DMA_HandleTypeDef*			hdmaout;
+	HAL_LockTypeDef					Lock;
+	volatile HAL_JPEG_STATETypeDef State;
+	volatile uint32_t				ErrorCode;
+} JPEG_HandleTypeDef;
+
+void HAL_JPEG_IRQHandler(JPEG_HandleTypeDef* hjpeg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_HAL_JPEG_H*/
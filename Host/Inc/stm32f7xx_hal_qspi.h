@@ -0,0 +1,50 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_HAL_QSPI_H
+#define HOST_STM32F7xx_HAL_QSPI_H
+
+#include "stm32f7xx_hal_dma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// QSPI_FRAM_SOFTWARE_EMULATOR reports its errors with the hal error codes, values as stm32f7xx_hal_qspi.h
+#define HAL_QSPI_ERROR_NONE						0x00000000U
+#define HAL_QSPI_ERROR_TIMEOUT				0x00000001U
+#define HAL_QSPI_ERROR_TRANSFER				0x00000002U
+#define HAL_QSPI_ERROR_DMA						0x00000004U
+#define HAL_QSPI_ERROR_INVALID_PARAM	0x00000008U
+
+typedef enum
+{
+	HAL_QSPI_STATE_RESET							= 0x00U,
+	HAL_QSPI_STATE_READY							= 0x01U,
+	HAL_QSPI_STATE_BUSY								= 0x02U,
+	HAL_QSPI_STATE_ERROR							= 0x08U
+} HAL_QSPI_StateTypeDef;
+
+typedef struct
+{
+	QUADSPI_TypeDef*							Instance;
+	DMA_HandleTypeDef*						hdma;
+	HAL_LockTypeDef								Lock;
+	volatile HAL_QSPI_StateTypeDef State;
+	volatile uint32_t							ErrorCode;
+} QSPI_HandleTypeDef;
+
+void HAL_QSPI_IRQHandler(QSPI_HandleTypeDef* hqspi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_HAL_QSPI_H*/
@@ -0,0 +1,55 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_BUS_H
+#define HOST_STM32F7xx_LL_BUS_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LL_AHB1_GRP1_PERIPH_GPIOA		(0x1UL << 0)
+#define LL_AHB1_GRP1_PERIPH_GPIOB		(0x1UL << 1)
+#define LL_AHB1_GRP1_PERIPH_GPIOC		(0x1UL << 2)
+#define LL_AHB1_GRP1_PERIPH_GPIOD		(0x1UL << 3)
+#define LL_AHB1_GRP1_PERIPH_GPIOE		(0x1UL << 4)
+#define LL_AHB1_GRP1_PERIPH_GPIOF		(0x1UL << 5)
+#define LL_AHB1_GRP1_PERIPH_GPIOG		(0x1UL << 6)
+#define LL_AHB1_GRP1_PERIPH_GPIOH		(0x1UL << 7)
+#define LL_AHB1_GRP1_PERIPH_BKPSRAM	(0x1UL << 18)
+#define LL_AHB1_GRP1_PERIPH_DTCMRAM	(0x1UL << 20)
+#define LL_AHB1_GRP1_PERIPH_DMA1		(0x1UL << 21)
+#define LL_AHB1_GRP1_PERIPH_DMA2		(0x1UL << 22)
+#define LL_AHB1_GRP1_PERIPH_DMA2D		(0x1UL << 23)
+#define LL_AHB2_GRP1_PERIPH_JPEG		(0x1UL << 1)
+#define LL_AHB2_GRP1_PERIPH_RNG			(0x1UL << 6)
+#define LL_AHB3_GRP1_PERIPH_FMC			(0x1UL << 0)
+#define LL_AHB3_GRP1_PERIPH_QSPI		(0x1UL << 1)
+#define LL_APB1_GRP1_PERIPH_USART3	(0x1UL << 18)
+#define LL_APB1_GRP1_PERIPH_PWR			(0x1UL << 28)
+#define LL_APB1_GRP1_PERIPH_LPTIM1	(0x1UL << 9)
+#define LL_APB2_GRP1_PERIPH_SPI1		(0x1UL << 12)
+#define LL_APB2_GRP1_PERIPH_SYSCFG	(0x1UL << 14)
+
+__STATIC_INLINE void LL_AHB1_GRP1_EnableClock(uint32_t Periphs) { SET_BIT(RCC->AHB1ENR, Periphs); }
+__STATIC_INLINE uint32_t LL_AHB1_GRP1_IsEnabledClock(uint32_t Periphs) { return( READ_BIT(RCC->AHB1ENR, Periphs) == Periphs ); }
+__STATIC_INLINE void LL_AHB1_GRP1_DisableClock(uint32_t Periphs) { CLEAR_BIT(RCC->AHB1ENR, Periphs); }
+__STATIC_INLINE void LL_AHB2_GRP1_EnableClock(uint32_t Periphs) { SET_BIT(RCC->AHB2ENR, Periphs); }
+__STATIC_INLINE void LL_AHB3_GRP1_EnableClock(uint32_t Periphs) { SET_BIT(RCC->AHB3ENR, Periphs); }
+__STATIC_INLINE void LL_APB1_GRP1_EnableClock(uint32_t Periphs) { SET_BIT(RCC->APB1ENR, Periphs); }
+__STATIC_INLINE void LL_APB2_GRP1_EnableClock(uint32_t Periphs) { SET_BIT(RCC->APB2ENR, Periphs); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_BUS_H*/
@@ -0,0 +1,87 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_CORTEX_H
+#define HOST_STM32F7xx_LL_CORTEX_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LL_SYSTICK_CLKSOURCE_HCLK_DIV8	0x00000000U
+#define LL_SYSTICK_CLKSOURCE_HCLK				SysTick_CTRL_CLKSOURCE_Msk
+
+__STATIC_INLINE void LL_SYSTICK_SetClkSource(uint32_t Source) { MODIFY_REG(SysTick->CTRL, SysTick_CTRL_CLKSOURCE_Msk, Source); }
+__STATIC_INLINE void LL_SYSTICK_EnableIT(void) { SET_BIT(SysTick->CTRL, SysTick_CTRL_TICKINT_Msk); Host_SysTick_Enable(); }
+__STATIC_INLINE void LL_SYSTICK_DisableIT(void) { CLEAR_BIT(SysTick->CTRL, SysTick_CTRL_TICKINT_Msk); }
+__STATIC_INLINE uint32_t LL_SYSTICK_IsActiveCounterFlag(void) { return( (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) == SysTick_CTRL_COUNTFLAG_Msk ); }
+
+// mpu, configuration is recorded only
+#define LL_MPU_CTRL_HFNMI_PRIVDEF_NONE		0x00000000U
+#define LL_MPU_CTRL_HARDFAULT_NMI					0x00000002U
+#define LL_MPU_CTRL_PRIVILEGED_DEFAULT		0x00000004U
+#define LL_MPU_CTRL_HFNMI_PRIVDEF					0x00000006U
+
+#define LL_MPU_REGION_NUMBER0		0x00U
+#define LL_MPU_REGION_NUMBER1		0x01U
+#define LL_MPU_REGION_NUMBER2		0x02U
+#define LL_MPU_REGION_NUMBER3		0x03U
+#define LL_MPU_REGION_NUMBER4		0x04U
+#define LL_MPU_REGION_NUMBER5		0x05U
+#define LL_MPU_REGION_NUMBER6		0x06U
+#define LL_MPU_REGION_NUMBER7		0x07U
+
+#define LL_MPU_REGION_SIZE_32B		(0x04U << 1)
+#define LL_MPU_REGION_SIZE_4KB		(0x0BU << 1)
+#define LL_MPU_REGION_SIZE_16KB		(0x0DU << 1)
+#define LL_MPU_REGION_SIZE_64KB		(0x0FU << 1)
+#define LL_MPU_REGION_SIZE_256KB	(0x11U << 1)
+#define LL_MPU_REGION_SIZE_512KB	(0x12U << 1)
+#define LL_MPU_REGION_SIZE_1MB		(0x13U << 1)
+#define LL_MPU_REGION_SIZE_8MB		(0x16U << 1)
+#define LL_MPU_REGION_SIZE_16MB		(0x17U << 1)
+#define LL_MPU_REGION_SIZE_256MB	(0x1BU << 1)
+
+#define LL_MPU_REGION_NO_ACCESS		(0x00U << 24)
+#define LL_MPU_REGION_PRIV_RW			(0x01U << 24)
+#define LL_MPU_REGION_PRIV_RW_URO	(0x02U << 24)
+#define LL_MPU_REGION_FULL_ACCESS	(0x03U << 24)
+#define LL_MPU_REGION_PRIV_RO			(0x05U << 24)
+#define LL_MPU_REGION_PRIV_RO_URO	(0x06U << 24)
+
+#define LL_MPU_TEX_LEVEL0					(0x00U << 19)
+#define LL_MPU_TEX_LEVEL1					(0x01U << 19)
+#define LL_MPU_TEX_LEVEL2					(0x02U << 19)
+
+#define LL_MPU_INSTRUCTION_ACCESS_ENABLE	0x00U
+#define LL_MPU_INSTRUCTION_ACCESS_DISABLE	(0x01U << 28)
+#define LL_MPU_ACCESS_SHAREABLE						(0x01U << 18)
+#define LL_MPU_ACCESS_NOT_SHAREABLE				0x00U
+#define LL_MPU_ACCESS_CACHEABLE						(0x01U << 17)
+#define LL_MPU_ACCESS_NOT_CACHEABLE				0x00U
+#define LL_MPU_ACCESS_BUFFERABLE					(0x01U << 16)
+#define LL_MPU_ACCESS_NOT_BUFFERABLE			0x00U
+
+__STATIC_INLINE void LL_MPU_Enable(uint32_t Options) { MPU->CTRL = Options | 1U; }
+__STATIC_INLINE void LL_MPU_Disable(void) { MPU->CTRL = 0U; }
+__STATIC_INLINE void LL_MPU_ConfigRegion(uint32_t Region, uint32_t SubRegionDisable, uint32_t Address, uint32_t Attributes)
+{
+	MPU->RNR = Region;
+	MPU->RBAR = Address;
+	MPU->RASR = 1U | Attributes | (SubRegionDisable << 8);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_CORTEX_H*/
@@ -0,0 +1,137 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_DMA_H
+#define HOST_STM32F7xx_LL_DMA_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// enabling a stream hands the transfer to the host board emulation (Host.h), flags / interrupt enables are the register bits
+#define LL_DMA_STREAM_0		0x00000000U
+#define LL_DMA_STREAM_1		0x00000001U
+#define LL_DMA_STREAM_2		0x00000002U
+#define LL_DMA_STREAM_3		0x00000003U
+#define LL_DMA_STREAM_4		0x00000004U
+#define LL_DMA_STREAM_5		0x00000005U
+#define LL_DMA_STREAM_6		0x00000006U
+#define LL_DMA_STREAM_7		0x00000007U
+
+#define LL_DMA_CHANNEL_0	0x00000000U
+#define LL_DMA_CHANNEL_3	(0x3UL << DMA_SxCR_CHSEL_Pos)
+#define LL_DMA_CHANNEL_4	(0x4UL << DMA_SxCR_CHSEL_Pos)
+
+#define LL_DMA_DIRECTION_PERIPH_TO_MEMORY		0x00000000U
+#define LL_DMA_DIRECTION_MEMORY_TO_PERIPH		(0x1UL << DMA_SxCR_DIR_Pos)
+#define LL_DMA_DIRECTION_MEMORY_TO_MEMORY		(0x2UL << DMA_SxCR_DIR_Pos)
+
+#define LL_DMA_MODE_NORMAL							0x00000000U
+#define LL_DMA_MODE_CIRCULAR						DMA_SxCR_CIRC
+#define LL_DMA_MODE_PFCTRL							DMA_SxCR_PFCTRL
+#define LL_DMA_DOUBLEBUFFER_MODE_DISABLE	0x00000000U
+#define LL_DMA_DOUBLEBUFFER_MODE_ENABLE		DMA_SxCR_DBM
+#define LL_DMA_PERIPH_NOINCREMENT				0x00000000U
+#define LL_DMA_PERIPH_INCREMENT					DMA_SxCR_PINC
+#define LL_DMA_MEMORY_NOINCREMENT				0x00000000U
+#define LL_DMA_MEMORY_INCREMENT					DMA_SxCR_MINC
+#define LL_DMA_PDATAALIGN_BYTE					0x00000000U
+#define LL_DMA_PDATAALIGN_HALFWORD			(0x1UL << DMA_SxCR_PSIZE_Pos)
+#define LL_DMA_PDATAALIGN_WORD					(0x2UL << DMA_SxCR_PSIZE_Pos)
+#define LL_DMA_MDATAALIGN_BYTE					0x00000000U
+#define LL_DMA_MDATAALIGN_HALFWORD			(0x1UL << DMA_SxCR_MSIZE_Pos)
+#define LL_DMA_MDATAALIGN_WORD					(0x2UL << DMA_SxCR_MSIZE_Pos)
+#define LL_DMA_PRIORITY_LOW							0x00000000U
+#define LL_DMA_PRIORITY_MEDIUM					(0x1UL << 16)
+#define LL_DMA_PRIORITY_HIGH						(0x2UL << 16)
+#define LL_DMA_PRIORITY_VERYHIGH				(0x3UL << 16)
+#define LL_DMA_MBURST_SINGLE						0x00000000U
+#define LL_DMA_PBURST_SINGLE						0x00000000U
+#define LL_DMA_FIFOTHRESHOLD_1_4				0x00000000U
+#define LL_DMA_FIFOTHRESHOLD_1_2				0x00000001U
+#define LL_DMA_FIFOTHRESHOLD_3_4				0x00000002U
+#define LL_DMA_FIFOTHRESHOLD_FULL				0x00000003U
+#define LL_DMA_CURRENTTARGETMEM0				0x00000000U
+#define LL_DMA_CURRENTTARGETMEM1				DMA_SxCR_CT
+
+// flag bit of a stream in LISR / HISR
+__STATIC_INLINE uint32_t Host_DMA_FlagShift(uint32_t Stream) { static uint8_t const Shift[4] = { 0, 6, 16, 22 }; return( Shift[Stream & 3] ); }
+__STATIC_INLINE volatile uint32_t* Host_DMA_ISR(DMA_TypeDef* DMAx, uint32_t Stream) { return( Stream < 4 ? &DMAx->LISR : &DMAx->HISR ); }
+#define HOST_DMA_FLAG_TE	(0x1UL << 3)
+#define HOST_DMA_FLAG_TC	(0x1UL << 5)
+
+__STATIC_INLINE void LL_DMA_EnableStream(DMA_TypeDef* DMAx, uint32_t Stream) { SET_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_EN); Host_DMA_EnableStream(DMAx, Stream); }
+__STATIC_INLINE void LL_DMA_DisableStream(DMA_TypeDef* DMAx, uint32_t Stream) { CLEAR_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_EN); }
+__STATIC_INLINE uint32_t LL_DMA_IsEnabledStream(DMA_TypeDef* DMAx, uint32_t Stream) { return( READ_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_EN) == DMA_SxCR_EN ); }
+__STATIC_INLINE void LL_DMA_ConfigTransfer(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Configuration)
+{
+	MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_DIR | DMA_SxCR_CIRC | DMA_SxCR_PINC | DMA_SxCR_MINC | DMA_SxCR_PSIZE | DMA_SxCR_MSIZE | DMA_SxCR_PL | DMA_SxCR_PFCTRL | DMA_SxCR_DBM, Configuration);
+}
+__STATIC_INLINE void LL_DMA_SetDataTransferDirection(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Direction) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_DIR, Direction); }
+__STATIC_INLINE uint32_t LL_DMA_GetDataTransferDirection(DMA_TypeDef* DMAx, uint32_t Stream) { return( READ_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_DIR) ); }
+__STATIC_INLINE void LL_DMA_SetMode(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Mode) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_CIRC | DMA_SxCR_PFCTRL, Mode); }
+__STATIC_INLINE void LL_DMA_SetPeriphIncMode(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t IncrementMode) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_PINC, IncrementMode); }
+__STATIC_INLINE void LL_DMA_SetMemoryIncMode(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t IncrementMode) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_MINC, IncrementMode); }
+__STATIC_INLINE void LL_DMA_SetPeriphSize(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Size) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_PSIZE, Size); }
+__STATIC_INLINE void LL_DMA_SetMemorySize(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Size) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_MSIZE, Size); }
+__STATIC_INLINE void LL_DMA_SetStreamPriorityLevel(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Priority) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_PL, Priority); }
+__STATIC_INLINE void LL_DMA_SetChannelSelection(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Channel) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_CHSEL, Channel); }
+__STATIC_INLINE void LL_DMA_SetMemoryBurstxfer(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Mburst) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_MBURST, Mburst); }
+__STATIC_INLINE void LL_DMA_SetPeriphBurstxfer(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Pburst) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_PBURST, Pburst); }
+__STATIC_INLINE void LL_DMA_EnableDoubleBufferMode(DMA_TypeDef* DMAx, uint32_t Stream) { SET_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_DBM); }
+__STATIC_INLINE void LL_DMA_SetCurrentTargetMem(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t CurrentMemory) { MODIFY_REG(DMAx->Stream[Stream].CR, DMA_SxCR_CT, CurrentMemory); }
+__STATIC_INLINE uint32_t LL_DMA_GetCurrentTargetMem(DMA_TypeDef* DMAx, uint32_t Stream) { return( READ_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_CT) ); }
+__STATIC_INLINE void LL_DMA_EnableFifoMode(DMA_TypeDef* DMAx, uint32_t Stream) { SET_BIT(DMAx->Stream[Stream].FCR, DMA_SxFCR_DMDIS); }
+__STATIC_INLINE void LL_DMA_DisableFifoMode(DMA_TypeDef* DMAx, uint32_t Stream) { CLEAR_BIT(DMAx->Stream[Stream].FCR, DMA_SxFCR_DMDIS); }
+__STATIC_INLINE void LL_DMA_SetFIFOThreshold(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Threshold) { MODIFY_REG(DMAx->Stream[Stream].FCR, DMA_SxFCR_FTH, Threshold); }
+__STATIC_INLINE void LL_DMA_SetDataLength(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t NbData) { DMAx->Stream[Stream].NDTR = NbData; }
+__STATIC_INLINE uint32_t LL_DMA_GetDataLength(DMA_TypeDef* DMAx, uint32_t Stream) { return( DMAx->Stream[Stream].NDTR ); }
+__STATIC_INLINE void LL_DMA_SetMemoryAddress(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t MemoryAddress) { DMAx->Stream[Stream].M0AR = MemoryAddress; }
+__STATIC_INLINE void LL_DMA_SetMemory1Address(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t Address) { DMAx->Stream[Stream].M1AR = Address; }
+__STATIC_INLINE void LL_DMA_SetPeriphAddress(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t PeriphAddress) { DMAx->Stream[Stream].PAR = PeriphAddress; }
+__STATIC_INLINE void LL_DMA_SetM2MSrcAddress(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t MemoryAddress) { DMAx->Stream[Stream].PAR = MemoryAddress; }
+__STATIC_INLINE void LL_DMA_SetM2MDstAddress(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t MemoryAddress) { DMAx->Stream[Stream].M0AR = MemoryAddress; }
+__STATIC_INLINE void LL_DMA_ConfigAddresses(DMA_TypeDef* DMAx, uint32_t Stream, uint32_t SrcAddress, uint32_t DstAddress, uint32_t Direction)
+{
+	if ( LL_DMA_DIRECTION_MEMORY_TO_PERIPH == Direction ) {
+		DMAx->Stream[Stream].M0AR = SrcAddress;
+		DMAx->Stream[Stream].PAR = DstAddress;
+	}
+	else {
+		DMAx->Stream[Stream].PAR = SrcAddress;
+		DMAx->Stream[Stream].M0AR = DstAddress;
+	}
+}
+__STATIC_INLINE void LL_DMA_EnableIT_TC(DMA_TypeDef* DMAx, uint32_t Stream) { SET_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_TCIE); }
+__STATIC_INLINE void LL_DMA_EnableIT_TE(DMA_TypeDef* DMAx, uint32_t Stream) { SET_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_TEIE); }
+__STATIC_INLINE void LL_DMA_DisableIT_TE(DMA_TypeDef* DMAx, uint32_t Stream) { CLEAR_BIT(DMAx->Stream[Stream].CR, DMA_SxCR_TEIE); }
+
+#define HOST_DMA_FLAG_FUNCTIONS(n) \
+__STATIC_INLINE uint32_t LL_DMA_IsActiveFlag_TC##n(DMA_TypeDef* DMAx) { return( 0 != (*Host_DMA_ISR(DMAx, n) & (HOST_DMA_FLAG_TC << Host_DMA_FlagShift(n))) ); } \
+__STATIC_INLINE uint32_t LL_DMA_IsActiveFlag_TE##n(DMA_TypeDef* DMAx) { return( 0 != (*Host_DMA_ISR(DMAx, n) & (HOST_DMA_FLAG_TE << Host_DMA_FlagShift(n))) ); } \
+__STATIC_INLINE void LL_DMA_ClearFlag_TC##n(DMA_TypeDef* DMAx) { *Host_DMA_ISR(DMAx, n) &= ~(HOST_DMA_FLAG_TC << Host_DMA_FlagShift(n)); } \
+__STATIC_INLINE void LL_DMA_ClearFlag_TE##n(DMA_TypeDef* DMAx) { *Host_DMA_ISR(DMAx, n) &= ~(HOST_DMA_FLAG_TE << Host_DMA_FlagShift(n)); }
+
+HOST_DMA_FLAG_FUNCTIONS(0)
+HOST_DMA_FLAG_FUNCTIONS(1)
+HOST_DMA_FLAG_FUNCTIONS(2)
+HOST_DMA_FLAG_FUNCTIONS(3)
+HOST_DMA_FLAG_FUNCTIONS(4)
+HOST_DMA_FLAG_FUNCTIONS(5)
+HOST_DMA_FLAG_FUNCTIONS(6)
+HOST_DMA_FLAG_FUNCTIONS(7)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_DMA_H*/
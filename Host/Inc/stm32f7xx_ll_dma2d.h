@@ -0,0 +1,166 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_DMA2D_H
+#define HOST_STM32F7xx_LL_DMA2D_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// register level only, transfers are executed by the DMA2D software engine (DMA2D_Soft.h)
+#define LL_DMA2D_MODE_M2M							0x00000000U
+#define LL_DMA2D_MODE_M2M_PFC					(0x1UL << 16)
+#define LL_DMA2D_MODE_M2M_BLEND				(0x2UL << 16)
+#define LL_DMA2D_MODE_R2M							(0x3UL << 16)
+
+#define LL_DMA2D_OUTPUT_MODE_ARGB8888	0x00000000U
+#define LL_DMA2D_OUTPUT_MODE_RGB888		0x00000001U
+#define LL_DMA2D_OUTPUT_MODE_RGB565		0x00000002U
+
+#define LL_DMA2D_INPUT_MODE_ARGB8888	0x00000000U
+#define LL_DMA2D_INPUT_MODE_RGB888		0x00000001U
+#define LL_DMA2D_INPUT_MODE_RGB565		0x00000002U
+#define LL_DMA2D_INPUT_MODE_L8				0x00000005U
+#define LL_DMA2D_INPUT_MODE_AL44			0x00000006U
+#define LL_DMA2D_INPUT_MODE_AL88			0x00000007U
+#define LL_DMA2D_INPUT_MODE_L4				0x00000008U
+#define LL_DMA2D_INPUT_MODE_A8				0x00000009U
+#define LL_DMA2D_INPUT_MODE_A4				0x0000000AU
+
+#define LL_DMA2D_ALPHA_MODE_NO_MODIF	0x00000000U
+#define LL_DMA2D_ALPHA_MODE_REPLACE		(0x1UL << 16)
+#define LL_DMA2D_ALPHA_MODE_COMBINE		(0x2UL << 16)
+
+#define LL_DMA2D_ALPHA_REGULAR				0x00000000U
+#define LL_DMA2D_ALPHA_INVERTED				DMA2D_FGPFCCR_AI
+#define LL_DMA2D_RB_MODE_REGULAR			0x00000000U
+#define LL_DMA2D_RB_MODE_SWAP					DMA2D_FGPFCCR_RBS
+
+#define LL_DMA2D_CLUT_COLOR_MODE_ARGB8888	0x00000000U
+#define LL_DMA2D_CLUT_COLOR_MODE_RGB888		DMA2D_FGPFCCR_CCM
+
+typedef struct
+{
+	uint32_t Mode;
+	uint32_t ColorMode;
+	uint32_t OutputBlue;
+	uint32_t OutputGreen;
+	uint32_t OutputRed;
+	uint32_t OutputAlpha;
+	uint32_t OutputMemoryAddress;
+	uint32_t LineOffset;
+	uint32_t NbrOfLines;
+	uint32_t NbrOfPixelsPerLines;
+	uint32_t AlphaInversionMode;
+	uint32_t RBSwapMode;
+} LL_DMA2D_InitTypeDef;
+
+typedef struct
+{
+	uint32_t MemoryAddress;
+	uint32_t LineOffset;
+	uint32_t ColorMode;
+	uint32_t CLUTColorMode;
+	uint32_t CLUTSize;
+	uint32_t AlphaMode;
+	uint32_t Alpha;
+	uint32_t Blue;
+	uint32_t Green;
+	uint32_t Red;
+	uint32_t CLUTMemoryAddress;
+	uint32_t AlphaInversionMode;
+	uint32_t RBSwapMode;
+} LL_DMA2D_LayerCfgTypeDef;
+
+__STATIC_INLINE void LL_DMA2D_Start(DMA2D_TypeDef* DMA2Dx) { SET_BIT(DMA2Dx->CR, DMA2D_CR_START); }
+__STATIC_INLINE uint32_t LL_DMA2D_IsTransferOngoing(DMA2D_TypeDef* DMA2Dx) { return( READ_BIT(DMA2Dx->CR, DMA2D_CR_START) == DMA2D_CR_START ); }
+__STATIC_INLINE void LL_DMA2D_Abort(DMA2D_TypeDef* DMA2Dx) { CLEAR_BIT(DMA2Dx->CR, DMA2D_CR_START); }
+__STATIC_INLINE void LL_DMA2D_SetMode(DMA2D_TypeDef* DMA2Dx, uint32_t Mode) { MODIFY_REG(DMA2Dx->CR, DMA2D_CR_MODE, Mode); }
+__STATIC_INLINE void LL_DMA2D_SetOutputColorMode(DMA2D_TypeDef* DMA2Dx, uint32_t ColorMode) { MODIFY_REG(DMA2Dx->OPFCCR, DMA2D_OPFCCR_CM, ColorMode); }
+__STATIC_INLINE void LL_DMA2D_SetOutputColor(DMA2D_TypeDef* DMA2Dx, uint32_t OutputColor) { DMA2Dx->OCOLR = OutputColor; }
+__STATIC_INLINE void LL_DMA2D_SetOutputMemAddr(DMA2D_TypeDef* DMA2Dx, uint32_t OutputMemoryAddress) { DMA2Dx->OMAR = OutputMemoryAddress; }
+__STATIC_INLINE void LL_DMA2D_SetLineOffset(DMA2D_TypeDef* DMA2Dx, uint32_t LineOffset) { MODIFY_REG(DMA2Dx->OOR, DMA2D_OOR_LO, LineOffset); }
+__STATIC_INLINE void LL_DMA2D_SetNbrOfLines(DMA2D_TypeDef* DMA2Dx, uint32_t NbrOfLines) { MODIFY_REG(DMA2Dx->NLR, DMA2D_NLR_NL, NbrOfLines); }
+__STATIC_INLINE void LL_DMA2D_SetNbrOfPixelsPerLines(DMA2D_TypeDef* DMA2Dx, uint32_t NbrOfPixelsPerLines) { MODIFY_REG(DMA2Dx->NLR, DMA2D_NLR_PL, NbrOfPixelsPerLines << DMA2D_NLR_PL_Pos); }
+__STATIC_INLINE void LL_DMA2D_ConfigSize(DMA2D_TypeDef* DMA2Dx, uint32_t NbrOfLines, uint32_t NbrOfPixelsPerLines) { DMA2Dx->NLR = (NbrOfPixelsPerLines << DMA2D_NLR_PL_Pos) | NbrOfLines; }
+
+__STATIC_INLINE void LL_DMA2D_FGND_SetMemAddr(DMA2D_TypeDef* DMA2Dx, uint32_t MemoryAddress) { DMA2Dx->FGMAR = MemoryAddress; }
+__STATIC_INLINE uint32_t LL_DMA2D_FGND_GetMemAddr(DMA2D_TypeDef* DMA2Dx) { return( DMA2Dx->FGMAR ); }
+__STATIC_INLINE void LL_DMA2D_FGND_SetLineOffset(DMA2D_TypeDef* DMA2Dx, uint32_t LineOffset) { MODIFY_REG(DMA2Dx->FGOR, DMA2D_FGOR_LO, LineOffset); }
+__STATIC_INLINE void LL_DMA2D_FGND_SetAlpha(DMA2D_TypeDef* DMA2Dx, uint32_t Alpha) { MODIFY_REG(DMA2Dx->FGPFCCR, DMA2D_FGPFCCR_ALPHA, Alpha << DMA2D_FGPFCCR_ALPHA_Pos); }
+__STATIC_INLINE void LL_DMA2D_FGND_EnableCLUTLoad(DMA2D_TypeDef* DMA2Dx) { SET_BIT(DMA2Dx->FGPFCCR, DMA2D_FGPFCCR_START); }
+__STATIC_INLINE void LL_DMA2D_BGND_SetMemAddr(DMA2D_TypeDef* DMA2Dx, uint32_t MemoryAddress) { DMA2Dx->BGMAR = MemoryAddress; }
+__STATIC_INLINE uint32_t LL_DMA2D_BGND_GetMemAddr(DMA2D_TypeDef* DMA2Dx) { return( DMA2Dx->BGMAR ); }
+__STATIC_INLINE void LL_DMA2D_BGND_SetLineOffset(DMA2D_TypeDef* DMA2Dx, uint32_t LineOffset) { MODIFY_REG(DMA2Dx->BGOR, DMA2D_BGOR_LO, LineOffset); }
+__STATIC_INLINE void LL_DMA2D_BGND_EnableCLUTLoad(DMA2D_TypeDef* DMA2Dx) { SET_BIT(DMA2Dx->BGPFCCR, DMA2D_BGPFCCR_START); }
+
+__STATIC_INLINE uint32_t LL_DMA2D_IsActiveFlag_TC(DMA2D_TypeDef* DMA2Dx) { return( READ_BIT(DMA2Dx->ISR, DMA2D_ISR_TCIF) == DMA2D_ISR_TCIF ); }
+__STATIC_INLINE uint32_t LL_DMA2D_IsActiveFlag_TE(DMA2D_TypeDef* DMA2Dx) { return( READ_BIT(DMA2Dx->ISR, DMA2D_ISR_TEIF) == DMA2D_ISR_TEIF ); }
+__STATIC_INLINE uint32_t LL_DMA2D_IsActiveFlag_CE(DMA2D_TypeDef* DMA2Dx) { return( READ_BIT(DMA2Dx->ISR, DMA2D_ISR_CEIF) == DMA2D_ISR_CEIF ); }
+__STATIC_INLINE void LL_DMA2D_ClearFlag_TC(DMA2D_TypeDef* DMA2Dx) { CLEAR_BIT(DMA2Dx->ISR, DMA2D_ISR_TCIF); }
+__STATIC_INLINE void LL_DMA2D_EnableIT_TC(DMA2D_TypeDef* DMA2Dx) { SET_BIT(DMA2Dx->CR, DMA2D_CR_TCIE); }
+__STATIC_INLINE void LL_DMA2D_DisableIT_TC(DMA2D_TypeDef* DMA2Dx) { CLEAR_BIT(DMA2Dx->CR, DMA2D_CR_TCIE); }
+__STATIC_INLINE void LL_DMA2D_EnableIT_TE(DMA2D_TypeDef* DMA2Dx) { SET_BIT(DMA2Dx->CR, DMA2D_CR_TEIE); }
+__STATIC_INLINE void LL_DMA2D_EnableIT_CE(DMA2D_TypeDef* DMA2Dx) { SET_BIT(DMA2Dx->CR, DMA2D_CR_CEIE); }
+__STATIC_INLINE void LL_DMA2D_DisableIT_CTC(DMA2D_TypeDef* DMA2Dx) { CLEAR_BIT(DMA2Dx->CR, DMA2D_CR_CTCIE); }
+__STATIC_INLINE void LL_DMA2D_DisableIT_CAE(DMA2D_TypeDef* DMA2Dx) { CLEAR_BIT(DMA2Dx->CR, DMA2D_CR_CAEIE); }
+__STATIC_INLINE void LL_DMA2D_DisableIT_TW(DMA2D_TypeDef* DMA2Dx) { CLEAR_BIT(DMA2Dx->CR, DMA2D_CR_TWIE); }
+
+__STATIC_INLINE void LL_DMA2D_StructInit(LL_DMA2D_InitTypeDef* DMA2D_InitStruct)
+{
+	memset(DMA2D_InitStruct, 0, sizeof(LL_DMA2D_InitTypeDef));
+	DMA2D_InitStruct->Mode = LL_DMA2D_MODE_M2M;
+	DMA2D_InitStruct->ColorMode = LL_DMA2D_OUTPUT_MODE_ARGB8888;
+}
+__STATIC_INLINE ErrorStatus LL_DMA2D_Init(DMA2D_TypeDef* DMA2Dx, LL_DMA2D_InitTypeDef* DMA2D_InitStruct)
+{
+	MODIFY_REG(DMA2Dx->CR, DMA2D_CR_MODE, DMA2D_InitStruct->Mode);
+	DMA2Dx->OPFCCR = DMA2D_InitStruct->ColorMode | DMA2D_InitStruct->AlphaInversionMode | DMA2D_InitStruct->RBSwapMode;
+	DMA2Dx->OOR = DMA2D_InitStruct->LineOffset;
+	DMA2Dx->NLR = (DMA2D_InitStruct->NbrOfPixelsPerLines << DMA2D_NLR_PL_Pos) | DMA2D_InitStruct->NbrOfLines;
+	DMA2Dx->OMAR = DMA2D_InitStruct->OutputMemoryAddress;
+	DMA2Dx->OCOLR = (DMA2D_InitStruct->OutputAlpha << 24) | (DMA2D_InitStruct->OutputRed << 16) | (DMA2D_InitStruct->OutputGreen << 8) | DMA2D_InitStruct->OutputBlue;
+	return(SUCCESS);
+}
+__STATIC_INLINE void LL_DMA2D_LayerCfgStructInit(LL_DMA2D_LayerCfgTypeDef* DMA2D_LayerCfg)
+{
+	memset(DMA2D_LayerCfg, 0, sizeof(LL_DMA2D_LayerCfgTypeDef));
+}
+__STATIC_INLINE void LL_DMA2D_ConfigLayer(DMA2D_TypeDef* DMA2Dx, LL_DMA2D_LayerCfgTypeDef* DMA2D_LayerCfg, uint32_t LayerIdx)
+{
+	uint32_t const PFCCR = DMA2D_LayerCfg->ColorMode | DMA2D_LayerCfg->CLUTColorMode | (DMA2D_LayerCfg->CLUTSize << DMA2D_FGPFCCR_CS_Pos)
+											 | DMA2D_LayerCfg->AlphaMode | DMA2D_LayerCfg->AlphaInversionMode | DMA2D_LayerCfg->RBSwapMode
+											 | (DMA2D_LayerCfg->Alpha << DMA2D_FGPFCCR_ALPHA_Pos);
+	uint32_t const COLR = (DMA2D_LayerCfg->Red << 16) | (DMA2D_LayerCfg->Green << 8) | DMA2D_LayerCfg->Blue;
+	
+	if ( 0 == LayerIdx ) {
+		DMA2Dx->BGMAR = DMA2D_LayerCfg->MemoryAddress;
+		DMA2Dx->BGOR = DMA2D_LayerCfg->LineOffset;
+		DMA2Dx->BGPFCCR = PFCCR;
+		DMA2Dx->BGCOLR = COLR;
+		DMA2Dx->BGCMAR = DMA2D_LayerCfg->CLUTMemoryAddress;
+	}
+	else {
+		DMA2Dx->FGMAR = DMA2D_LayerCfg->MemoryAddress;
+		DMA2Dx->FGOR = DMA2D_LayerCfg->LineOffset;
+		DMA2Dx->FGPFCCR = PFCCR;
+		DMA2Dx->FGCOLR = COLR;
+		DMA2Dx->FGCMAR = DMA2D_LayerCfg->CLUTMemoryAddress;
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_DMA2D_H*/
@@ -0,0 +1,49 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_EXTI_H
+#define HOST_STM32F7xx_LL_EXTI_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LL_EXTI_LINE_13						(0x1UL << 13)
+#define LL_EXTI_MODE_IT						0x00U
+#define LL_EXTI_MODE_EVENT				0x01U
+#define LL_EXTI_TRIGGER_NONE			0x00U
+#define LL_EXTI_TRIGGER_RISING		0x01U
+#define LL_EXTI_TRIGGER_FALLING		0x02U
+
+typedef struct
+{
+	uint32_t Line_0_31;
+	FunctionalState LineCommand;
+	uint8_t Mode;
+	uint8_t Trigger;
+} LL_EXTI_InitTypeDef;
+
+__STATIC_INLINE void LL_EXTI_EnableIT_0_31(uint32_t ExtiLine) { SET_BIT(EXTI->IMR, ExtiLine); }
+__STATIC_INLINE uint32_t LL_EXTI_IsActiveFlag_0_31(uint32_t ExtiLine) { return( READ_BIT(EXTI->PR, ExtiLine) == ExtiLine ); }
+__STATIC_INLINE void LL_EXTI_ClearFlag_0_31(uint32_t ExtiLine) { CLEAR_BIT(EXTI->PR, ExtiLine); }
+__STATIC_INLINE uint32_t LL_EXTI_Init(LL_EXTI_InitTypeDef* EXTI_InitStruct)
+{
+	if ( ENABLE == EXTI_InitStruct->LineCommand && LL_EXTI_MODE_IT == EXTI_InitStruct->Mode )
+		LL_EXTI_EnableIT_0_31(EXTI_InitStruct->Line_0_31);
+	return(0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_EXTI_H*/
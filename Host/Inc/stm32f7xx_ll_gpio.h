@@ -0,0 +1,105 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_GPIO_H
+#define HOST_STM32F7xx_LL_GPIO_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// pins only keep their configuration / output state, nothing is connected
+#define LL_GPIO_PIN_0			(0x1UL << 0)
+#define LL_GPIO_PIN_1			(0x1UL << 1)
+#define LL_GPIO_PIN_2			(0x1UL << 2)
+#define LL_GPIO_PIN_3			(0x1UL << 3)
+#define LL_GPIO_PIN_4			(0x1UL << 4)
+#define LL_GPIO_PIN_5			(0x1UL << 5)
+#define LL_GPIO_PIN_6			(0x1UL << 6)
+#define LL_GPIO_PIN_7			(0x1UL << 7)
+#define LL_GPIO_PIN_8			(0x1UL << 8)
+#define LL_GPIO_PIN_9			(0x1UL << 9)
+#define LL_GPIO_PIN_10		(0x1UL << 10)
+#define LL_GPIO_PIN_11		(0x1UL << 11)
+#define LL_GPIO_PIN_12		(0x1UL << 12)
+#define LL_GPIO_PIN_13		(0x1UL << 13)
+#define LL_GPIO_PIN_14		(0x1UL << 14)
+#define LL_GPIO_PIN_15		(0x1UL << 15)
+#define LL_GPIO_PIN_ALL		0x0000FFFFU
+
+#define LL_GPIO_MODE_INPUT				0x0U
+#define LL_GPIO_MODE_OUTPUT				0x1U
+#define LL_GPIO_MODE_ALTERNATE		0x2U
+#define LL_GPIO_MODE_ANALOG				0x3U
+#define LL_GPIO_OUTPUT_PUSHPULL		0x0U
+#define LL_GPIO_OUTPUT_OPENDRAIN	0x1U
+#define LL_GPIO_SPEED_FREQ_LOW				0x0U
+#define LL_GPIO_SPEED_FREQ_MEDIUM			0x1U
+#define LL_GPIO_SPEED_FREQ_HIGH				0x2U
+#define LL_GPIO_SPEED_FREQ_VERY_HIGH	0x3U
+#define LL_GPIO_PULL_NO						0x0U
+#define LL_GPIO_PULL_UP						0x1U
+#define LL_GPIO_PULL_DOWN					0x2U
+#define LL_GPIO_AF_0							0x0U
+#define LL_GPIO_AF_5							0x5U
+#define LL_GPIO_AF_7							0x7U
+#define LL_GPIO_AF_9							0x9U
+#define LL_GPIO_AF_10							0xAU
+#define LL_GPIO_AF_11							0xBU
+#define LL_GPIO_AF_12							0xCU
+
+typedef struct
+{
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Speed;
+	uint32_t OutputType;
+	uint32_t Pull;
+	uint32_t Alternate;
+} LL_GPIO_InitTypeDef;
+
+__STATIC_INLINE uint32_t Host_GPIO_PinIndex(uint32_t Pin) { return( __builtin_ctz(Pin) ); }
+
+__STATIC_INLINE void LL_GPIO_SetPinMode(GPIO_TypeDef* GPIOx, uint32_t Pin, uint32_t Mode) { uint32_t const i = Host_GPIO_PinIndex(Pin) << 1; MODIFY_REG(GPIOx->MODER, 0x3UL << i, Mode << i); }
+__STATIC_INLINE void LL_GPIO_SetPinOutputType(GPIO_TypeDef* GPIOx, uint32_t PinMask, uint32_t OutputType) { MODIFY_REG(GPIOx->OTYPER, PinMask, PinMask * OutputType); }
+__STATIC_INLINE void LL_GPIO_SetPinSpeed(GPIO_TypeDef* GPIOx, uint32_t Pin, uint32_t Speed) { uint32_t const i = Host_GPIO_PinIndex(Pin) << 1; MODIFY_REG(GPIOx->OSPEEDR, 0x3UL << i, Speed << i); }
+__STATIC_INLINE void LL_GPIO_SetPinPull(GPIO_TypeDef* GPIOx, uint32_t Pin, uint32_t Pull) { uint32_t const i = Host_GPIO_PinIndex(Pin) << 1; MODIFY_REG(GPIOx->PUPDR, 0x3UL << i, Pull << i); }
+__STATIC_INLINE void LL_GPIO_SetAFPin_0_7(GPIO_TypeDef* GPIOx, uint32_t Pin, uint32_t Alternate) { uint32_t const i = Host_GPIO_PinIndex(Pin) << 2; MODIFY_REG(GPIOx->AFR[0], 0xFUL << i, Alternate << i); }
+__STATIC_INLINE void LL_GPIO_SetAFPin_8_15(GPIO_TypeDef* GPIOx, uint32_t Pin, uint32_t Alternate) { uint32_t const i = (Host_GPIO_PinIndex(Pin) - 8) << 2; MODIFY_REG(GPIOx->AFR[1], 0xFUL << i, Alternate << i); }
+__STATIC_INLINE void LL_GPIO_SetOutputPin(GPIO_TypeDef* GPIOx, uint32_t PinMask) { SET_BIT(GPIOx->ODR, PinMask); }
+__STATIC_INLINE void LL_GPIO_ResetOutputPin(GPIO_TypeDef* GPIOx, uint32_t PinMask) { CLEAR_BIT(GPIOx->ODR, PinMask); }
+__STATIC_INLINE void LL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint32_t PinMask) { GPIOx->ODR ^= PinMask; }
+__STATIC_INLINE uint32_t LL_GPIO_IsInputPinSet(GPIO_TypeDef* GPIOx, uint32_t PinMask) { return( READ_BIT(GPIOx->IDR, PinMask) == PinMask ); }
+
+__STATIC_INLINE ErrorStatus LL_GPIO_Init(GPIO_TypeDef* GPIOx, LL_GPIO_InitTypeDef* GPIO_InitStruct)
+{
+	for ( uint32_t Pins = GPIO_InitStruct->Pin ; 0 != Pins ; Pins &= Pins - 1 )
+	{
+		uint32_t const Pin = Pins & (0U - Pins);
+		
+		LL_GPIO_SetPinMode(GPIOx, Pin, GPIO_InitStruct->Mode);
+		LL_GPIO_SetPinSpeed(GPIOx, Pin, GPIO_InitStruct->Speed);
+		LL_GPIO_SetPinPull(GPIOx, Pin, GPIO_InitStruct->Pull);
+		LL_GPIO_SetPinOutputType(GPIOx, Pin, GPIO_InitStruct->OutputType);
+		if ( Pin < LL_GPIO_PIN_8 )
+			LL_GPIO_SetAFPin_0_7(GPIOx, Pin, GPIO_InitStruct->Alternate);
+		else
+			LL_GPIO_SetAFPin_8_15(GPIOx, Pin, GPIO_InitStruct->Alternate);
+	}
+	return(SUCCESS);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_GPIO_H*/
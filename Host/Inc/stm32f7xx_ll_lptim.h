@@ -0,0 +1,52 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_LPTIM_H
+#define HOST_STM32F7xx_LL_LPTIM_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// starting the counter hands the compare match rate to the host board emulation (Host.h)
+#define LL_LPTIM_CLK_SOURCE_INTERNAL				0x00000000U
+#define LL_LPTIM_PRESCALER_DIV1							0x00000000U
+#define LL_LPTIM_PRESCALER_DIV4							(0x2UL << LPTIM_CFGR_PRESC_Pos)
+#define LL_LPTIM_PRESCALER_DIV16						(0x4UL << LPTIM_CFGR_PRESC_Pos)
+#define LL_LPTIM_OUTPUT_POLARITY_REGULAR		0x00000000U
+#define LL_LPTIM_UPDATE_MODE_IMMEDIATE			0x00000000U
+#define LL_LPTIM_COUNTER_MODE_INTERNAL			0x00000000U
+#define LL_LPTIM_OPERATING_MODE_CONTINUOUS	LPTIM_CR_CNTSTRT
+#define LL_LPTIM_OPERATING_MODE_ONESHOT			LPTIM_CR_SNGSTRT
+
+__STATIC_INLINE void LL_LPTIM_Enable(LPTIM_TypeDef* LPTIMx) { SET_BIT(LPTIMx->CR, LPTIM_CR_ENABLE); }
+__STATIC_INLINE void LL_LPTIM_Disable(LPTIM_TypeDef* LPTIMx) { CLEAR_BIT(LPTIMx->CR, LPTIM_CR_ENABLE | LPTIM_CR_CNTSTRT | LPTIM_CR_SNGSTRT); }
+__STATIC_INLINE void LL_LPTIM_StartCounter(LPTIM_TypeDef* LPTIMx, uint32_t OperatingMode) { MODIFY_REG(LPTIMx->CR, LPTIM_CR_CNTSTRT | LPTIM_CR_SNGSTRT, OperatingMode); Host_LPTIM_Start(); }
+__STATIC_INLINE void LL_LPTIM_TrigSw(LPTIM_TypeDef* LPTIMx) { (void)LPTIMx; }
+__STATIC_INLINE void LL_LPTIM_SetClockSource(LPTIM_TypeDef* LPTIMx, uint32_t ClockSource) { (void)LPTIMx; (void)ClockSource; }
+__STATIC_INLINE void LL_LPTIM_SetPrescaler(LPTIM_TypeDef* LPTIMx, uint32_t Prescaler) { MODIFY_REG(LPTIMx->CFGR, LPTIM_CFGR_PRESC, Prescaler); }
+__STATIC_INLINE uint32_t LL_LPTIM_GetPrescaler(LPTIM_TypeDef* LPTIMx) { return( READ_BIT(LPTIMx->CFGR, LPTIM_CFGR_PRESC) ); }
+__STATIC_INLINE void LL_LPTIM_SetPolarity(LPTIM_TypeDef* LPTIMx, uint32_t Polarity) { (void)LPTIMx; (void)Polarity; }
+__STATIC_INLINE void LL_LPTIM_SetUpdateMode(LPTIM_TypeDef* LPTIMx, uint32_t UpdateMode) { (void)LPTIMx; (void)UpdateMode; }
+__STATIC_INLINE void LL_LPTIM_SetCounterMode(LPTIM_TypeDef* LPTIMx, uint32_t CounterMode) { (void)LPTIMx; (void)CounterMode; }
+__STATIC_INLINE void LL_LPTIM_SetAutoReload(LPTIM_TypeDef* LPTIMx, uint32_t AutoReload) { LPTIMx->ARR = AutoReload; }
+__STATIC_INLINE void LL_LPTIM_SetCompare(LPTIM_TypeDef* LPTIMx, uint32_t CompareValue) { LPTIMx->CMP = CompareValue; }
+__STATIC_INLINE void LL_LPTIM_EnableIT_CMPM(LPTIM_TypeDef* LPTIMx) { SET_BIT(LPTIMx->IER, LPTIM_IER_CMPMIE); }
+__STATIC_INLINE void LL_LPTIM_DisableIT_CMPM(LPTIM_TypeDef* LPTIMx) { CLEAR_BIT(LPTIMx->IER, LPTIM_IER_CMPMIE); }
+__STATIC_INLINE uint32_t LL_LPTIM_IsActiveFlag_CMPM(LPTIM_TypeDef* LPTIMx) { return( READ_BIT(LPTIMx->ISR, LPTIM_ISR_CMPM) == LPTIM_ISR_CMPM ); }
+__STATIC_INLINE void LL_LPTIM_ClearFLAG_CMPM(LPTIM_TypeDef* LPTIMx) { CLEAR_BIT(LPTIMx->ISR, LPTIM_ISR_CMPM); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_LPTIM_H*/
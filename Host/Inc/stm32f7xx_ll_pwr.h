@@ -0,0 +1,45 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_PWR_H
+#define HOST_STM32F7xx_LL_PWR_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// regulators and overdrive are ready as soon as they are enabled
+#define PWR_CR1_DBP				(0x1UL << 8)
+#define PWR_CR1_VOS				(0x3UL << 14)
+#define PWR_CR1_ODEN			(0x1UL << 16)
+#define PWR_CR1_ODSWEN		(0x1UL << 17)
+#define PWR_CSR1_BRE			(0x1UL << 9)
+
+#define LL_PWR_REGU_VOLTAGE_SCALE3	(0x1UL << 14)
+#define LL_PWR_REGU_VOLTAGE_SCALE2	(0x2UL << 14)
+#define LL_PWR_REGU_VOLTAGE_SCALE1	(0x3UL << 14)
+
+__STATIC_INLINE void LL_PWR_SetRegulVoltageScaling(uint32_t VoltageScaling) { MODIFY_REG(PWR->CR1, PWR_CR1_VOS, VoltageScaling); }
+__STATIC_INLINE void LL_PWR_EnableBkUpAccess(void) { SET_BIT(PWR->CR1, PWR_CR1_DBP); }
+__STATIC_INLINE void LL_PWR_DisableBkUpAccess(void) { CLEAR_BIT(PWR->CR1, PWR_CR1_DBP); }
+__STATIC_INLINE void LL_PWR_EnableBkUpRegulator(void) { SET_BIT(PWR->CSR1, PWR_CSR1_BRE); }
+__STATIC_INLINE uint32_t LL_PWR_IsEnabledBkUpRegulator(void) { return( READ_BIT(PWR->CSR1, PWR_CSR1_BRE) == PWR_CSR1_BRE ); }
+__STATIC_INLINE void LL_PWR_EnableOverDriveMode(void) { SET_BIT(PWR->CR1, PWR_CR1_ODEN); }
+__STATIC_INLINE void LL_PWR_EnableOverDriveSwitching(void) { SET_BIT(PWR->CR1, PWR_CR1_ODSWEN); }
+__STATIC_INLINE uint32_t LL_PWR_IsActiveFlag_OD(void) { return( READ_BIT(PWR->CR1, PWR_CR1_ODEN) == PWR_CR1_ODEN ); }
+__STATIC_INLINE uint32_t LL_PWR_IsActiveFlag_ODSW(void) { return( READ_BIT(PWR->CR1, PWR_CR1_ODSWEN) == PWR_CR1_ODSWEN ); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_PWR_H*/
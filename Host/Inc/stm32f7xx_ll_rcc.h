@@ -0,0 +1,95 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_RCC_H
+#define HOST_STM32F7xx_LL_RCC_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// oscillators and plls are ready as soon as they are enabled, the frequencies reported are the configured target clocks
+#define RCC_CR_HSION				(0x1UL << 0)
+#define RCC_CR_HSEON				(0x1UL << 16)
+#define RCC_CR_PLLON				(0x1UL << 24)
+#define RCC_CR_PLLSAION			(0x1UL << 28)
+#define RCC_BDCR_LSEON			(0x1UL << 0)
+#define RCC_CFGR_SW					(0x3UL << 0)
+#define RCC_CFGR_SWS				(0x3UL << 2)
+#define RCC_CFGR_HPRE				(0xFUL << 4)
+#define RCC_CFGR_PPRE1			(0x7UL << 10)
+#define RCC_CFGR_PPRE2			(0x7UL << 13)
+
+#define LL_RCC_SYS_CLKSOURCE_HSI					0x00000000U
+#define LL_RCC_SYS_CLKSOURCE_PLL					0x00000002U
+#define LL_RCC_SYS_CLKSOURCE_STATUS_PLL		0x00000008U
+#define LL_RCC_SYSCLK_DIV_1								0x00000000U
+#define LL_RCC_APB1_DIV_4									(0x5UL << 10)
+#define LL_RCC_APB2_DIV_2									(0x4UL << 13)
+#define LL_RCC_LSEDRIVE_MEDIUMHIGH				(0x2UL << 3)
+#define LL_RCC_PLLSOURCE_HSI							0x00000000U
+#define LL_RCC_PLLM_DIV_8									8U
+#define LL_RCC_PLLP_DIV_2									0x00000000U
+#define LL_RCC_PLLQ_DIV_9									9U
+#define LL_RCC_PLLSAIP_DIV_4							1U
+#define LL_RCC_RNG_CLKSOURCE_PLLSAI				1U
+#define LL_RCC_LPTIM1_CLKSOURCE_LSE				(0x3UL << 24)
+#define LL_RCC_USART3_CLKSOURCE						(0x3UL << 4)
+#define LL_RCC_USART3_CLKSOURCE_PCLK1			((0x3UL << 4) << 16)
+#define LL_RCC_USART3_CLKSOURCE_HSI				(((0x3UL << 4) << 16) | (0x2UL << 4))
+
+#define HOST_HSI_VALUE										16000000U
+
+typedef struct
+{
+	uint32_t SYSCLK_Frequency;
+	uint32_t HCLK_Frequency;
+	uint32_t PCLK1_Frequency;
+	uint32_t PCLK2_Frequency;
+} LL_RCC_ClocksTypeDef;
+
+__STATIC_INLINE void LL_RCC_HSE_Disable(void) { CLEAR_BIT(RCC->CR, RCC_CR_HSEON); }
+__STATIC_INLINE void LL_RCC_HSI_Enable(void) { SET_BIT(RCC->CR, RCC_CR_HSION); }
+__STATIC_INLINE uint32_t LL_RCC_HSI_IsReady(void) { return( READ_BIT(RCC->CR, RCC_CR_HSION) == RCC_CR_HSION ); }
+__STATIC_INLINE void LL_RCC_HSI_SetCalibTrimming(uint32_t Value) { (void)Value; }
+__STATIC_INLINE void LL_RCC_LSE_SetDriveCapability(uint32_t LSEDrive) { (void)LSEDrive; }
+__STATIC_INLINE void LL_RCC_LSE_Enable(void) { SET_BIT(RCC->BDCR, RCC_BDCR_LSEON); }
+__STATIC_INLINE uint32_t LL_RCC_LSE_IsReady(void) { return( READ_BIT(RCC->BDCR, RCC_BDCR_LSEON) == RCC_BDCR_LSEON ); }
+__STATIC_INLINE void LL_RCC_PLL_ConfigDomain_SYS(uint32_t Source, uint32_t PLLM, uint32_t PLLN, uint32_t PLLP_R) { RCC->PLLCFGR = Source | PLLM | (PLLN << 6) | (PLLP_R << 16); }
+__STATIC_INLINE void LL_RCC_PLL_ConfigDomain_48M(uint32_t Source, uint32_t PLLM, uint32_t PLLN, uint32_t PLLQ) { (void)Source; (void)PLLM; (void)PLLN; (void)PLLQ; }
+__STATIC_INLINE void LL_RCC_PLL_Enable(void) { SET_BIT(RCC->CR, RCC_CR_PLLON); }
+__STATIC_INLINE uint32_t LL_RCC_PLL_IsReady(void) { return( READ_BIT(RCC->CR, RCC_CR_PLLON) == RCC_CR_PLLON ); }
+__STATIC_INLINE void LL_RCC_PLLSAI_ConfigDomain_48M(uint32_t Source, uint32_t PLLM, uint32_t PLLSAIN, uint32_t PLLSAIP) { (void)Source; (void)PLLM; (void)PLLSAIN; (void)PLLSAIP; }
+__STATIC_INLINE void LL_RCC_PLLSAI_Enable(void) { SET_BIT(RCC->CR, RCC_CR_PLLSAION); }
+__STATIC_INLINE uint32_t LL_RCC_PLLSAI_IsReady(void) { return( READ_BIT(RCC->CR, RCC_CR_PLLSAION) == RCC_CR_PLLSAION ); }
+__STATIC_INLINE void LL_RCC_SetAHBPrescaler(uint32_t Prescaler) { MODIFY_REG(RCC->CFGR, RCC_CFGR_HPRE, Prescaler); }
+__STATIC_INLINE void LL_RCC_SetAPB1Prescaler(uint32_t Prescaler) { MODIFY_REG(RCC->CFGR, RCC_CFGR_PPRE1, Prescaler); }
+__STATIC_INLINE void LL_RCC_SetAPB2Prescaler(uint32_t Prescaler) { MODIFY_REG(RCC->CFGR, RCC_CFGR_PPRE2, Prescaler); }
+__STATIC_INLINE void LL_RCC_SetSysClkSource(uint32_t Source) { MODIFY_REG(RCC->CFGR, RCC_CFGR_SW | RCC_CFGR_SWS, Source | (Source << 2)); }
+__STATIC_INLINE uint32_t LL_RCC_GetSysClkSource(void) { return( READ_BIT(RCC->CFGR, RCC_CFGR_SWS) ); }
+__STATIC_INLINE void LL_RCC_SetRNGClockSource(uint32_t Source) { (void)Source; }
+__STATIC_INLINE void LL_RCC_SetLPTIMClockSource(uint32_t Source) { (void)Source; }
+__STATIC_INLINE void LL_RCC_SetUSARTClockSource(uint32_t Source) { (void)Source; }
+__STATIC_INLINE void LL_RCC_GetSystemClocksFreq(LL_RCC_ClocksTypeDef* RCC_Clocks)
+{
+	RCC_Clocks->SYSCLK_Frequency = RCC_Clocks->HCLK_Frequency = SystemCoreClock;
+	RCC_Clocks->PCLK1_Frequency = SystemCoreClock >> 2;
+	RCC_Clocks->PCLK2_Frequency = SystemCoreClock >> 1;
+}
+__STATIC_INLINE uint32_t LL_RCC_GetUSARTClockFreq(uint32_t USARTxSource) { (void)USARTxSource; return(HOST_HSI_VALUE); }
+__STATIC_INLINE uint32_t LL_RCC_GetUARTClockFreq(uint32_t UARTxSource) { (void)UARTxSource; return(HOST_HSI_VALUE); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_RCC_H*/
@@ -0,0 +1,36 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_RNG_H
+#define HOST_STM32F7xx_LL_RNG_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// enabling the interrupt requests a random number from the host board emulation (Host.h), ready immediately
+__STATIC_INLINE void LL_RNG_Enable(RNG_TypeDef* RNGx) { SET_BIT(RNGx->CR, RNG_CR_RNGEN); }
+__STATIC_INLINE void LL_RNG_Disable(RNG_TypeDef* RNGx) { CLEAR_BIT(RNGx->CR, RNG_CR_RNGEN); }
+__STATIC_INLINE void LL_RNG_EnableIT(RNG_TypeDef* RNGx) { SET_BIT(RNGx->CR, RNG_CR_IE); Host_RNG_Request(); }
+__STATIC_INLINE void LL_RNG_DisableIT(RNG_TypeDef* RNGx) { CLEAR_BIT(RNGx->CR, RNG_CR_IE); }
+__STATIC_INLINE uint32_t LL_RNG_IsActiveFlag_DRDY(RNG_TypeDef* RNGx) { return( READ_BIT(RNGx->SR, RNG_SR_DRDY) == RNG_SR_DRDY ); }
+__STATIC_INLINE uint32_t LL_RNG_IsActiveFlag_CEIS(RNG_TypeDef* RNGx) { return( READ_BIT(RNGx->SR, RNG_SR_CEIS) == RNG_SR_CEIS ); }
+__STATIC_INLINE uint32_t LL_RNG_IsActiveFlag_SEIS(RNG_TypeDef* RNGx) { return( READ_BIT(RNGx->SR, RNG_SR_SEIS) == RNG_SR_SEIS ); }
+__STATIC_INLINE void LL_RNG_ClearFlag_CEIS(RNG_TypeDef* RNGx) { CLEAR_BIT(RNGx->SR, RNG_SR_CEIS); }
+__STATIC_INLINE void LL_RNG_ClearFlag_SEIS(RNG_TypeDef* RNGx) { CLEAR_BIT(RNGx->SR, RNG_SR_SEIS); }
+__STATIC_INLINE uint32_t LL_RNG_ReadRandData32(RNG_TypeDef* RNGx) { CLEAR_BIT(RNGx->SR, RNG_SR_DRDY); return( RNGx->DR ); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_RNG_H*/
@@ -0,0 +1,69 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_SPI_H
+#define HOST_STM32F7xx_LL_SPI_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// nothing is connected, the transmit buffer is always empty and the bus never busy
+#define LL_SPI_FULL_DUPLEX							0x00000000U
+#define LL_SPI_MODE_MASTER							0x00000104U
+#define LL_SPI_DATAWIDTH_8BIT						0x00000700U
+#define LL_SPI_POLARITY_LOW							0x00000000U
+#define LL_SPI_PHASE_1EDGE							0x00000000U
+#define LL_SPI_NSS_SOFT									0x00000200U
+#define LL_SPI_BAUDRATEPRESCALER_DIV16	0x00000018U
+#define LL_SPI_MSB_FIRST								0x00000000U
+#define LL_SPI_CRCCALCULATION_DISABLE		0x00000000U
+#define LL_SPI_PROTOCOL_MOTOROLA				0x00000000U
+
+typedef struct
+{
+	uint32_t TransferDirection;
+	uint32_t Mode;
+	uint32_t DataWidth;
+	uint32_t ClockPolarity;
+	uint32_t ClockPhase;
+	uint32_t NSS;
+	uint32_t BaudRate;
+	uint32_t BitOrder;
+	uint32_t CRCCalculation;
+	uint32_t CRCPoly;
+} LL_SPI_InitTypeDef;
+
+__STATIC_INLINE ErrorStatus LL_SPI_Init(SPI_TypeDef* SPIx, LL_SPI_InitTypeDef* SPI_InitStruct)
+{
+	SPIx->CR1 = SPI_InitStruct->TransferDirection | SPI_InitStruct->Mode | SPI_InitStruct->ClockPolarity | SPI_InitStruct->ClockPhase
+						| SPI_InitStruct->NSS | SPI_InitStruct->BaudRate | SPI_InitStruct->BitOrder | SPI_InitStruct->CRCCalculation;
+	SPIx->CR2 = SPI_InitStruct->DataWidth;
+	SPIx->SR = SPI_SR_TXE;
+	return(SUCCESS);
+}
+__STATIC_INLINE void LL_SPI_SetStandard(SPI_TypeDef* SPIx, uint32_t Standard) { (void)SPIx; (void)Standard; }
+__STATIC_INLINE void LL_SPI_DisableNSSPulseMgt(SPI_TypeDef* SPIx) { (void)SPIx; }
+__STATIC_INLINE void LL_SPI_EnableDMAReq_TX(SPI_TypeDef* SPIx) { (void)SPIx; }
+__STATIC_INLINE void LL_SPI_EnableIT_ERR(SPI_TypeDef* SPIx) { (void)SPIx; }
+__STATIC_INLINE void LL_SPI_Enable(SPI_TypeDef* SPIx) { SET_BIT(SPIx->CR1, SPI_CR1_SPE); }
+__STATIC_INLINE uint32_t LL_SPI_DMA_GetRegAddr(SPI_TypeDef* SPIx) { return( (uint32_t)(uintptr_t)&(SPIx->DR) ); }
+__STATIC_INLINE uint32_t LL_SPI_IsActiveFlag_TXE(SPI_TypeDef* SPIx) { (void)SPIx; return(1U); }
+__STATIC_INLINE uint32_t LL_SPI_IsActiveFlag_BSY(SPI_TypeDef* SPIx) { (void)SPIx; return(0U); }
+__STATIC_INLINE void LL_SPI_TransmitData8(SPI_TypeDef* SPIx, uint8_t TxData) { SPIx->DR = TxData; }
+__STATIC_INLINE void LL_SPI_TransmitData16(SPI_TypeDef* SPIx, uint16_t TxData) { SPIx->DR = TxData; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_SPI_H*/
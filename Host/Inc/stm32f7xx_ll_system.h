@@ -0,0 +1,34 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_SYSTEM_H
+#define HOST_STM32F7xx_LL_SYSTEM_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LL_FLASH_LATENCY_0		0x00000000U
+#define LL_FLASH_LATENCY_7		0x00000007U
+
+#define LL_SYSCFG_EXTI_PORTC	2U
+#define LL_SYSCFG_EXTI_LINE13	((0xFUL << 16U) | 3U)
+
+__STATIC_INLINE void LL_FLASH_SetLatency(uint32_t Latency) { MODIFY_REG(FLASH->ACR, FLASH_ACR_LATENCY, Latency); }
+__STATIC_INLINE uint32_t LL_FLASH_GetLatency(void) { return( READ_BIT(FLASH->ACR, FLASH_ACR_LATENCY) ); }
+__STATIC_INLINE void LL_SYSCFG_SetEXTISource(uint32_t Port, uint32_t Line) { (void)Port; (void)Line; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_SYSTEM_H*/
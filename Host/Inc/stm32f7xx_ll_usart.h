@@ -0,0 +1,42 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_USART_H
+#define HOST_STM32F7xx_LL_USART_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the serial port is not used on the host (USART_ENABLE is 0 in HOST_BUILD), declared so usart.c compiles
+#define LL_USART_DIRECTION_TX						0x00000008U
+#define LL_USART_DATAWIDTH_8B						0x00000000U
+#define LL_USART_PARITY_NONE						0x00000000U
+#define LL_USART_STOPBITS_1							0x00000000U
+#define LL_USART_OVERSAMPLING_8					0x00008000U
+#define LL_USART_DMA_REG_DATA_TRANSMIT	0x00000000U
+
+__STATIC_INLINE void LL_USART_SetTransferDirection(USART_TypeDef* USARTx, uint32_t TransferDirection) { (void)USARTx; (void)TransferDirection; }
+__STATIC_INLINE void LL_USART_ConfigCharacter(USART_TypeDef* USARTx, uint32_t DataWidth, uint32_t Parity, uint32_t StopBits) { (void)USARTx; (void)DataWidth; (void)Parity; (void)StopBits; }
+__STATIC_INLINE void LL_USART_SetBaudRate(USART_TypeDef* USARTx, uint32_t PeriphClk, uint32_t OverSampling, uint32_t BaudRate) { (void)USARTx; (void)PeriphClk; (void)OverSampling; (void)BaudRate; }
+__STATIC_INLINE void LL_USART_ConfigAsyncMode(USART_TypeDef* USARTx) { (void)USARTx; }
+__STATIC_INLINE void LL_USART_Enable(USART_TypeDef* USARTx) { SET_BIT(USARTx->CR1, USART_CR1_UE); SET_BIT(USARTx->ISR, USART_ISR_TEACK); }
+__STATIC_INLINE uint32_t LL_USART_IsActiveFlag_TEACK(USART_TypeDef* USARTx) { return( READ_BIT(USARTx->ISR, USART_ISR_TEACK) == USART_ISR_TEACK ); }
+__STATIC_INLINE void LL_USART_EnableDMAReq_TX(USART_TypeDef* USARTx) { (void)USARTx; }
+__STATIC_INLINE void LL_USART_DisableDMAReq_TX(USART_TypeDef* USARTx) { (void)USARTx; }
+__STATIC_INLINE uint32_t LL_USART_DMA_GetRegAddr(USART_TypeDef* USARTx, uint32_t Direction) { (void)Direction; return( (uint32_t)(uintptr_t)&(USARTx->TDR) ); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_USART_H*/
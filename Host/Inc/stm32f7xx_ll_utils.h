@@ -0,0 +1,34 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef HOST_STM32F7xx_LL_UTILS_H
+#define HOST_STM32F7xx_LL_UTILS_H
+
+#include "stm32f7xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+__STATIC_INLINE void LL_InitTick(uint32_t HCLKFrequency, uint32_t Ticks)
+{
+	SysTick->LOAD = (uint32_t)((HCLKFrequency / Ticks) - 1UL);
+	SysTick->VAL = 0UL;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+__STATIC_INLINE void LL_Init1msTick(uint32_t HCLKFrequency) { LL_InitTick(HCLKFrequency, 1000U); }
+__STATIC_INLINE void LL_SetSystemCoreClock(uint32_t HCLKFrequency) { SystemCoreClock = HCLKFrequency; }
+__STATIC_INLINE void LL_mDelay(uint32_t Delay) { Host_DelayMs(Delay); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*HOST_STM32F7xx_LL_UTILS_H*/
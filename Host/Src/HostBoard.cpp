@@ -0,0 +1,301 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+
+// Host build board emulation, see Host.h for the interrupt model
+// Register blocks are plain structures in ram, the clock tree / gpio / mpu configuration writes land there and are otherwise ignored
+
+#include "PreprocessorCore.h"
+#include "stm32f7xx_it.h"
+#include "stm32f7xx_hal.h"
+#include "stm32f7xx_hal_dma.h"
+#include "stm32f7xx_hal_jpeg.h"
+#include "stm32f7xx_hal_qspi.h"
+#include "stm32f7xx_ll_dma.h"
+#include "ext_sram.h"
+
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/time.h>
+#include <sys/random.h>
+#include <malloc.h>
+
+// ---- registers ---- //
+SysTick_Type		Host_SysTick{};
+SCB_Type				Host_SCB{};
+MPU_Type				Host_MPU{};
+
+DMA_TypeDef			Host_DMA1, Host_DMA2;
+GPIO_TypeDef		Host_GPIO[11];
+SPI_TypeDef			Host_SPI1;
+USART_TypeDef		Host_USART3;
+LPTIM_TypeDef		Host_LPTIM1;
+RNG_TypeDef			Host_RNG;
+PWR_TypeDef			Host_PWR;
+FLASH_TypeDef		Host_FLASH;
+QUADSPI_TypeDef	Host_QUADSPI;
+RCC_TypeDef			Host_RCC;
+EXTI_TypeDef		Host_EXTI;
+SYSCFG_TypeDef	Host_SYSCFG;
+JPEG_TypeDef		Host_JPEG;
+DMA2D_TypeDef		Host_DMA2D;
+
+uint8_t					Host_BackupSRAM[4096] __attribute__((aligned(4)));
+uint32_t				SystemCoreClock(216000000);
+
+#ifdef JPEG_SOFTWARE_DECODER
+JPEG_HandleTypeDef	JPEG_Handle;	// unused, JPEG_IRQHandler still references it
+#endif
+
+// ---- nvic ---- //
+static struct sNVIC
+{
+	uint32_t	PriorityGroup;
+	uint8_t		Enabled[HOST_NUM_IRQn],
+						Pending[HOST_NUM_IRQn],
+						Priority[HOST_NUM_IRQn];
+} oNVIC;
+
+STATIC_INLINE bool const IsLine(IRQn_Type const IRQn) { return( IRQn >= 0 && IRQn < HOST_NUM_IRQn ); }
+
+extern "C" {
+void NVIC_SetPriorityGrouping(uint32_t PriorityGroup) { oNVIC.PriorityGroup = PriorityGroup & 0x07UL; }
+uint32_t NVIC_GetPriorityGrouping(void) { return(oNVIC.PriorityGroup); }
+void NVIC_EnableIRQ(IRQn_Type IRQn) { if (IsLine(IRQn)) oNVIC.Enabled[IRQn] = 1; }
+void NVIC_DisableIRQ(IRQn_Type IRQn) { if (IsLine(IRQn)) oNVIC.Enabled[IRQn] = 0; }
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn) { return( IsLine(IRQn) ? oNVIC.Enabled[IRQn] : 0 ); }
+void NVIC_SetPendingIRQ(IRQn_Type IRQn) { if (IsLine(IRQn)) oNVIC.Pending[IRQn] = 1; }
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn) { if (IsLine(IRQn)) oNVIC.Pending[IRQn] = 0; }
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { if (IsLine(IRQn)) oNVIC.Priority[IRQn] = (uint8_t)priority; }
+uint32_t NVIC_GetPriority(IRQn_Type IRQn) { return( IsLine(IRQn) ? oNVIC.Priority[IRQn] : 0 ); }
+void NVIC_SystemReset(void) { abort(); }
+} // extern "C"
+
+// ---- interrupt emulation ---- //
+static struct sHostBoard
+{
+	static constexpr uint32_t const LSE_HZ = 32768;
+
+	struct timespec				tStart;
+	volatile sig_atomic_t	InterruptDepth;		// > 0 while a handler is running (the tick, or a synchronous completion)
+	volatile sig_atomic_t	InLPTIM;
+	uint64_t							tNextLPTIM_us;
+	bool									bTickRunning,
+												bRNGPending;
+} oHost;
+
+STATIC_INLINE uint64_t const Now_us()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return( (uint64_t)(t.tv_sec - oHost.tStart.tv_sec) * 1000000ULL + (uint64_t)((t.tv_nsec - oHost.tStart.tv_nsec) / 1000) );
+}
+
+STATIC_INLINE uint64_t const LPTIM_Period_us()
+{
+	uint32_t const Prescaler( 1U << ((LPTIM1->CFGR & LPTIM_CFGR_PRESC) >> LPTIM_CFGR_PRESC_Pos) );
+
+	return( ((uint64_t)(LPTIM1->ARR + 1) * Prescaler * 1000000ULL) / sHostBoard::LSE_HZ );
+}
+
+// the spi double buffer stream has moved its frame once a tick has passed since it was enabled
+static void ServiceSPIStream()
+{
+	DMA_Stream_TypeDef* const Stream = &DMA2->Stream[LL_DMA_STREAM_3];
+
+	if ( 0 == (Stream->CR & DMA_SxCR_EN) )
+		return;
+
+	DMA2->LISR |= (HOST_DMA_FLAG_TC << Host_DMA_FlagShift(LL_DMA_STREAM_3));
+	if ( (Stream->CR & DMA_SxCR_TCIE) && oNVIC.Enabled[DMA2_Stream3_IRQn] )
+		DMA2_Stream3_IRQHandler();
+}
+
+static void OnTick(int)
+{
+	int const SavedErrno(errno);
+
+	++oHost.InterruptDepth;
+
+	SysTick->CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+	if ( SysTick->CTRL & SysTick_CTRL_TICKINT_Msk )
+		SysTick_Handler();
+
+	ServiceSPIStream();
+
+	// the render interrupt is lower priority than the tick, ticks keep landing while it runs (SA_NODEFER)
+	if ( !oHost.InLPTIM && (LPTIM1->CR & (LPTIM_CR_CNTSTRT | LPTIM_CR_SNGSTRT)) ) {
+
+		uint64_t const tNow(Now_us());
+		if ( tNow >= oHost.tNextLPTIM_us ) {
+
+			oHost.tNextLPTIM_us = tNow + LPTIM_Period_us();
+			LPTIM1->ISR |= LPTIM_ISR_CMPM;
+
+			if ( (LPTIM1->IER & LPTIM_IER_CMPMIE) && oNVIC.Enabled[LPTIM1_IRQn] ) {
+				oHost.InLPTIM = 1;
+				LPTIM1_IRQHandler();
+				oHost.InLPTIM = 0;
+			}
+		}
+	}
+
+	--oHost.InterruptDepth;
+
+	errno = SavedErrno;
+}
+
+extern "C" {
+
+uint32_t Host_Micros(void)
+{
+	return( (uint32_t)Now_us() );
+}
+
+void Host_DelayMs(uint32_t const Delay)
+{
+	uint64_t const tEnd( Now_us() + (uint64_t)Delay * 1000ULL );
+
+	while ( Now_us() < tEnd ) {
+		Host_WaitForInterrupt();
+	}
+}
+
+void Host_WaitForInterrupt(void)
+{
+	if ( !oHost.bTickRunning ) {
+		if ( oHost.InterruptDepth > 0 )
+			ServiceSPIStream();	// nothing else can complete it
+		return;
+	}
+	struct timespec const tSleep{ 0, 1000000 };
+	nanosleep(&tSleep, nullptr);	// returns early on the tick
+}
+
+void Host_SysTick_Enable(void)
+{
+	if ( oHost.bTickRunning )
+		return;
+
+	struct sigaction sa{};
+	sa.sa_handler = &OnTick;
+	sa.sa_flags = SA_RESTART | SA_NODEFER;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGALRM, &sa, nullptr);
+
+	struct itimerval const Interval{ { 0, 1000 }, { 0, 1000 } };
+	setitimer(ITIMER_REAL, &Interval, nullptr);
+
+	oHost.bTickRunning = true;
+}
+
+void Host_LPTIM_Start(void)
+{
+	oHost.tNextLPTIM_us = Now_us() + LPTIM_Period_us();
+}
+
+// memory to memory streams copy synchronously, peripheral streams complete on the tick (ServiceSPIStream)
+void Host_DMA_EnableStream(void* const DMAx, uint32_t const Stream)
+{
+	DMA_TypeDef* const DMA = (DMA_TypeDef*)DMAx;
+	DMA_Stream_TypeDef* const S = &DMA->Stream[Stream];
+
+	if ( LL_DMA_DIRECTION_MEMORY_TO_MEMORY != (S->CR & DMA_SxCR_DIR) )
+		return;
+
+	uint32_t const ItemSize( 1U << ((S->CR & DMA_SxCR_PSIZE) >> DMA_SxCR_PSIZE_Pos) );
+	memmove((void*)(uintptr_t)S->M0AR, (void const*)(uintptr_t)S->PAR, (size_t)S->NDTR * ItemSize);
+	S->NDTR = 0;
+	S->CR &= ~DMA_SxCR_EN;
+
+	*Host_DMA_ISR(DMA, Stream) |= (HOST_DMA_FLAG_TC << Host_DMA_FlagShift(Stream));
+
+	// the repo enables the m2m interrupts on DMA1 (see PrepareM2MStream), the nvic line alone decides here
+	if ( DMA2 == DMA ) {
+		++oHost.InterruptDepth;
+		if ( LL_DMA_STREAM_6 == Stream && oNVIC.Enabled[DMA2_Stream6_IRQn] )
+			DMA2_Stream6_IRQHandler();
+		else if ( LL_DMA_STREAM_7 == Stream && oNVIC.Enabled[DMA2_Stream7_IRQn] )
+			DMA2_Stream7_IRQHandler();
+		--oHost.InterruptDepth;
+	}
+}
+
+// a random number is ready as soon as it is requested, requests from inside the handler are serviced once it returns
+void Host_RNG_Request(void)
+{
+	if ( 0 == (RNG->CR & RNG_CR_RNGEN) || 0 == (RNG->CR & RNG_CR_IE) || !oNVIC.Enabled[HASH_RNG_IRQn] )
+		return;
+
+	if ( oHost.bRNGPending ) {	// inside the handler
+		return;
+	}
+	oHost.bRNGPending = true;
+	++oHost.InterruptDepth;
+
+	while ( (RNG->CR & RNG_CR_IE) && 0 == (RNG->SR & RNG_SR_DRDY) ) {
+		uint32_t Random(0);
+		while ( sizeof(Random) != getrandom(&Random, sizeof(Random), 0) ) {}
+
+		RNG->DR = Random;
+		RNG->SR |= RNG_SR_DRDY;
+
+		HASH_RNG_IRQHandler();
+	}
+
+	--oHost.InterruptDepth;
+	oHost.bRNGPending = false;
+}
+
+// ---- hal ---- //
+static uint32_t uwTick;
+
+HAL_StatusTypeDef HAL_Init(void) { return(HAL_OK); }
+void HAL_IncTick(void) { ++uwTick; }
+uint32_t HAL_GetTick(void) { return(uwTick); }
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma) { (void)hdma; }
+void HAL_JPEG_IRQHandler(JPEG_HandleTypeDef* hjpeg) { (void)hjpeg; }
+void HAL_QSPI_IRQHandler(QSPI_HandleTypeDef* hqspi) { (void)hqspi; }
+
+// arm c library, sinf / cosf are always accurate on the host
+void __use_accurate_range_reduction(void) {}
+
+} // extern "C"
+
+// ---- external sram ---- //
+// the .ext_sram sections are ordinary data on the host, nothing to bring up
+namespace ExtSRAM
+{
+uint8_t const* const ExtSRAM_Address = (uint8_t const* const)(EXTSRAM_ADDRESS);
+
+void Init() {}
+
+uint32_t const RamTest(uint32_t& NbBytes, float& tWrite, float& tRead)
+{
+	NbBytes = 0; tWrite = tRead = 0.0f;
+	return(0);
+}
+} // end namespace
+
+// ---- reset ---- //
+// SystemInitCustom runs from the reset handler before the c runtime init on target, here before any constructor
+extern "C" void SystemInitCustom(void);
+
+__attribute__((constructor(101))) static void HostReset()
+{
+	clock_gettime(CLOCK_MONOTONIC, &oHost.tStart);
+
+	// every allocation stays in the low 4GB (uint32_t addresses), the heap is brk based in a non-PIE executable
+	mallopt(M_MMAP_MAX, 0);
+
+	SystemInitCustom();
+}
@@ -0,0 +1,36 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+
+// Host build equivalents of Src/memcpy.s
+
+#include "globals.h"
+
+extern "C" {
+
+void memcpy32(uint32_t* __restrict dst, uint32_t const* __restrict src, uint32_t const length)	// not size, only #of elements
+{
+	memcpy(dst, src, length * sizeof(uint32_t));
+}
+
+void memcpy8(uint8_t* __restrict dst, uint8_t const* __restrict src, uint32_t const length)
+{
+	memcpy(dst, src, length);
+}
+
+// input and output must be divisable by 8, the low byte of every word is the luma
+void asmConv_L8L8L8L8_To_L8(uint8_t* __restrict outputL8, uint32_t const* __restrict inputLumaReplicated, uint32_t length)
+{
+	while ( 0 != length-- ) {
+		*outputL8++ = (uint8_t)(*inputLumaReplicated++);
+	}
+}
+
+} // extern "C"
@@ -12,7 +12,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #define AIBOT_H
 
 #include "globals.h"
-#include "point2D.h"
+#include "Point2D.h"
 
 class cAIBot
 {
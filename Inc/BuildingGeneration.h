@@ -11,7 +11,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #ifndef BUILDINGGENERATION_H
 #define BUILDINGGENERATION_H
 #include "isoVoxel.h"
-#include "point2D.h"
+#include "Point2D.h"
 
 namespace BuildingGen
 {
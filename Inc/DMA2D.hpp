@@ -13,6 +13,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "globals.h"
 #include "stm32f7xx_ll_dma2d.h"
 #include "commonmath.h"
+#include "DMA2D_Soft.h"
 
 namespace xDMA2D
 {
@@ -218,7 +219,11 @@ STATIC_INLINE void Start_DMA2D()
 {		
 	/* Start transfer */
 	DMA2D_Private.DMA2D_OpIsBusy = DMA2D_BUSY;
+#ifndef DMA2D_SOFTWARE_ENGINE
 	LL_DMA2D_Start(DMA2D);
+#else
+	xDMA2D::Soft::Start();
+#endif
 	
 	if constexpr ( bWaitForCompletion ) {
 		// Wait foor current operation to finish
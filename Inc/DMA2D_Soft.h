@@ -0,0 +1,42 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef xDMA2D_SOFT_H
+#define xDMA2D_SOFT_H
+#include "globals.h"
+
+#ifdef DMA2D_SOFTWARE_ENGINE
+
+// Software emulation of the DMA2D peripheral for the headless host build
+// DMA2D (see PreprocessorCore.h) points to a plain register block in ram, all the existing
+// LL_DMA2D_xxx configuration writes land there unchanged. Starting a transfer executes it
+// synchronously, and if the TC interrupt is enabled DMA2D_IRQHandler is serviced afterwards
+// exactly as the NVIC would, so the resize / dual filter blur chains run unmodified
+//
+// Supported:  modes M2M, M2M_PFC, M2M_BLEND, R2M
+//             input ARGB8888, RGB888, L8, AL44, AL88, A8 (CLUT ARGB8888 or RGB888)
+//             alpha modes NO_MODIF, REPLACE, COMBINE + alpha inversion
+//             output ARGB8888 only (all the repo uses)
+// Anything else sets the configuration error flag (CEIF) and the transfer is skipped
+
+namespace xDMA2D
+{
+namespace Soft
+{
+	void Start();										// replaces LL_DMA2D_Start(DMA2D)
+	void LoadCLUT(uint32_t const TargetLayer);		// replaces LL_DMA2D_xGND_EnableCLUTLoad(DMA2D), xDMA2D::BGND or xDMA2D::FGND
+
+} // end namespace
+} // end namespace
+
+#endif /*DMA2D_SOFTWARE_ENGINE*/
+
+#endif /*xDMA2D_SOFT_H*/
+
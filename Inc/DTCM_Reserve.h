@@ -11,7 +11,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #ifndef DTCM_RESERVE_H
 #define DTCM_RESERVE_H
 #include "commonmath.h"
-#include "FLASH\Imports.h"
+#include "FLASH/imports.h"
 
 extern uint8_t const _dithertable[64]
 __attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
@@ -48,14 +48,19 @@ ADDY SRAM2_RWDATA_ADDRESS 	= 0x2007C000;			// 16,384 bytes (16KB) non-DTCM (SRAM
 
 // __attribute__((aligned(ARMV7M_DCACHE_LINESIZE))) is only good for arrays,buffers, structures - data that can be cached in increments of 32 bytes
 
+// Ground AO mask atlas, baked once by ScatterLoad from the flash masks
+// top variants are indexed by the top occlusion bits (0 = no top occlusion, unused), the rooftop is height independent
+// side variants are indexed by the side occlusion bits and the ground height step (1-7), each holds the left face
+// (columns 0 - 11) and the front face (columns 11 - 22) with the bottom ao anchored to the bottom of the face
+ADDY AO_TOP_VARIANTS = 4,
+		 AO_SIDE_VARIANTS = 4,
+		 AO_HEIGHT_STEPS = 7;
+ADDY side_ao_atlas_stride = top_ao_stride,				// both faces in one mask
+		 side_ao_atlas_numoflines = side_ao_numoflines;
+
 // DTCM external buffers
-extern uint8_t _sram_top_ao_bothsides[top_ao_stride*top_ao_numoflines],				// 276 bytes
-			  _sram_top_ao_oneside[top_ao_stride*top_ao_numoflines],								// 276bytes
-				_sram_top_ao_oneside_mirrored[top_ao_stride*top_ao_numoflines],				// ""
-				_sram_side_7_both_ao[side_ao_stride*side_ao_numoflines],							// 396 bytes
-				_sram_side_7_both_ao_mirrored[side_ao_stride*side_ao_numoflines],			// ""
-				_sram_side_7_botom_ao[side_ao_stride*side_ao_numoflines],							// 396 bytes
-				_sram_side_7_botom_ao_mirrored[side_ao_stride*side_ao_numoflines]			// ""
+extern uint8_t _sram_top_ao_atlas[AO_TOP_VARIANTS][top_ao_stride*top_ao_numoflines],																			// 1,104 bytes
+			  _sram_side_ao_atlas[AO_SIDE_VARIANTS][AO_HEIGHT_STEPS][side_ao_atlas_stride*side_ao_atlas_numoflines]		// 21,252 bytes
 __attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
 __attribute__((section (".ext_sram")));   // seems there is better concurrency while using external sram (AXI Bus), TCM bus may be too busy (ART, DTCM, ITCM, FLASH)
 
@@ -18,6 +18,13 @@ extern const unsigned char _vox_sr71[];
 extern const unsigned char _vox_f2a[];
 extern const unsigned char _vox_sidewinder[];
 
+// Baked voxel models (.vxb), see VoxBaker.h
+#ifdef VOX_BAKED_MODELS
+extern const unsigned char _vxb_sr71[];
+extern const unsigned char _vxb_f2a[];
+extern const unsigned char _vxb_sidewinder[];
+#endif
+
 
 
 #endif /*IMPORTS_FLASH*/
@@ -0,0 +1,63 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef GOLDEN_FRAME_H
+#define GOLDEN_FRAME_H
+#include "globals.h"
+
+#ifdef GOLDEN_FRAME_HARNESS
+
+// Golden frame regression gate for the host build
+// main() renders FRAME_COUNT frames at a fixed FRAME_STEP instead of entering the realtime loop. After every frame
+// the BackBuffer, FrontBuffer (alpha and luma), DepthBuffer (unrotated) and the final 4bpp dithered output are
+// written / compared as 8bit PGM in GOLDEN_FRAME_DIR (environment, default "Golden"):
+//
+//   GOLDEN_FRAME_RECORD=1    (re)writes the golden images
+//   otherwise                compares against them, a pixel is a failure if it differs by more than
+//                            GOLDEN_FRAME_TOLERANCE (environment, default 0 = pixel exact). For every failing
+//                            buffer <name>_actual.pgm and <name>_diff.pgm are written next to the golden
+//
+// Report() prints the per buffer summary, main() returns the number of failing frames (0 == pass)
+//
+// Every input that differs between two runs is pinned so the frames are pixel exact:
+//   rng          Init() restores a fixed RandomState (reserved, hash and psuedo seeds), every true random number
+//                consumed is replaced by a fixed xorshift sequence (TrueRandom, TRUE_RANDOM_FILTER in rng.c)
+//   millis()     returns the frame clock set by SetClock() instead of the systick count (Millis, stm32f7xx_it.c)
+//   tNow         world::Init / PrepareScene / UpdateScene / RenderScene run at getFrameTime() in the realtime loop's order
+//   text layer   the debug / frame timing text is not drawn (OLED::Render)
+//   lp timer     disabled once the scene is prepared, no spi send runs during a capture
+
+#ifndef GOLDEN_FRAME_COUNT
+#define GOLDEN_FRAME_COUNT 120
+#endif
+
+namespace GoldenFrame
+{
+	static constexpr uint32_t const FRAME_COUNT = GOLDEN_FRAME_COUNT,
+																	FRAME_STEP = 16,				// ms, 60Hz lockstep with the lp timer
+																	FRAME_START = 1000;			// ms, first tNow
+	
+	STATIC_INLINE_PURE uint32_t const getFrameTime(uint32_t const iFrame) { return(FRAME_START + iFrame * FRAME_STEP); }
+	
+	NOINLINE void Init();														// after MX_RNG_Init, pins the rng state and starts the frame clock at FRAME_START
+	
+	void SetClock(uint32_t const tNow);
+	uint32_t const Millis(uint32_t const tTicks);			// frame clock once Init is called, pass thru before
+	uint32_t const TrueRandom(uint32_t const Value);	// fixed sequence once Init is called, pass thru before
+	
+	NOINLINE void Capture(uint32_t const iFrame);		// after RenderScene, waits for the main dma2d blend
+	NOINLINE int const Report();
+	
+} // end namespace
+
+#endif /*GOLDEN_FRAME_HARNESS*/
+
+#endif /*GOLDEN_FRAME_H*/
+
@@ -1,7 +1,7 @@
 #ifndef GOTHICA_H
 #define GOTHICA_H
 #include "PreprocessorCore.h"
-#include "Font.h"
+#include "font.h"
 
 extern const unsigned char Gothica64x128_8x18[];			//bugfix -- must be extern array not a pointer
 
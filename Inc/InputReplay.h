@@ -0,0 +1,84 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+#include "globals.h"
+
+// Deterministic record / replay of a run for the host build
+// Everything that makes two runs of UpdateScene / world::Update differ comes from only a few places:
+//
+//   tNow         of every world::Init, UpdateScene and RenderScene call, and their order (lp timer lockstep)
+//   true random  every number consumed from the hardware rng (AI descisions, missile / camera targets, hash seeds ...)
+//   millis()     the few reads inside the update path (camera move start time)
+//   rng seeds    reserved + hash seed and the psuedo rng (xorshift) state at the start of the run
+//
+// these are written in consumption order to a compact binary log (INPUT_RECORD environment = path). Playing back
+// (INPUT_REPLAY environment = path) replaces the realtime loop, main() feeds the same calls in the same order with the
+// logged tNow and every input is served from the log instead, reproducing the run bit for bit.
+//
+// Camera move targets, missile spawns, AI bot turns and the psuedo rng state after every update are also logged
+// as checkpoints. They are not inputs, on playback they are compared and the first divergence is reported
+// (event index, what was expected), playback then stops and Finish() returns non zero.
+//
+// not covered: the jpeg decode and fram sleep timeouts still use the wall clock, they do not feed the world state
+
+#ifdef INPUT_RECORD_REPLAY
+
+namespace InputReplay
+{
+	static constexpr uint32_t const EVENT_INIT = 1,		// world::Init
+																	EVENT_UPDATE = 2,	// UpdateScene
+																	EVENT_RENDER = 3;	// RenderScene
+
+	static constexpr uint32_t const CHECK_CAMERA = 0x10,		// moveTo target x, y (float bits), duration
+																	CHECK_MISSILE = 0x11,		// origin x, y, target x, y (float bits)
+																	CHECK_AIBOT = 0x12;			// root descision, descision / turn successful, plot min, plot max, frustration
+
+	NOINLINE bool const Init();			// after MX_RNG_Init, before world::Init. true = playing back, main() runs the replay loop
+	bool const isRecording();
+	bool const isPlaying();
+
+	void Record(uint32_t const Event, uint32_t const tNow);			// no-op unless recording
+	bool const Next(uint32_t& __restrict Event, uint32_t& __restrict tNow);	// playback, false = end of log or diverged
+
+	uint32_t const TrueRandom(uint32_t const Value);		// pass thru when not active
+	uint32_t const Millis(uint32_t const tMillis);
+
+	void Checkpoint(uint32_t const Check, uint32_t const* const __restrict Values, uint32_t const Count);
+
+	NOINLINE int const Finish();		// flushes the log, 0 == ok, 1 == playback diverged
+
+	STATIC_INLINE_PURE uint32_t const FloatBits(float const f)	// checkpoints compare floats bit exact
+	{
+		union
+		{
+			float const f;
+			uint32_t const i;
+		} const pun = { f };
+		
+		return(pun.i);
+	}
+
+} // end namespace
+
+#define INPUT_RECORD(Event, tNow) InputReplay::Record(Event, tNow)
+#define INPUT_MILLIS() InputReplay::Millis(millis())
+#define INPUT_CHECKPOINT(Check, ...) { uint32_t const Values_[] = { __VA_ARGS__ }; InputReplay::Checkpoint(Check, Values_, countof(Values_)); }
+
+#else
+
+#define INPUT_RECORD(Event, tNow)
+#define INPUT_MILLIS() millis()
+#define INPUT_CHECKPOINT(Check, ...)
+
+#endif /*INPUT_RECORD_REPLAY*/
+
+#endif /*INPUT_REPLAY_H*/
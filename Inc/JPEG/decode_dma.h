@@ -37,7 +37,7 @@
 #ifndef __DECODE_DMA_H
 #define __DECODE_DMA_H
 
-#include "PreProcessorCore.h"
+#include "PreprocessorCore.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -0,0 +1,52 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DECODE_SOFT_H
+#define __DECODE_SOFT_H
+
+#include "PreprocessorCore.h"
+
+#ifdef JPEG_SOFTWARE_DECODER
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f7xx_hal_jpeg.h"
+
+/* Software replacement of decode_dma.c for the headless host build
+ * Baseline huffman (SOF0/SOF1), single component grayscale, 8bit precision, restart markers supported
+ * Output is produced in 8x8 MCU blocks exactly as the hardware codec would emit them,
+ * and handed to the same jpeg_utils.c MCU => L8 convertor that the DMA path uses. */
+
+/* Exported constants --------------------------------------------------------*/
+#define JPEG_SOFT_ERROR_NONE			0
+#define JPEG_SOFT_ERROR_HEADER		1		/* unsupported or malformed header (progressive, color, 12bit ...) */
+#define JPEG_SOFT_ERROR_HUFFMAN		2		/* bad huffman code / coefficient overrun */
+#define JPEG_SOFT_ERROR_DATA			3		/* ran out of entropy coded data */
+
+/* Exported functions ------------------------------------------------------- */
+uint32_t JPEG_Decode_Soft(uint8_t const * const JPEGImageBuffer, uint32_t JPEGImageSize_Bytes, uint8_t* const DestBuffer);
+uint32_t JPEG_OutputHandler_Soft(void);		/* 1 : finished, 0 : ongoing or error (check getSoft_Error) */
+
+uint32_t const getSoft_MCUBlockIndex();
+uint32_t const getSoft_MCUTotalNb();
+uint32_t const getSoft_Error();
+uint32_t const getSoft_IsBusy();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JPEG_SOFTWARE_DECODER */
+
+#endif /* __DECODE_SOFT_H */
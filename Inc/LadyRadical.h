@@ -1,7 +1,7 @@
 #ifndef LADYRADICAL_H
 #define LADYRADICAL_H
 #include "PreprocessorCore.h"
-#include "Font.h"
+#include "font.h"
 
 extern const unsigned char LadyRadical64x128_9x14[];			//bugfix -- must be extern array not a pointer
 
@@ -12,16 +12,18 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #define LIGHTING_H
 #include "commonmath.h"
 #include "math_3d.h"
-#include "point2d.h"
+#include "Point2D.h"
 #include "globals.h"
 #include "oled.h"
 #include "rng.h"
 #include "vector_rotation.h"
+#include "isoVoxel.h"
 
-//#define DEBUG_LIGHTING 
+#if defined(HOST_BUILD) && defined(__SSE__)
+#include <immintrin.h>
+#endif
 
-// helper macros
-#define ISFOGENABLED(RenderingFlags) (OLED::FOG_ENABLE == (OLED::FOG_ENABLE & RenderingFlags))
+//#define DEBUG_LIGHTING 
 
 namespace Lighting
 {
@@ -33,12 +35,14 @@ namespace Lighting
 	// see shade_op.h for custom shading / lighting
 extern union uLightingDefaults
 {	
+#ifndef HOST_BUILD	// gcc does not allow members with constructors in an anonymous struct, only vNormal[] is used
 	struct {
 		vec3_t const vNormaLeftFace,
 								 vNormaFrontFace,
 								 vNormaLTopFace;// Cached normals for isometric "cube" or "voxel"
 		vec3_t 			 vNormalSpecific;
 	};
+#endif
 	
 	vec3_t vNormal[4];
 	
@@ -73,22 +77,39 @@ typedef struct sLight
 	vec2_rotation_t Angle;
 	float FalloffMaxDistance,
 				InvFalloffMaxDistance;
+	float Radius,								// 0.0f = unbounded (lights everything), otherwise contribution is windowed to zero at radius
+				InvRadiusSquared;
+	
+	// window applied to a bounded light's contribution, reaches zero at Radius so clusters can cull the light exactly
+	__attribute__((always_inline)) inline float const getWindow(float const fDistance) const
+	{
+		float const fWindow = __fmaxf(0.0f, 1.0f - (fDistance * fDistance) * InvRadiusSquared);
+		return( fWindow * fWindow );
+	}
+	__attribute__((always_inline)) inline bool const isBounded() const { return(InvRadiusSquared > 0.0f); }
+	
+	inline void setRadius(float const radius) { Radius = radius; InvRadiusSquared = (radius > 0.0f) ? (1.0f / (radius * radius)) : 0.0f; }
 	
 	inline sLight()
 		: IntensityDiffuse(0.0f), IntensityAmbient(0.0f),
-			FalloffMaxDistance(0.0f), InvFalloffMaxDistance(0.0f)
+			FalloffMaxDistance(0.0f), InvFalloffMaxDistance(0.0f),
+			Radius(0.0f), InvRadiusSquared(0.0f)
 	{}
 	inline sLight(float const& diffuse, float const& ambient, float const& falloff)
 		: IntensityDiffuse(diffuse), IntensityAmbient(ambient), Angle(0.0f), 
-			FalloffMaxDistance(falloff*ATTENUATION_NONLINEARITY), InvFalloffMaxDistance((1.0f / falloff) * BRIGHTNESS_FALLOFF)
+			FalloffMaxDistance(falloff*ATTENUATION_NONLINEARITY), InvFalloffMaxDistance((1.0f / falloff) * BRIGHTNESS_FALLOFF),
+			Radius(0.0f), InvRadiusSquared(0.0f)
 	{}
 	inline sLight(float const& diffuse, float const& ambient, float const& falloff, vec3_t const& position)
 		: IntensityDiffuse(diffuse), IntensityAmbient(ambient), Position(position), Angle(0.0f), 
-			FalloffMaxDistance(falloff*ATTENUATION_NONLINEARITY), InvFalloffMaxDistance((1.0f / falloff) * BRIGHTNESS_FALLOFF)
+			FalloffMaxDistance(falloff*ATTENUATION_NONLINEARITY), InvFalloffMaxDistance((1.0f / falloff) * BRIGHTNESS_FALLOFF),
+			Radius(0.0f), InvRadiusSquared(0.0f)
 	{}
 } Light;
 
-static constexpr uint32_t const MAX_NUM_ACTIVE_LIGHTS = 3;
+static constexpr uint32_t const MAX_NUM_ACTIVE_LIGHTS = 3,																		// activated/deactivated world lights (unbounded)
+																MAX_NUM_LIGHTS = 32,																					// + lights emitted by effects every frame (bounded)
+																MAX_NUM_EMITTED_LIGHTS = MAX_NUM_LIGHTS - MAX_NUM_ACTIVE_LIGHTS;
 extern struct ActiveLightSet
 {
 	static constexpr uint32_t const LIGHTING_UPDATE_RATE = 33; // ms
@@ -114,16 +135,41 @@ extern struct ActiveLightSet
 		
 	} LightState;
 	
-	constexpr uint32_t const getNumMaxLights() const { return(MAX_NUM_ACTIVE_LIGHTS); }
+	// light clusters, screen x tiles by IsoDepth depth slices, each holding a bitmask of the lights that reach it
+	// bit [0, MAX_NUM_ACTIVE_LIGHTS) is Lights[i] (world lights, always set while active, not stored in the clusters)
+	// bit [MAX_NUM_ACTIVE_LIGHTS, MAX_NUM_LIGHTS) is an emitted light, Lights[i] = &Emitted[i - MAX_NUM_ACTIVE_LIGHTS]
+	static constexpr uint32_t const CLUSTER_TILE_BITS = 5,	// 32 pixels wide
+																	CLUSTER_SLICE_BITS = 5,	// 8 slices of the 256 depth levels
+																	NUM_CLUSTER_TILES = OLED::SCREEN_WIDTH >> CLUSTER_TILE_BITS,
+																	NUM_CLUSTER_SLICES = 256 >> CLUSTER_SLICE_BITS;
+	
+	constexpr uint32_t const getNumMaxLights() const { return(MAX_NUM_LIGHTS); }
 	__attribute__((pure)) __inline uint32_t const getNumActiveLights() const { return(NumActive); }
+	__attribute__((pure)) __inline uint32_t const getNumEmittedLights() const { return(NumEmitted); }
 	
-	Light const*							Lights[MAX_NUM_ACTIVE_LIGHTS];
+	__attribute__((pure)) __inline uint32_t const getActiveLightsMask() const { return( (1U << NumActive) - 1U ); }
+	__attribute__((pure)) __inline uint32_t const getClusterLightsMask( vec3_t const vPoint ) const
+	{
+		return( ClusterLights[getCluster(vPoint)] | getActiveLightsMask() );
+	}
+	
+	// emitted lights only live for the frame they are emitted in, emit every frame while the effect is alive
+	// WorldLocation is in world grid space, returns false if no free light
+	bool const EmitLight(vec2_t const WorldLocation, float const fHeight, float const fDiffuse, float const fAmbient, float const fFalloff, float const fRadius);
+	void ResetEmittedLights();
+	void BuildClusters();			// once per frame, after lights are emitted and before rendering
+	
+	Light const*							Lights[MAX_NUM_LIGHTS];
 	Light const*							RestoreLights[MAX_NUM_ACTIVE_LIGHTS];
 	
 	LightState								LightStates[MAX_NUM_ACTIVE_LIGHTS];
 	uint32_t								  NumActive,
 														tLastUpdate;
 	
+	Light											Emitted[MAX_NUM_EMITTED_LIGHTS];
+	uint32_t									NumEmitted;
+	uint32_t									ClusterLights[NUM_CLUSTER_SLICES * NUM_CLUSTER_TILES];
+	
 	ActiveLightSet();
 	
 	void Initialize( sLight* const (&ppLights)[MAX_NUM_ACTIVE_LIGHTS], uint32_t const tNow );
@@ -137,6 +183,19 @@ extern struct ActiveLightSet
 private:
 	void RestoreLightSettings(Light* const __restrict Dest, Light const& __restrict Src);
 	void UpdateLightPointers();
+	
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getClusterTile( int32_t const xPixel )
+	{
+		return( __USAT(xPixel, Constants::SATBIT_256) >> CLUSTER_TILE_BITS );
+	}
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getClusterSlice( int32_t const yPixel )
+	{
+		return( IsoDepth::getLevelIndex(IsoDepth::getDepthLevel(yPixel)) >> CLUSTER_SLICE_BITS );
+	}
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getCluster( vec3_t const vPoint )
+	{
+		return( getClusterSlice((int32_t)vPoint.z) * NUM_CLUSTER_TILES + getClusterTile((int32_t)vPoint.x) );
+	}
 } ActiveLighting __attribute__((section (".dtcm")));
 
 
@@ -159,14 +218,83 @@ STATIC_INLINE_PURE vec3_t const refract(vec3_t const I, vec3_t const N, float co
 	return ( T );
 }
 
-// does not write any global memory, however call to UpdateFogShade does, but has its own function attributes set, even if inlined
-template<bool const FogEnabled>
+// ### shadow map
+// low resolution height field shadows of the primary light, one cell per voxel, covering the visible grid window
+// a cell holds the height in pixels below which a point on that voxel is in the shadow of a taller neighbour,
+// heights are from the world base (0) for ground and structures alike, the same heights points are lit at
+// cells are built by World (UpdateShadowMap) a fixed number per frame, so shadows cost a fixed slice of the frame
+// and lighting only does a lookup. The map wraps (toroidal) and a cell is tagged with the grid position it was built for,
+// scrolling the camera keeps every cell still in view, cells newly in view are unshadowed until they are built
+namespace ShadowMap
+{
+	static constexpr uint32_t const SIZE_SATBITS = 5,								// 32x32 covers the visible window
+																	SIZE = (1 << SIZE_SATBITS),
+																	HEIGHT_BITS = 8,
+																	TAG_BITS = 12;									// grid x and y, world grid size is 288
+	static constexpr float const PENUMBRA = 4.0f,										// pixels of height over which the shadow fades in
+															 SHADOW_DIFFUSE = 0.3f;							// diffuse remaining in full shadow
+	
+	extern uint32_t Cells[SIZE * SIZE];		// height | grid x << HEIGHT_BITS | grid y << (HEIGHT_BITS + TAG_BITS)
+	extern Light const* Caster;						// only this light is shadowed
+	extern vec2_t vScreenOrigin;					// screen position of grid (0,0), maps a screen point back to its voxel
+	
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getIndex( uint32_t const x, uint32_t const y )
+	{
+		return( (x & (SIZE - 1)) | ((y & (SIZE - 1)) << SIZE_SATBITS) );
+	}
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getTag( uint32_t const x, uint32_t const y )
+	{
+		return( ((x & ((1 << TAG_BITS) - 1)) << HEIGHT_BITS) | ((y & ((1 << TAG_BITS) - 1)) << (HEIGHT_BITS + TAG_BITS)) );
+	}
+	// inverse of Iso::p2D_GridToIso
+	__attribute__((always_inline)) STATIC_INLINE_PURE vec2_t const v2_ScreenToGrid( vec2_t const screenSpace )
+	{
+		static constexpr float const INV_GRID_FX = 1.0f / (Iso::GRID_FRADII_X2),
+																 INV_GRID_FY = 1.0f / (Iso::GRID_FRADII);
+		float const fXScreen(screenSpace.x * INV_GRID_FX),
+								fYScreen(screenSpace.y * INV_GRID_FY);
+		return( vec2_t( fXScreen + fYScreen, fXScreen - fYScreen ) );
+	}
+	
+	// [SHADOW_DIFFUSE, 1.0f] diffuse visibility of a point at fHeight on the voxel with its base origin at screen vOrigin
+	__attribute__((always_inline)) STATIC_INLINE_PURE float const getVisibility( vec2_t const vOrigin, float const fHeight )
+	{
+		static constexpr float const INV_PENUMBRA = 1.0f / PENUMBRA;
+		
+		vec2_t const vGrid( v2_ScreenToGrid(v2_sub(vOrigin, vScreenOrigin)) );
+		uint32_t const x( int32::__roundf(vGrid.x) ), y( int32::__roundf(vGrid.y) );
+		
+		uint32_t const Cell( Cells[getIndex(x, y)] );
+		
+		if ( getTag(x, y) != (Cell & ~((1 << HEIGHT_BITS) - 1)) )	// not built yet
+			return(1.0f);
+		
+		float const fDepth( (float)(Cell & ((1 << HEIGHT_BITS) - 1)) - fHeight );	// how far below the shadow height
+		
+		if ( fDepth <= 0.0f )
+			return(1.0f);
+		
+		return( lerp(1.0f, SHADOW_DIFFUSE, __fminf(1.0f, fDepth * INV_PENUMBRA)) );
+	}
+	// point on the voxel base origin (screen x, height, screen y), ie. top faces
+	__attribute__((always_inline)) STATIC_INLINE_PURE float const getVisibility( vec3_t const vPoint )
+	{
+		return( getVisibility(vec2_t(vPoint.x, vPoint.z), vPoint.y) );
+	}
+	
+} // end namespace
+
+// does not write any global memory, fog is applied after rendering (World PostProcess_Fog)
 __ramfunc __attribute__((pure)) inline float const Shade_FullRange(vec3_t const vPoint, uint32_t const uiNormalID, float const fDiffuseMaterial) // main lighting routine, should be leveraged not duplicated
 {	
 	float lighting(0.0f);
 
-	for ( int32_t iDx = ActiveLighting.getNumActiveLights() - 1 ; iDx >= 0 ; --iDx )
+	// only the lights reaching this point's cluster, highest light first
+	for ( uint32_t uiLights = ActiveLighting.getClusterLightsMask(vPoint) ; 0 != uiLights ; )
 	{
+		int32_t const iDx = 31 - __CLZ(uiLights);
+		uiLights ^= (1U << iDx);
+		
 		vec3_t vLight;
 		float fDistance, fAttenuation;
 		
@@ -189,6 +317,9 @@ __ramfunc __attribute__((pure)) inline float const Shade_FullRange(vec3_t const
 				// Attenuate diffuse based on falloff				// this seems to not have a huge impact on perf, but looks much better for diffuse
 				diffuse = (LdotN * pLight->IntensityDiffuse) * fDiffuseMaterial;
 				
+				if ( ShadowMap::Caster == pLight ) {
+					diffuse *= ShadowMap::getVisibility(vPoint);
+				}
 				
 #ifdef DEBUG_LIGHTING
 				// draw incident ray
@@ -205,72 +336,317 @@ __ramfunc __attribute__((pure)) inline float const Shade_FullRange(vec3_t const
 			// add diffuse lighting contribution
 			// Attenuate ambient based on falloff
 
-			lighting += __fma(pLight->IntensityAmbient * fDiffuseMaterial, 
-												1.0f / (fAttenuation * Light::AMBIENT_ATTENUATION_FACTOR), 
-												diffuse);
+			float contribution = __fma(pLight->IntensityAmbient * fDiffuseMaterial, 
+																 1.0f / (fAttenuation * Light::AMBIENT_ATTENUATION_FACTOR), 
+																 diffuse);
+			
+			if ( pLight->isBounded() ) {
+				contribution *= pLight->getWindow(fDistance);
+			}
+			
+			lighting += contribution;
 			
 		} // nullptr check
 		
 	} // for
-
-	if constexpr( FogEnabled ) {
-		IsoDepth::UpdateActiveFogShade(vPoint, lighting);
-	}
 	
 	return(lighting);
 }
 
 // ### for full range value return and a custom normal input
-template<bool const FogEnabled>
 __attribute__((always_inline)) STATIC_INLINE float const Shade_FullRange(vec3_t const vPoint, vec3_t const vNormal, float const fDiffuse) 
 {	
 	LightingDefaults.vNormal[NORMAL_SPECIFIC] = vNormal;
-	return( Shade_FullRange<FogEnabled>(vPoint, NORMAL_SPECIFIC, fDiffuse) );
+	return( Shade_FullRange(vPoint, NORMAL_SPECIFIC, fDiffuse) );
 }
 
 // #### for limited range value return
-template<bool const FogEnabled>
 __attribute__((always_inline)) STATIC_INLINE __attribute__((pure)) uint32_t const Shade(vec3_t const vPoint, uint32_t const uiNormalID, float const fDiffuse)
 {
-	float const fLighting = Shade_FullRange<FogEnabled>(vPoint, uiNormalID, fDiffuse);
+	float const fLighting = Shade_FullRange(vPoint, uiNormalID, fDiffuse);
 	
 	return( __USAT( int32::__roundf(fLighting * Constants::nf255), Constants::SATBIT_256) );
 }
 
 // #### for limited range value return and a custom normal input
-template<bool const FogEnabled>
 __attribute__((always_inline)) STATIC_INLINE uint32_t const Shade(vec3_t const vPoint, vec3_t const vNormal, float const fDiffuse)
 {	
 	LightingDefaults.vNormal[NORMAL_SPECIFIC] = vNormal;
-	return( Shade<FogEnabled>(vPoint, NORMAL_SPECIFIC, fDiffuse) );
+	return( Shade(vPoint, NORMAL_SPECIFIC, fDiffuse) );
 }
 
-// default lighting op (fog enabled):
-// op does not write any global memory
-__attribute__((always_inline)) STATIC_INLINE __attribute__((pure)) uint32_t const shade_op_defaultlighting_fog(vec3_t const vPoint, uint32_t const uiNormalID, float const fDiffuse) 
-{ 
-	return( Shade<true>(vPoint, uiNormalID, fDiffuse) );
+// ### batched lighting, structure of arrays
+// the light loop is hoisted outside of the points, each light's parameters are loaded once per batch and the
+// per point math (normalize, sqrt, attenuate) is independent across points. On the host build with SSE the points are
+// evaluated 4 at a time, the Cortex-M7 FPU has no float SIMD (DSP extension is integer only) so on target the same math
+// is interleaved across points which hides the vsqrt/vdiv latency that stalls the single point Shade_FullRange
+// lighting output per point is the same as Shade_FullRange (same order of operations, fused where it is fused)
+static constexpr uint32_t const SHADE_BATCH_SIZE = 4;
+
+template<uint32_t const N = SHADE_BATCH_SIZE>
+struct ShadeBatch
+{
+	static_assert( 0 == (N & 3) && N <= 8, "batch size must be 4 or 8" );
+
+	float x[N] __attribute__((aligned(16))),		// input, world position
+				y[N] __attribute__((aligned(16))),
+				z[N] __attribute__((aligned(16)));
+	float lighting[N] __attribute__((aligned(16)));	// output, full range lighting
+	vec2_t vOrigin;																	// input, screen position of the base origin of the voxel all points are on (shadow map lookup)
+
+	__attribute__((always_inline)) inline void set(uint32_t const i, vec3_t const vPoint) { x[i] = vPoint.x; y[i] = vPoint.y; z[i] = vPoint.z; }
+	__attribute__((always_inline)) inline vec3_t const get(uint32_t const i) const { return(vec3_t(x[i], y[i], z[i])); }
+};
+
+#if defined(HOST_BUILD) && defined(__SSE__)
+__attribute__((always_inline)) STATIC_INLINE_PURE __m128 const __fma( __m128 const Sn, __m128 const Sm, __m128 const Sd )
+{
+#ifdef __FMA__
+	return( _mm_fmadd_ps(Sn, Sm, Sd) );
+#else
+	return( _mm_add_ps(_mm_mul_ps(Sn, Sm), Sd) );	// not fused, last bit may differ from the target
+#endif
 }
+#endif
 
-// default lighting op (with specific normal) (fog enabled):
-// op does not write any global memory
-__attribute__((always_inline)) STATIC_INLINE __attribute__((pure)) uint32_t const shade_op_defaultlighting_normal_fog(vec3_t const vPoint, vec3_t const vNormal, float const fDiffuse) 
-{ 
-	return( Shade<true>(vPoint, vNormal, fDiffuse) );
+template<uint32_t const N>
+__ramfunc inline void Shade_FullRange(ShadeBatch<N>& __restrict Batch, uint32_t const uiNormalID, float const fDiffuseMaterial)
+{
+	vec3_t const vNormal(getVoxelNormal(uiNormalID));
+
+	uint32_t uiLights(0);
+	
+	for ( uint32_t i = 0 ; i < N ; ++i ) {
+		Batch.lighting[i] = 0.0f;
+		uiLights |= ActiveLighting.getClusterLightsMask(Batch.get(i));	// union of the clusters, a light outside a point's cluster contributes exactly zero
+	}
+
+	for ( ; 0 != uiLights ; )
+	{
+		int32_t const iDx = 31 - __CLZ(uiLights);
+		uiLights ^= (1U << iDx);
+		
+		Light const* const __restrict pLight(ActiveLighting.Lights[iDx]);
+
+		float const fAmbient(pLight->IntensityAmbient * fDiffuseMaterial);
+
+#if defined(HOST_BUILD) && defined(__SSE__)
+		__m128 const vPositionX(_mm_set1_ps(pLight->Position.x)), vPositionY(_mm_set1_ps(pLight->Position.y)), vPositionZ(_mm_set1_ps(pLight->Position.z)),
+								 vNormalX(_mm_set1_ps(vNormal.x)), vNormalY(_mm_set1_ps(vNormal.y)), vNormalZ(_mm_set1_ps(vNormal.z));
+		__m128 const vZero(_mm_setzero_ps()), vOne(_mm_set1_ps(1.0f));
+
+		for ( uint32_t i = 0 ; i < N ; i += 4 )
+		{
+			__m128 vLightX(_mm_sub_ps(_mm_load_ps(&Batch.x[i]), vPositionX)),
+						 vLightY(_mm_sub_ps(_mm_load_ps(&Batch.y[i]), vPositionY)),
+						 vLightZ(_mm_sub_ps(_mm_load_ps(&Batch.z[i]), vPositionZ));
+
+			// v3_normalize
+			__m128 const fNorm(__fma(vLightX, vLightX, __fma(vLightY, vLightY, _mm_mul_ps(vLightZ, vLightZ))));
+			__m128 const bValid(_mm_cmpgt_ps(fNorm, vZero));
+			__m128 const fDistance(_mm_sqrt_ps(fNorm));
+			__m128 const fInvLength(_mm_and_ps(bValid, _mm_div_ps(vOne, fDistance)));	// zero length normalizes to zero
+
+			vLightX = _mm_mul_ps(vLightX, fInvLength);
+			vLightY = _mm_mul_ps(vLightY, fInvLength);
+			vLightZ = _mm_mul_ps(vLightZ, fInvLength);
+
+			__m128 fAttenuation(_mm_sqrt_ps(_mm_mul_ps(fDistance, _mm_set1_ps(pLight->FalloffMaxDistance))));
+
+			__m128 const LdotN(_mm_max_ps(vZero, __fma(vLightX, vNormalX, __fma(vLightY, vNormalY, _mm_mul_ps(vLightZ, vNormalZ)))));
+			__m128 diffuse(_mm_and_ps(_mm_cmpgt_ps(LdotN, _mm_set1_ps(Light::MAX_INCIDENT_ANGLE)),
+																_mm_mul_ps(_mm_mul_ps(LdotN, _mm_set1_ps(pLight->IntensityDiffuse)), _mm_set1_ps(fDiffuseMaterial))));
+			
+			if ( ShadowMap::Caster == pLight ) {
+				diffuse = _mm_mul_ps(diffuse, _mm_setr_ps(ShadowMap::getVisibility(Batch.vOrigin, Batch.y[i]), ShadowMap::getVisibility(Batch.vOrigin, Batch.y[i + 1]),
+																									ShadowMap::getVisibility(Batch.vOrigin, Batch.y[i + 2]), ShadowMap::getVisibility(Batch.vOrigin, Batch.y[i + 3])));
+			}
+
+			fAttenuation = _mm_mul_ps(_mm_add_ps(fDistance, fAttenuation), _mm_set1_ps(pLight->InvFalloffMaxDistance));
+
+			__m128 contribution(__fma(_mm_set1_ps(fAmbient),
+																_mm_div_ps(vOne, _mm_mul_ps(fAttenuation, _mm_set1_ps(Light::AMBIENT_ATTENUATION_FACTOR))),
+																diffuse));
+			
+			if ( pLight->isBounded() ) {
+				__m128 fWindow(_mm_max_ps(vZero, _mm_sub_ps(vOne, _mm_mul_ps(_mm_mul_ps(fDistance, fDistance), _mm_set1_ps(pLight->InvRadiusSquared)))));
+				fWindow = _mm_mul_ps(fWindow, fWindow);
+				contribution = _mm_mul_ps(contribution, fWindow);
+			}
+			
+			_mm_store_ps(&Batch.lighting[i], _mm_add_ps(_mm_load_ps(&Batch.lighting[i]), contribution));
+		}
+#else
+		for ( uint32_t i = 0 ; i < N ; ++i )
+		{
+			float fDistance(0.0f), fAttenuation;
+
+			vec3_t const vLight = v3_normalize(v3_sub(Batch.get(i), pLight->Position), &fDistance);
+
+			fAttenuation = __sqrtf( fDistance * pLight->FalloffMaxDistance );
+
+			float diffuse(0.0f);
+			float const LdotN = __fmaxf(0.0f, v3_dot(vLight, vNormal));
+
+			if (LdotN > Light::MAX_INCIDENT_ANGLE) {
+				diffuse = (LdotN * pLight->IntensityDiffuse) * fDiffuseMaterial;
+				
+				if ( ShadowMap::Caster == pLight ) {
+					diffuse *= ShadowMap::getVisibility(Batch.vOrigin, Batch.y[i]);
+				}
+			}
+
+			fAttenuation = (fDistance + fAttenuation) * pLight->InvFalloffMaxDistance;
+
+			float contribution = __fma(fAmbient, 1.0f / (fAttenuation * Light::AMBIENT_ATTENUATION_FACTOR), diffuse);
+			
+			if ( pLight->isBounded() ) {
+				contribution *= pLight->getWindow(fDistance);
+			}
+			
+			Batch.lighting[i] += contribution;
+		}
+#endif
+	} // for
+}
+
+// #### for limited range value return of a point in a batch
+template<uint32_t const N>
+__attribute__((always_inline)) STATIC_INLINE uint32_t const Shade(ShadeBatch<N> const& __restrict Batch, uint32_t const i)
+{
+	float const fLighting = Batch.lighting[i];
+
+	return( __USAT( int32::__roundf(fLighting * Constants::nf255), Constants::SATBIT_256) );
+}
+
+// ### lighting cache (SHADE_CACHE)
+// memoises the full range lighting of a point, keyed by its screen position, height, face normal and material
+// lighting is all in screen space, so an entry stays valid while nothing it depends on changes. Once per frame before rendering
+// the cache is invalidated if the lights (BuildClusters), the camera scroll or a shadow map cell (World UpdateShadowMap) changed,
+// Invalidate() starts a new generation, stale entries are never cleared, just never match
+// direct mapped, a collision simply replaces the entry
+// only pays off while the camera and lights are still, the demo scrolls and emits effect lights nearly every frame (~5% hits)
+// without SHADE_CACHE the cached variants are Shade / Shade_FullRange
+#ifdef SHADE_CACHE
+namespace ShadeCache
+{
+	static constexpr uint32_t const NUM_POINT_ENTRIES = 1024,				// ground and rooftops
+																	NUM_BATCH_ENTRIES = 512;				// batches of face columns
+	static constexpr uint32_t const HEIGHT_BITS = 14,
+																	NORMAL_BITS = 2,
+																	GENERATION_SHIFT = HEIGHT_BITS + NORMAL_BITS;
+
+	template<uint32_t const N>
+	struct sEntry
+	{
+		uint32_t	Position,			// screen x | screen y << 16
+							Tag;					// height | normal | generation
+		float			Material;
+		float			lighting[N];
+	};
+
+	extern sEntry<1> Points[NUM_POINT_ENTRIES];
+	extern sEntry<SHADE_BATCH_SIZE> Batches[NUM_BATCH_ENTRIES];
+	extern uint32_t Generation;
+
+	void Invalidate();
+	
+#ifdef STAGE_PROFILING
+	extern uint32_t Lookups, Hits, Invalidations;
+	
+#ifdef HOST_BUILD
+	NOINLINE void Report();	// hit rate of the run so far to stdout
+#endif
+#define SHADE_CACHE_COUNT(counter) (++ShadeCache::counter)
+#else
+#define SHADE_CACHE_COUNT(counter)
+#endif
+
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getPosition( vec3_t const vPoint )
+	{
+		return( ((uint32_t)((int32_t)vPoint.x) & 0xFFFF) | ((uint32_t)((int32_t)vPoint.z) << 16) );
+	}
+	__attribute__((always_inline)) STATIC_INLINE uint32_t const getTag( vec3_t const vPoint, uint32_t const uiNormalID )
+	{
+		return( ((uint32_t)((int32_t)vPoint.y) & ((1 << HEIGHT_BITS) - 1)) | (uiNormalID << HEIGHT_BITS) | (Generation << GENERATION_SHIFT) );
+	}
+	template<uint32_t const NUM_ENTRIES>
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getIndex( uint32_t const Position, uint32_t const Tag )
+	{
+		static_assert( 0 == (NUM_ENTRIES & (NUM_ENTRIES - 1)), "cache size must be a power of 2" );
+
+		return( ((Position ^ Tag) * 2654435761U) >> (32 - __builtin_ctz(NUM_ENTRIES)) ); // fibonacci hash
+	}
+
+} // end namespace
+
+// #### cached variant of Shade, same result, points must be on integer screen positions and heights
+__attribute__((always_inline)) STATIC_INLINE uint32_t const Shade_Cached(vec3_t const vPoint, uint32_t const uiNormalID, float const fDiffuse)
+{
+	uint32_t const Position(ShadeCache::getPosition(vPoint)), Tag(ShadeCache::getTag(vPoint, uiNormalID));
+
+	ShadeCache::sEntry<1>& __restrict Entry( ShadeCache::Points[ShadeCache::getIndex<ShadeCache::NUM_POINT_ENTRIES>(Position, Tag)] );
+
+	SHADE_CACHE_COUNT(Lookups);
+	if ( Position != Entry.Position || Tag != Entry.Tag || fDiffuse != Entry.Material ) {
+		Entry.Position = Position; Entry.Tag = Tag; Entry.Material = fDiffuse;
+		Entry.lighting[0] = Shade_FullRange(vPoint, uiNormalID, fDiffuse);
+	}
+	else {
+		SHADE_CACHE_COUNT(Hits);
+	}
+
+	return( __USAT( int32::__roundf(Entry.lighting[0] * Constants::nf255), Constants::SATBIT_256) );
+}
+
+// #### cached variant of the batched Shade_FullRange, keyed by the first point of the batch, so it is only valid
+// for batches where every other point and the voxel origin are a fixed offset of the first (eg. columns of a face, see World setFaceColumnBatch)
+__attribute__((always_inline)) STATIC_INLINE void Shade_FullRange_Cached(ShadeBatch<SHADE_BATCH_SIZE>& __restrict Batch, uint32_t const uiNormalID, float const fDiffuseMaterial)
+{
+	vec3_t const vKey(Batch.get(0));
+	uint32_t const Position(ShadeCache::getPosition(vKey)), Tag(ShadeCache::getTag(vKey, uiNormalID));
+
+	ShadeCache::sEntry<SHADE_BATCH_SIZE>& __restrict Entry( ShadeCache::Batches[ShadeCache::getIndex<ShadeCache::NUM_BATCH_ENTRIES>(Position, Tag)] );
+
+	SHADE_CACHE_COUNT(Lookups);
+	if ( Position != Entry.Position || Tag != Entry.Tag || fDiffuseMaterial != Entry.Material ) {
+		Shade_FullRange(Batch, uiNormalID, fDiffuseMaterial);
+
+		Entry.Position = Position; Entry.Tag = Tag; Entry.Material = fDiffuseMaterial;
+		for ( uint32_t i = 0 ; i < SHADE_BATCH_SIZE ; ++i ) {
+			Entry.lighting[i] = Batch.lighting[i];
+		}
+	}
+	else {
+		SHADE_CACHE_COUNT(Hits);
+		for ( uint32_t i = 0 ; i < SHADE_BATCH_SIZE ; ++i ) {
+			Batch.lighting[i] = Entry.lighting[i];
+		}
+	}
+}
+#else
+__attribute__((always_inline)) STATIC_INLINE uint32_t const Shade_Cached(vec3_t const vPoint, uint32_t const uiNormalID, float const fDiffuse)
+{
+	return( Shade(vPoint, uiNormalID, fDiffuse) );
+}
+__attribute__((always_inline)) STATIC_INLINE void Shade_FullRange_Cached(ShadeBatch<SHADE_BATCH_SIZE>& __restrict Batch, uint32_t const uiNormalID, float const fDiffuseMaterial)
+{
+	Shade_FullRange(Batch, uiNormalID, fDiffuseMaterial);
 }
+#endif /*SHADE_CACHE*/
 
 // default lighting op:
 // op does not write any global memory
 __attribute__((always_inline)) STATIC_INLINE __attribute__((pure)) uint32_t const shade_op_defaultlighting(vec3_t const vPoint, uint32_t const uiNormalID, float const fDiffuse) 
 { 
-	return( Shade<false>(vPoint, uiNormalID, fDiffuse) );
+	return( Shade(vPoint, uiNormalID, fDiffuse) );
 }
 
 // default lighting (with specific normal) op:
 // op does not write any global memory
 __attribute__((always_inline)) STATIC_INLINE __attribute__((pure)) uint32_t const shade_op_defaultlighting_normal(vec3_t const vPoint, vec3_t const vNormal, float const fDiffuse) 
 { 
-	return( Shade<false>(vPoint, vNormal, fDiffuse) );
+	return( Shade(vPoint, vNormal, fDiffuse) );
 }
 
 } // end namespace
@@ -0,0 +1,38 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef OLED_BENCHMARK_H
+#define OLED_BENCHMARK_H
+#include "globals.h"
+
+#ifdef OLED_MICROBENCHMARK
+
+// Microbenchmark of the oled.h rasterization primitives for the host build
+// main() runs every primitive for every RenderingFlags combination (and both target buffers where applicable)
+// instead of entering the realtime loop. Each case replays the same deterministic list of calls, lengths are drawn
+// from a distribution approximating the isometric world (short ground faces, fewer tall building faces), depth
+// levels are random against a depth buffer of random level runs per column so roughly half of the depth tests fail.
+// Buffers are restored between repetitions (not timed) so every repetition sees the same depth / shade state.
+//
+// results: calls/s and pixels/s (nominal pixels = requested line lengths, 1 per pixel call), printed and written as
+// csv to OLED_BENCH_CSV (environment, default "oled_bench.csv")
+// depth column is "spans" when built with DEPTH_SPANS, "pixels" otherwise - run both builds to compare the modes
+// "depth ties" renders a grid of adjacent buildings into the depth buffer in both draw orders and counts the pixels
+// whose winner changes, build with and without DEPTH_16BIT to compare the precisions (16bit fails the run on any)
+
+namespace OLEDBenchmark
+{
+	NOINLINE int const Run();		// after OLED::Init and DTCM::ScatterLoad, returns 0 on success
+
+} // end namespace
+
+#endif /*OLED_MICROBENCHMARK*/
+
+#endif /*OLED_BENCHMARK_H*/
@@ -42,6 +42,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #endif 
 
 #define SHOW_FRAMETIMING
+//#define STAGE_PROFILING		// per stage min/p50/p99/max frame timing, see Profiler.h
 #define _DEBUG_OUT_OLED
 //#define RENDER_BLOOMHDRSOURCE
 //#define RENDER_DEPTH
@@ -50,9 +51,32 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 //#define FIRST_MOVE_ONLY
 //#define DEBUG_FLAT_GROUND
 //#define DEBUG_NORENDER_STRUCTURES
+//#define GRID_MORTON_CHUNKS		// theGrid stored as 8x8 morton ordered chunks instead of row major, see getGridOffset in World.cpp
+//#define RENDERGRID_BINNED		// front to back grid traversal skipping voxels behind fully covered screen tiles, see RenderGrid in World.cpp
+//#define SHADE_CACHE			// ground, rooftop and face column lighting memoised across frames, the primary light rotates in steps, see Lighting.h ShadeCache
 #define VOX_DEBUG_ENABLED
 //#define VOX_FRAM_FORCE_REPROGRAMMING
+//#define VOX_ADJACENCY_BITMAP		// .vox adjacency by a dense occupancy bitmap of the model bounds (default: the smaller of bitmap / spatial hash per model)
+//#define VOX_ADJACENCY_HASHED		// .vox adjacency by a spatial hash of the voxels, see VoxBinary.cpp
+//#define VOX_BAKED_MODELS			// models loaded from the offline baked images (.vxb) in flash, mapped from FRAM instead of parsed at boot, see VoxBaker.h
+//#define VOX_IMPOSTOR_CACHE		// dynamic voxel models rendered once per quantized heading and blitted from external sram after, see VoxImpostor.h
 #define USART_ENABLE 1 // too fucking noisy
+//#define HOST_BUILD			// headless build for the host pc (x86-64 linux, non-PIE so addresses fit uint32_t), peripherals emulated in software, see CMakeLists.txt
+
+#ifdef HOST_BUILD
+	 #undef USART_ENABLE
+	 #define USART_ENABLE 0				// no serial port on the host
+	 #define DMA2D_SOFTWARE_ENGINE
+	 #define JPEG_SOFTWARE_DECODER
+	 #define QSPI_FRAM_SOFTWARE_EMULATOR	// FRAM backed by a mmap'd image file, see quadspi.h
+	 #define STAGE_PROFILING
+	 #define INPUT_RECORD_REPLAY		// record / play back every nondeterministic input of a run, see InputReplay.h
+	 //#define OLED_MICROBENCHMARK		// time every oled.h rasterization primitive / rendering flags combination, see OLEDBenchmark.h
+	 //#define GOLDEN_FRAME_HARNESS		// render a fixed number of deterministic frames and compare to golden images, see GoldenFrame.h
+	 //#define VOX_ADJACENCY_BENCHMARK	// time the .vox adjacency builders over the models in Data/VOX, see VoxAdjacencyBenchmark.h
+	 //#define VOX_BAKE_MODELS			// bake the .vox models in Data/VOX to baked model images (.vxb), see VoxBaker.h
+	 //#define VOX_BATCH_BENCHMARK		// time missiles rendered one by one against one batch, and their FRAM reads, see VoxBatchBenchmark.h
+#endif
 	 
 // **** The below defines include the entire FRAM INCBIN file when needed
 // defined only if currently programming FRAM, FRAM Loading
@@ -87,6 +111,13 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_ll_cortex.h"
 #include "stm32f7xx_ll_system.h"
 #include "stm32f767xx.h"
+
+#ifdef DMA2D_SOFTWARE_ENGINE
+extern DMA2D_TypeDef DMA2D_Soft_Registers;		// see DMA2D_Soft.h
+#undef DMA2D
+#define DMA2D (&DMA2D_Soft_Registers)
+#endif
+
 #include <math.h>
 #ifdef fmaf
 #undef fmaf
@@ -99,8 +130,16 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 	
 	/// ##### __ramfunc's if defined in header file should never be static or inline!!!! ##### ///
 #define STATIC_INLINE __STATIC_INLINE
+#ifndef HOST_BUILD
 #define STATIC_INLINE_PURE __attribute__((const)) __STATIC_INLINE
+#else
+#define STATIC_INLINE_PURE __attribute__((pure)) __STATIC_INLINE	// gcc passes point2D_t (user copy ctor) by reference, const calls on one temporary get merged
+#endif
+#ifndef HOST_BUILD
 #define __ramfunc __attribute__((noinline, section(".ramfunc")))
+#else
+#define __ramfunc __attribute__((noinline))	// gcc rejects inline (comdat) and plain functions sharing one section
+#endif
 #define NOINLINE __attribute__((noinline))
 #define ZI_BSS  __attribute__((section(".bss")))
 
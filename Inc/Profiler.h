@@ -0,0 +1,102 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+#include "globals.h"
+
+// Per stage frame timing
+// PROFILE_STAGE(stage) times the enclosing scope with micros() and accumulates into the total of the current frame,
+// Profiler::EndFrame() pushes each stage that was entered this frame into a fixed ring of the last NUM_SAMPLES frames.
+// PROFILE_STAGE_SAMPLE(stage) pushes every call as its own sample instead (interrupt / not once per frame stages)
+// Nested stages are inclusive, ie. GRID contains all of the GRID_xxx stages
+//
+// min / p50 / p99 / max of every ring is rotated out thru DebugMessage one stage per REPORT_INTERVAL,
+// the host build also rewrites a csv (PROFILE_CSV environment, default "profile.csv") every CSV_INTERVAL frames
+//
+// all of it compiles away when STAGE_PROFILING is not defined
+
+#ifdef STAGE_PROFILING
+
+namespace Profiler
+{
+	static constexpr uint32_t const GRID = 0,
+																	GRID_GROUND = 1,
+																	GRID_STRUCTURE = 2,
+																	GRID_HASHPLOT = 3,
+																	GRID_DESTRUCTION = 4,
+																	GRID_EFFECT = 5,
+																	SHOCKWAVE = 6,
+																	EXPLOSION = 7,
+																	MISSILE = 8,
+																	OLED_RENDER = 9,
+																	BLOOM = 10,
+																	SEND_FRAMEBUFFER = 11,
+																	UPDATE_SCENE = 12,
+																	FOG = 13,
+																	SHADOW = 14,
+																	NUM_STAGES = 15;
+
+	static constexpr uint32_t const NUM_SAMPLES = 128,			// per stage, must be a power of 2
+																	REPORT_INTERVAL = 750,		// ms, per stage
+																	CSV_INTERVAL = 256;				// frames
+
+	typedef struct sStageStats
+	{
+		uint32_t	Samples,
+							Min,
+							P50,
+							P99,
+							Max;			// us
+	} StageStats;
+
+	void Accumulate(uint32_t const Stage, uint32_t const tDelta);
+	void Sample(uint32_t const Stage, uint32_t const tDelta);
+	void EndFrame(uint32_t const tNow);
+
+	char const* const getStageName(uint32_t const Stage);
+	NOINLINE void getStageStats(uint32_t const Stage, StageStats& __restrict Stats);
+
+#ifdef HOST_BUILD
+	NOINLINE bool const ExportCSV(char const* const szPath = nullptr);	// nullptr = PROFILE_CSV environment
+#endif
+
+	template<uint32_t const Stage, bool const bSample = false>
+	struct Scope
+	{
+		uint32_t const tStart;
+
+		__attribute__((always_inline)) inline Scope()
+		: tStart(micros())
+		{}
+		__attribute__((always_inline)) inline ~Scope()
+		{
+			if ( bSample )
+				Sample(Stage, micros() - tStart);
+			else
+				Accumulate(Stage, micros() - tStart);
+		}
+	};
+
+} // end namespace
+
+#define PROFILE_SCOPE_NAME_(line) oProfileScope_##line
+#define PROFILE_SCOPE_NAME(line) PROFILE_SCOPE_NAME_(line)
+#define PROFILE_STAGE(stage) Profiler::Scope<stage> const PROFILE_SCOPE_NAME(__LINE__)
+#define PROFILE_STAGE_SAMPLE(stage) Profiler::Scope<stage, true> const PROFILE_SCOPE_NAME(__LINE__)
+
+#else
+
+#define PROFILE_STAGE(stage)
+#define PROFILE_STAGE_SAMPLE(stage)
+
+#endif /*STAGE_PROFILING*/
+
+#endif /*PROFILER_H*/
@@ -0,0 +1,33 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef VOX_ADJACENCY_BENCHMARK_H
+#define VOX_ADJACENCY_BENCHMARK_H
+#include "globals.h"
+
+#ifdef VOX_ADJACENCY_BENCHMARK
+
+// Benchmark of the .vox adjacency builders (VoxBinary.cpp) for the host build
+// main() loads every model in VOX_BENCH_DIR (environment, default "Data/VOX") and times the linear search (reference),
+// the spatial hash and the occupancy bitmap building the adjacency of every voxel, with both the dynamic and static rules,
+// instead of entering the realtime loop. Every builder must produce the same adjacency and culled voxels as the reference.
+//
+// results: voxels/s per builder and the speedup over the reference, printed and written as csv to VOX_BENCH_CSV
+// (environment, default "vox_adjacency_bench.csv")
+
+namespace VoxAdjacencyBenchmark
+{
+	NOINLINE int const Run();		// returns 0 on success, 1 if a builder does not match the reference
+
+} // end namespace
+
+#endif /*VOX_ADJACENCY_BENCHMARK*/
+
+#endif /*VOX_ADJACENCY_BENCHMARK_H*/
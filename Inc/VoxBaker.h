@@ -0,0 +1,32 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef VOX_BAKER_H
+#define VOX_BAKER_H
+#include "globals.h"
+
+#ifdef VOX_BAKE_MODELS
+
+// Offline baker of the .vox models (VoxBinary.cpp) for the host build
+// main() bakes every model in VOX_BAKE_DIR (environment, default "Data/VOX") to a baked model image (voxelModel.h)
+// written next to it as <model>.vxb, or to VOX_BAKE_OUT (environment) if set, instead of entering the realtime loop.
+// Every image is mapped back (voxB::Map) to validate it.
+//
+// the images are included in flash (INC_BIN.s _vxb_*) and copied as is to FRAM when VOX_BAKED_MODELS is defined
+
+namespace VoxBaker
+{
+	NOINLINE int const Run();		// returns 0 on success, 1 if a model could not be baked
+
+} // end namespace
+
+#endif /*VOX_BAKE_MODELS*/
+
+#endif /*VOX_BAKER_H*/
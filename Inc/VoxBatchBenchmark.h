@@ -0,0 +1,33 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef VOX_BATCH_BENCHMARK_H
+#define VOX_BATCH_BENCHMARK_H
+#include "globals.h"
+
+#ifdef VOX_BATCH_BENCHMARK
+
+// Benchmark of batched voxel model rendering (RenderVoxelModels, VoxBinary.h) for the host build
+// main() initializes the world and loads the models, then renders rings of missiles around the screen centre, each missile
+// by itself (VoxMissile::Render) and all of them in one batch (VoxMissile::RenderBatch), instead of entering the realtime loop.
+// Batches larger than the batch size are split by RenderVoxelModels. The depth buffer is cleared before every repetition.
+//
+// results: us per frame of missiles and the FRAM bytes read per frame (QSPI_FRAM_ACCOUNT_READ), printed and written as
+// csv to VOX_BATCH_CSV (environment, default "vox_batch_bench.csv")
+
+namespace VoxBatchBenchmark
+{
+	NOINLINE int const Run();		// after OLED::Init and DTCM::ScatterLoad, returns 0 on success, 1 if a batch reads more FRAM than its missiles alone
+
+} // end namespace
+
+#endif /*VOX_BATCH_BENCHMARK*/
+
+#endif /*VOX_BATCH_BENCHMARK_H*/
@@ -16,13 +16,14 @@ The VOX File format is Copyright to their respectful owners.
 
 #include "math_3d.h"
 #include "shade_ops.h"
-#include "IsoVoxel.h"
+#include "isoVoxel.h"
 #include "voxelModel.h"
+#include "quadspi.h"
 
 #include <vector>
 
 #ifdef VOX_DEBUG_ENABLED
-#include "debug.cpp"
+#include "Debug.cpp"
 #endif
 	
 
@@ -36,15 +37,51 @@ namespace voxB
 // supporting 16x16x16 (4KB) size voxel model.
 NOINLINE bool const Load( voxelModelBase* const __restrict pDestMem, uint8_t const * const pSourceVoxBinaryData, uint8_t*& __restrict FRAMWritePointer );
 
+// maps the model to a baked model image (voxelModelBakedHeader), nothing is parsed or copied. The header is validated
+// returns the size of the image in bytes, 0 if it is not a valid image for this model
+NOINLINE uint32_t const Map( voxelModelBase* const __restrict pDestMem, uint8_t const * const pBakedImage );
+
+// z slices (voxelModelSlice) of every level of a loaded or mapped model, the voxels are read once (FRAM memory mapped)
+void BuildSlices( voxelModelBase* const __restrict pDestMem );
+
+#ifdef VOX_BAKE_MODELS
+// bakes a .vox model to a baked model image appended to Image, see VoxBaker.h
+bool const Bake( std::vector<uint8_t>& __restrict Image, uint8_t const * const pSourceVoxBinaryData, bool const isDynamic );
+#endif
+
+#ifdef VOX_ADJACENCY_BENCHMARK
+// adjacency builders compared by the host benchmark, see VoxAdjacencyBenchmark.h
+static constexpr uint32_t const ADJACENCY_LINEAR = 0,			// the original O(n²) search, reference
+																ADJACENCY_HASHED = 1,
+																ADJACENCY_BITMAP = 2,
+																NUM_ADJACENCY_BUILDERS = 3;
+static constexpr uint16_t const ADJACENCY_IN = (1 << 8);	// voxel is not culled, the low 8 bits are its adjacency
+
+// adjacency of every voxel of a .vox model in file order, returns the number of voxels (0 if not a supported model)
+// pResults may be nullptr to only get the number of voxels
+uint32_t const BuildAdjacency( uint32_t const Builder, bool const isDynamic, uint8_t const* const pSourceVoxBinaryData, uint16_t* const __restrict pResults );
+#endif
+
 } // end namespace voxB
 
 // ## forward declarations first
 template<Shading::shade_op_default OPTop, Shading::shade_op_default_normal OPSides, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
-STATIC_INLINE void RenderVoxelModel( vec2_t const vObjectOrigin, vec2_rotation_t const vR, voxB::voxelModel<voxB::DYNAMIC> const* const __restrict pModel, float const fAdditionalHeight = 0.0f);																																																
+STATIC_INLINE void RenderVoxelModel( vec2_t const vObjectOrigin, vec2_rotation_t const vR, voxB::voxelModel<voxB::DYNAMIC> const* const __restrict pModel, float const fAdditionalHeight = 0.0f, uint32_t const uiLOD = 0);																																																
 
 template<Shading::shade_op_default OP, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
 STATIC_INLINE void RenderVoxelModel( vec2_t const vObjectOrigin, voxB::voxelModel<voxB::STATIC> const* const __restrict pModel);
 
+#ifdef VOX_IMPOSTOR_CACHE
+// same as the dynamic RenderVoxelModel, drawn from the impostor cache (VoxImpostor.h) when the heading is cached
+template<Shading::shade_op_default OPTop, Shading::shade_op_default_normal OPSides, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+STATIC_INLINE void RenderVoxelModel_Impostor( vec2_t const vObjectOrigin, vec2_rotation_t const vR, voxB::voxelModel<voxB::DYNAMIC> const* const __restrict pModel, float const fAdditionalHeight, uint32_t const uiLOD, uint32_t const tNow );
+#endif
+
+// batches of instances sharing a model, rendered front to back in one pass. Every voxel is read once (FRAM) for the whole batch
+// pAdditionalHeights is per instance, may be nullptr. Every instance of a batch uses the same level of detail
+template<Shading::shade_op_default OPTop, Shading::shade_op_default_normal OPSides, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+STATIC_INLINE void RenderVoxelModels( voxB::voxelModelInstance_Dynamic const* const* const __restrict ppInstances, float const* const __restrict pAdditionalHeights, uint32_t numInstances, uint32_t const uiLOD = 0 );
+
 STATIC_INLINE __attribute__((pure)) bool const isVoxModelInstanceNotVisible( vec2_t vOrigin, float const fRadius );
 } // end namespace
 
@@ -58,7 +95,7 @@ namespace Volumetric
 namespace internal
 {
 	
-	__attribute__((always_inline)) __attribute__((pure)) STATIC_INLINE vec3_t const getPlotPosition(vec3_t const maxDimensions, vec3_t const maxDimensionsInv,
+	__attribute__((always_inline)) STATIC_INLINE vec3_t const getPlotPosition(vec3_t const maxDimensions, vec3_t const maxDimensionsInv,
 																																																	float const fScale,
 																																																  float& __restrict fNormalizedHeightOffset,
 																																																	voxB::voxelDescPacked const* const __restrict pVoxel)
@@ -84,59 +121,239 @@ namespace internal
 		return(vPlotGridSpace);
 	}
 	
+	// screen space extents of a rotated voxel, same for every voxel of an instance
+	__attribute__((always_inline)) STATIC_INLINE void getVoxelRotation( vec2_rotation_t const& __restrict vR, float const fScale, point2D_t& __restrict rotationX, point2D_t& __restrict rotationY )
+	{
+		// rotation is done using floating point, the accurary of the rotation increases tenfold, especially for "small" voxels animation		
+		vec2_rotation_t const vRNegated(-vR - RotationConstants.v45); // rotation is off 45 degrees
+		float const fRadiiScaled = fScale * Iso::VERY_TINY_GRID_FRADII;
+		rotationX = v2_to_p2D_rounded(v2_rotate_screenspace(vRNegated, vec2_t( fRadiiScaled, 0.0f )));
+		rotationY = v2_to_p2D_rounded(v2_rotate_screenspace(vRNegated, vec2_t( 0.0f, fRadiiScaled)));
+	}
+	
+	static constexpr uint32_t const SLICE_CULLED = 0,		// off screen or behind the depth buffer, no voxel is drawn
+																	SLICE_PARTIAL = 1,	// every voxel is tested (getVoxel_IfVisible)
+																	SLICE_INSIDE = 2;		// on screen and within the world, no voxel is tested
+	
+	// conservative screen bounds of every voxel of the slice, same transforms as getPlotPosition and RenderTinyVoxel_Complex
+	// Margin covers the voxel extents, the rooftop / side heights and the AA pixels
+	template<uint32_t const RenderingFlags>
+	__attribute__((pure)) STATIC_INLINE uint32_t const getSliceVisibility( voxB::voxelModelSlice const& __restrict Slice, vec2_t const vObjectOrigin, vec2_rotation_t const& __restrict vR,
+																																			 vec3_t const maxDimensions, float const fScale, float const modelHeightOffset, int32_t const Margin )
+	{
+		float const fGridScale( fScale * Iso::VERY_TINY_GRID_HALF_SCALE );
+		
+		// relative coordinates in [-maxDimensions, maxDimensions] scaled to grid space (getPlotPosition)
+		vec2_t const vMin( __fms(2.0f, (float)Slice.xMin, maxDimensions.x) * fGridScale, __fms(2.0f, (float)Slice.yMin, maxDimensions.y) * fGridScale ),
+								 vMax( __fms(2.0f, (float)Slice.xMax, maxDimensions.x) * fGridScale, __fms(2.0f, (float)Slice.yMax, maxDimensions.y) * fGridScale );
+		vec2_t const vCorners[4] = { vMin, vec2_t(vMax.x, vMin.y), vMax, vec2_t(vMin.x, vMax.y) };
+		
+		point2D_t vScreenMin(INT32_MAX, INT32_MAX), vScreenMax(INT32_MIN, INT32_MIN);
+		bool bInsideWorld(true);
+		
+		#pragma unroll
+		for ( uint32_t iDx = 0 ; iDx < 4 ; ++iDx ) {
+			
+			vec2_t const vGrid( v2_add(v2_rotate(vR, vCorners[iDx]), vObjectOrigin) );
+			point2D_t const vScreen( v2_to_p2D_rounded(world::v2_GridToScreen(vGrid)) );
+			
+			vScreenMin = point2D_t( min(vScreenMin.pt.x, vScreen.pt.x), min(vScreenMin.pt.y, vScreen.pt.y) );
+			vScreenMax = point2D_t( max(vScreenMax.pt.x, vScreen.pt.x), max(vScreenMax.pt.y, vScreen.pt.y) );
+			
+			bInsideWorld &= (nullptr != world::getVoxelAt(vGrid));	// world is rectangular in grid space, slice is convex
+		}
+		
+		// height of the slice above the ground (pixelOffset of RenderTinyVoxel_Complex)
+		float const fHalfRadiiScaled( fScale * Iso::VERY_TINY_GRID_FRADII_HALF );
+		int32_t const yOffset( int32::__roundf(__fms(__fms(2.0f, (float)Slice.z, maxDimensions.z) - modelHeightOffset, fHalfRadiiScaled, fHalfRadiiScaled)) );
+		
+		int32_t const xMin( vScreenMin.pt.x - Margin ), xMax( vScreenMax.pt.x + Margin ),
+									yMin( vScreenMin.pt.y + yOffset - Margin ), yMax( vScreenMax.pt.y + yOffset + Margin );
+		
+		if ( xMax < 0 || yMax < 0 || xMin >= (int32_t)OLED::SCREEN_WIDTH || yMin >= (int32_t)OLED::SCREEN_HEIGHT )
+			return(SLICE_CULLED);
+		
+		// an impostor capture must not depend on what is already drawn
+		if constexpr ( OLED::Z_ENABLE == ((OLED::Z_ENABLE|OLED::IMPOSTOR_CAPTURE) & RenderingFlags) ) {
+			// depth of a voxel is set at its ground position, closest is the bottom of the slice
+			if ( OLED::isOccluded_HiZ(xMin, yMin, xMax, yMax, IsoDepth::getDepthLevel(vScreenMax.pt.y + Margin)) )
+				return(SLICE_CULLED);
+		}
+		
+		if ( bInsideWorld && (xMin | yMin) >= 0 && xMax < (int32_t)OLED::SCREEN_WIDTH && yMax < (int32_t)OLED::SCREEN_HEIGHT )
+			return(SLICE_INSIDE);
+		
+		return(SLICE_PARTIAL);
+	}
+	
 } // end namespace internal
 	
 // ######### static inline definitions only
 template<Shading::shade_op_default OPTop, Shading::shade_op_default_normal OPSides, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
-STATIC_INLINE void RenderVoxelModel( vec2_t const vObjectOrigin, vec2_rotation_t const vR, voxB::voxelModel<voxB::DYNAMIC> const* const __restrict pModel, float const fAdditionalHeight )
+STATIC_INLINE void RenderVoxelModel( vec2_t const vObjectOrigin, vec2_rotation_t const vR, voxB::voxelModel<voxB::DYNAMIC> const* const __restrict pModel, float const fAdditionalHeight, uint32_t const uiLOD )
 {
-	voxB::voxelDescPacked const* __restrict pTraversal( /*pModel->Voxels.data()*/ pModel->VoxelsFRAM );
-	uint32_t numTraverse( pModel->numVoxels );
-	vec3_t const maxDimensions(pModel->maxDimensions), maxDimensionsInv(pModel->maxDimensionsInv);
-	float const modelHeightOffset(maxDimensions.z + fAdditionalHeight),
-							fScale(pModel->Scalar);
+	voxB::voxelModelLOD const Level( pModel->getLOD(uiLOD) );	// decimated levels have proportionally larger voxels, same extents
+	voxB::voxelDescPacked const* __restrict pTraversal( /*pModel->Voxels.data()*/ Level.Voxels );
+	uint32_t numTraverse( Level.numVoxels );
+	vec3_t const maxDimensions(Level.maxDimensions), maxDimensionsInv(Level.maxDimensionsInv);
+	float const modelHeightOffset(maxDimensions.z + fAdditionalHeight * (pModel->Scalar / Level.Scalar)),
+							fScale(Level.Scalar);
 	
 	point2D_t rotationX, rotationY;
+	internal::getVoxelRotation(vR, fScale, rotationX, rotationY);	// rotation is agnostic to coordinate space, can be used for all voxels of model
 	
-	{ // rotation is agnostic to coordinate space, can be used for all voxels of model
-		// rotation is done using floating point, the accurary of the rotation increases tenfold, especially for "small" voxels animation		
-		vec2_rotation_t const vRNegated(-vR - RotationConstants.v45); // rotation is off 45 degrees
-		float const fRadiiScaled = fScale * Iso::VERY_TINY_GRID_FRADII;
-		rotationX = v2_to_p2D_rounded(v2_rotate_screenspace(vRNegated, vec2_t( fRadiiScaled, 0.0f )));
-		rotationY = v2_to_p2D_rounded(v2_rotate_screenspace(vRNegated, vec2_t( 0.0f, fRadiiScaled)));
-	}
+	// whole z slices are culled, only the voxels of slices partially on screen are tested one by one
+	voxB::voxelModelSlice const WholeLevel = { 0, numTraverse, 0, 0, 0, 0, 0 };
+	voxB::voxelModelSlice const* __restrict pSlice( nullptr != Level.Slices ? Level.Slices : &WholeLevel );	// slices not built, every voxel is tested
+	uint32_t numSlices( nullptr != Level.Slices ? Level.numSlices : 1 );
+	int32_t const Margin( int32::__ceilf(fScale * Iso::VERY_TINY_GRID_FRADII * 4.0f) + 2 );
 	
 	do
 	{
-		float fNormalizedHeightOffset;
+		uint32_t const Visibility( nullptr != Level.Slices ? internal::getSliceVisibility<RenderingFlags>(*pSlice, vObjectOrigin, vR, maxDimensions, fScale, modelHeightOffset, Margin)
+																											 : internal::SLICE_PARTIAL );
+		if ( internal::SLICE_CULLED == Visibility ) {
+#ifdef VOX_IMPOSTOR_CACHE
+			if constexpr ( OLED::IMPOSTOR_CAPTURE == (OLED::IMPOSTOR_CAPTURE & RenderingFlags) ) {
+				ImpostorCapture.Rejected += pSlice->numVoxels;
+			}
+#endif
+			continue;
+		}
 		
-		vec3_t vPlotRelative = internal::getPlotPosition(maxDimensions, maxDimensionsInv, fScale, fNormalizedHeightOffset, pTraversal);
+		bool const bInside( internal::SLICE_INSIDE == Visibility );
+		pTraversal = Level.Voxels + pSlice->Start;
+		numTraverse = pSlice->numVoxels;
+		QSPI_FRAM_ACCOUNT_READ(pTraversal, numTraverse * sizeof(voxB::voxelDescPacked));	// only the voxels of slices not culled are streamed from FRAM
 		
-		// currently cordinates are "normalized relative units", can be fractional 
-		// transform by chosen 2D World Coordinates, will now be grid space
+		do
+		{
+			float fNormalizedHeightOffset;
 		
-		// rotate point (skipping subtract origin, rotate, then add origin back in)
-		vec2_t vPlotIsometric = v2_rotate(vR, vec2_t(vPlotRelative));
-		vPlotIsometric = v2_add( vPlotIsometric, vObjectOrigin );
+			vec3_t vPlotRelative = internal::getPlotPosition(maxDimensions, maxDimensionsInv, fScale, fNormalizedHeightOffset, pTraversal);
 		
-		Iso::Voxel const* pVoxelFound(nullptr);
-	
-		if ( nullptr != (pVoxelFound = world::getVoxel_IfVisible(vPlotIsometric)) )	// only within bounds of world and if visible onscreen 
-		{
-			// Transform from GridSpace to ScreenSpace
-			world::RenderTinyVoxel_Complex<OPTop, OPSides, TargetBuffer, RenderingFlags>
-																		( fNormalizedHeightOffset, vPlotRelative.z - modelHeightOffset, fScale,
-																			pTraversal->getAdjAndShade(),
-																		  v2_to_p2D_rounded(  world::v2_GridToScreen( vPlotIsometric ) ), 
-																			rotationX, rotationY );
-		}
+			// currently cordinates are "normalized relative units", can be fractional 
+			// transform by chosen 2D World Coordinates, will now be grid space
 		
-		++pTraversal;
+			// rotate point (skipping subtract origin, rotate, then add origin back in)
+			vec2_t vPlotIsometric = v2_rotate(vR, vec2_t(vPlotRelative));
+			vPlotIsometric = v2_add( vPlotIsometric, vObjectOrigin );
 		
-	} while ( 0 != --numTraverse );
+			if ( bInside || nullptr != world::getVoxel_IfVisible(vPlotIsometric) )	// only within bounds of world and if visible onscreen 
+			{
+				// Transform from GridSpace to ScreenSpace
+				world::RenderTinyVoxel_Complex<OPTop, OPSides, TargetBuffer, RenderingFlags>
+																			( fNormalizedHeightOffset, vPlotRelative.z - modelHeightOffset, fScale,
+																				pTraversal->getAdjAndShade(),
+																			  v2_to_p2D_rounded(  world::v2_GridToScreen( vPlotIsometric ) ), 
+																				rotationX, rotationY );
+			}
+#ifdef VOX_IMPOSTOR_CACHE
+			else if constexpr ( OLED::IMPOSTOR_CAPTURE == (OLED::IMPOSTOR_CAPTURE & RenderingFlags) ) {
+				++ImpostorCapture.Rejected;	// would be missing from the impostor once the model moves
+			}
+#endif
+		
+			++pTraversal;
+		
+		} while ( 0 != --numTraverse );
+		
+	} while ( ++pSlice, 0 != --numSlices );
 
 }
 
+#ifdef VOX_IMPOSTOR_CACHE
+namespace internal
+{
+	// every pixel of the impostor depth tested at the depth level of the voxel that drew it, the neighbours of the
+	// anti-aliasing are blended with the scene, their luma is already scaled by the coverage (captured over black)
+	template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+	STATIC_INLINE void BlitImpostor( VoxImpostor::Impostor const* const __restrict pImpostor, point2D_t const Origin, int32_t const DepthOrigin )
+	{
+		point2D_t const Window( p2D_sub(Origin, point2D_t(VoxImpostor::WIDTH >> 1, VoxImpostor::HEIGHT >> 1)) );
+		
+		// clipped to the screen, the model may have moved since the capture
+		int32_t const xMin( max(pImpostor->xMin, -Window.pt.x) ), xMax( min(pImpostor->xMax, (int32_t)OLED::SCREEN_WIDTH - 1 - Window.pt.x) ),
+									yMin( max(pImpostor->yMin, -Window.pt.y) ), yMax( min(pImpostor->yMax, (int32_t)OLED::SCREEN_HEIGHT - 1 - Window.pt.y) );
+		
+		int32_t LastDepth(VoxImpostor::EMPTY);
+		
+		for ( int32_t y = yMin ; y <= yMax ; ++y )
+		{
+			uint8_t const* const __restrict pLuma( pImpostor->Luma + (y << VoxImpostor::WIDTH_BITS) );
+			uint8_t const* const __restrict pAlpha( pImpostor->Alpha + (y << VoxImpostor::WIDTH_BITS) );
+			depth_t const* const __restrict pDepth( pImpostor->Depth + (y << VoxImpostor::WIDTH_BITS) );
+			uint32_t const* const __restrict pAA( pImpostor->AA + ((y << VoxImpostor::WIDTH_BITS) >> 5) );
+			
+			for ( int32_t x = xMin ; x <= xMax ; ++x )
+			{
+				int32_t const Depth( pDepth[x] );
+				
+				if ( VoxImpostor::EMPTY != Depth ) {
+					
+					if ( Depth != LastDepth ) {	// voxels are mostly drawn in runs of the same depth
+						IsoDepth::NewDepthLevelSet_Fixed(DepthOrigin + Depth);
+						LastDepth = Depth;
+					}
+					
+					uint32_t const xScreen( Window.pt.x + x ), yScreen( Window.pt.y + y ),
+												 Alpha( pAlpha[x] );
+					
+					if ( 0 == (pAA[x >> 5] & (1U << (x & 31))) ) {
+						(void)OLED::LL_DrawPixel<TargetBuffer, RenderingFlags>( xScreen, yScreen, xDMA2D::AlphaLuma((Alpha << 24) | pLuma[x]) );	// as drawn, not replicated
+					}
+					else {	// same as the neighbours of DrawPixelAA, over the scene
+						uint32_t const Transparency( 0xFF - Alpha );
+						xDMA2D::AlphaLuma Scene;
+						
+						if constexpr ( OLED::BACK_BUFFER == TargetBuffer ) {
+							Scene = xDMA2D::AlphaLuma(0xFF, OLED::GetPixel<OLED::BACK_BUFFER>( xScreen, yScreen ));
+						}
+						else {
+							Scene = xDMA2D::AlphaLuma(OLED::GetPixel<OLED::FRONT_BUFFER>( xScreen, yScreen ));
+						}
+						(void)OLED::LL_DrawPixel<TargetBuffer, (RenderingFlags | OLED::BLOOM_DISABLE)>( xScreen, yScreen,
+										xDMA2D::AlphaLuma( Alpha + ((Scene.pixel.Alpha * Transparency) >> 8), pLuma[x] + ((Scene.pixel.Luma * Transparency) >> 8) ) );
+					}
+				}
+			}
+		}
+	}
+	
+} // end namespace internal
+
+template<Shading::shade_op_default OPTop, Shading::shade_op_default_normal OPSides, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+STATIC_INLINE void RenderVoxelModel_Impostor( vec2_t const vObjectOrigin, vec2_rotation_t const vR, voxB::voxelModel<voxB::DYNAMIC> const* const __restrict pModel, float const fAdditionalHeight, uint32_t const uiLOD, uint32_t const tNow )
+{
+	static constexpr float const HEADING_STEP = (2.0f * MathConstants::kPI) / (float)VoxImpostor::NUM_HEADINGS;
+	
+	// vR is not always constructed from an angle (VoxMissile), the heading is the sincos pair
+	uint32_t const uiHeading( ((uint32_t)int32::__roundf(atan2f(vR.s, vR.c) * (1.0f / HEADING_STEP))) & (VoxImpostor::NUM_HEADINGS - 1) );
+	
+	// screen position of the model origin at its altitude, the impostor is relative to it
+	// depth is relative to the ground below the origin, same as the depth level of every voxel
+	point2D_t const vGround( v2_to_p2D_rounded(world::v2_GridToScreen(vObjectOrigin)) );
+	point2D_t const vOrigin( vGround.pt.x, vGround.pt.y - int32::__roundf(fAdditionalHeight * pModel->Scalar * Iso::VERY_TINY_GRID_FRADII_HALF) );
+	int32_t const DepthOrigin( IsoDepth::getFixedDepth(vGround.pt.y, 0) );
+	
+	VoxImpostor::Impostor const* const __restrict pImpostor( VoxImpostor::Find(pModel, uiLOD, uiHeading, tNow) );
+	
+	if ( nullptr != pImpostor ) {
+		internal::BlitImpostor<TargetBuffer, RenderingFlags>(pImpostor, vOrigin, DepthOrigin);
+		return;
+	}
+	
+	// rendered at the quantized heading so that every later frame at this heading matches the impostor
+	float const fHeading( (float)uiHeading * HEADING_STEP );
+	vec2_rotation_t vRQuantized(vR);
+	vRQuantized.vR = vec2_t(cosf(fHeading), sinf(fHeading));
+	
+	VoxImpostor::BeginCapture(pModel, uiLOD, uiHeading, tNow, vOrigin, DepthOrigin);
+	RenderVoxelModel<OPTop, OPSides, TargetBuffer, (RenderingFlags|OLED::IMPOSTOR_CAPTURE)>(vObjectOrigin, vRQuantized, pModel, fAdditionalHeight, uiLOD);
+	VoxImpostor::EndCapture();
+}
+#endif
+
 template<Shading::shade_op_default OP, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
 	STATIC_INLINE void RenderVoxelModel( vec2_t const vObjectOrigin, voxB::voxelModel<voxB::STATIC> const* const __restrict pModel)
 {
@@ -175,6 +392,146 @@ template<Shading::shade_op_default OP, uint32_t const TargetBuffer, uint32_t con
 
 }
 
+namespace internal
+{
+	static constexpr uint32_t const MAX_BATCH = 8;	// instances rendered in one pass, larger batches are split
+	
+	// front to back order of the instances (greatest screen y is closest), the farther instances then mostly fail the depth test early
+	template<typename Instance>
+	STATIC_INLINE void SortInstancesByDepth( Instance const* const* const __restrict ppInstances, uint32_t const numInstances, uint32_t* const __restrict pOrder )
+	{
+		float Depth[MAX_BATCH];
+		
+		for ( uint32_t iDx = 0 ; iDx < numInstances ; ++iDx ) {
+			
+			Depth[iDx] = world::v2_GridToScreen(ppInstances[iDx]->vLoc).y;
+			
+			uint32_t iInsert(iDx);
+			for ( ; iInsert > 0 && Depth[pOrder[iInsert - 1]] < Depth[iDx] ; --iInsert ) {
+				pOrder[iInsert] = pOrder[iInsert - 1];
+			}
+			pOrder[iInsert] = iDx;
+		}
+	}
+	
+} // end namespace internal
+
+template<Shading::shade_op_default OPTop, Shading::shade_op_default_normal OPSides, uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+STATIC_INLINE void RenderVoxelModels( voxB::voxelModelInstance_Dynamic const* const* const __restrict ppInstances, float const* const __restrict pAdditionalHeights, uint32_t numInstances, uint32_t const uiLOD )
+{
+	if ( numInstances > internal::MAX_BATCH ) {
+		RenderVoxelModels<OPTop, OPSides, TargetBuffer, RenderingFlags>( ppInstances + internal::MAX_BATCH, nullptr != pAdditionalHeights ? pAdditionalHeights + internal::MAX_BATCH : nullptr,
+																																		 numInstances - internal::MAX_BATCH, uiLOD );
+		numInstances = internal::MAX_BATCH;
+	}
+	if ( 0 == numInstances )
+		return;
+	
+	voxB::voxelModel<voxB::DYNAMIC> const& __restrict model( ppInstances[0]->model );	// same model for every instance
+	voxB::voxelModelLOD const Level( model.getLOD(uiLOD) );
+	vec3_t const maxDimensions(Level.maxDimensions), maxDimensionsInv(Level.maxDimensionsInv);
+	float const fScale(Level.Scalar);
+	int32_t const Margin( int32::__ceilf(fScale * Iso::VERY_TINY_GRID_FRADII * 4.0f) + 2 );
+	
+	typedef struct sBatchInstance
+	{
+		vec2_rotation_t vR;
+		vec2_t					vOrigin;
+		float						modelHeightOffset;
+		point2D_t				rotationX, rotationY;
+		uint32_t				Visibility;		// of the current slice
+		
+	} BatchInstance;
+	
+	BatchInstance Batch[internal::MAX_BATCH];
+	{
+		uint32_t Order[internal::MAX_BATCH];
+		internal::SortInstancesByDepth(ppInstances, numInstances, Order);
+		
+		for ( uint32_t iDx = 0 ; iDx < numInstances ; ++iDx ) {
+			
+			voxB::voxelModelInstance_Dynamic const& __restrict Instance( *ppInstances[Order[iDx]] );
+			BatchInstance& __restrict Dest( Batch[iDx] );
+			
+			Dest.vR = Instance.vR;
+			Dest.vOrigin = Instance.vLoc;
+			Dest.modelHeightOffset = maxDimensions.z + (nullptr != pAdditionalHeights ? pAdditionalHeights[Order[iDx]] : 0.0f) * (model.Scalar / Level.Scalar);
+			
+			// instances at the same heading share the rotation setup
+			uint32_t iShared(0);
+			while ( iShared < iDx && (Batch[iShared].vR.c != Dest.vR.c || Batch[iShared].vR.s != Dest.vR.s) ) {
+				++iShared;
+			}
+			if ( iShared < iDx ) {
+				Dest.rotationX = point2D_t(Batch[iShared].rotationX);
+				Dest.rotationY = point2D_t(Batch[iShared].rotationY);
+			}
+			else {
+				internal::getVoxelRotation(Dest.vR, fScale, Dest.rotationX, Dest.rotationY);
+			}
+		}
+	}
+	
+	voxB::voxelModelSlice const WholeLevel = { 0, Level.numVoxels, 0, 0, 0, 0, 0 };
+	voxB::voxelModelSlice const* __restrict pSlice( nullptr != Level.Slices ? Level.Slices : &WholeLevel );	// slices not built, every voxel is tested
+	uint32_t numSlices( nullptr != Level.Slices ? Level.numSlices : 1 );
+	
+	do
+	{
+		// a slice is read only if it is visible for any instance
+		bool bAnyVisible(false);
+		
+		for ( uint32_t iDx = 0 ; iDx < numInstances ; ++iDx ) {
+			
+			BatchInstance& __restrict Instance( Batch[iDx] );
+			
+			Instance.Visibility = ( nullptr != Level.Slices ? internal::getSliceVisibility<RenderingFlags>(*pSlice, Instance.vOrigin, Instance.vR, maxDimensions, fScale, Instance.modelHeightOffset, Margin)
+																											: internal::SLICE_PARTIAL );
+			bAnyVisible |= (internal::SLICE_CULLED != Instance.Visibility);
+		}
+		if ( !bAnyVisible )
+			continue;
+		
+		voxB::voxelDescPacked const* __restrict pTraversal( Level.Voxels + pSlice->Start );
+		uint32_t numTraverse( pSlice->numVoxels );
+		QSPI_FRAM_ACCOUNT_READ(pTraversal, numTraverse * sizeof(voxB::voxelDescPacked));	// once for the whole batch
+		
+		do
+		{
+			voxB::voxelDescPacked const Voxel( *pTraversal );	// single read of the voxel
+			uint16_t const AdjAndShade( Voxel.getAdjAndShade() );
+			float fNormalizedHeightOffset;
+			
+			vec3_t const vPlotRelative = internal::getPlotPosition(maxDimensions, maxDimensionsInv, fScale, fNormalizedHeightOffset, &Voxel);
+			
+			for ( uint32_t iDx = 0 ; iDx < numInstances ; ++iDx ) {
+				
+				BatchInstance const& __restrict Instance( Batch[iDx] );
+				
+				if ( internal::SLICE_CULLED == Instance.Visibility )
+					continue;
+				
+				// rotate point (skipping subtract origin, rotate, then add origin back in)
+				vec2_t const vPlotIsometric( v2_add( v2_rotate(Instance.vR, vec2_t(vPlotRelative)), Instance.vOrigin ) );
+				
+				if ( internal::SLICE_INSIDE == Instance.Visibility || nullptr != world::getVoxel_IfVisible(vPlotIsometric) )	// only within bounds of world and if visible onscreen 
+				{
+					// Transform from GridSpace to ScreenSpace
+					world::RenderTinyVoxel_Complex<OPTop, OPSides, TargetBuffer, RenderingFlags>
+																				( fNormalizedHeightOffset, vPlotRelative.z - Instance.modelHeightOffset, fScale,
+																					AdjAndShade,
+																					v2_to_p2D_rounded(  world::v2_GridToScreen( vPlotIsometric ) ), 
+																					Instance.rotationX, Instance.rotationY );
+				}
+			}
+			
+			++pTraversal;
+			
+		} while ( 0 != --numTraverse );
+		
+	} while ( ++pSlice, 0 != --numSlices );
+}
+
 STATIC_INLINE __attribute__((pure)) bool const isVoxModelInstanceNotVisible( vec2_t vOrigin, float const fRadius )
 {
 	vec2_t const vExtent = world::v2_GridToScreen( v2_adds(vOrigin, fRadius) );
@@ -0,0 +1,194 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#ifndef VOX_IMPOSTOR_H
+#define VOX_IMPOSTOR_H
+#include "globals.h"
+#include "Point2D.h"
+#include "isodepth.h"
+
+#ifdef VOX_IMPOSTOR_CACHE
+
+// ### impostor cache of the dynamic voxel models (VOX_IMPOSTOR_CACHE)
+// a model is rendered normally once per quantized heading (NUM_HEADINGS of the vR sincos pair) and level of detail, every pixel
+// it draws is recorded (OLED::IMPOSTOR_CAPTURE) as luma + screen y of the voxel relative to the model origin into an impostor
+// in external sram. The following frames blit the impostor with the depth test instead of rendering every voxel.
+// - lighting is baked in, an impostor is rendered again after MAX_AGE
+// - anti-aliased pixels are recorded as drawn over an empty scene, luma and coverage (alpha), the blit blends the neighbours
+//   of the anti-aliasing with the scene
+// - a model clipped by the screen edges or the window is never cached, it is rendered every frame
+// - 8bit depth stores whole pixels, 16bit depth stores the same 8.8 fixed point screen y that NewDepthLevelSet_Fixed takes
+
+// capture in progress, written by LL_DrawPixel
+extern struct sImpostorCapture
+{
+	uint8_t* __restrict Luma;
+	depth_t* __restrict Depth;				// relative fixed point screen y of the voxel that drew the pixel, EMPTY if not drawn
+	uint8_t* __restrict Alpha;				// alpha as drawn, coverage for the neighbours of the anti-aliasing
+	uint32_t* __restrict AA;					// bit per pixel, set if blended by the anti-aliasing (not the same shade for the early exit)
+
+	point2D_t Origin;									// screen position of the window
+	int32_t   DepthOrigin,						// fixed point screen y of the model origin
+						xMin, yMin, xMax, yMax;	// bounds of the pixels drawn, window coordinates
+	uint32_t  Rejected;								// voxels or pixels missing from the impostor
+
+} ImpostorCapture __attribute__((section (".dtcm")));
+
+namespace VoxImpostor
+{
+	static constexpr uint32_t const NUM_HEADINGS = 32,	// 11.25 degrees
+																	NUM_SLOTS = 4,
+																	WIDTH_BITS = 7,
+																	HEIGHT_BITS = 6,
+																	WIDTH = (1 << WIDTH_BITS),			// window centered on the model origin
+																	HEIGHT = (1 << HEIGHT_BITS),
+																	MAX_AGE = 250;									// ms
+	static constexpr int32_t const EMPTY = IsoDepth::DEPTH_MIN;
+
+	typedef struct sImpostor
+	{
+		uint8_t const* const __restrict Luma;		// [HEIGHT][WIDTH]
+		depth_t const* const __restrict Depth;	//      ""
+		uint8_t const* const __restrict Alpha;	//      ""
+		uint32_t const* const __restrict AA;		// [HEIGHT][WIDTH / 32]
+
+		void const* Model;											// key
+		uint32_t    LOD, Heading;
+
+		uint32_t    tCaptured, tLastUsed;
+		int32_t     xMin, yMin, xMax, yMax;			// bounds of the pixels, window coordinates
+		bool        Valid;
+
+		sImpostor( uint8_t const* const __restrict Luma_, depth_t const* const __restrict Depth_, uint8_t const* const __restrict Alpha_,
+							 uint32_t const* const __restrict AA_ )
+			: Luma(Luma_), Depth(Depth_), Alpha(Alpha_), AA(AA_), Model(nullptr), LOD(0), Heading(0), tCaptured(0), tLastUsed(0),
+			  xMin(0), yMin(0), xMax(WIDTH - 1), yMax(HEIGHT - 1), Valid(false)		// whole window is cleared on first capture
+		{}
+
+	} Impostor;
+
+	// valid impostor of the model at the heading / level of detail that is not older than MAX_AGE, nullptr otherwise
+	Impostor const* const __restrict Find( void const* const Model, uint32_t const uiLOD, uint32_t const uiHeading, uint32_t const tNow );
+
+	// starts capturing to the least recently used slot (or the slot with the same key), Origin / DepthOrigin are the
+	// screen position and fixed point screen y of the model origin
+	void BeginCapture( void const* const Model, uint32_t const uiLOD, uint32_t const uiHeading, uint32_t const tNow,
+										 point2D_t const Origin, int32_t const DepthOrigin );
+	// the impostor is valid only if nothing was rejected and it is not clipped by the screen edges
+	void EndCapture();
+
+	namespace internal
+	{
+		// depth test against the pixels already captured, same as the depth test of LL_DrawPixel
+		template<bool const bAA>
+		__attribute__((always_inline)) STATIC_INLINE void CaptureWrite( int32_t const xWindow, int32_t const yWindow, int32_t const Depth, uint32_t const Alpha, uint32_t const Luma )
+		{
+			uint32_t const uiOffset( (yWindow << WIDTH_BITS) + xWindow );
+
+			if ( Depth >= ImpostorCapture.Depth[uiOffset] ) {
+
+				ImpostorCapture.Depth[uiOffset] = Depth;
+				ImpostorCapture.Alpha[uiOffset] = Alpha;
+				ImpostorCapture.Luma[uiOffset] = Luma;
+				
+				uint32_t const uiBit( 1U << (uiOffset & 31) );
+				if constexpr ( bAA )
+					ImpostorCapture.AA[uiOffset >> 5] |= uiBit;
+				else
+					ImpostorCapture.AA[uiOffset >> 5] &= ~uiBit;
+
+				ImpostorCapture.xMin = min(ImpostorCapture.xMin, xWindow);
+				ImpostorCapture.yMin = min(ImpostorCapture.yMin, yWindow);
+				ImpostorCapture.xMax = max(ImpostorCapture.xMax, xWindow);
+				ImpostorCapture.yMax = max(ImpostorCapture.yMax, yWindow);
+			}
+		}
+		// pixel already captured blended with the anti-aliased pixel, empty is transparent black (cleared front buffer)
+		__attribute__((always_inline)) STATIC_INLINE void CaptureBlend( int32_t const xWindow, int32_t const yWindow, int32_t const Depth, uint32_t const Alpha, uint32_t const Luma )
+		{
+			uint32_t const uiOffset( (yWindow << WIDTH_BITS) + xWindow );
+			uint32_t CurAlpha(0), CurLuma(0);
+
+			if ( EMPTY != ImpostorCapture.Depth[uiOffset] ) {
+				CurAlpha = ImpostorCapture.Alpha[uiOffset];
+				CurLuma = ImpostorCapture.Luma[uiOffset];
+			}
+			CaptureWrite<true>(xWindow, yWindow, Depth, (CurAlpha + Alpha) >> 1, (CurLuma + Luma) >> 1);	// __UHADD8 of DrawPixelAA
+		}
+		__attribute__((always_inline)) STATIC_INLINE int32_t const CaptureDepth()
+		{
+			return( max(EMPTY + 1, __SSAT(IsoDepth_Private.CurSelectedDepth - ImpostorCapture.DepthOrigin, IsoDepth::DEPTH_BITS)) );
+		}
+	} // end namespace internal
+
+	// called by LL_DrawPixel for every pixel drawn while the IMPOSTOR_CAPTURE rendering flag is set, into the impostor
+	// rather than the scene so the impostor does not depend on what is already drawn
+	__attribute__((always_inline)) STATIC_INLINE void CapturePixel( uint32_t const x, uint32_t const y, uint32_t const Alpha, uint32_t const Luma )
+	{
+		int32_t const xWindow( (int32_t)x - ImpostorCapture.Origin.pt.x ),
+									yWindow( (int32_t)y - ImpostorCapture.Origin.pt.y );
+
+		if ( unlikely((uint32_t)xWindow >= WIDTH || (uint32_t)yWindow >= HEIGHT) ) {
+			++ImpostorCapture.Rejected;
+			return;
+		}
+
+		internal::CaptureWrite<false>(xWindow, yWindow, internal::CaptureDepth(), Alpha, Luma);
+	}
+
+	// called by DrawPixelAA, the same anti-aliasing into the impostor as DrawPixelAA into an empty scene
+	// only the luma is compared by the early exit of the back buffer (bLumaOnly)
+	template<bool const bLumaOnly>
+	__attribute__((always_inline)) STATIC_INLINE void CapturePixelAA( uint32_t const x, uint32_t const y, uint32_t const Alpha, uint32_t const Luma )
+	{
+		int32_t const xWindow( (int32_t)x - ImpostorCapture.Origin.pt.x ),
+									yWindow( (int32_t)y - ImpostorCapture.Origin.pt.y );
+
+		if ( unlikely((uint32_t)(xWindow - 1) >= (WIDTH - 2) || (uint32_t)(yWindow - 1) >= (HEIGHT - 2)) ) {	// and the neighbours
+			++ImpostorCapture.Rejected;
+			return;
+		}
+
+		uint32_t const uiOffset( (yWindow << WIDTH_BITS) + xWindow );
+		int32_t const Depth( internal::CaptureDepth() );
+		bool const bEmpty( EMPTY == ImpostorCapture.Depth[uiOffset] );
+
+		// early exit if current pixel is same shade, the front buffer compares the whole pixel
+		if ( bLumaOnly || bEmpty || 0 == (ImpostorCapture.AA[uiOffset >> 5] & (1U << (uiOffset & 31))) ) {
+			if ( (bEmpty ? 0 : ImpostorCapture.Luma[uiOffset]) == Luma && (bLumaOnly || (bEmpty ? 0 : ImpostorCapture.Alpha[uiOffset]) == Alpha) )
+				return;
+		}
+
+		// early exit if current main pixel does not pass
+		if ( Depth < ImpostorCapture.Depth[uiOffset] )
+			return;
+
+		internal::CaptureWrite<false>(xWindow, yWindow, Depth, Alpha, Luma);
+
+		// left, right, top, bottom then the corners, same order as DrawPixelAA
+		int32_t const xSides[4] = { xWindow - 1, xWindow + 1, xWindow, xWindow },
+									ySides[4] = { yWindow, yWindow, yWindow - 1, yWindow + 1 },
+									xCorners[4] = { xWindow - 1, xWindow + 1, xWindow - 1, xWindow + 1 },
+									yCorners[4] = { yWindow - 1, yWindow - 1, yWindow + 1, yWindow + 1 };
+
+		for ( uint32_t iDx = 0 ; iDx < 4 ; ++iDx ) {
+			internal::CaptureBlend(xSides[iDx], ySides[iDx], Depth, Alpha, Luma);
+		}
+		for ( uint32_t iDx = 0 ; iDx < 4 ; ++iDx ) {
+			internal::CaptureBlend(xCorners[iDx], yCorners[iDx], Depth, Alpha, Luma);
+		}
+	}
+
+} // end namespace
+
+#endif /*VOX_IMPOSTOR_CACHE*/
+
+#endif /*VOX_IMPOSTOR_H*/
+
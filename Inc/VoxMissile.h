@@ -28,7 +28,8 @@ typedef struct VoxMissile : Volumetric::voxB::voxelModelInstance_Dynamic
 	
 	bool const isVisible() const;
 	bool const Update( uint32_t const tNow); 
-	void Render() const;
+	void Render( uint32_t const tNow ) const;
+	static void RenderBatch( VoxMissile const* const* const __restrict ppMissiles, uint32_t const numMissiles, uint32_t const tNow );	// visible missiles in one pass
 	
 	static bool const LoadModel();	// to be called init world init, once once!
 	VoxMissile( uint32_t const tNow, vec2_t const worldCoord, vec2_t const worldCoordTarget );
@@ -26,6 +26,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 template <typename T>
 __attribute__((always_inline)) STATIC_INLINE void atomic_set(volatile T* const __restrict ptr, int const set_value) 
 {
+#ifndef HOST_BUILD
   unsigned int old_value_tmp,
 							 strex_result_tmp;
 
@@ -42,10 +43,14 @@ __attribute__((always_inline)) STATIC_INLINE void atomic_set(volatile T* const _
 											 : [ptr]"r"(ptr), 
 												 [set_value]"r"(set_value)
 											 : "cc", "memory");
+#else
+	__atomic_store_n(ptr, (T)set_value, __ATOMIC_SEQ_CST);
+#endif
 }
 template <typename T>
 __attribute__((always_inline)) STATIC_INLINE void atomic_increment(volatile T* const __restrict ptr) 
 {
+#ifndef HOST_BUILD
   unsigned int value_tmp,
 							 strex_result_tmp;
 
@@ -62,10 +67,14 @@ __attribute__((always_inline)) STATIC_INLINE void atomic_increment(volatile T* c
 												 [ptr]"+m"(*ptr)
 											 : [ptr]"r"(ptr)
 											 : "cc", "memory");
+#else
+	__atomic_add_fetch(ptr, (T)1, __ATOMIC_SEQ_CST);
+#endif
 }
 template <typename T>
 __attribute__((always_inline)) STATIC_INLINE void atomic_decrement(volatile T* const __restrict ptr) 
 {
+#ifndef HOST_BUILD
   unsigned int value_tmp,
 							 strex_result_tmp;
 
@@ -82,6 +91,9 @@ __attribute__((always_inline)) STATIC_INLINE void atomic_decrement(volatile T* c
 												 [ptr]"+m"(*ptr)
 											 : [ptr]"r"(ptr)
 											 : "cc", "memory");
+#else
+	__atomic_sub_fetch(ptr, (T)1, __ATOMIC_SEQ_CST);
+#endif
 }
 
 template <class T>
@@ -12,7 +12,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #define COMMONMATH_H
 
 #include "PreprocessorCore.h"
-#include "Globals.h"
+#include "globals.h"
 
 /*
 void layouttemplate(int *src, int *dst, int len) {
@@ -149,7 +149,11 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __fmaxf ( floa
 	// t VFP floating-point registers s0-s31. Used for 32 bit values.
 	// w VFP floating-point registers d0-d31 and the appropriate subset d0-d15 based on command line options. Used for 64 bit values only.
 	
+#ifndef HOST_BUILD
 	__asm("vmaxnm.f32 %0, %0, %1" : "+t" (Sn) : "t" (Sm) );
+#else
+	Sn = fmaxf(Sn, Sm);
+#endif
 	
 	return(Sn);
 }
@@ -162,7 +166,11 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __fminf ( floa
 	// t VFP floating-point registers s0-s31. Used for 32 bit values.
 	// w VFP floating-point registers d0-d31 and the appropriate subset d0-d15 based on command line options. Used for 64 bit values only.
 	
+#ifndef HOST_BUILD
 	__asm("vminnm.f32 %0, %0, %1" : "+t" (Sn) : "t" (Sm) );
+#else
+	Sn = fminf(Sn, Sm);
+#endif
 	
 	return(Sn);
 }
@@ -175,7 +183,11 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __fabsf ( floa
 	// t VFP floating-point registers s0-s31. Used for 32 bit values.
 	// w VFP floating-point registers d0-d31 and the appropriate subset d0-d15 based on command line options. Used for 64 bit values only.
 	
+#ifndef HOST_BUILD
 	__asm("vabs.f32 %0, %0" : "+t" (Sn) );
+#else
+	Sn = fabsf(Sn);
+#endif
 	
 	return(Sn);
 }
@@ -188,7 +200,11 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __sqrtf ( floa
 	// t VFP floating-point registers s0-s31. Used for 32 bit values.
 	// w VFP floating-point registers d0-d31 and the appropriate subset d0-d15 based on command line options. Used for 64 bit values only.
 	
+#ifndef HOST_BUILD
 	__asm("vsqrt.f32 %0, %0" : "+t" (Sn) );
+#else
+	Sn = sqrtf(Sn);
+#endif
 	
 	return(Sn);
 }
@@ -204,7 +220,11 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __fma ( float3
 	// t VFP floating-point registers s0-s31. Used for 32 bit values.
 	// w VFP floating-point registers d0-d31 and the appropriate subset d0-d15 based on command line options. Used for 64 bit values only.
 	
+#ifndef HOST_BUILD
 	__asm("vfma.f32 %0, %1, %2" : "+t" (Sd) : "t" (Sn), "t" (Sm) );
+#else
+	Sd = fmaf(Sn, Sm, Sd);
+#endif
 	
 	return(Sd);
 }
@@ -220,7 +240,11 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __fms ( float3
 	// w VFP floating-point registers d0-d31 and the appropriate subset d0-d15 based on command line options. Used for 64 bit values only.
 	
 	//bugfix, this has to be vfNms to get correct subtraction order... very odd but tested
+#ifndef HOST_BUILD
 	__asm("vfnms.f32 %0, %1, %2" : "+t" (Sd) : "t" (Sn), "t" (Sm) );
+#else
+	Sd = fmaf(Sn, Sm, -Sd);
+#endif
 	
 	return(Sd);
 }
@@ -242,9 +266,13 @@ __attribute__((always_inline)) STATIC_INLINE_PURE int32_t const __roundf(float32
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	// syntax is vcvt(r).#to type#.#from type#
 	
+#ifndef HOST_BUILD
 	__asm("vcvtr.s32.f32 %[tmp], %[Sn] \n\t" 
 				"vmov %[Sd], %[tmp]"
 				: [Sd] "=r" (Sd), [tmp] "=&t" (tmp) : [Sn] "t" (Sn) );
+#else
+	Sd = (int32_t)lrintf(Sn); (void)tmp;
+#endif
 	
 	return(Sd);
 }
@@ -256,9 +284,13 @@ __attribute__((always_inline)) STATIC_INLINE_PURE int32_t const __floorf(float32
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	// syntax is vcvt(m).#to type#.#from type#
 	
+#ifndef HOST_BUILD
 	__asm("vcvtm.s32.f32 %[tmp], %[Sn] \n\t" 
 				"vmov %[Sd], %[tmp]"
 				: [Sd] "=r" (Sd), [tmp] "=&t" (tmp) : [Sn] "t" (Sn) );
+#else
+	Sd = (int32_t)floorf(Sn); (void)tmp;
+#endif
 	
 	return(Sd);
 }
@@ -270,9 +302,13 @@ __attribute__((always_inline)) STATIC_INLINE_PURE int32_t const __ceilf(float32_
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	// syntax is vcvt(p).#to type#.#from type#
 	
+#ifndef HOST_BUILD
 	__asm("vcvtp.s32.f32 %[tmp], %[Sn] \n\t" 
 				"vmov %[Sd], %[tmp]"
 				: [Sd] "=r" (Sd), [tmp] "=&t" (tmp) : [Sn] "t" (Sn) );
+#else
+	Sd = (int32_t)ceilf(Sn); (void)tmp;
+#endif
 	
 	return(Sd);
 }
@@ -293,9 +329,13 @@ __attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const __roundf(float3
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	// syntax is vcvt(r).#to type#.#from type#
 	
+#ifndef HOST_BUILD
 	__asm("vcvtr.u32.f32 %[tmp], %[Sn] \n\t" 
 				"vmov %[Sd], %[tmp]"
 				: [Sd] "=r" (Sd), [tmp] "=&t" (tmp) : [Sn] "t" (Sn) );
+#else
+	Sd = (Sn > 0.0f ? (uint32_t)lrintf(Sn) : 0); (void)tmp;
+#endif
 	
 	return(Sd);
 }
@@ -307,9 +347,13 @@ __attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const __floorf(float3
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	// syntax is vcvt(m).#to type#.#from type#
 	
+#ifndef HOST_BUILD
 	__asm("vcvtm.u32.f32 %[tmp], %[Sn] \n\t" 
 				"vmov %[Sd], %[tmp]"
 				: [Sd] "=r" (Sd), [tmp] "=&t" (tmp) : [Sn] "t" (Sn) );
+#else
+	Sd = (Sn > 0.0f ? (uint32_t)floorf(Sn) : 0); (void)tmp;
+#endif
 	
 	return(Sd);
 }
@@ -321,9 +365,13 @@ __attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const __ceilf(float32
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	// syntax is vcvt(p).#to type#.#from type#
 	
+#ifndef HOST_BUILD
 	__asm("vcvtp.u32.f32 %[tmp], %[Sn] \n\t" 
 				"vmov %[Sd], %[tmp]"
 				: [Sd] "=r" (Sd), [tmp] "=&t" (tmp) : [Sn] "t" (Sn) );
+#else
+	Sd = (Sn > 0.0f ? (uint32_t)ceilf(Sn) : 0); (void)tmp;
+#endif
 	
 	return(Sd);
 }
@@ -342,8 +390,12 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __roundf(float
 	// VRINT - R will round to nearest as already set in FPSCR (at startup), remains as float format
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	
+#ifndef HOST_BUILD
 	__asm("vrintr.f32 %0, %0"
 				: "+t" (Sn) );
+#else
+	Sn = rintf(Sn);
+#endif
 	
 	return(Sn);
 }
@@ -352,8 +404,12 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __floorf(float
 	// VRINT - M will round to negative infinity (M for minus infinity) Directed Rounding, remains as float format
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	
+#ifndef HOST_BUILD
 	__asm("vrintm.f32 %0, %0"
 				          : "+t" (Sn) );
+#else
+	Sn = floorf(Sn);
+#endif
 	
 	return(Sn);
 }
@@ -362,8 +418,12 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __ceilf(float3
 	// VRINT - M will round to positive infinity (P for plus infinity) Directed Rounding, remains as float format
 	// by default a (int)_floatvar_ uses VCVT without R which will round to zero
 	
+#ifndef HOST_BUILD
 	__asm("vrintp.f32 %0, %0"
 				: "+t" (Sn) );
+#else
+	Sn = ceilf(Sn);
+#endif
 	
 	return(Sn);
 }
@@ -376,7 +436,7 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __sfractf(floa
 {
 	return( Sn - float32::__floorf(Sn) );	// faster signed fractional part
 }
-__attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __modf(float32_t const Sn, float32_t& fIntegral) 
+__attribute__((always_inline)) STATIC_INLINE float32_t const __modf(float32_t const Sn, float32_t& fIntegral) 
 {
 	// returns unsigned fractional part, store integral part in fIntegral
 	
@@ -386,27 +446,39 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const __modf(float32
 }
 __attribute__((always_inline)) STATIC_INLINE_PURE float const clampf(float Sn)	// 0.0f => 1.0f clamp, // Cortex M7 Extension
 {
+#ifndef HOST_BUILD
 	__asm("vmaxnm.f32 %0, %0, %1 \n\t" 
 				"vminnm.f32 %0, %0, %2"
 				: "+t" (Sn) : "t" (0.0f), "t" (1.0f) );
+#else
+	Sn = fminf(fmaxf(Sn, 0.0f), 1.0f);
+#endif
 	
 	//return( Sn >= 0.0f && Sn <= 1.0f ? Sn : (float32_t)(Sn > 0.0f) );
 	return( Sn );
 }
 __attribute__((always_inline)) STATIC_INLINE_PURE float const clampf(float Sn, float const Sm)	// 0.0f => B clamp, // Cortex M7 Extension
 {
+#ifndef HOST_BUILD
 	__asm("vmaxnm.f32 %0, %0, %1 \n\t" 
 				"vminnm.f32 %0, %0, %2"
 				: "+t" (Sn) : "t" (0.0f), "t" (Sm) );
+#else
+	Sn = fminf(fmaxf(Sn, 0.0f), Sm);
+#endif
 	
 	//return( Sn >= 0.0f && Sn <= Sm ? Sn : ((float32_t)(Sn > 0.0f))*Sm );
 	return( Sn );
 }
 __attribute__((always_inline)) STATIC_INLINE_PURE float const clampf(float Sn, float const Smin, float const Smax)	// min => max clamp, // Cortex M7 Extension
 {
+#ifndef HOST_BUILD
 	__asm("vmaxnm.f32 %0, %0, %1 \n\t" 
 				"vminnm.f32 %0, %0, %2"
 				: "+t" (Sn) : "t" (Smin), "t" (Smax) );
+#else
+	Sn = fminf(fmaxf(Sn, Smin), Smax);
+#endif
 	//Sn = __fmaxf( Sn, Smin );
 	//Sn = __fminf( Sn, Smax );
 	return( Sn );
@@ -427,11 +499,15 @@ __attribute__((always_inline)) STATIC_INLINE_PURE float32_t const lerp ( float32
 	// = is write only
 	// + is read/write
 	
+#ifndef HOST_BUILD
 	__asm("vneg.f32 %[tmp], %[tNorm] \n\t"				// s3 = -tNorm
 				"vfma.f32 %[A], %[tmp], %[A] \n\t"		// A = A + (-tNorm * A)
 				"vfma.f32 %[A], %[tNorm], %[B]"					// A = A + (tNorm * b)
 				: [A] "+t" (A), [tmp] "=&t" (tmp)
 				: [tNorm] "t" (tNorm), [B] "t" (B) );
+#else
+	A = fmaf(tNorm, B, fmaf(-tNorm, A, A)); (void)tmp;
+#endif
 	
 	//A = __fma(tNorm, B, __fma(-tNorm, A, A));
 	return(A);
@@ -11,7 +11,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #ifndef EXTERNsdfMULTI_H
 #define EXTERNsdfMULTI_H
 
-#include "FLASH\SDF_13_Header_JPEG.h"
+#include "FLASH/SDF_13_Header_JPEG.h"
 
 /////
 
@@ -35,6 +35,8 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #define UserButton_Blue_GPIO_Port GPIOC
 
 //#define ENABLE_SKULL
+//#define DEPTH_SPANS		// per column span encoded depth for DrawVLine, see DTCM::DepthSpans
+//#define DEPTH_16BIT		// 16bit depth levels, see IsoDepth::depth_t (DepthBuffer 16KB -> 32KB, moved out of DTCM)
 
 enum eLED
 {
@@ -151,9 +153,13 @@ __attribute__((always_inline)) STATIC_INLINE void swap(T& __restrict pA, T& __re
 */
  __attribute__((always_inline)) STATIC_INLINE uint32_t const micros()
 {
+#ifndef HOST_BUILD
 	static constexpr uint32_t const CLOCKSPEED_SCALED = CLOCKSPEED / 1e6;
 	
 	return( millis() * 1000 + 1000 - SysTick->VAL / CLOCKSPEED_SCALED );
+#else
+	return( Host_Micros() );	// wall clock, see Host.h
+#endif
 }
 
 #endif  // __cplusplus
@@ -10,7 +10,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #ifndef ISOVOXEL_H
 #define ISOVOXEL_H
-#include "point2D.h"
+#include "Point2D.h"
 
 namespace Iso
 {
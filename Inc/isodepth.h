@@ -11,13 +11,21 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #ifndef ISODEPTH_H
 #define ISODEPTH_H
 #include "globals.h"
-#include "point2D.h"
+#include "Point2D.h"
 #include "DMA2D.hpp"
 
+// depth level stored in DepthBuffer
+// 8bit: screen y normalized by the frame range (y / DynamicRangeMax), saturating below -DynamicRangeMax
+// 16bit: whole frame range [DynamicRangeMin, DynamicRangeMax] in 8.8 fixed point screen y + screen x in the fraction,
+//        structures at the same screen y are ordered by x instead of by draw order
+#ifdef DEPTH_16BIT
+typedef int16_t depth_t;
+#else
+typedef int8_t depth_t;
+#endif
+
 extern struct sIsoDepth_Private
 {
-uint32_t FogShade;
-	
 int32_t  FogDynamicRangeMin,
 				 FogDynamicRangeMax,
 				 CurFogDensityRangeMin, 
@@ -28,21 +36,48 @@ int32_t CurSelectedDepthLevel,
 							 DynamicRangeMax,
 							 CurFrameRangeMin,
 							 CurFrameRangeMax;
+#ifdef VOX_IMPOSTOR_CACHE
+int32_t CurSelectedDepth;					// fixed point screen y of the selected depth level, recorded by an impostor capture (VoxImpostor.h)
+#endif
 
 float	InvDynamicRangeDepthLength,
 			FogInvDynamicRangeLength;
+#ifdef DEPTH_16BIT
+float	LevelScale16;						// fixed point screen y - DynamicRangeMin => depth level
+#endif
 
 vec3_t vEyePt;
 
 } IsoDepth_Private __attribute__((section (".dtcm")));
+
+// fog lookup tables, rebuilt by UpdateDynamicRange only when the depth range (and so the eye point) changes
+// read once per pixel by the deferred fog pass (World PostProcess_Fog)
+extern struct sFogLUT
+{
+	static constexpr uint32_t const NUM_DEPTH_LEVELS = 256,	// every depth level [-128, 127] NewDepthLevelSet can select (top 8 bits when 16bit)
+																	NUM_EXTINCTION = 256;			// exp(-x) sampled over [0, EXTINCTION_MAX]
+	static constexpr uint32_t const SHADE_BITS = 4,					// lighting shade (back buffer luma) bucket size
+																	NUM_SHADES = (256 >> SHADE_BITS) + 1;	// +1 for the lerp at full luma
+	static constexpr float const EXTINCTION_MAX = 8.0f;			// exp(-8) is below 1/255
+	
+	float		Exp[NUM_EXTINCTION + 1];							// +1 for the lerp at EXTINCTION_MAX
+	int16_t	ScreenY[NUM_DEPTH_LEVELS];						// screen y of the base of an object at the depth level
+	uint8_t	Density[NUM_DEPTH_LEVELS],						// fog density [0, 255]
+					Shade[NUM_DEPTH_LEVELS][NUM_SHADES];	// fog luma over a lighting shade
+	
+} FogLUT;
  
 
 namespace IsoDepth
 {     
     static constexpr bool const DEPTH_TEST_FAIL = false,
                                 DEPTH_TEST_PASS = true;
+		
+		static constexpr uint32_t const DEPTH_BITS = sizeof(depth_t) << 3,
+																		DEPTH_FRACTION_BITS = DEPTH_BITS - 8;	// sub pixel bits of the screen y passed to NewDepthLevelSet_Fixed
+		static constexpr int32_t const DEPTH_MIN = -(1 << (DEPTH_BITS - 1)),	// cleared depth, farthest
+																	 DEPTH_MAX = (1 << (DEPTH_BITS - 1)) - 1;
      
-		__attribute__((always_inline)) __attribute__((pure)) STATIC_INLINE uint32_t const getActiveFogShade() { return(IsoDepth_Private.FogShade); }
 		__attribute__((always_inline)) __attribute__((pure)) STATIC_INLINE int32_t const getCurSelectedDepth() { return(IsoDepth_Private.CurSelectedDepthLevel); }
     __attribute__((always_inline)) __attribute__((pure)) STATIC_INLINE int32_t const getDynamicRangeMin() { return(IsoDepth_Private.DynamicRangeMin); }
     __attribute__((always_inline)) __attribute__((pure)) STATIC_INLINE int32_t const getDynamicRangeMax() { return(IsoDepth_Private.DynamicRangeMax); }
@@ -50,10 +85,7 @@ namespace IsoDepth
 		NOINLINE void Init();
     NOINLINE void UpdateDynamicRange();	// CALLED DURING PARALLEL DMA2D OP, noinline WORKS FINE HERE
 		
-    STATIC_INLINE void 										UpdateActiveFogShade(vec3_t const vPoint, float const fLightingShade);
 		xDMA2D::AlphaLuma const 							getFogShadeAtPixel( uint32_t const pixelCoordX, uint32_t const pixelCoordY );
-		STATIC_INLINE void 										setActiueFogShade( xDMA2D::AlphaLuma const FogShade ) { IsoDepth_Private.FogShade = FogShade.v; }
-		STATIC_INLINE void 										ResetActiveFogShade() { IsoDepth_Private.FogShade = 0; };
 				
 		__attribute__((always_inline)) STATIC_INLINE float const getDistance(int32_t const Depth = IsoDepth_Private.CurSelectedDepthLevel )
     {
@@ -66,59 +98,111 @@ namespace IsoDepth
 			return( ((float)((int32_t)FogAlpha - (int32_t)IsoDepth_Private.FogDynamicRangeMin) * IsoDepth_Private.FogInvDynamicRangeLength) );
 		}
 		
-		__attribute__((always_inline)) STATIC_INLINE void NewDepthLevelSet(int32_t NewDepth)
+		// depth level NewDepthLevelSet_Fixed would select, without selecting it or tracking the frame range
+		// Depth is screen y in fixed point with DEPTH_FRACTION_BITS
+		__attribute__((always_inline)) STATIC_INLINE int32_t const getDepthLevel_Fixed(int32_t const Depth)
     { 
+#ifdef DEPTH_16BIT
+			// whole frame range mapped to [DEPTH_MIN, DEPTH_MAX], only saturates outside of the last frames range
+			return( __SSAT(int32::__roundf((float)(Depth - (IsoDepth_Private.DynamicRangeMin << DEPTH_FRACTION_BITS)) * IsoDepth_Private.LevelScale16) + DEPTH_MIN, 16) );
+#else
 			// for expanding the range/gradient to max and min that is possible
-			NewDepth = __SSAT(NewDepth, 8);
-			IsoDepth_Private.CurSelectedDepthLevel = __SSAT(int32::__roundf(getDistance(NewDepth) * Constants::nf127), 8);
+			return( __SSAT(int32::__roundf(getDistance(__SSAT(Depth, 8)) * Constants::nf127), 8) );
+#endif
+		}
+		// screen y + x in the fraction, x orders objects at the same screen y when there are fractional bits (16bit)
+		__attribute__((always_inline)) STATIC_INLINE_PURE int32_t const getFixedDepth(int32_t const Depth, int32_t const ScreenX)
+    { 
+			if constexpr ( 0 != DEPTH_FRACTION_BITS ) {
+				// x is [0, 255] onscreen, keep the top bit of the fraction clear so it never reaches the next pixel
+				return( (__SSAT(Depth, 8) << DEPTH_FRACTION_BITS) | (__USAT(ScreenX, OLED::Width_SATBITS) >> (9 - DEPTH_FRACTION_BITS)) );
+			}
+			return( __SSAT(Depth, 8) );
+		}
+		// depth level NewDepthLevelSet would select, Depth is screen y
+		__attribute__((always_inline)) STATIC_INLINE int32_t const getDepthLevel(int32_t const Depth)
+    { 
+			return( getDepthLevel_Fixed(__SSAT(Depth, 8) << DEPTH_FRACTION_BITS) );
+		}
+		__attribute__((always_inline)) STATIC_INLINE int32_t const getDepthLevel(int32_t const Depth, int32_t const ScreenX)
+    { 
+			return( getDepthLevel_Fixed(getFixedDepth(Depth, ScreenX)) );
+		}
+		// screen y of a depth level as a fraction of DynamicRangeMax, same meaning as getDistance for 8bit levels
+		__attribute__((always_inline)) STATIC_INLINE float const getLevelDistance(int32_t const DepthLevel)
+    { 
+#ifdef DEPTH_16BIT
+			return( (((float)(DepthLevel - DEPTH_MIN) / IsoDepth_Private.LevelScale16) * (1.0f / (float)(1 << DEPTH_FRACTION_BITS)) + (float)IsoDepth_Private.DynamicRangeMin)
+							* IsoDepth_Private.InvDynamicRangeDepthLength );
+#else
+			return( getDistance(DepthLevel) );
+#endif
+		}
+		// [0, 255] of a depth level, indexes FogLUT and the light cluster slices
+		__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getLevelIndex(int32_t const DepthLevel)
+		{
+			return( (uint32_t)((DepthLevel >> DEPTH_FRACTION_BITS) - INT8_MIN) );
+		}
+		
+		// Depth is screen y in fixed point with DEPTH_FRACTION_BITS
+		__attribute__((always_inline)) STATIC_INLINE void NewDepthLevelSet_Fixed(int32_t NewDepth)
+    { 
+			NewDepth = __SSAT(NewDepth, DEPTH_BITS);
+			IsoDepth_Private.CurSelectedDepthLevel = getDepthLevel_Fixed(NewDepth);
+#ifdef VOX_IMPOSTOR_CACHE
+			IsoDepth_Private.CurSelectedDepth = NewDepth;
+#endif
 			
-      // Update min/max current frame trackingrange
-      IsoDepth_Private.CurFrameRangeMin = min(IsoDepth_Private.CurFrameRangeMin, NewDepth);
-      IsoDepth_Private.CurFrameRangeMax = max(IsoDepth_Private.CurFrameRangeMax, NewDepth);
+      // Update min/max current frame trackingrange (whole pixels)
+      IsoDepth_Private.CurFrameRangeMin = min(IsoDepth_Private.CurFrameRangeMin, NewDepth >> DEPTH_FRACTION_BITS);
+      IsoDepth_Private.CurFrameRangeMax = max(IsoDepth_Private.CurFrameRangeMax, NewDepth >> DEPTH_FRACTION_BITS);
+    }
+		// Depth is screen y
+		__attribute__((always_inline)) STATIC_INLINE void NewDepthLevelSet(int32_t const NewDepth)
+    { 
+			NewDepthLevelSet_Fixed(__SSAT(NewDepth, 8) << DEPTH_FRACTION_BITS);
+    }
+		// Depth is screen y, see getFixedDepth
+		__attribute__((always_inline)) STATIC_INLINE void NewDepthLevelSet(int32_t const NewDepth, int32_t const ScreenX)
+    { 
+			NewDepthLevelSet_Fixed(getFixedDepth(NewDepth, ScreenX));
     }
 		
-		// reads and writes global memory, only place this is called should be Lighting::Shade - which is a ramfunc
-		__attribute__((always_inline)) STATIC_INLINE void UpdateActiveFogShade(vec3_t const vPoint, float const fLightingShade)
+		// exp(-x) by table lookup and lerp, x >= 0
+		__attribute__((always_inline)) STATIC_INLINE_PURE float const getFogExtinction(float const x)
 		{
-			static constexpr float const FOG_SHADE_MAX = 0.5f;	// Fog Color
-			static constexpr float const C = 0.55f,	// Found with stepping valu debugly
-																	 B = -0.38f; // importanmt to negate
+			static constexpr float const SCALE = (float)sFogLUT::NUM_EXTINCTION / sFogLUT::EXTINCTION_MAX;
 			
-			float fFogAlpha, fInScattering;
+			float const fIndex( clampf(x * SCALE, (float)sFogLUT::NUM_EXTINCTION) );
+			uint32_t const uiIndex( (uint32_t)fIndex );	// truncation == floor, always positive
 			
-			{
-				float fogDistance(0.0f);   // fog distance is accurate do not scale
-				vec3_t const vViewRay = v3_normalize(v3_sub(vPoint, IsoDepth_Private.vEyePt), &fogDistance);
-				fogDistance = __fma(getDistance(), 0.5f, fogDistance);
-				
-				fInScattering = (1.0f - ARM__expf(fogDistance*vViewRay.y*B)/vViewRay.y);
-
-				fFogAlpha = clampf( (C * ARM__expf(IsoDepth_Private.vEyePt.y*B)) * fInScattering);
-			}
+			if ( unlikely(uiIndex >= sFogLUT::NUM_EXTINCTION) )
+				return( FogLUT.Exp[sFogLUT::NUM_EXTINCTION] );
 			
-			float fFogShade;
-			{
-				float const FogLighting = ARM__expf(-fLightingShade*(fInScattering)*fFogAlpha) + 0.8f;
-				
-				//float const Noise = Noise::getBlueNoiseSample( vec2_t(vPoint.x, vPoint.z) ); noise is limited to the midpoint or height of a single voxel block
-				// needs to be per pixel to get effect
-				fFogShade = mix(fLightingShade, FogLighting, fFogAlpha);
-			}
+			return( lerp(FogLUT.Exp[uiIndex], FogLUT.Exp[uiIndex + 1], fIndex - (float)uiIndex) );
+		}
 		
-			int32_t const FogAlpha( int32::__roundf(fFogAlpha * Constants::nf255) );
+		// [0, 255] fog density of a depth level (getLevelIndex), relative to the fog density range of the last frame
+		// reads and writes global memory, the range for the next frame is tracked here
+		__attribute__((always_inline)) STATIC_INLINE uint32_t const getFogDensity(uint32_t const uiLevel)
+		{
+			int32_t const FogAlpha( FogLUT.Density[uiLevel] );
 			
 			// Update min/max current frame trackingrange
 			IsoDepth_Private.CurFogDensityRangeMin = min( IsoDepth_Private.CurFogDensityRangeMin, FogAlpha );
 			IsoDepth_Private.CurFogDensityRangeMax = max( IsoDepth_Private.CurFogDensityRangeMax, FogAlpha );
 			
-			// combine results and saturate the faster way
-			Pixels oAlphaLuma( int32::__roundf(getDensity(FogAlpha) * Constants::nf255), int32::__roundf(fFogShade * Constants::nf255) );
-			oAlphaLuma.Saturate();
-	
-			// packing saturated result, and returning in required uint32_t ARGB format
-			IsoDepth_Private.FogShade = xDMA2D::AlphaLuma(oAlphaLuma.pixel.Alpha, 
-																										oAlphaLuma.pixel.Luma
-																									 ).v;
+			return( __USAT( int32::__roundf(getDensity(FogAlpha) * Constants::nf255), Constants::SATBIT_256) );
+		}
+		// fog luma of a depth level (getLevelIndex) over the lighting shade Luma [0, 255] drawn at the pixel
+		__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getFogLuma(uint32_t const uiLevel, uint32_t const Luma)
+		{
+			uint8_t const* const __restrict Shade( FogLUT.Shade[uiLevel] );
+			
+			uint32_t const uiBucket( Luma >> sFogLUT::SHADE_BITS );
+			int32_t const Fraction( Luma & ((1 << sFogLUT::SHADE_BITS) - 1) );
+			
+			return( Shade[uiBucket] + ((((int32_t)Shade[uiBucket + 1] - (int32_t)Shade[uiBucket]) * Fraction) >> sFogLUT::SHADE_BITS) );
 		}
 } // end namespace
 #endif
\ No newline at end of file
@@ -38,6 +38,7 @@ uint32_t const Start_Decode(uint8_t const* const srcJPEG_MemoryBuffer,
 int32_t const IsReady( uint32_t const idJPEG);
 uint32_t const getCurrentMCUBlockIndex();
 uint32_t const getCurrentMCUTotalNb();
+uint32_t const getLastDecodeDuration();	// microseconds of cpu time spent decoding the last completed jpeg (software decoder only, 0 otherwise)
 												
 //void GetInfo( JPEG_ConfTypeDef const*& pInfo );											 
 
@@ -164,7 +164,7 @@ STATIC_INLINE_PURE float  const v3_length     (vec3_t const v);
 STATIC_INLINE_PURE float const  v3_distanceSquared(vec3_t const vDisplacement);
 STATIC_INLINE_PURE vec3_t const v3_normalize_fast  (vec3_t const v);
 STATIC_INLINE_PURE vec3_t const v3_normalize  (vec3_t const v);
-STATIC_INLINE_PURE vec3_t const v3_normalize  (vec3_t const v, float* const __restrict pLength) __attribute__((__nonnull__(2)));
+STATIC_INLINE vec3_t const v3_normalize  (vec3_t const v, float* const __restrict pLength) __attribute__((__nonnull__(2)));	// not pure, writes the length
 STATIC_INLINE_PURE vec3_t const v3_lerp(vec3_t const a, vec3_t const b, float const t);
 
 STATIC_INLINE_PURE vec3_t const v3_proj  (vec3_t const v, vec3_t const onto);
@@ -201,7 +201,7 @@ STATIC_INLINE_PURE float  const v2_length(vec2_t const v);
 STATIC_INLINE_PURE float const  v2_distanceSquared(vec2_t const vDisplacement);
 STATIC_INLINE_PURE vec2_t const v2_normalize_fast(vec2_t const v);
 STATIC_INLINE_PURE vec2_t const v2_normalize(vec2_t const v);
-STATIC_INLINE_PURE vec2_t const v2_normalize(vec2_t const v, float* const __restrict pLength) __attribute__((__nonnull__(2)));
+STATIC_INLINE vec2_t const v2_normalize(vec2_t const v, float* const __restrict pLength) __attribute__((__nonnull__(2)));	// not pure, writes the length
 STATIC_INLINE_PURE vec2_t const v2_lerp(vec2_t const a, vec2_t const b, float const t);
 	
 //
@@ -360,7 +360,7 @@ STATIC_INLINE_PURE vec2_t const v2_normalize(vec2_t const v) {
 	else
 		return( vec2_t() );
 }
-__attribute__((__nonnull__(2))) STATIC_INLINE_PURE vec2_t const v2_normalize(vec2_t const v, float* const __restrict pLength) {
+__attribute__((__nonnull__(2))) STATIC_INLINE vec2_t const v2_normalize(vec2_t const v, float* const __restrict pLength) {
 	
 	float const fNorm = v2_norm(v);
 	
@@ -432,7 +432,7 @@ STATIC_INLINE_PURE vec3_t const v3_normalize(vec3_t const v) {
 	else
 		return( vec3_t() );
 }
-__attribute__((__nonnull__(2))) STATIC_INLINE_PURE vec3_t const v3_normalize(vec3_t const v, float* const __restrict pLength) {
+__attribute__((__nonnull__(2))) STATIC_INLINE vec3_t const v3_normalize(vec3_t const v, float* const __restrict pLength) {
 	
 	float const fNorm = v3_norm(v);
 	
@@ -15,7 +15,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "oled.h"
 #include "commonmath.h"
 
-#include "FRAM\FRAM_SDF_MemoryLayout.h"
+#include "FRAM/FRAM_SDF_MemoryLayout.h"
 
 static constexpr uint32_t const NOISE_TEXTURE_SATBITS = Constants::SATBIT_256,
 																NOISE_TEXTURE_DIMENSION = (1 << NOISE_TEXTURE_SATBITS),
@@ -80,6 +80,20 @@ namespace Noise
 	template<typename T = uint8_t>
 	STATIC_INLINE T const getBlueNoiseSample(vec2_t const uv)
 	{
+#ifdef QSPI_FRAM_SOFTWARE_EMULATOR
+		{ // bilinear, the 2x2 texels actually read (FRAM), same texel selection as textureSampleBilinear_1D
+			vec2_t const st( v2_fract(uv) );
+			int32_t const x0( __USAT((int32_t)__fma(st.x, (float)NOISE_TEXTURE_DIMENSION, Constants::nfNegativePoint5), NOISE_TEXTURE_SATBITS) ),
+										y0( __USAT((int32_t)__fma(st.y, (float)NOISE_TEXTURE_DIMENSION, Constants::nfNegativePoint5), NOISE_TEXTURE_SATBITS) ),
+										x1( __USAT(x0 + 1, NOISE_TEXTURE_SATBITS) ),
+										y1( __USAT(y0 + 1, NOISE_TEXTURE_SATBITS) );
+			
+			QSPI_FRAM_ACCOUNT_READ(BlueNoise_x256 + (y0 << NOISE_TEXTURE_SATBITS) + x0, x1 - x0 + 1);
+			if ( y1 != y0 ) {
+				QSPI_FRAM_ACCOUNT_READ(BlueNoise_x256 + (y1 << NOISE_TEXTURE_SATBITS) + x0, x1 - x0 + 1);
+			}
+		}
+#endif
 		return( OLED::Texture::textureSampleBilinear_1D<T, NOISE_TEXTURE_SATBITS, OLED::Texture::WRAP, uint8_t>(BlueNoise_x256, uv) );
 	}
 	template<typename T = uint8_t>
@@ -16,10 +16,11 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_ll_gpio.h"
 #include "spi.h"
 #include "font.h"
-#include "Commonmath.h"
+#include "commonmath.h"
 #include "math_3d.h"
 #include "DTCM_Reserve.h"
 #include "isodepth.h"
+#include "VoxImpostor.h"
 #include "shade_ops.h"
 
 
@@ -33,9 +34,51 @@ namespace DTCM
 		__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
 		__attribute__((section (".dtcm.FrontBuffer")));
 
-	extern int8_t	DepthBuffer[OLED::SCREEN_WIDTH][OLED::SCREEN_HEIGHT] 	// 90 dsgree rotation in memory
+#ifdef DEPTH_16BIT
+	// 32KB does not fit in DTCM with the other buffers, SRAM1 (cached)
+	extern depth_t	DepthBuffer[OLED::SCREEN_WIDTH][OLED::SCREEN_HEIGHT] 	// 90 dsgree rotation in memory
+		__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
+		__attribute__((section (".bss.DepthBuffer")));
+#else
+	extern depth_t	DepthBuffer[OLED::SCREEN_WIDTH][OLED::SCREEN_HEIGHT] 	// 90 dsgree rotation in memory
 		__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
 		__attribute__((section (".dtcm.DepthBuffer")));
+#endif
+
+	// hierarchical depth (Hi-Z), farthest (minimum) depth level stored in every 8x8 and 32x32 tile of DepthBuffer
+	// same 90 degree rotation as DepthBuffer. Tiles are flagged dirty per drawn rectangle (MarkHiZ) or all at once (InvalidateHiZ),
+	// never per pixel, and only rescanned when tested, a 32x32 tile is valid when none of its 16 8x8 tiles are dirty
+	// depth writes only ever raise a level, so a tile not flagged yet is conservative - it never rejects a visible rectangle
+	extern struct sDepthHiZ
+	{
+		static constexpr uint32_t const FINE_BITS = 3,		// 8x8
+																		COARSE_BITS = 5,	// 32x32
+																		FINE_X = OLED::SCREEN_WIDTH >> FINE_BITS, FINE_Y = OLED::SCREEN_HEIGHT >> FINE_BITS,
+																		COARSE_X = OLED::SCREEN_WIDTH >> COARSE_BITS, COARSE_Y = OLED::SCREEN_HEIGHT >> COARSE_BITS,
+																		FINE_PER_COARSE = 1 << (COARSE_BITS - FINE_BITS);
+		
+		depth_t		Farthest8[FINE_X][FINE_Y],
+							Farthest32[COARSE_X][COARSE_Y];
+		uint32_t	Dirty8[COARSE_X];		// one word per column of 32x32 tiles, bit = (fine x & 3) * FINE_Y + fine y
+		
+	} DepthHiZ __attribute__((section (".dtcm")));
+
+#ifdef DEPTH_SPANS
+	// span encoded depth, every column is a sorted list of (end, depth) runs covering the whole column
+	// DepthBuffer is still written (AA pixels, Hi-Z, post processing and GoldenFrame read it per pixel), the spans let DrawVLine
+	// test & write a whole line with one compare per span. A column with more than MAX_SPANS runs is marked overflowed (Count = 0)
+	// and uses the per pixel depth test until the next clear
+	extern struct sDepthSpans
+	{
+		static constexpr uint32_t const MAX_SPANS = 16;
+		
+		uint8_t		End[OLED::SCREEN_WIDTH][MAX_SPANS];		// exclusive, the last span of a column always ends at SCREEN_HEIGHT
+		depth_t		Depth[OLED::SCREEN_WIDTH][MAX_SPANS];
+		uint8_t		Count[OLED::SCREEN_WIDTH];
+		uint8_t		Stale[OLED::SCREEN_WIDTH];			// raised by single pixels since built, rebuilt from DepthBuffer by the next line test
+		
+	} DepthSpans;
+#endif
 
 #define getBackBuffer() BackBuffer
 #define getFrontBuffer() FrontBuffer
@@ -105,8 +148,8 @@ namespace OLED
 	static constexpr uint32_t const SHADE_ENABLE = (1 << 0), // intended for complex shading enabling, or simple flag when not using zbuffer only
 																	Z_ENABLE = (1 << 1),
 																	ZWRITE_ENABLE = (1 << 2),
-																	FOG_ENABLE = (1 << 3),
-																	BLOOM_DISABLE = (1 << 4);
+																	BLOOM_DISABLE = (1 << 4),	// (1 << 3) was per pixel fog, fog is a deferred pass over the depth buffer now (World PostProcess_Fog)
+																	IMPOSTOR_CAPTURE = (1 << 5);	// every pixel is also recorded to the impostor being captured (VOX_IMPOSTOR_CACHE, VoxImpostor.h)
 	
 	typedef struct sRenderSync
 	{
@@ -145,6 +188,8 @@ __attribute__((pure)) __attribute__((assume_aligned(ARMV7M_DCACHE_LINESIZE))) ex
 uint32_t const getStringPixelLength(char const* const szString);
 
 STATIC_INLINE void setDepthLevel( int32_t const NewLevel );
+STATIC_INLINE void setDepthLevel( int32_t const NewLevel, int32_t const ScreenX );
+void FillDepth( depth_t* const __restrict pDepth, int32_t const DepthLevel, uint32_t const Count );	// memset for any depth_t
 
 void setActiveFont( FontType const* const oFontType );
 	
@@ -161,6 +206,20 @@ void TestPixels(uint32_t const& tNow);
 void RenderBloomHDRBuffer();
 void RenderDepthBuffer();
 
+// hierarchical depth test of a screen rectangle (inclusive), true if every pixel would fail the depth test at DepthLevel
+bool const isOccluded_HiZ( int32_t const xMin, int32_t const yMin, int32_t const xMax, int32_t const yMax, int32_t const DepthLevel );
+void MarkHiZ( int32_t const xMin, int32_t const yMin, int32_t const xMax, int32_t const yMax );	// rectangle drawn (inclusive)
+void ClearHiZ();				// depth buffer cleared
+void InvalidateHiZ();		// depth buffer written anywhere
+
+#ifdef DEPTH_SPANS
+void ClearDepthSpans();			// depth buffer cleared
+void RebuildDepthSpans();		// depth buffer written outside of LL_DrawPixel / DrawVLine
+void RefreshDepthSpans( uint32_t const x );	// column marked stale by LL_DrawPixel
+// bit per row in [yBegin, yEnd) that passes the depth test at DepthLevel, bWrite also updates the spans, DepthBuffer and Hi-Z
+uint64_t const TestDepthSpans( uint32_t const x, uint32_t const yBegin, uint32_t const yEnd, int32_t const DepthLevel, bool const bWrite );
+#endif
+
 void RenderCopy32bitScreenLayerAsync(uint32_t* const __restrict p32bitLayerDst, uint32_t const* const __restrict p32bitLayerSrc);
 void RenderCopy8bitScreenLayerAsync(uint8_t* const __restrict p8bitLayerDst, uint8_t const* const __restrict p8bitLayerSrc);
 void RenderCopy32bitScreenLayer(uint32_t* const __restrict p32bitLayerDst, uint32_t const* const __restrict p32bitLayerSrc);
@@ -329,6 +388,10 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 	{		
 		IsoDepth::NewDepthLevelSet(NewLevel);
 	}
+	STATIC_INLINE void setDepthLevel( int32_t const NewLevel, int32_t const ScreenX ) // objects at the same depth are ordered by x when depth has the precision (DEPTH_16BIT)
+	{		
+		IsoDepth::NewDepthLevelSet(NewLevel, ScreenX);
+	}
 	STATIC_INLINE void setDepthLevel_ToFarthest( int32_t const DepthModifier = 0 ) // takes a signed number to increase / decrease depth to be set
 	{		
 		IsoDepth::NewDepthLevelSet(IsoDepth::getDynamicRangeMin() + DepthModifier ); // positive being closer, negative farther
@@ -338,7 +401,7 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 		IsoDepth::NewDepthLevelSet(IsoDepth::getDynamicRangeMax() + DepthModifier ); // positive being closer, negative farther
 	}
 	
-	STATIC_INLINE_PURE bool const TestStrict_Not_OnScreen(point2D_t pixel) 
+	STATIC_INLINE_PURE bool const TestStrict_Not_OnScreen(point2D_t const pixel) 
 	{
 		// zero based tests (performance)
 		
@@ -350,11 +413,11 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 			// Continue and verify not greater than screen bounds
 			
 			// Test case, outside bounds right | bottom
-			pixel = p2D_sub( point2D_t(OLED::SCREEN_WIDTH, OLED::SCREEN_HEIGHT), pixel );
+			point2D_t const result( p2D_sub( point2D_t(OLED::SCREEN_WIDTH, OLED::SCREEN_HEIGHT), pixel ) );
 			
 			// If either component is negative, the point was greater than screen bounds
 			//test the sign bit if it exists
-			return((pixel.pt.x | pixel.pt.y) < 0); // returning zero for successfully tested, point is onscreen
+			return((result.pt.x | result.pt.y) < 0); // returning zero for successfully tested, point is onscreen
 		}
 			
 		return(true); 
@@ -475,9 +538,15 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 	template<uint32_t const TargetBuffer = OLED::BACK_BUFFER, uint32_t const RenderingFlags = (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE)>
 	 __attribute__((always_inline)) STATIC_INLINE bool const LL_DrawPixel( uint32_t const x, uint32_t const y, xDMA2D::AlphaLuma const AlphaLuma )
 	{
+#ifdef VOX_IMPOSTOR_CACHE
+		if constexpr (IMPOSTOR_CAPTURE == (IMPOSTOR_CAPTURE & RenderingFlags)) // before the depth test, the impostor does not depend on the scene
+		{
+			VoxImpostor::CapturePixel(x, y, OLED::BACK_BUFFER == TargetBuffer ? 0xFF : AlphaLuma.pixel.Alpha, AlphaLuma.pixel.Luma);
+		}
+#endif
 		if constexpr (Z_ENABLE == (Z_ENABLE & RenderingFlags)) // statically evaluated addition of code @ compile time
 		{
-			int8_t* const __restrict pDepthBuffer
+			depth_t* const __restrict pDepthBuffer
 				__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))(&DTCM::getDepthBuffer()[x][y]);
 			
 			int32_t const CurDepth(*pDepthBuffer),
@@ -491,6 +560,11 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 			else if constexpr ( ZWRITE_ENABLE == (ZWRITE_ENABLE & RenderingFlags) ) {
 				// update stored depth value to "greater" depth currently selected
 				*pDepthBuffer = CurSelectedDepth;
+#ifdef DEPTH_SPANS
+				if ( CurSelectedDepth != CurDepth ) {
+					DTCM::DepthSpans.Stale[x] = 1;	// batched, column rebuilt once by the next line test
+				}
+#endif
 				// fallthrough to below and draw pixel to appropriate buffer
 			}
 		}
@@ -506,21 +580,19 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 			if constexpr ( BLOOM_DISABLE != (BLOOM_DISABLE & RenderingFlags) )
 				LL_DrawBloomHDRPixel<TargetBuffer>(x, y, AlphaLuma);
 		}
-		
-		if constexpr ( FOG_ENABLE == (FOG_ENABLE & RenderingFlags) )
-		{
-			uint32_t const FogShade = IsoDepth::getActiveFogShade();
-			
-			if ( 0 != FogShade ) {
-				DTCM::getFrontBuffer()[y][x] = FogShade;		// Fog will overwrite frontbuffer, FOG_ENABLE Rendering flag
-			}
-		}
 		return(IsoDepth::DEPTH_TEST_PASS);
 	}
 	
 	template<uint32_t const RenderingFlags = (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE)>
 	__attribute__((always_inline)) STATIC_INLINE void DrawPixelAA_BackBuffer( uint32_t const x, uint32_t const y, xDMA2D::AlphaLuma const Luma )
 	{
+#ifdef VOX_IMPOSTOR_CACHE
+		if constexpr (IMPOSTOR_CAPTURE == (IMPOSTOR_CAPTURE & RenderingFlags)) { // anti-aliased into the impostor over an empty scene, the neighbours are not captured from the scene
+			VoxImpostor::CapturePixelAA<true>(x, y, 0xFF, Luma.pixel.Luma);
+			DrawPixelAA_BackBuffer<(RenderingFlags & ~IMPOSTOR_CAPTURE)>(x, y, Luma);
+			return;
+		}
+#endif
 		// early reject / exit if current pixel is same shade -- speedup
 		if (GetPixel<OLED::BACK_BUFFER>( x, y ) == Luma.pixel.Luma)
 			return;
@@ -574,6 +646,13 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 	template<uint32_t const RenderingFlags = (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE)>
 	__attribute__((always_inline)) STATIC_INLINE void DrawPixelAA_FrontBuffer( uint32_t const x, uint32_t const y, xDMA2D::AlphaLuma const AlphaLuma )
 	{
+#ifdef VOX_IMPOSTOR_CACHE
+		if constexpr (IMPOSTOR_CAPTURE == (IMPOSTOR_CAPTURE & RenderingFlags)) { // anti-aliased into the impostor over an empty scene, the neighbours are not captured from the scene
+			VoxImpostor::CapturePixelAA<false>(x, y, AlphaLuma.pixel.Alpha, AlphaLuma.pixel.Luma);
+			DrawPixelAA_FrontBuffer<(RenderingFlags & ~IMPOSTOR_CAPTURE)>(x, y, AlphaLuma);
+			return;
+		}
+#endif
 		// early reject / exit if current pixel is same shade -- speedup
 		if (GetPixel<OLED::FRONT_BUFFER>( x, y ) == AlphaLuma.v)
 			return;
@@ -581,13 +660,13 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 		// early reject all antialiasing if current main pixel does not pass
 		if constexpr ( Z_ENABLE == (Z_ENABLE & RenderingFlags) ) // statically evaluated 
 		{
-			if ( IsoDepth::DEPTH_TEST_FAIL == DrawPixel_DepthTestResult<OLED::FRONT_BUFFER, ((SHADE_ENABLE | RenderingFlags) & ~FOG_ENABLE)>( x, y, AlphaLuma ))
+			if ( IsoDepth::DEPTH_TEST_FAIL == DrawPixel_DepthTestResult<OLED::FRONT_BUFFER, (SHADE_ENABLE | RenderingFlags)>( x, y, AlphaLuma ))
 				return;
 		}
 		else
 		{
 			// just draw
-			DrawPixel<OLED::FRONT_BUFFER, ((SHADE_ENABLE | RenderingFlags) & ~FOG_ENABLE)>( x, y, AlphaLuma );
+			DrawPixel<OLED::FRONT_BUFFER, (SHADE_ENABLE | RenderingFlags)>( x, y, AlphaLuma );
 		}
 		PixelsQuad const pixLevelAlpha(AlphaLuma.pixel.Alpha), // isolate alpha and replicate 4 times
 										 pixLevelLuma(AlphaLuma.pixel.Luma);   //    ""   luma   ""   ""      ""  ""
@@ -617,10 +696,10 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 				pixLRTB_Luma.v = __UHADD8(pixLRTB_Luma.v, pixLevelLuma.v);
 			}
 			// must always enable Z for "additional" pixels drawn for AA
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( oLeftRight.pixels.p0, y, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p0, pixLRTB_Luma.pixels.p0).v );
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( oLeftRight.pixels.p1, y, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p1, pixLRTB_Luma.pixels.p1).v );
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( x, oTopBottom.pixels.p0, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p2, pixLRTB_Luma.pixels.p2).v );
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( x, oTopBottom.pixels.p1, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p3, pixLRTB_Luma.pixels.p3).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( oLeftRight.pixels.p0, y, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p0, pixLRTB_Luma.pixels.p0).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( oLeftRight.pixels.p1, y, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p1, pixLRTB_Luma.pixels.p1).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( x, oTopBottom.pixels.p0, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p2, pixLRTB_Luma.pixels.p2).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( x, oTopBottom.pixels.p1, xDMA2D::AlphaLuma(pixLRTB_Alpha.pixels.p3, pixLRTB_Luma.pixels.p3).v );
 		}	
 		
 		{
@@ -646,10 +725,10 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 			}
 			
 			// must always enable Z for "additional" pixels drawn for AA
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( oLeftRight.pixels.p0, oTopBottom.pixels.p0, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p0, pixTLTRBLBR_Luma.pixels.p0).v );
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( oLeftRight.pixels.p1, oTopBottom.pixels.p0, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p1, pixTLTRBLBR_Luma.pixels.p1).v );
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( oLeftRight.pixels.p0, oTopBottom.pixels.p1, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p2, pixTLTRBLBR_Luma.pixels.p2).v );
-			DrawPixel<OLED::FRONT_BUFFER,((RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE)) & ~FOG_ENABLE)>( oLeftRight.pixels.p1, oTopBottom.pixels.p1, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p3, pixTLTRBLBR_Luma.pixels.p3).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( oLeftRight.pixels.p0, oTopBottom.pixels.p0, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p0, pixTLTRBLBR_Luma.pixels.p0).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( oLeftRight.pixels.p1, oTopBottom.pixels.p0, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p1, pixTLTRBLBR_Luma.pixels.p1).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( oLeftRight.pixels.p0, oTopBottom.pixels.p1, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p2, pixTLTRBLBR_Luma.pixels.p2).v );
+			DrawPixel<OLED::FRONT_BUFFER,(RenderingFlags | (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE|BLOOM_DISABLE))>( oLeftRight.pixels.p1, oTopBottom.pixels.p1, xDMA2D::AlphaLuma(pixTLTRBLBR_Alpha.pixels.p3, pixTLTRBLBR_Luma.pixels.p3).v );
 		}
 	}
 	
@@ -713,11 +792,62 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 	
 	
 	
+#ifdef DEPTH_SPANS
+	// true if the column spans can replace the per pixel depth test
+	__attribute__((always_inline)) STATIC_INLINE bool const isDepthSpansValid( uint32_t const x )
+	{
+		if ( DTCM::DepthSpans.Stale[x] ) {
+			RefreshDepthSpans(x);
+		}
+		return( 0 != DTCM::DepthSpans.Count[x] );	// not overflowed
+	}
+	
+	// whole line depth tested (and written) against the column spans, only the rows that pass are drawn
+	template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+	__attribute__((always_inline)) STATIC_INLINE void DrawVLine_Spans( uint32_t const x, uint32_t y, uint32_t Height, xDMA2D::AlphaLuma const AlphaLuma )
+	{
+		uint64_t const Rows( TestDepthSpans(x, y, y + Height, IsoDepth::getCurSelectedDepth(), ZWRITE_ENABLE == (ZWRITE_ENABLE & RenderingFlags)) );
+		
+		if ( 0 == Rows )
+			return;	// completely occluded
+		
+		// depth of passing rows is already written, so the per pixel test of the AA pixels passes for them as before
+		if ( (Rows >> y) & 1 ) {
+			DrawPixelAA<TargetBuffer, RenderingFlags>( x, y, AlphaLuma ); // first
+		}
+		
+		if ( 0 != --Height )	// Single pixel case, don't want to draw second AA pixel
+		{
+			uint32_t const yLast(y + Height);
+			
+			for ( uint64_t Interior(Rows >> ++y) ; y < yLast && 0 != Interior ; ++y, Interior >>= 1 )
+			{
+				if ( Interior & 1 ) {
+					DrawPixel<TargetBuffer, RenderingFlags & ~(Z_ENABLE|ZWRITE_ENABLE)>( x, y, AlphaLuma );
+				}
+			}
+			
+			if ( (Rows >> yLast) & 1 ) {
+				DrawPixelAA<TargetBuffer, RenderingFlags>( x, yLast, AlphaLuma ); // last
+			}
+		}
+	}
+#endif
+	
 	template<uint32_t const TargetBuffer = OLED::BACK_BUFFER, uint32_t const RenderingFlags = (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE)>
 	__ramfunc inline void DrawVLine( uint32_t const x, uint32_t y, uint32_t Height, xDMA2D::AlphaLuma const AlphaLuma )
 	{
 		Height = min(Height, OLED::SCREEN_HEIGHT - y);	// OLED::SCREEN_HEIGHT - y will never be zero if checked
 		
+#ifdef DEPTH_SPANS
+		if constexpr ( Z_ENABLE == ((Z_ENABLE|IMPOSTOR_CAPTURE) & RenderingFlags) ) {	// occluded rows of a capture still need to be recorded
+			if ( isDepthSpansValid(x) ) {
+				DrawVLine_Spans<TargetBuffer, RenderingFlags>( x, y, Height, AlphaLuma );
+				return;
+			}
+		}
+#endif
+		
 		// only first and last pixekl need anti-aliasing (edges)
 		DrawPixelAA<TargetBuffer, RenderingFlags>( x, y, AlphaLuma ); // first
 		
@@ -753,7 +883,7 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 		//if (descMask.Mirrored)
 		//	return( ((uint8_t)*(descMask.Mask + (y * descMask.Stride) + (descMask.Stride - 1 - x))) );
 		//else
-			return( ((uint8_t)*(descMask.Mask + (y * descMask.Stride) + x)) );
+			return( ((uint8_t)*(descMask.Mask + (int32_t)((y * descMask.Stride) + x))) );	// offset can be negative (wraps on 32bit)
 	}
 
 	template<uint32_t const RenderingFlags = (SHADE_ENABLE|Z_ENABLE|ZWRITE_ENABLE)>
@@ -786,6 +916,42 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 
 		xDMA2D::AlphaLuma MixedAlphaLuma( (AlphaLuma.v * getMaskPixel(xMask, yMask, descMask)) >> 8 );
 
+#ifdef DEPTH_SPANS
+		if constexpr ( Z_ENABLE == ((Z_ENABLE|IMPOSTOR_CAPTURE) & RenderingFlags) ) {	// same as DrawVLine_Spans, one depth test for the whole line
+			if ( isDepthSpansValid(x) ) {
+				
+				uint64_t const Rows( TestDepthSpans(x, y, y + RunHeight, IsoDepth::getCurSelectedDepth(), ZWRITE_ENABLE == (ZWRITE_ENABLE & RenderingFlags)) );
+				
+				if ( 0 == Rows )
+					return;	// completely occluded
+				
+				if ( (Rows >> y) & 1 ) {
+					DrawPixelAA<OLED::BACK_BUFFER, RenderingFlags>(x, y, MixedAlphaLuma); // first
+				}
+				
+				if (0 != --RunHeight)
+				{
+					uint32_t const yLast(y + RunHeight);
+					
+					++y; ++yMask;
+					for ( uint64_t Interior(Rows >> y) ; y < yLast ; ++y, ++yMask, Interior >>= 1 )
+					{
+						if ( Interior & 1 ) {
+							MixedAlphaLuma.v = (AlphaLuma.v * getMaskPixel(xMask, yMask, descMask)) >> 8;
+							DrawPixel<OLED::BACK_BUFFER, RenderingFlags & ~(Z_ENABLE|ZWRITE_ENABLE)>(x, y, MixedAlphaLuma);
+						}
+					}
+					
+					if ( (Rows >> yLast) & 1 ) {
+						MixedAlphaLuma.v = (AlphaLuma.v * getMaskPixel(xMask, yMask, descMask)) >> 8;
+						DrawPixelAA<OLED::BACK_BUFFER, RenderingFlags>(x, yLast, MixedAlphaLuma); // last
+					}
+				}
+				return;
+			}
+		}
+#endif
+
 		// only first and last pixekl need anti-aliasing (edges)
 		DrawPixelAA<OLED::BACK_BUFFER, RenderingFlags>(x, y, MixedAlphaLuma); // first
 
@@ -870,15 +1036,16 @@ void Render8bitScreenLayer_Front(uint8_t const* __restrict p8bitLayerA, uint32_t
 		 if ( 0 == (DeltaY = Y1 - Y0) ) {
 				/* Horizontal line */
 			 if (CheckHLine( __USAT(min(X0, X1), OLED::Width_SATBITS), __USAT(Y0, OLED::Height_SATBITS), DeltaX)) {
-				DrawHLine<TargetBuffer, RenderingFlags>( __USAT(min(X0, X1), OLED::Width_SATBITS), __USAT(Y0, OLED::Height_SATBITS), DeltaX);
+				DrawHLine<TargetBuffer, RenderingFlags>( __USAT(min(X0, X1), OLED::Width_SATBITS), __USAT(Y0, OLED::Height_SATBITS), DeltaX, AlphaLuma.v);
 			 }
 			 return;
 		 }
 		 if ( 0 == DeltaX ) {
 				/* Vertical line */
 			 if (CheckVLine( X0, min(Y0, Y1), absolute(DeltaY))) {
-				DrawVLine<TargetBuffer, RenderingFlags>(X0, min(Y0, Y1), absolute(DeltaY));
+				DrawVLine<TargetBuffer, RenderingFlags>(X0, min(Y0, Y1), absolute(DeltaY), AlphaLuma);
 			 }
+			 return;
 		 }
 
 		/* Draw the initial pixel, which is always exactly intersected by
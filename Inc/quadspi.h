@@ -10,7 +10,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #ifndef __quadspi_H
 #define __quadspi_H
 
-#include "PreProcessorCore.h"
+#include "PreprocessorCore.h"
 #include "stm32f7xx_hal_msp.h"
 
 //#define DUAL_MODE_ENABLED
@@ -75,7 +75,11 @@ namespace QuadSPI_FRAM
 	uint32_t const ProgramFRAM(uint32_t& NbBytesProgrammed, ProgrammingDesc const programmingDesc);
 	uint32_t const VerifyFRAM(uint32_t& NbBytesVerified, uint32_t const& NbBytesExpectedProgrammed, uint8_t const* Address, ProgrammingDesc const programmedList);
 	
+#ifndef QSPI_FRAM_SOFTWARE_EMULATOR
 	__attribute__((pure)) bool const IsWriteMemoryComplete();
+#else
+	bool const IsWriteMemoryComplete();	// completion is time based in the emulator, must be re-evaluated every poll
+#endif
 	uint32_t const WriteEnable();
 	uint32_t const WriteMemory(uint8_t const* const pDataOut, uint32_t const Address, uint32_t const NbBytes);
 	uint32_t const WriteDisable();
@@ -86,6 +90,48 @@ namespace QuadSPI_FRAM
 /* USER CODE END Private defines */
 
 NOINLINE void Init(void);
+
+#ifdef QSPI_FRAM_SOFTWARE_EMULATOR
+// Host build replacement for the FRAM on the QSPI bus (see quadspi_soft.cpp)
+// The FRAM contents are a file (QSPI_FRAM_IMAGE environment variable, or QSPI_FRAM_IMAGE_DEFAULT) mapped shared
+// so anything programmed persists between runs exactly as it does on the non-volatile part. The read view is mapped
+// readonly at QUADSPI_ADDRESS so the fixed FRAM addresses (BlueNoise_x256, SDF layers) resolve unmodified,
+// writes go thru WriteMemory only, a stray write thru QSPI_Address faults the same as the MPU region on target.
+//
+// Memory mapped reads cannot be trapped, so the bus model only sees what is reported with QSPI_FRAM_ACCOUNT_READ
+// at the places that stream from FRAM. Each report is costed as uncached cache line fills, an upper bound of the
+// bus time on target, where the dcache absorbs repeated reads.
+#ifndef QSPI_FRAM_IMAGE_DEFAULT
+#define QSPI_FRAM_IMAGE_DEFAULT "FRAM.bin"
+#endif
+
+namespace Soft
+{
+	static constexpr uint32_t const DEFAULT_BUS_CLOCK = 43200000,		// HCLK / 5, see Init()
+																	DEFAULT_DATA_LINES = 1;					// READMEM / WRITEMEM are single line
+	
+	typedef struct sBusStats
+	{
+		uint32_t	BytesRead,
+							BytesWritten,
+							Bursts,						// cache line fills (reads) + write commands
+							BusTime_us,				// modelled time the bus was occupied
+							AccessWhileAsleep;	// reads reported while the FRAM was sleeping, garbage on target
+	} BusStats;
+	
+	void AccountRead(uint8_t const* const Address, uint32_t const NbBytes);
+	void SetBusModel(uint32_t const BusClockHz, uint32_t const DataLines);
+	
+	BusStats const& EndFrame();				// latches the current frame's counters and starts a new frame
+	BusStats const& getLastFrameStats();
+	BusStats const& getTotalStats();	// since Init, includes the startup (LoadAllModels, SDF) traffic
+	
+} // end namespace
+
+#define QSPI_FRAM_ACCOUNT_READ(Address, NbBytes) QuadSPI_FRAM::Soft::AccountRead((uint8_t const* const)(Address), (NbBytes))
+#else
+#define QSPI_FRAM_ACCOUNT_READ(Address, NbBytes)
+#endif
 	
 template <uint32_t const RegionNumber>
 void MPU_Config()
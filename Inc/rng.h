@@ -11,7 +11,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #define __rng_H
 
 #include "PreprocessorCore.h"
-#include "..\..\superrandom\superrandom_exports.h"
+#include "../SuperRandom/superrandom_exports.h"
 
 /* Includes ------------------------------------------------------------------*/
 
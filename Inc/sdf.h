@@ -49,7 +49,7 @@ void RenderSignedDistanceField(uint8_t * const __restrict RenderBuffer,
 template<uint32_t const Orientation = Orient_Normal, bool const Inverted = false>
 void RenderSignedDistanceField_DMA2D(uint8_t * const __restrict RenderBuffer, uint8_t const * const __restrict p2DSDF,
 																					SignedDistanceFieldParams const * const __restrict Config);
-#include "..\src\sdf.cpp"
+#include "../Src/sdf.cpp"
 																				
 #endif
 
@@ -12,7 +12,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #define SHADE_OPS_H
 
 #include "math_3d.h"
-#include "point2d.h"
+#include "Point2D.h"
 
 namespace Shading
 {
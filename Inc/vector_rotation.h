@@ -11,8 +11,8 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #define VECTOR_ROTATION_H
 #include "commonmath.h"
 #include "arm_optimized_math.h"
-#include "point2D.h"
-#include "IsoVoxel.h"
+#include "Point2D.h"
+#include "isoVoxel.h"
 
 struct vec2_rotation_t {
 
@@ -127,16 +127,16 @@ STATIC_INLINE_PURE vec2_t const v2_rotate(vec2_rotation_t const angle, vec2_t co
 }
 
 /// #### the following functions operate in any given "space" used, rotating with respect to an origin
-STATIC_INLINE_PURE point2D_t const p2D_rotate(vec2_rotation_t const angle, point2D_t p, point2D_t const origin)
+STATIC_INLINE_PURE point2D_t const p2D_rotate(vec2_rotation_t const angle, point2D_t const p, point2D_t const origin)
 {
 	// translate point back to origin:
-	p = p2D_sub(p, origin);
+	point2D_t const pRelative(p2D_sub(p, origin));
 
 	// rotate point
-	p = p2D_rotate(angle, p);
+	point2D_t const pRotated(p2D_rotate(angle, pRelative));
 
 	// translate point back:
-	return(p2D_add(p, origin));
+	return(p2D_add(pRotated, origin));
 }
 
 STATIC_INLINE_PURE vec2_t const v2_rotate(vec2_rotation_t const angle, vec2_t p, vec2_t const origin)
@@ -165,16 +165,16 @@ STATIC_INLINE_PURE vec2_t const v2_rotate_screenspace(vec2_rotation_t const angl
 					                     __fma(p.x, angle.s, p.y * angle.c))));
 }
 
-STATIC_INLINE_PURE point2D_t const p2D_rotate_screenspace(vec2_rotation_t const angle, point2D_t p, point2D_t const origin)
+STATIC_INLINE_PURE point2D_t const p2D_rotate_screenspace(vec2_rotation_t const angle, point2D_t const p, point2D_t const origin)
 {
 	// translate point back to origin:
-	p = p2D_sub(p, origin);
+	point2D_t const pRelative(p2D_sub(p, origin));
 
 	// rotate point
-	p = p2D_rotate_screenspace(angle, p);
+	point2D_t const pRotated(p2D_rotate_screenspace(angle, pRelative));
 
 	// translate point back:
-	return(p2D_add(p, origin));
+	return(p2D_add(pRotated, origin));
 }
 
 STATIC_INLINE_PURE vec2_t const v2_rotate_screenspace(vec2_rotation_t const angle, vec2_t p, vec2_t const origin)
@@ -13,15 +13,15 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #include "commonmath.h"
 #include "math_3d.h"
-#include "point2D.h"
-#include "IsoVoxel.h"
+#include "Point2D.h"
+#include "isoVoxel.h"
 #include "oled.h"
 #include "world.h"
 
 #include <float.h>
 #include <vector>
 
-#include "debug.cpp"
+#include "Debug.cpp"
 //#define DEBUG_RANGE 
 
 namespace Volumetric
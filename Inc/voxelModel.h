@@ -118,6 +118,62 @@ namespace voxB
 		
 	} voxelModelDescHeader;
 	
+	// ### baked voxel model image (.vxb), made offline from a .vox by the host baker (see VoxBaker.h) and mapped as is from FRAM by Map
+	// header, followed by the voxel array of each level of detail. Level 0 is the full detail model identical to Load,
+	// level n is the model decimated to cells of 2^n voxels rendered 2^n times larger
+	static constexpr uint32_t const BAKED_MAGIC = 0x31425856,		// "VXB1"
+																	BAKED_VERSION = 1,
+																	MAX_LODS = 3;								// full detail + 2 decimated levels
+	
+	typedef struct __attribute__((packed)) voxelModelBakedLOD
+	{
+		uint32_t Offset;															// of the voxel array from the beginning of the image (4 byte aligned)
+		uint32_t numVoxels;														// culled, z sorted, adjacency resolved, shade is the gray level
+		uint8_t  dimensionX, dimensionY, dimensionZ;	// maximum coordinate, eg.) 7 for a level 8 voxels wide
+		uint8_t  reserved;
+		
+	} voxelModelBakedLOD;
+	
+	typedef struct __attribute__((packed)) voxelModelBakedHeader
+	{
+		uint32_t 						Magic;
+		uint16_t 						Version;
+		uint8_t  						isDynamic,
+												numLODs;
+		uint32_t 						SizeInBytes;					// of the whole image, the next image follows
+		uint8_t  						BoundsMin[3],					// of the full detail voxels
+												BoundsMax[3];
+		uint8_t  						reserved[2];
+		uint8_t  						GrayLevels[256];			// palette index to gray level, already applied to every level
+		voxelModelBakedLOD	LOD[MAX_LODS];
+		
+	} voxelModelBakedHeader;
+	static_assert( 0 == (sizeof(voxelModelBakedHeader) & 3), "voxels following the baked header must be 4 byte aligned" );
+	
+	// run of the voxels at the same .z (voxels are sorted by .z), with the .x .y bounds of the run
+	// the renderer culls a whole slice off screen or behind the depth buffer
+	typedef struct voxelModelSlice
+	{
+		uint32_t 		Start,							// index of the first voxel of the slice in its level
+								numVoxels;
+		uint8_t  		xMin, yMin,
+								xMax, yMax,
+								z;
+		
+	} voxelModelSlice;
+	
+	typedef struct voxelModelLOD
+	{
+		voxelDescPacked const* __restrict   Voxels;
+		uint32_t 		numVoxels;
+		vec3_t 			maxDimensionsInv;
+		vec3_t 			maxDimensions;
+		float				Scalar;
+		voxelModelSlice const* __restrict   Slices;	// nullptr until BuildSlices
+		uint32_t 		numSlices;
+		
+	} voxelModelLOD;
+	
 	typedef struct voxelModelBase
 	{		
 		std::vector<voxelDescPacked>	VoxelsTemp;
@@ -128,8 +184,25 @@ namespace voxB
 		float const	Scalar;
 		bool const	isDynamic_;
 		
+		voxelModelLOD	LOD[MAX_LODS - 1];	// decimated levels 1 ... numLODs - 1, only a baked model (Map) has any
+		uint32_t			numLODs;
+		
+		std::vector<voxelModelSlice>	SliceTable;	// slices of every level, see BuildSlices
+		voxelModelSlice const* __restrict   Slices;	// slices of the full detail level
+		uint32_t 		numSlices;
+		
+		// level of detail, clamped to the levels the model has. Level 0 is the full detail model
+		inline voxelModelLOD const getLOD(uint32_t const uiLOD) const
+		{
+			if ( 0 == uiLOD || numLODs <= 1 ) {
+				voxelModelLOD const Full = { VoxelsFRAM, numVoxels, maxDimensionsInv, maxDimensions, Scalar, Slices, numSlices };
+				return(Full);
+			}
+			return( LOD[ (uiLOD < numLODs ? uiLOD : numLODs - 1) - 1 ] );
+		}
+		
 		inline voxelModelBase(bool const isDynamic, float const Scale = 1.0f) //  #!#!#! minimum allowed scale is 1.0f #!#!#!  //
-				: numVoxels(0), Scalar(Scale), isDynamic_(isDynamic)
+				: numVoxels(0), Scalar(Scale), isDynamic_(isDynamic), numLODs(1), Slices(nullptr), numSlices(0)
 		{}
 		
 	} voxelModelBase; // voxelModelBase
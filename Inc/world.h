@@ -11,7 +11,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #ifndef WORLD_H
 #define WORLD_H
 #include "globals.h"
-#include "point2D.h"
+#include "Point2D.h"
 #include "math_3d.h"
 #include "isoVoxel.h"
 #include "shade_ops.h"
@@ -76,7 +76,7 @@ void Render( uint32_t const tNow );
 
 // ########## Camera
 __attribute__((pure)) uint32_t const& __restrict getCameraState();
-__attribute__((pure)) point2D_t const p2D_GridToScreen(point2D_t thePt);
+__attribute__((pure)) point2D_t const p2D_GridToScreen(point2D_t const thePt);
 __attribute__((pure)) vec2_t const    v2_GridToScreen(vec2_t thePt);
 
 // Therefore the neighbours of a voxel, follow same isometric layout/order //
@@ -102,10 +102,10 @@ static constexpr uint32_t const ADJACENT_NEIGHBOUR_COUNT = 8;
 extern point2D_t const ADJACENT[ADJACENT_NEIGHBOUR_COUNT];
 
 // Grid Space (-x,-y) to (X, Y) Coordinates Only
-__attribute__((pure)) Iso::Voxel const* const __restrict getNeighbour(point2D_t voxelIndex, point2D_t const relativeOffset);
+__attribute__((pure)) Iso::Voxel const* const __restrict getNeighbour(point2D_t const voxelIndex, point2D_t const relativeOffset);
 
 // Grid Space (-x,-y) to (X, Y) Coordinates Only
-__attribute__((pure)) Iso::Voxel const * const __restrict getVoxelAt( point2D_t voxelIndex );
+__attribute__((pure)) Iso::Voxel const * const __restrict getVoxelAt( point2D_t const voxelIndex );
 __attribute__((pure)) Iso::Voxel const * const __restrict getVoxelAt( vec2_t const Location );
 
 // Grid Space (-x,-y) to (X, Y) Coordinates Only
@@ -117,7 +117,7 @@ __attribute__((pure)) bool const isPointNotInVisibleVoxel( vec2_t const Location
 __attribute__((pure)) STATIC_INLINE Iso::Voxel const* const __restrict getVoxel_IfVisible( vec2_t const Location );
 
 // Grid Space (-x,-y) to (X, Y) Coordinates Only
-__attribute__((pure)) bool const getVoxelDepth( vec2_t const Location, 
+bool const getVoxelDepth( vec2_t const Location, 
 																								Iso::Voxel const* __restrict& __restrict pVoxelOut, int32_t& __restrict Depth );
 
 // Grid Space (-x,-y) to (X, Y) Coordinates Only - Center of Screen in GridSpace
@@ -241,6 +241,13 @@ __attribute__((always_inline)) STATIC_INLINE void RenderTinyVoxel( float const f
 		
 		OLED::setDepthLevel( p2D_sub(cornersB.pts.b, p2D_subh(cornersB.pts.b, cornersB.pts.t)).pt.y );  // solves depth for shockwave! yay!!
 		
+		if constexpr ( OLED::Z_ENABLE & RenderingFlags ) {
+			// +1 at the top, the anti-aliased first pixel of a vertical line also blends into the pixel above it
+			if ( OLED::isOccluded_HiZ(VoxelOrigin.pt.x - (int32_t)Iso::TINY_GRID_RADII, cornersB.pts.t.pt.y - (int32_t)uiPixelHeight - 1,
+																VoxelOrigin.pt.x + (int32_t)Iso::TINY_GRID_RADII, cornersB.pts.b.pt.y, IsoDepth::getCurSelectedDepth()) )
+				return; // completely hidden
+		}
+		
 		// get corner extents (top diamond)
 		halfdiamond2D_t cornersT;
 		{
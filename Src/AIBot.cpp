@@ -9,12 +9,13 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
  */
 
 #include "globals.h"
-#include "AiBot.h"
+#include "AIBot.h"
 #include "rng.h"
 #include "BuildingGeneration.h"
 #include "world.h"
+#include "InputReplay.h"
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
 static constexpr uint32_t const VAL_STEP_SMALL = 10,
 																VAL_STEP_MEDIUM = 40,
@@ -427,6 +428,9 @@ void cAIBot::DoTurn(uint32_t const tNow) // Following thru on decisions
 	
 	UpdateTurnText();
 	
+	INPUT_CHECKPOINT(InputReplay::CHECK_AIBOT, m_rootDescision, m_bDescisionSuccessful, m_bTurnSuccessful,
+																						 (uint32_t)m_CurPlotMin.v, (uint32_t)m_CurPlotMax.v, m_Frustration);
+	
 	// Reset applicable variables for next decision making progress
 	m_bDescisionSuccessful = false;
 	m_CurPlotMin = point2D_t(0);
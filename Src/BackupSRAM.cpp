@@ -1,5 +1,5 @@
 #include "BackupSRAM.h"
-#include "Globals.h"
+#include "globals.h"
 #include "stm32f7xx_ll_bus.h"
 #include "stm32f7xx_ll_rcc.h"
 #include "stm32f7xx_ll_pwr.h"
@@ -5,7 +5,7 @@
 #include "noise.h"
 #include <list>
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
 //#define DEBUG_TRACKING
          
@@ -169,7 +169,11 @@ STATIC_INLINE void D2D_Blend_Line(void)
 	/* restart DMA2D transfer*/
  
 	/* Start transfer */
+#ifndef DMA2D_SOFTWARE_ENGINE
 	LL_DMA2D_Start(DMA2D);		// special case start of DMA2D
+#else
+	xDMA2D::Soft::Start();
+#endif
 }
 /* 
 
@@ -0,0 +1,301 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "globals.h"
+
+#ifdef DMA2D_SOFTWARE_ENGINE
+
+#include "DMA2D.hpp"
+#include "DMA2D_Soft.h"
+#include "stm32f7xx_ll_dma2d.h"
+#include <string.h>
+
+extern "C" void DMA2D_IRQHandler(void);
+
+// the emulated register block, DMA2D is redefined to point here
+DMA2D_TypeDef DMA2D_Soft_Registers;
+
+namespace xDMA2D
+{
+namespace Soft
+{
+
+typedef struct sLayerDesc
+{
+	uint8_t const* __restrict Memory;
+	uint32_t const* __restrict CLUT;
+	uint32_t Offset,					// in pixels
+					 ColorMode,
+					 AlphaMode,
+					 Alpha,
+					 Color;
+	bool		 bAlphaInverted;
+
+} LayerDesc;
+
+static bool bInterruptActive(false);	// TC ISR is being serviced, any start within it is tail-chained
+
+STATIC_INLINE_PURE uint32_t const getBytesPerPixel(uint32_t const ColorMode)
+{
+	switch(ColorMode)
+	{
+		case LL_DMA2D_INPUT_MODE_ARGB8888:
+			return(4);
+		case LL_DMA2D_INPUT_MODE_RGB888:
+			return(3);
+		case LL_DMA2D_INPUT_MODE_AL88:
+			return(2);
+		case LL_DMA2D_INPUT_MODE_L8:
+		case LL_DMA2D_INPUT_MODE_AL44:
+		case LL_DMA2D_INPUT_MODE_A8:
+			return(1);
+		default:
+			break;
+	}
+	return(0); // unsupported (RGB565, ARGB1555, ARGB4444, L4, A4)
+}
+
+STATIC_INLINE void ApplyFlagClears()
+{
+	// IFCR bits mirror ISR bits, hardware clears the flag as a side effect of the write
+	DMA2D->ISR &= ~DMA2D->IFCR;
+	DMA2D->IFCR = 0;
+}
+
+STATIC_INLINE bool const LoadLayerDesc(LayerDesc& __restrict Layer, uint32_t const PFCCR, uint32_t const COLR,
+																			 uint32_t const MemAddress, uint32_t const LineOffset, uint32_t const* const __restrict CLUT)
+{
+	Layer.ColorMode = (PFCCR & DMA2D_FGPFCCR_CM);
+	if ( 0 == getBytesPerPixel(Layer.ColorMode) )
+		return(false);
+
+	Layer.Memory = (uint8_t const* const)MemAddress;
+	Layer.CLUT = CLUT;
+	Layer.Offset = (LineOffset & DMA2D_FGOR_LO);
+	Layer.AlphaMode = (PFCCR & DMA2D_FGPFCCR_AM);
+	Layer.Alpha = (PFCCR >> DMA2D_FGPFCCR_ALPHA_Pos) & 0xFF;
+	Layer.Color = (COLR & (DMA2D_FGCOLR_RED | DMA2D_FGCOLR_GREEN | DMA2D_FGCOLR_BLUE));
+	Layer.bAlphaInverted = (0 != (PFCCR & DMA2D_FGPFCCR_AI));
+
+	return(true);
+}
+
+// Pixel format converter stage, any input => ARGB8888 with alpha modification applied
+STATIC_INLINE uint32_t const FetchPixel(LayerDesc const& __restrict Layer, uint8_t const* const __restrict pSrc)
+{
+	uint32_t ARGB;
+
+	switch(Layer.ColorMode)
+	{
+		case LL_DMA2D_INPUT_MODE_ARGB8888:
+			ARGB = *((uint32_t const* const)pSrc);
+			break;
+		case LL_DMA2D_INPUT_MODE_RGB888:
+			ARGB = 0xFF000000 | (pSrc[2] << 16) | (pSrc[1] << 8) | pSrc[0];
+			break;
+		case LL_DMA2D_INPUT_MODE_L8:
+			ARGB = Layer.CLUT[pSrc[0]];
+			break;
+		case LL_DMA2D_INPUT_MODE_AL44:
+			ARGB = ((((pSrc[0] >> 4) * 0x11) << 24) | (Layer.CLUT[pSrc[0] & 0x0F] & 0x00FFFFFF));
+			break;
+		case LL_DMA2D_INPUT_MODE_AL88:
+			ARGB = ((pSrc[1] << 24) | (Layer.CLUT[pSrc[0]] & 0x00FFFFFF));
+			break;
+		default: // LL_DMA2D_INPUT_MODE_A8
+			ARGB = ((pSrc[0] << 24) | Layer.Color);
+			break;
+	}
+
+	uint32_t Alpha(ARGB >> 24);
+
+	if ( Layer.bAlphaInverted ) {
+		Alpha = 0xFF - Alpha;
+	}
+
+	switch(Layer.AlphaMode)
+	{
+		case LL_DMA2D_ALPHA_MODE_REPLACE:
+			Alpha = Layer.Alpha;
+			break;
+		case LL_DMA2D_ALPHA_MODE_COMBINE:
+			Alpha = (Alpha * Layer.Alpha) / 0xFF;
+			break;
+		default: // LL_DMA2D_ALPHA_MODE_NO_MODIF
+			break;
+	}
+
+	return( (Alpha << 24) | (ARGB & 0x00FFFFFF) );
+}
+
+// Blender stage, RM0410 DMA2D blending equations
+STATIC_INLINE_PURE uint32_t const BlendPixel(uint32_t const FG, uint32_t const BG)
+{
+	uint32_t const aFG(FG >> 24), aBG(BG >> 24);
+	uint32_t const aMult((aFG * aBG) / 0xFF);
+	uint32_t const aOut(aFG + aBG - aMult);
+
+	if ( 0 == aOut )
+		return(0);
+
+	uint32_t Result(aOut << 24);
+
+	for ( uint32_t iShift = 0 ; iShift < 24 ; iShift += 8 ) {
+
+		uint32_t const cFG((FG >> iShift) & 0xFF), cBG((BG >> iShift) & 0xFF);
+		uint32_t const c((cFG * aFG + cBG * aBG - cBG * aMult) / aOut);
+
+		Result |= (__USAT(c, Constants::SATBIT_256) << iShift);
+	}
+
+	return(Result);
+}
+
+static bool const Execute()
+{
+	uint32_t const Mode(DMA2D->CR & DMA2D_CR_MODE);
+	uint32_t const PixelPerLine((DMA2D->NLR & DMA2D_NLR_PL) >> DMA2D_NLR_PL_Pos),
+								 NumberOfLine(DMA2D->NLR & DMA2D_NLR_NL);
+	uint32_t const OutputOffset(DMA2D->OOR & DMA2D_OOR_LO);
+
+	if ( LL_DMA2D_OUTPUT_MODE_ARGB8888 != (DMA2D->OPFCCR & DMA2D_OPFCCR_CM) )
+		return(false);
+
+	uint32_t* __restrict pDst((uint32_t* const)DMA2D->OMAR);
+
+	if ( LL_DMA2D_MODE_R2M == Mode ) {
+
+		uint32_t const Color(DMA2D->OCOLR);
+		for ( uint32_t y = 0 ; y < NumberOfLine ; ++y ) {
+			for ( uint32_t x = 0 ; x < PixelPerLine ; ++x ) {
+				*pDst++ = Color;
+			}
+			pDst += OutputOffset;
+		}
+		return(true);
+	}
+
+	LayerDesc FGND;
+	if ( !LoadLayerDesc(FGND, DMA2D->FGPFCCR, DMA2D->FGCOLR, DMA2D->FGMAR, DMA2D->FGOR, (uint32_t const*)DMA2D->FGCLUT) )
+		return(false);
+
+	uint32_t const FGBytesPerPixel(getBytesPerPixel(FGND.ColorMode));
+	uint8_t const* __restrict pFG(FGND.Memory);
+
+	if ( LL_DMA2D_MODE_M2M == Mode ) {
+
+		// no pfc, raw copy in the foreground pixel format
+		uint8_t* __restrict pDstRaw((uint8_t* const)pDst);
+		uint32_t const LineBytes(PixelPerLine * FGBytesPerPixel);
+
+		for ( uint32_t y = 0 ; y < NumberOfLine ; ++y ) {
+			memcpy(pDstRaw, pFG, LineBytes);
+			pDstRaw += LineBytes + OutputOffset * FGBytesPerPixel;
+			pFG += LineBytes + FGND.Offset * FGBytesPerPixel;
+		}
+		return(true);
+	}
+
+	if ( LL_DMA2D_MODE_M2M_PFC == Mode ) {
+
+		for ( uint32_t y = 0 ; y < NumberOfLine ; ++y ) {
+			for ( uint32_t x = 0 ; x < PixelPerLine ; ++x ) {
+				*pDst++ = FetchPixel(FGND, pFG);
+				pFG += FGBytesPerPixel;
+			}
+			pDst += OutputOffset;
+			pFG += FGND.Offset * FGBytesPerPixel;
+		}
+		return(true);
+	}
+
+	// LL_DMA2D_MODE_M2M_BLEND
+	LayerDesc BGND;
+	if ( !LoadLayerDesc(BGND, DMA2D->BGPFCCR, DMA2D->BGCOLR, DMA2D->BGMAR, DMA2D->BGOR, (uint32_t const*)DMA2D->BGCLUT) )
+		return(false);
+
+	uint32_t const BGBytesPerPixel(getBytesPerPixel(BGND.ColorMode));
+	uint8_t const* __restrict pBG(BGND.Memory);
+
+	for ( uint32_t y = 0 ; y < NumberOfLine ; ++y ) {
+		for ( uint32_t x = 0 ; x < PixelPerLine ; ++x ) {
+			// read both before write, output is commonly the background (in-place blend)
+			uint32_t const FG(FetchPixel(FGND, pFG)), BG(FetchPixel(BGND, pBG));
+			*pDst++ = BlendPixel(FG, BG);
+			pFG += FGBytesPerPixel;
+			pBG += BGBytesPerPixel;
+		}
+		pDst += OutputOffset;
+		pFG += FGND.Offset * FGBytesPerPixel;
+		pBG += BGND.Offset * BGBytesPerPixel;
+	}
+	return(true);
+}
+
+void Start()
+{
+	ApplyFlagClears();
+
+	DMA2D->CR |= DMA2D_CR_START;		// transfer ongoing for the duration
+	bool const bOk(Execute());
+	DMA2D->CR &= ~DMA2D_CR_START;
+
+	if ( unlikely(!bOk) ) {
+		DMA2D->ISR |= DMA2D_ISR_CEIF;
+		return;
+	}
+	DMA2D->ISR |= DMA2D_ISR_TCIF;
+
+	if ( 0 == (DMA2D->CR & DMA2D_CR_TCIE) )
+		return;
+
+	if ( bInterruptActive )
+		return;		// started from inside the ISR, serviced below once it returns (tail-chaining) - no recursion
+
+	bInterruptActive = true;
+	// the resize loops restart the DMA2D from within the ISR for every line,
+	// keep servicing until no further transfer complete is pending
+	while ( (DMA2D->ISR & DMA2D_ISR_TCIF) && (DMA2D->CR & DMA2D_CR_TCIE) ) {
+		DMA2D_IRQHandler();
+		ApplyFlagClears();
+	}
+	bInterruptActive = false;
+}
+
+void LoadCLUT(uint32_t const TargetLayer)
+{
+	uint32_t const PFCCR( xDMA2D::BGND == TargetLayer ? DMA2D->BGPFCCR : DMA2D->FGPFCCR );
+	uint32_t const CLUTSize( ((PFCCR & DMA2D_FGPFCCR_CS) >> DMA2D_FGPFCCR_CS_Pos) + 1 );
+	uint8_t const* __restrict pSrc( (uint8_t const* const)(xDMA2D::BGND == TargetLayer ? DMA2D->BGCMAR : DMA2D->FGCMAR) );
+	uint32_t* __restrict pCLUT( (uint32_t*)(xDMA2D::BGND == TargetLayer ? DMA2D->BGCLUT : DMA2D->FGCLUT) );
+
+	if ( LL_DMA2D_CLUT_COLOR_MODE_RGB888 == (PFCCR & DMA2D_FGPFCCR_CCM) ) {
+		for ( uint32_t i = 0 ; i < CLUTSize ; ++i, pSrc += 3 ) {
+			pCLUT[i] = 0xFF000000 | (pSrc[2] << 16) | (pSrc[1] << 8) | pSrc[0];
+		}
+	}
+	else {
+		memcpy(pCLUT, pSrc, CLUTSize * sizeof(uint32_t));
+	}
+
+	// automatic load finished
+	if ( xDMA2D::BGND == TargetLayer ) {
+		DMA2D->BGPFCCR &= ~DMA2D_BGPFCCR_START;
+	}
+	else {
+		DMA2D->FGPFCCR &= ~DMA2D_FGPFCCR_START;
+	}
+	DMA2D->ISR |= DMA2D_ISR_CTCIF;
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*DMA2D_SOFTWARE_ENGINE*/
@@ -10,6 +10,8 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #include "globals.h"
 #include "DTCM_Reserve.h"
+#include "isoVoxel.h"
+#include "world.h"
 
 /* ############## */
 uint8_t const _dithertable[64]																// 64 bytes
@@ -29,30 +31,59 @@ extern "C" uint8_t const globalasm_dithertable[64]
 namespace DTCM
 {			
 	
-uint8_t _sram_top_ao_bothsides[top_ao_stride*top_ao_numoflines],							// 276 bytes
-			  _sram_top_ao_oneside[top_ao_stride*top_ao_numoflines],								// 276bytes
-				_sram_top_ao_oneside_mirrored[top_ao_stride*top_ao_numoflines],				// ""
-				_sram_side_7_both_ao[side_ao_stride*side_ao_numoflines],							// 396 bytes
-				_sram_side_7_both_ao_mirrored[side_ao_stride*side_ao_numoflines],			// ""
-				_sram_side_7_botom_ao[side_ao_stride*side_ao_numoflines],							// 396 bytes
-				_sram_side_7_botom_ao_mirrored[side_ao_stride*side_ao_numoflines]			// ""
+uint8_t _sram_top_ao_atlas[AO_TOP_VARIANTS][top_ao_stride*top_ao_numoflines],																			// 1,104 bytes
+			  _sram_side_ao_atlas[AO_SIDE_VARIANTS][AO_HEIGHT_STEPS][side_ao_atlas_stride*side_ao_atlas_numoflines]		// 21,252 bytes
 __attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
 __attribute__((section (".ext_sram")));
+
+static_assert(Iso::MAX_HEIGHT_STEP == AO_HEIGHT_STEPS, "side ao atlas requires a variant per ground height step");
+static_assert((Iso::GRID_RADII << 1) - 1 == side_ao_atlas_stride, "side ao atlas must hold both faces of a ground voxel");
+static_assert(Iso::GRID_RADII + world::getGroundHeight_InPixels<Iso::MAX_HEIGHT_STEP>() <= side_ao_atlas_numoflines, "side ao atlas too short for tallest ground");
+
+// copies a source side mask column so that its bottom line ySrcBottom lands on yFaceBottom of the atlas column
+// shorter faces keep the bottom ao at full size and drop lines from the top of the source column instead of squashing it
+static void BakeSideAOColumn(uint8_t* const __restrict dst, uint32_t const xDst, int32_t const yFaceBottom, 
+														 uint8_t const* const __restrict src, uint32_t const xSrc, int32_t const ySrcBottom)
+{
+	for ( int32_t y = 0 ; y < (int32_t)side_ao_atlas_numoflines ; ++y ) {
+		dst[y * side_ao_atlas_stride + xDst] = src[clamp(ySrcBottom - (yFaceBottom - y), ySrcBottom) * side_ao_stride + xSrc];
+	}
+}
+
+// left face is drawn at columns GRID_RADII - 1 - iD, front face at GRID_RADII - 1 + iD (see RenderBox_AO), both sample source column GRID_RADII - 1 - iD
+// rows are relative to the top of each face column, which RenderBox_AO places at GRID_RADII - (iD >> 1)
+// the bottom edge of the source masks steps up a line every 2 columns like the faces do, the anti-aliased line below it is not copied
+static void BakeSideAOVariant(uint8_t* const __restrict dst, uint32_t const uiHeight, uint8_t const* const __restrict srcLeft, uint8_t const* const __restrict srcFront)
+{
+	for ( int32_t iD = Iso::GRID_RADII - 1 ; iD >= 0 ; --iD ) {
+		
+		int32_t const yFaceBottom( (int32_t)(Iso::GRID_RADII + uiHeight) - (iD >> 1) - 1 ),
+									ySrcBottom( (int32_t)side_ao_numoflines - (iD >> 1) - 1 );
+		uint32_t const xSrc( Iso::GRID_RADII - 1 - iD );
 		
+		BakeSideAOColumn(dst, Iso::GRID_RADII - 1 + iD, yFaceBottom, srcFront, xSrc, ySrcBottom);
+		BakeSideAOColumn(dst, Iso::GRID_RADII - 1 - iD, yFaceBottom, srcLeft, xSrc, ySrcBottom);	// shared middle column (iD = 0) keeps the left face
+	}
+}
+
 NOINLINE void ScatterLoad()
 {	
-	// Copy AO mask textures to DTCM section of Internal SRAM
-	memcpy8(DTCM::_sram_top_ao_bothsides, _flash_top_ao_bothsides, top_ao_stride*top_ao_numoflines);
-	
-	memcpy8(DTCM::_sram_top_ao_oneside, _flash_top_ao_oneside, top_ao_stride*top_ao_numoflines);
-	memcpy8_mirrored(DTCM::_sram_top_ao_oneside_mirrored, DTCM::_sram_top_ao_oneside, top_ao_stride, top_ao_numoflines);
-	
-	memcpy8(DTCM::_sram_side_7_both_ao, _flash_side_7_both_ao, side_ao_stride*side_ao_numoflines);
-	memcpy8_mirrored(DTCM::_sram_side_7_both_ao_mirrored, DTCM::_sram_side_7_both_ao, side_ao_stride, side_ao_numoflines);
-	
-	memcpy8(DTCM::_sram_side_7_botom_ao, _flash_side_7_botom_ao, side_ao_stride*side_ao_numoflines);
-	memcpy8_mirrored(DTCM::_sram_side_7_botom_ao_mirrored, DTCM::_sram_side_7_botom_ao, side_ao_stride, side_ao_numoflines);
+	// Copy AO mask textures to external SRAM
+	memcpy8(DTCM::_sram_top_ao_atlas[Iso::OCCLUSION_SHADING_TOP_LEFT >> 1], _flash_top_ao_oneside, top_ao_stride*top_ao_numoflines);
+	memcpy8_mirrored(DTCM::_sram_top_ao_atlas[Iso::OCCLUSION_SHADING_TOP_RIGHT >> 1], DTCM::_sram_top_ao_atlas[Iso::OCCLUSION_SHADING_TOP_LEFT >> 1], top_ao_stride, top_ao_numoflines);
+	memcpy8(DTCM::_sram_top_ao_atlas[(Iso::OCCLUSION_SHADING_TOP_LEFT | Iso::OCCLUSION_SHADING_TOP_RIGHT) >> 1], _flash_top_ao_bothsides, top_ao_stride*top_ao_numoflines);
 	
+	// Bake side AO variants for every combination of side occlusion and every ground height step
+	// edge ao comes from the "both" mask on the face with the occluding neighbour, all faces have bottom ao
+	for ( uint32_t uiSides = 0 ; uiSides < AO_SIDE_VARIANTS ; ++uiSides ) {
+		
+		uint8_t const* const srcLeft( ((Iso::OCCLUSION_SHADING_SIDE_LEFT >> 3) & uiSides) ? _flash_side_7_both_ao : _flash_side_7_botom_ao );
+		uint8_t const* const srcFront( ((Iso::OCCLUSION_SHADING_SIDE_RIGHT >> 3) & uiSides) ? _flash_side_7_both_ao : _flash_side_7_botom_ao );
+		
+		for ( uint32_t uiHeightStep = 1 ; uiHeightStep <= AO_HEIGHT_STEPS ; ++uiHeightStep ) {
+			BakeSideAOVariant(DTCM::_sram_side_ao_atlas[uiSides][uiHeightStep - 1], world::getGroundHeight_InPixels(uiHeightStep), srcLeft, srcFront);
+		}
+	}
 }
 
 }//endnamespace
@@ -9,7 +9,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
  */
 
 #include "globals.h"
-#include "fireeffect.h"
+#include "FireEffect.h"
 #include "oled.h"
 #include "math_3d.h"
 #include "noise.h"
@@ -88,5 +88,5 @@ STATIC_INLINE_PURE float const acesToneMapping(float const x) {
 	}
 	
 	//OLED::Render8bitScreenLayer_Back(EffectFrameBuffer);
-	OLED::RenderScreenLayer_Upscale<uint8_t, FRAMEBUFFER_Width_SATBITS, FRAMEBUFFER_Height_SATBITS>(getBackBuffer(), EffectFrameBuffer);
+	OLED::RenderScreenLayer_Upscale<uint8_t, FRAMEBUFFER_Width_SATBITS, FRAMEBUFFER_Height_SATBITS>((uint8_t* const __restrict)DTCM::getBackBuffer(), EffectFrameBuffer);
 }
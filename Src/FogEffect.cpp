@@ -9,12 +9,12 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
  */
 
 #include "globals.h"
-#include "fogeffect.h"
+#include "FogEffect.h"
 #include "oled.h"
 #include "noise.h"
 #include "isoVoxel.h"
 #include "math_3d.h"
-#include "debug.cpp"
+#include "Debug.cpp"
 
 static constexpr uint32_t const FRAMEBUFFER_Width_SATBITS = Constants::SATBIT_64,
 														    FRAMEBUFFER_Height_SATBITS = Constants::SATBIT_16;	// should be same aspect ratio as OLED
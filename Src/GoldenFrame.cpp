@@ -0,0 +1,282 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "GoldenFrame.h"
+
+#ifdef GOLDEN_FRAME_HARNESS
+
+#include "oled.h"
+#include "DMA2D.hpp"
+#include "rng.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" void asmDitherBlit(void);
+extern uint8_t * __restrict _DitherTargetFrameBuffer;
+
+namespace GoldenFrame
+{
+static constexpr uint32_t const WIDTH = OLED::SCREEN_WIDTH,
+																HEIGHT = OLED::SCREEN_HEIGHT,
+																NBPIXELS = WIDTH * HEIGHT;
+
+// must match oOLED in oled.cpp, layout of the 4bpp spi framebuffer the dither targets
+static constexpr uint32_t const DITHER_STRIDE = 480 >> 1,
+																DITHER_XOFFSET = 112 >> 1;
+
+static constexpr uint32_t const BACK = 0,
+																FRONT_ALPHA = 1,
+																FRONT_LUMA = 2,
+																DEPTH = 3,
+																DITHER = 4,
+																NUM_BUFFERS = 5;
+
+static constexpr uint32_t const RESERVED_SEED = 0xC00C1001,
+																HASH_SEED = 0x5EED600D,
+																PSUEDO_SEED = 0x1234ABCD,
+																TRUE_RANDOM_SEED = 0x2545F491;	// non zero
+
+static char const* const szBufferName[NUM_BUFFERS] = { "back", "front_a", "front_l", "depth", "dither" };
+
+typedef struct sBufferResult
+{
+	uint32_t	FramesFailed,
+						PixelsFailed,
+						MaxDiff,
+						FramesMissing;
+} BufferResult;
+
+static struct sGoldenFrame
+{
+	char const*		szDir;
+	uint32_t			Tolerance;
+	bool					bRecord;
+
+	uint32_t			FramesFailed;
+	BufferResult	Result[NUM_BUFFERS];
+
+	uint32_t			tClock,
+								TrueRandomState;	// xorshift32, 0 = not pinned
+
+	uint8_t				Image[NUM_BUFFERS][NBPIXELS],
+								Golden[NBPIXELS],
+								Diff[NBPIXELS];
+
+	uint8_t				DitherTarget[DITHER_STRIDE * HEIGHT];
+
+	sGoldenFrame()
+	: szDir(nullptr), Tolerance(0), bRecord(false), FramesFailed(0), Result{}, tClock(0), TrueRandomState(0)
+	{}
+} oGolden;
+
+static void getPath(char* const szPath, size_t const NbMax, uint32_t const iFrame, uint32_t const iBuffer, char const* const szSuffix)
+{
+	snprintf(szPath, NbMax, "%s/%04u_%s%s.pgm", oGolden.szDir, iFrame, szBufferName[iBuffer], szSuffix);
+}
+
+static bool const WritePGM(char const* const szPath, uint8_t const* const pImage)
+{
+	FILE* const fp = fopen(szPath, "wb");
+	if ( nullptr == fp )
+		return(false);
+
+	fprintf(fp, "P5\n%u %u\n255\n", WIDTH, HEIGHT);
+	bool const bOk = (NBPIXELS == fwrite(pImage, 1, NBPIXELS, fp));
+	fclose(fp);
+
+	return(bOk);
+}
+
+static bool const ReadPGM(char const* const szPath, uint8_t* const pImage)
+{
+	FILE* const fp = fopen(szPath, "rb");
+	if ( nullptr == fp )
+		return(false);
+
+	unsigned int Width(0), Height(0), MaxVal(0);
+	bool const bOk = ( 3 == fscanf(fp, "P5 %u %u %u", &Width, &Height, &MaxVal) &&
+										 WIDTH == Width && HEIGHT == Height && 255 == MaxVal &&
+										 '\n' == fgetc(fp) &&		// single whitespace before the raster
+										 NBPIXELS == fread(pImage, 1, NBPIXELS, fp) );
+	fclose(fp);
+
+	return(bOk);
+}
+
+// convert all the buffers of the finished frame to 8bit images (row major, unrotated)
+static void Convert()
+{
+	uint8_t* __restrict pBack(oGolden.Image[BACK]),
+				 * __restrict pAlpha(oGolden.Image[FRONT_ALPHA]),
+				 * __restrict pLuma(oGolden.Image[FRONT_LUMA]),
+				 * __restrict pDepth(oGolden.Image[DEPTH]),
+				 * __restrict pDither(oGolden.Image[DITHER]);
+
+	for ( uint32_t y = 0 ; y < HEIGHT ; ++y ) {
+
+		uint8_t const* const pDitherRow = oGolden.DitherTarget + y * DITHER_STRIDE + DITHER_XOFFSET;
+
+		for ( uint32_t x = 0 ; x < WIDTH ; ++x ) {
+
+			xDMA2D::AlphaLuma const Front(DTCM::getFrontBuffer()[y][x]);
+
+			*pBack++ = DTCM::getBackBuffer()[y][x];
+			*pAlpha++ = Front.pixel.Alpha;
+			*pLuma++ = Front.pixel.Luma;
+			*pDepth++ = (uint8_t)IsoDepth::getLevelIndex(DTCM::getDepthBuffer()[x][y]);	// depth buffer is rotated 90 in memory
+
+			uint8_t const Nybble = (0 == (x & 1)) ? (pDitherRow[x >> 1] >> 4) : (pDitherRow[x >> 1] & 0x0F);
+			*pDither++ = Nybble * 17;	// 4bpp => 8bpp
+		}
+	}
+}
+
+static void Compare(uint32_t const iFrame, uint32_t const iBuffer, bool& bFrameFailed)
+{
+	char szPath[256];
+	BufferResult& Result(oGolden.Result[iBuffer]);
+	uint8_t const* const pImage(oGolden.Image[iBuffer]);
+
+	getPath(szPath, sizeof(szPath), iFrame, iBuffer, "");
+
+	if ( oGolden.bRecord ) {
+		if ( !WritePGM(szPath, pImage) ) {
+			printf("golden: cannot write %s\n", szPath);
+			bFrameFailed = true;
+		}
+		return;
+	}
+
+	if ( !ReadPGM(szPath, oGolden.Golden) ) {
+		++Result.FramesMissing;
+		bFrameFailed = true;
+		return;
+	}
+
+	uint32_t PixelsFailed(0), MaxDiff(0), FirstFailed(NBPIXELS);
+	for ( uint32_t iDx = 0 ; iDx < NBPIXELS ; ++iDx ) {
+
+		uint32_t const Diff = abs((int32_t)pImage[iDx] - (int32_t)oGolden.Golden[iDx]);
+
+		if ( Diff > oGolden.Tolerance ) {
+			if ( 0 == PixelsFailed++ )
+				FirstFailed = iDx;
+		}
+		MaxDiff = (Diff > MaxDiff ? Diff : MaxDiff);
+		oGolden.Diff[iDx] = (uint8_t)Diff;
+	}
+
+	Result.MaxDiff = (MaxDiff > Result.MaxDiff ? MaxDiff : Result.MaxDiff);
+
+	if ( 0 != PixelsFailed ) {
+
+		printf("golden: frame %u %-8s %5u px > %u, max diff %3u, first (%u, %u)\n",
+					 iFrame, szBufferName[iBuffer], PixelsFailed, oGolden.Tolerance, MaxDiff, FirstFailed % WIDTH, FirstFailed / WIDTH);
+
+		getPath(szPath, sizeof(szPath), iFrame, iBuffer, "_actual");
+		WritePGM(szPath, pImage);
+		getPath(szPath, sizeof(szPath), iFrame, iBuffer, "_diff");
+		WritePGM(szPath, oGolden.Diff);
+
+		++Result.FramesFailed;
+		Result.PixelsFailed += PixelsFailed;
+		bFrameFailed = true;
+	}
+}
+
+NOINLINE void Init()
+{
+	char const* const szTolerance = getenv("GOLDEN_FRAME_TOLERANCE");
+	char const* const szRecord = getenv("GOLDEN_FRAME_RECORD");
+
+	oGolden.szDir = getenv("GOLDEN_FRAME_DIR");
+	if ( nullptr == oGolden.szDir )
+		oGolden.szDir = "Golden";
+
+	oGolden.Tolerance = (nullptr != szTolerance ? strtoul(szTolerance, nullptr, 10) : 0);
+	oGolden.bRecord = (nullptr != szRecord && '0' != *szRecord);
+
+	// the same seeds every run, independent of the hardware rng that seeded MX_RNG_Init
+	static constexpr RandomState const FIXED_STATE{ RESERVED_SEED, HASH_SEED, { PSUEDO_SEED, PSUEDO_SEED ^ 0x9E3779B9, PSUEDO_SEED ^ 0x85EBCA6B, PSUEDO_SEED ^ 0xC2B2AE35 } };
+	SetRandomState(&FIXED_STATE);
+	oGolden.TrueRandomState = TRUE_RANDOM_SEED;
+
+	SetClock(getFrameTime(0));
+}
+
+void SetClock(uint32_t const tNow)
+{
+	oGolden.tClock = tNow;
+}
+
+uint32_t const Millis(uint32_t const tTicks)
+{
+	return( 0 != oGolden.tClock ? oGolden.tClock : tTicks );
+}
+
+uint32_t const TrueRandom(uint32_t const Value)
+{
+	if ( 0 == oGolden.TrueRandomState )
+		return(Value);
+
+	uint32_t x(oGolden.TrueRandomState);
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	oGolden.TrueRandomState = x;
+
+	return(x);
+}
+
+NOINLINE void Capture(uint32_t const iFrame)
+{
+	// OLED::Render started the main blend of back + front into _DMA2DFrameBuffer
+	xDMA2D::Wait_DMA2D<true>();
+
+	// dither into a private target, the spi double buffers and their dma state are left untouched
+	uint8_t* const __restrict DitherTargetSaved(_DitherTargetFrameBuffer);
+	_DitherTargetFrameBuffer = oGolden.DitherTarget;
+	asmDitherBlit();
+	_DitherTargetFrameBuffer = DitherTargetSaved;
+
+	Convert();
+
+	bool bFrameFailed(false);
+	for ( uint32_t iBuffer = 0 ; iBuffer < NUM_BUFFERS ; ++iBuffer ) {
+		Compare(iFrame, iBuffer, bFrameFailed);
+	}
+
+	oGolden.FramesFailed += bFrameFailed;
+}
+
+NOINLINE int const Report()
+{
+	if ( oGolden.bRecord ) {
+		printf("golden: recorded %u frames to %s (%s)\n", FRAME_COUNT, oGolden.szDir, 0 == oGolden.FramesFailed ? "ok" : "errors");
+		return(oGolden.FramesFailed);
+	}
+
+	printf("golden: %u / %u frames failed, tolerance %u\n", oGolden.FramesFailed, FRAME_COUNT, oGolden.Tolerance);
+	for ( uint32_t iBuffer = 0 ; iBuffer < NUM_BUFFERS ; ++iBuffer ) {
+
+		BufferResult const& Result(oGolden.Result[iBuffer]);
+
+		printf("golden: %-8s frames failed %4u  pixels failed %8u  max diff %3u  missing %4u\n",
+					 szBufferName[iBuffer], Result.FramesFailed, Result.PixelsFailed, Result.MaxDiff, Result.FramesMissing);
+	}
+
+	return(oGolden.FramesFailed);
+}
+
+} // end namespace
+
+#endif /*GOLDEN_FRAME_HARNESS*/
@@ -110,6 +110,25 @@ _vox_sidewinder
 	INCBIN  ..\Data\VOX\sidewinder.vox
 ; ************************************************************** ;
 
+; baked voxel models (VOX_BAKED_MODELS), made by the host baker (VOX_BAKE_MODELS) from the above .vox
+;	AREA    VXB_Section, DATA, READONLY, ALIGN=2
+        
+		
+;	EXPORT  _vxb_sr71
+;_vxb_sr71
+;	INCBIN  ..\Data\VOX\sr71.vxb
+	
+;	ALIGN	4
+;	EXPORT  _vxb_f2a
+;_vxb_f2a
+;	INCBIN  ..\Data\VOX\f2a.vxb
+		
+;	ALIGN	4
+;	EXPORT  _vxb_sidewinder
+;_vxb_sidewinder
+;	INCBIN  ..\Data\VOX\sidewinder.vxb
+; ************************************************************** ;
+
 
 
 
@@ -0,0 +1,411 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "InputReplay.h"
+
+#ifdef INPUT_RECORD_REPLAY
+
+#include "rng.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace InputReplay
+{
+// Log layout, little endian
+// header:  "VXRP" version(u32) RandomState(6 x u32)
+// events:  tag(u8) payload
+//   EVENT_INIT             tNow varint
+//   EVENT_UPDATE/RENDER    tNow - tLast varint (tNow only moves forward)
+//   TAG_RANDOM             value u32 (does not compress)
+//   TAG_MILLIS             millis - tLast zigzag varint
+//   TAG_PSUEDO             hash of the psuedo rng state u32, after every update
+//   CHECK_xxx              count u8, values varint
+//   TAG_END
+static constexpr uint32_t const MAGIC = 0x50525856,	// "VXRP"
+																VERSION = 1;
+
+static constexpr uint32_t const TAG_RANDOM = 0x20,
+																TAG_MILLIS = 0x21,
+																TAG_PSUEDO = 0x22,
+																TAG_END = 0xFF;
+
+static constexpr uint32_t const MODE_OFF = 0,
+																MODE_RECORD = 1,
+																MODE_PLAY = 2;
+
+static constexpr uint32_t const MAX_CHECK_VALUES = 8;
+
+static struct sInputReplay
+{
+	uint32_t			Mode;
+	uint32_t			tLast;
+	uint32_t			EventIndex;
+
+	FILE*					fp;							// record
+
+	uint8_t*			pLog;						// play, whole log in memory
+	uint32_t			LogSize,
+								ReadPosition;
+	bool					bDiverged;
+
+	sInputReplay()
+	: Mode(MODE_OFF), tLast(0), EventIndex(0), fp(nullptr), pLog(nullptr), LogSize(0), ReadPosition(0), bDiverged(false)
+	{}
+} oReplay;
+
+/// * writing * ///
+STATIC_INLINE void WriteByte(uint32_t const Value)
+{
+	fputc((int)(Value & 0xFF), oReplay.fp);
+}
+STATIC_INLINE void WriteU32(uint32_t const Value)
+{
+	uint8_t const Bytes[4] = { (uint8_t)Value, (uint8_t)(Value >> 8), (uint8_t)(Value >> 16), (uint8_t)(Value >> 24) };
+	fwrite(Bytes, 1, 4, oReplay.fp);
+}
+STATIC_INLINE void WriteVarint(uint32_t Value)
+{
+	while ( Value >= 0x80 ) {
+		WriteByte( (Value & 0x7F) | 0x80 );
+		Value >>= 7;
+	}
+	WriteByte(Value);
+}
+STATIC_INLINE_PURE uint32_t const ZigZag(int32_t const Value) { return( ((uint32_t)Value << 1) ^ (uint32_t)(Value >> 31) ); }
+STATIC_INLINE_PURE int32_t const UnZigZag(uint32_t const Value) { return( (int32_t)(Value >> 1) ^ -(int32_t)(Value & 1) ); }
+
+/// * reading * ///
+STATIC_INLINE bool const ReadByte(uint32_t& __restrict Value)
+{
+	if ( oReplay.ReadPosition >= oReplay.LogSize )
+		return(false);
+
+	Value = oReplay.pLog[oReplay.ReadPosition++];
+	return(true);
+}
+STATIC_INLINE bool const ReadU32(uint32_t& __restrict Value)
+{
+	if ( oReplay.ReadPosition + 4 > oReplay.LogSize )
+		return(false);
+
+	uint8_t const* const Bytes(oReplay.pLog + oReplay.ReadPosition);
+	Value = Bytes[0] | (Bytes[1] << 8) | (Bytes[2] << 16) | ((uint32_t)Bytes[3] << 24);
+	oReplay.ReadPosition += 4;
+	return(true);
+}
+STATIC_INLINE bool const ReadVarint(uint32_t& __restrict Value)
+{
+	uint32_t Byte(0), Shift(0);
+
+	Value = 0;
+	do {
+		if ( !ReadByte(Byte) || Shift > 28 )
+			return(false);
+
+		Value |= (Byte & 0x7F) << Shift;
+		Shift += 7;
+
+	} while ( Byte & 0x80 );
+
+	return(true);
+}
+
+static char const* const getTagName(uint32_t const Tag)
+{
+	switch(Tag)
+	{
+		case EVENT_INIT:		return("init");
+		case EVENT_UPDATE:	return("update");
+		case EVENT_RENDER:	return("render");
+		case TAG_RANDOM:		return("random");
+		case TAG_MILLIS:		return("millis");
+		case TAG_PSUEDO:		return("psuedo rng");
+		case CHECK_CAMERA:	return("camera");
+		case CHECK_MISSILE:	return("missile");
+		case CHECK_AIBOT:		return("aibot");
+		case TAG_END:				return("end");
+		default:						return("?");
+	}
+}
+
+// first divergence ends playback, live values are used from here on
+static void Diverge(uint32_t const Expected, uint32_t const Found, char const* const szDetail)
+{
+	if ( !oReplay.bDiverged ) {
+		printf("replay: diverged at event %u (offset %u), log has %s, run wants %s %s\n",
+					 oReplay.EventIndex, oReplay.ReadPosition, getTagName(Found), getTagName(Expected), szDetail);
+		oReplay.bDiverged = true;
+	}
+}
+
+// next tag from the log must be the one the run is asking for
+static bool const Expect(uint32_t const Tag)
+{
+	if ( oReplay.bDiverged )
+		return(false);
+
+	uint32_t Found(TAG_END);
+	if ( !ReadByte(Found) || Tag != Found ) {
+		Diverge(Tag, Found, "");
+		return(false);
+	}
+
+	++oReplay.EventIndex;
+	return(true);
+}
+
+static uint32_t const HashPsuedoState()
+{
+	RandomState State;
+	GetRandomState(&State);
+
+	// fnv-1a
+	uint32_t h32(2166136261U);
+	uint32_t const* const pWords((uint32_t const*)&State);
+	for ( uint32_t iDx = 0 ; iDx < sizeof(RandomState) / sizeof(uint32_t) ; ++iDx ) {
+		h32 = (h32 ^ pWords[iDx]) * 16777619U;
+	}
+	return(h32);
+}
+
+NOINLINE bool const Init()
+{
+	char const* const szRecord = getenv("INPUT_RECORD");
+	char const* const szPlay = getenv("INPUT_REPLAY");
+
+	if ( nullptr != szPlay ) {
+
+		FILE* const fp = fopen(szPlay, "rb");
+		if ( nullptr == fp ) {
+			printf("replay: cannot open %s\n", szPlay);
+			return(false);
+		}
+
+		fseek(fp, 0, SEEK_END);
+		oReplay.LogSize = (uint32_t)ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+
+		oReplay.pLog = (uint8_t*)malloc(oReplay.LogSize);
+		bool const bRead = (nullptr != oReplay.pLog && oReplay.LogSize == fread(oReplay.pLog, 1, oReplay.LogSize, fp));
+		fclose(fp);
+
+		uint32_t Magic(0), Version(0);
+		RandomState State;
+		uint32_t* const pWords((uint32_t*)&State);
+
+		bool bHeader = bRead && ReadU32(Magic) && ReadU32(Version) && MAGIC == Magic && VERSION == Version;
+		for ( uint32_t iDx = 0 ; bHeader && iDx < sizeof(RandomState) / sizeof(uint32_t) ; ++iDx ) {
+			bHeader = ReadU32(pWords[iDx]);
+		}
+
+		if ( !bHeader ) {
+			printf("replay: %s is not a replay log (version %u)\n", szPlay, VERSION);
+			free(oReplay.pLog); oReplay.pLog = nullptr;
+			return(false);
+		}
+
+		SetRandomState(&State);
+		oReplay.Mode = MODE_PLAY;
+		printf("replay: playing %s, %u bytes\n", szPlay, oReplay.LogSize);
+		return(true);
+	}
+
+	if ( nullptr != szRecord ) {
+
+		oReplay.fp = fopen(szRecord, "wb");
+		if ( nullptr == oReplay.fp ) {
+			printf("replay: cannot create %s\n", szRecord);
+			return(false);
+		}
+		setvbuf(oReplay.fp, nullptr, _IOFBF, 64 * 1024);
+
+		RandomState State;
+		GetRandomState(&State);
+		uint32_t const* const pWords((uint32_t const*)&State);
+
+		WriteU32(MAGIC);
+		WriteU32(VERSION);
+		for ( uint32_t iDx = 0 ; iDx < sizeof(RandomState) / sizeof(uint32_t) ; ++iDx ) {
+			WriteU32(pWords[iDx]);
+		}
+
+		oReplay.Mode = MODE_RECORD;
+		printf("replay: recording to %s\n", szRecord);
+	}
+
+	return(false);
+}
+
+bool const isRecording() { return(MODE_RECORD == oReplay.Mode); }
+bool const isPlaying() { return(MODE_PLAY == oReplay.Mode); }
+
+void Record(uint32_t const Event, uint32_t const tNow)
+{
+	if ( MODE_RECORD != oReplay.Mode )
+		return;
+
+	// psuedo rng state at the end of the previous update, catches any divergence inside the update
+	if ( EVENT_UPDATE == Event || EVENT_INIT == Event ) {
+		WriteByte(TAG_PSUEDO);
+		WriteU32(HashPsuedoState());
+		++oReplay.EventIndex;
+	}
+
+	WriteByte(Event);
+	WriteVarint( EVENT_INIT == Event ? tNow : tNow - oReplay.tLast );
+	oReplay.tLast = tNow;
+	++oReplay.EventIndex;
+
+	// the realtime loop never returns, keep the log cut at a frame boundary if the process is killed
+	if ( EVENT_RENDER == Event )
+		fflush(oReplay.fp);
+}
+
+bool const Next(uint32_t& __restrict Event, uint32_t& __restrict tNow)
+{
+	if ( MODE_PLAY != oReplay.Mode || oReplay.bDiverged )
+		return(false);
+
+	uint32_t Tag(TAG_END);
+	if ( !ReadByte(Tag) || TAG_END == Tag )
+		return(false);
+
+	if ( TAG_PSUEDO == Tag ) {
+
+		uint32_t Hash(0);
+		if ( !ReadU32(Hash) ) {
+			Diverge(TAG_PSUEDO, TAG_END, "");
+			return(false);
+		}
+		if ( HashPsuedoState() != Hash ) {
+			Diverge(TAG_PSUEDO, TAG_PSUEDO, "(state differs)");
+			return(false);
+		}
+		++oReplay.EventIndex;
+
+		if ( !ReadByte(Tag) )
+			return(false);
+	}
+
+	uint32_t Delta(0);
+	if ( (EVENT_INIT != Tag && EVENT_UPDATE != Tag && EVENT_RENDER != Tag) || !ReadVarint(Delta) ) {
+		Diverge(EVENT_UPDATE, Tag, "(inputs left unconsumed)");
+		return(false);
+	}
+
+	Event = Tag;
+	tNow = ( EVENT_INIT == Tag ? Delta : oReplay.tLast + Delta );
+	oReplay.tLast = tNow;
+	++oReplay.EventIndex;
+
+	return(true);
+}
+
+uint32_t const TrueRandom(uint32_t const Value)
+{
+	if ( MODE_RECORD == oReplay.Mode ) {
+		WriteByte(TAG_RANDOM);
+		WriteU32(Value);
+		++oReplay.EventIndex;
+	}
+	else if ( MODE_PLAY == oReplay.Mode ) {
+
+		uint32_t Logged(0);
+		if ( Expect(TAG_RANDOM) ) {
+			if ( ReadU32(Logged) )
+				return(Logged);
+
+			Diverge(TAG_RANDOM, TAG_END, "");
+		}
+	}
+
+	return(Value);
+}
+
+uint32_t const Millis(uint32_t const tMillis)
+{
+	if ( MODE_RECORD == oReplay.Mode ) {
+		WriteByte(TAG_MILLIS);
+		WriteVarint(ZigZag((int32_t)(tMillis - oReplay.tLast)));
+		++oReplay.EventIndex;
+	}
+	else if ( MODE_PLAY == oReplay.Mode ) {
+
+		uint32_t Logged(0);
+		if ( Expect(TAG_MILLIS) ) {
+			if ( ReadVarint(Logged) )
+				return(oReplay.tLast + UnZigZag(Logged));
+
+			Diverge(TAG_MILLIS, TAG_END, "");
+		}
+	}
+
+	return(tMillis);
+}
+
+void Checkpoint(uint32_t const Check, uint32_t const* const __restrict Values, uint32_t const Count)
+{
+	if ( MODE_RECORD == oReplay.Mode ) {
+		WriteByte(Check);
+		WriteByte(Count);
+		for ( uint32_t iDx = 0 ; iDx < Count ; ++iDx ) {
+			WriteVarint(Values[iDx]);
+		}
+		++oReplay.EventIndex;
+	}
+	else if ( MODE_PLAY == oReplay.Mode ) {
+
+		if ( !Expect(Check) )
+			return;
+
+		uint32_t LoggedCount(0), Logged(0);
+		if ( !ReadByte(LoggedCount) || Count != LoggedCount || LoggedCount > MAX_CHECK_VALUES ) {
+			Diverge(Check, Check, "(value count differs)");
+			return;
+		}
+		for ( uint32_t iDx = 0 ; iDx < Count ; ++iDx ) {
+
+			if ( !ReadVarint(Logged) || Logged != Values[iDx] ) {
+
+				char szDetail[64];
+				snprintf(szDetail, sizeof(szDetail), "(value %u is 0x%08x, logged 0x%08x)", iDx, Values[iDx], Logged);
+				Diverge(Check, Check, szDetail);
+				return;
+			}
+		}
+	}
+}
+
+NOINLINE int const Finish()
+{
+	int iResult(0);
+
+	if ( MODE_RECORD == oReplay.Mode ) {
+		WriteByte(TAG_END);
+		fclose(oReplay.fp); oReplay.fp = nullptr;
+		printf("replay: recorded %u events\n", oReplay.EventIndex);
+	}
+	else if ( MODE_PLAY == oReplay.Mode ) {
+		if ( !oReplay.bDiverged ) {
+			printf("replay: %u events reproduced\n", oReplay.EventIndex);
+		}
+		iResult = oReplay.bDiverged ? 1 : 0;
+		free(oReplay.pLog); oReplay.pLog = nullptr;
+	}
+
+	oReplay.Mode = MODE_OFF;
+	return(iResult);
+}
+
+} // end namespace
+
+#endif /*INPUT_RECORD_REPLAY*/
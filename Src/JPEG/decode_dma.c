@@ -34,8 +34,8 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
-#include "JPEG\decode_dma.h"
-#include "JPEG\jpeg_utils.h"
+#include "JPEG/decode_dma.h"
+#include "JPEG/jpeg_utils.h"
 
 /** @addtogroup STM32F7xx_HAL_Examples
   * @{
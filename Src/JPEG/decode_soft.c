@@ -0,0 +1,449 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "JPEG/decode_soft.h"
+
+#ifdef JPEG_SOFTWARE_DECODER
+
+#include "JPEG/jpeg_utils.h"
+#include <math.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+
+// 1 MCU (8x8) = 64 bytes, matches CHUNK_SIZE_OUT of decode_dma.c so the convertor sees the same sized bursts
+#define CHUNK_SIZE_OUT ((uint32_t)(8192))
+#define CHUNK_MCUS (CHUNK_SIZE_OUT / 64)
+
+#define MARKER_SOI 0xD8
+#define MARKER_EOI 0xD9
+#define MARKER_SOF0 0xC0
+#define MARKER_SOF1 0xC1
+#define MARKER_DHT 0xC4
+#define MARKER_SOS 0xDA
+#define MARKER_DQT 0xDB
+#define MARKER_DRI 0xDD
+#define MARKER_RST0 0xD0
+#define MARKER_RST7 0xD7
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+	uint8_t  Values[256];
+	int32_t  MaxCode[18];		/* largest code of length k, -1 if none */
+	int32_t  ValPtr[17];		/* index into Values of first code of length k */
+	uint16_t MinCode[17];
+
+} Huffman_TableTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static struct sSoftDecoderState
+{
+	JPEG_YCbCrToRGB_Convert_Function pConvert_Function;
+
+	uint8_t MCU_Data_OutBuffer[CHUNK_SIZE_OUT];
+
+	uint16_t QuantTable[4][64];			/* zigzag order */
+	Huffman_TableTypeDef DCTable[4], ACTable[4];
+
+	uint32_t idQuant, idDC, idAC;
+	uint32_t RestartInterval, RestartsToGo;
+	int32_t  DCPredictor;
+
+	/* entropy coded segment bit reader */
+	uint8_t const* pData;
+	uint8_t const* pDataEnd;
+	uint32_t BitBuffer;
+	int32_t  BitCount;
+	uint32_t bMarkerHit;
+
+	uint32_t MCU_TotalNb;
+	uint32_t MCU_BlockIndex;
+	uint32_t Error;
+	uint32_t bBusy;
+
+	uint8_t* FrameBuffer;
+
+} oSoftDecoderState;
+
+static uint8_t const ZIGZAG[64] = {
+	 0,  1,  8, 16,  9,  2,  3, 10,
+	17, 24, 32, 25, 18, 11,  4,  5,
+	12, 19, 26, 33, 40, 48, 41, 34,
+	27, 20, 13,  6,  7, 14, 21, 28,
+	35, 42, 49, 56, 57, 50, 43, 36,
+	29, 22, 15, 23, 30, 37, 44, 51,
+	58, 59, 52, 45, 38, 31, 39, 46,
+	53, 60, 61, 54, 47, 55, 62, 63
+};
+
+static float IDCT_Cos[8][8];		/* [x][u] = C(u) * cos((2x+1)u*pi/16) / 2 */
+static uint32_t bIDCT_Init = 0;
+
+/* Private functions ---------------------------------------------------------*/
+static void InitIDCT(void)
+{
+	for (uint32_t x = 0 ; x < 8 ; ++x) {
+		for (uint32_t u = 0 ; u < 8 ; ++u) {
+			float const Cu = (0 == u) ? 0.70710678f : 1.0f;
+			IDCT_Cos[x][u] = 0.5f * Cu * cosf((float)((2 * x + 1) * u) * 3.14159265f / 16.0f);
+		}
+	}
+	bIDCT_Init = 1;
+}
+
+static void IDCT_Block(int32_t const* const Coeff, uint8_t* const Out)
+{
+	float Temp[64];
+
+	/* rows */
+	for (uint32_t v = 0 ; v < 8 ; ++v) {
+		for (uint32_t x = 0 ; x < 8 ; ++x) {
+			float Sum = 0.0f;
+			for (uint32_t u = 0 ; u < 8 ; ++u) {
+				Sum += IDCT_Cos[x][u] * (float)Coeff[(v << 3) + u];
+			}
+			Temp[(v << 3) + x] = Sum;
+		}
+	}
+	/* columns */
+	for (uint32_t x = 0 ; x < 8 ; ++x) {
+		for (uint32_t y = 0 ; y < 8 ; ++y) {
+			float Sum = 0.0f;
+			for (uint32_t v = 0 ; v < 8 ; ++v) {
+				Sum += IDCT_Cos[y][v] * Temp[(v << 3) + x];
+			}
+			int32_t const Sample = (int32_t)lroundf(Sum) + 128;
+			Out[(y << 3) + x] = (uint8_t)(Sample < 0 ? 0 : (Sample > 255 ? 255 : Sample));
+		}
+	}
+}
+
+static void BuildHuffmanTable(Huffman_TableTypeDef* const pTable, uint8_t const* const Counts, uint8_t const* const Values, uint32_t const NbValues)
+{
+	uint32_t Code = 0, Index = 0;
+
+	memcpy(pTable->Values, Values, NbValues);
+
+	for (uint32_t Length = 1 ; Length <= 16 ; ++Length) {
+		pTable->ValPtr[Length] = Index;
+		pTable->MinCode[Length] = Code;
+		Code += Counts[Length - 1];
+		Index += Counts[Length - 1];
+		pTable->MaxCode[Length] = (0 != Counts[Length - 1]) ? (int32_t)(Code - 1) : -1;
+		Code <<= 1;
+	}
+	pTable->MaxCode[17] = 0x7FFFFFFF; /* sentinel */
+}
+
+static uint32_t GetBit(void)
+{
+	if (0 == oSoftDecoderState.BitCount) {
+		uint32_t Byte = 0;
+
+		if (!oSoftDecoderState.bMarkerHit && oSoftDecoderState.pData < oSoftDecoderState.pDataEnd) {
+
+			Byte = *oSoftDecoderState.pData;
+
+			if (0xFF == Byte) {
+				uint8_t const Next = (oSoftDecoderState.pData + 1 < oSoftDecoderState.pDataEnd) ? oSoftDecoderState.pData[1] : MARKER_EOI;
+				if (0x00 == Next) {
+					oSoftDecoderState.pData += 2;			/* stuffed byte */
+				}
+				else {
+					oSoftDecoderState.bMarkerHit = 1;	/* marker, feed zeros until consumed by restart handling */
+					Byte = 0;
+				}
+			}
+			else {
+				++oSoftDecoderState.pData;
+			}
+		}
+		else if (!oSoftDecoderState.bMarkerHit) {
+			oSoftDecoderState.Error = JPEG_SOFT_ERROR_DATA;
+		}
+		oSoftDecoderState.BitBuffer = Byte;
+		oSoftDecoderState.BitCount = 8;
+	}
+
+	--oSoftDecoderState.BitCount;
+	return((oSoftDecoderState.BitBuffer >> oSoftDecoderState.BitCount) & 1);
+}
+
+static uint32_t GetBits(uint32_t const NbBits)
+{
+	uint32_t Value = 0;
+	for (uint32_t i = 0 ; i < NbBits ; ++i) {
+		Value = (Value << 1) | GetBit();
+	}
+	return(Value);
+}
+
+static int32_t Extend(uint32_t const Value, uint32_t const NbBits)
+{
+	return( (0 != NbBits && Value < (1u << (NbBits - 1))) ? (int32_t)Value - (int32_t)((1u << NbBits) - 1) : (int32_t)Value );
+}
+
+static int32_t DecodeHuffman(Huffman_TableTypeDef const* const pTable)
+{
+	int32_t Code = GetBit();
+	uint32_t Length = 1;
+
+	while (Code > pTable->MaxCode[Length]) {
+		Code = (Code << 1) | GetBit();
+		if (++Length > 16) {
+			oSoftDecoderState.Error = JPEG_SOFT_ERROR_HUFFMAN;
+			return(0);
+		}
+	}
+	return(pTable->Values[pTable->ValPtr[Length] + Code - pTable->MinCode[Length]]);
+}
+
+static void ProcessRestart(void)
+{
+	/* byte align, skip the RSTn marker and reset the DC prediction */
+	oSoftDecoderState.BitCount = 0;
+
+	if (oSoftDecoderState.pData + 1 < oSoftDecoderState.pDataEnd && 0xFF == oSoftDecoderState.pData[0]) {
+		uint8_t const Marker = oSoftDecoderState.pData[1];
+		if (Marker >= MARKER_RST0 && Marker <= MARKER_RST7) {
+			oSoftDecoderState.pData += 2;
+			oSoftDecoderState.bMarkerHit = 0;
+		}
+	}
+	oSoftDecoderState.DCPredictor = 0;
+	oSoftDecoderState.RestartsToGo = oSoftDecoderState.RestartInterval;
+}
+
+static void DecodeMCU(uint8_t* const Out)
+{
+	int32_t Coeff[64];
+	uint16_t const* const Quant = oSoftDecoderState.QuantTable[oSoftDecoderState.idQuant];
+
+	if (0 != oSoftDecoderState.RestartInterval) {
+		if (0 == oSoftDecoderState.RestartsToGo) {
+			ProcessRestart();
+		}
+		--oSoftDecoderState.RestartsToGo;
+	}
+
+	memset(Coeff, 0, sizeof(Coeff));
+
+	/* DC */
+	uint32_t const NbBits = DecodeHuffman(&oSoftDecoderState.DCTable[oSoftDecoderState.idDC]);
+	oSoftDecoderState.DCPredictor += Extend(GetBits(NbBits), NbBits);
+	Coeff[0] = oSoftDecoderState.DCPredictor * Quant[0];
+
+	/* AC */
+	for (uint32_t k = 1 ; k < 64 ; ) {
+		uint32_t const RS = DecodeHuffman(&oSoftDecoderState.ACTable[oSoftDecoderState.idAC]);
+		uint32_t const R = RS >> 4, S = RS & 0x0F;
+
+		if (0 == S) {
+			if (15 != R)
+				break;		/* EOB */
+			k += 16;
+			continue;
+		}
+		k += R;
+		if (k > 63) {
+			oSoftDecoderState.Error = JPEG_SOFT_ERROR_HUFFMAN;
+			break;
+		}
+		Coeff[ZIGZAG[k]] = Extend(GetBits(S), S) * Quant[k];
+		++k;
+	}
+
+	IDCT_Block(Coeff, Out);
+}
+
+static uint32_t ParseHeader(uint8_t const* pData, uint8_t const* const pDataEnd, JPEG_ConfTypeDef* const pInfo)
+{
+	uint32_t bFrame = 0;
+
+	if (pDataEnd - pData < 4 || 0xFF != pData[0] || MARKER_SOI != pData[1])
+		return(HAL_ERROR);
+	pData += 2;
+
+	while (pData + 4 <= pDataEnd) {
+
+		if (0xFF != pData[0])
+			return(HAL_ERROR);
+
+		uint8_t const Marker = pData[1];
+		if (0xFF == Marker) {		/* fill byte */
+			++pData;
+			continue;
+		}
+		uint32_t const Length = (pData[2] << 8) | pData[3];
+		uint8_t const* const pSegment = pData + 4;
+
+		if (pSegment + Length - 2 > pDataEnd)
+			return(HAL_ERROR);
+
+		switch(Marker)
+		{
+			case MARKER_SOF0:
+			case MARKER_SOF1:
+				/* 8bit precision, single component only (SDF layers are grayscale) */
+				if (8 != pSegment[0] || 1 != pSegment[5] || 0x11 != pSegment[7])
+					return(HAL_ERROR);
+				pInfo->ImageHeight = (pSegment[1] << 8) | pSegment[2];
+				pInfo->ImageWidth = (pSegment[3] << 8) | pSegment[4];
+				pInfo->ColorSpace = JPEG_GRAYSCALE_COLORSPACE;
+				pInfo->ChromaSubsampling = JPEG_444_SUBSAMPLING;
+				pInfo->ImageQuality = 0;
+				oSoftDecoderState.idQuant = pSegment[8] & 0x03;
+				bFrame = 1;
+				break;
+			case MARKER_DQT:
+			{
+				uint8_t const* p = pSegment;
+				while (p < pSegment + Length - 2) {
+					uint32_t const Precision = p[0] >> 4, id = p[0] & 0x03;
+					++p;
+					for (uint32_t k = 0 ; k < 64 ; ++k) {
+						if (Precision) {
+							oSoftDecoderState.QuantTable[id][k] = (p[0] << 8) | p[1];
+							p += 2;
+						}
+						else {
+							oSoftDecoderState.QuantTable[id][k] = *p++;
+						}
+					}
+				}
+				break;
+			}
+			case MARKER_DHT:
+			{
+				uint8_t const* p = pSegment;
+				while (p < pSegment + Length - 2) {
+					uint32_t const Class = p[0] >> 4, id = p[0] & 0x03;
+					uint32_t NbValues = 0;
+					for (uint32_t i = 0 ; i < 16 ; ++i) {
+						NbValues += p[1 + i];
+					}
+					if (NbValues > 256)
+						return(HAL_ERROR);
+					BuildHuffmanTable(Class ? &oSoftDecoderState.ACTable[id] : &oSoftDecoderState.DCTable[id], p + 1, p + 17, NbValues);
+					p += 17 + NbValues;
+				}
+				break;
+			}
+			case MARKER_DRI:
+				oSoftDecoderState.RestartInterval = (pSegment[0] << 8) | pSegment[1];
+				break;
+			case MARKER_SOS:
+				if (!bFrame || 1 != pSegment[0])
+					return(HAL_ERROR);
+				oSoftDecoderState.idDC = pSegment[2] >> 4;
+				oSoftDecoderState.idAC = pSegment[2] & 0x03;
+				/* entropy coded data follows the segment */
+				oSoftDecoderState.pData = pSegment + Length - 2;
+				oSoftDecoderState.pDataEnd = pDataEnd;
+				return(HAL_OK);
+			default:
+				if ((Marker >= 0xC2 && Marker <= 0xCF && MARKER_DHT != Marker && 0xC8 != Marker && 0xCC != Marker))
+					return(HAL_ERROR);	/* progressive / lossless / arithmetic - not supported */
+				break;	/* APPn, COM etc. skipped */
+		}
+		pData = pSegment + Length - 2;
+	}
+	return(HAL_ERROR);
+}
+
+/**
+  * @brief  Decode_Soft, parses the header and prepares the entropy decoder, no MCUs are decoded here
+  * @param  JPEGImageBuffer : jpg image buffer Address.
+  * @param  JPEGImageSize_Bytes    : jpg image size in bytes.
+  * @param  DestBuffer : L8 destination buffer Address.
+  * @retval HAL_OK or HAL_ERROR
+  */
+uint32_t JPEG_Decode_Soft(uint8_t const * const JPEGImageBuffer, uint32_t JPEGImageSize_Bytes, uint8_t* const DestBuffer)
+{
+	JPEG_ConfTypeDef Info;
+
+	if (!bIDCT_Init) {
+		InitIDCT();
+	}
+
+	memset(&oSoftDecoderState, 0, sizeof(oSoftDecoderState));
+	oSoftDecoderState.FrameBuffer = DestBuffer;
+
+	if (HAL_OK != ParseHeader(JPEGImageBuffer, JPEGImageBuffer + JPEGImageSize_Bytes, &Info)) {
+		oSoftDecoderState.Error = JPEG_SOFT_ERROR_HEADER;
+		return(HAL_ERROR);
+	}
+
+	/* same as HAL_JPEG_InfoReadyCallback of decode_dma.c */
+	if (HAL_OK != JPEG_GetDecodeColorConvertFunc(&Info, &oSoftDecoderState.pConvert_Function, &oSoftDecoderState.MCU_TotalNb)) {
+		oSoftDecoderState.Error = JPEG_SOFT_ERROR_HEADER;
+		return(HAL_ERROR);
+	}
+
+	oSoftDecoderState.RestartsToGo = oSoftDecoderState.RestartInterval;
+	oSoftDecoderState.bBusy = 1;
+
+	return(HAL_OK);
+}
+
+/**
+  * @brief  Decodes the next chunk of MCUs and converts them, call repeatedly like JPEG_OutputHandler
+  * @retval 1 : if JPEG processing has finished, 0 : if JPEG processing still ongoing (or an error occured)
+  */
+uint32_t JPEG_OutputHandler_Soft(void)
+{
+	uint32_t ConvertedDataCount;
+
+	if (!oSoftDecoderState.bBusy)
+		return(0);
+
+	uint32_t const NbMCUs = (oSoftDecoderState.MCU_TotalNb - oSoftDecoderState.MCU_BlockIndex) < CHUNK_MCUS ?
+													(oSoftDecoderState.MCU_TotalNb - oSoftDecoderState.MCU_BlockIndex) : CHUNK_MCUS;
+
+	for (uint32_t i = 0 ; i < NbMCUs ; ++i) {
+		DecodeMCU(oSoftDecoderState.MCU_Data_OutBuffer + (i << 6));
+	}
+
+	if (JPEG_SOFT_ERROR_NONE != oSoftDecoderState.Error) {
+		oSoftDecoderState.bBusy = 0;
+		return(0);
+	}
+
+	oSoftDecoderState.MCU_BlockIndex += oSoftDecoderState.pConvert_Function(oSoftDecoderState.MCU_Data_OutBuffer,
+		oSoftDecoderState.FrameBuffer, oSoftDecoderState.MCU_BlockIndex, NbMCUs << 6, &ConvertedDataCount);
+
+	if (oSoftDecoderState.MCU_BlockIndex == oSoftDecoderState.MCU_TotalNb)
+	{
+		oSoftDecoderState.bBusy = 0;
+		return 1;
+	}
+	return 0;
+}
+
+uint32_t const getSoft_MCUBlockIndex()
+{
+	return(oSoftDecoderState.MCU_BlockIndex);
+}
+uint32_t const getSoft_MCUTotalNb()
+{
+	return(oSoftDecoderState.MCU_TotalNb);
+}
+uint32_t const getSoft_Error()
+{
+	return(oSoftDecoderState.Error);
+}
+uint32_t const getSoft_IsBusy()
+{
+	return(oSoftDecoderState.bBusy);
+}
+
+#endif /* JPEG_SOFTWARE_DECODER */
@@ -113,7 +113,7 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
-#include "JPEG\jpeg_utils.h"
+#include "JPEG/jpeg_utils.h"
 #include "globals.h"
 
 /** @addtogroup Utilities
@@ -9,8 +9,8 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
  */
 
 #include "globals.h"
-#include "lighting.h"
-#include "IsoVoxel.h"
+#include "Lighting.h"
+#include "isoVoxel.h"
 #include "world.h"
 
 using namespace Lighting;
@@ -75,10 +75,99 @@ uLightingDefaults::uLightingDefaults()
 }
 
 ActiveLightSet::ActiveLightSet()
-	: Lights{nullptr}, NumActive(0), tLastUpdate(0)
+	: Lights{nullptr}, NumActive(0), tLastUpdate(0), NumEmitted(0), ClusterLights{0}
 {
+	for ( uint32_t iDx = 0 ; iDx < MAX_NUM_EMITTED_LIGHTS ; ++iDx ) {
+		Lights[MAX_NUM_ACTIVE_LIGHTS + iDx] = &Emitted[iDx];
+	}
+}
+
+namespace ShadowMap
+{
+uint32_t Cells[SIZE * SIZE];		// zero initialized, grid (0,0) unshadowed
+Light const* Caster(nullptr);
+vec2_t vScreenOrigin;
+
+} // end namespace
+
+#ifdef SHADE_CACHE
+namespace ShadeCache
+{
+sEntry<1> Points[NUM_POINT_ENTRIES];
+sEntry<SHADE_BATCH_SIZE> Batches[NUM_BATCH_ENTRIES];
+uint32_t Generation(1);		// zero initialized entries must never match
+
+#ifdef STAGE_PROFILING
+uint32_t Lookups, Hits, Invalidations;
+#endif
+
+void Invalidate()
+{
+#ifdef STAGE_PROFILING
+	++Invalidations;
+#endif
+	Generation = (Generation + 1) & ((1 << (32 - GENERATION_SHIFT)) - 1);
+	
+	if ( unlikely(0 == Generation) ) { // wrapped, entries from an older generation with the same tag could match again
+		memset(Points, 0, sizeof(Points));
+		memset(Batches, 0, sizeof(Batches));
+		Generation = 1;
+	}
 }
 
+#if defined(STAGE_PROFILING) && defined(HOST_BUILD)
+NOINLINE void Report()
+{
+	printf("shade cache %u hits of %u lookups (%.1f%%), %u invalidations\n", Hits, Lookups, 
+				 (0 != Lookups) ? (100.0 * (double)Hits / (double)Lookups) : 0.0, Invalidations);
+}
+#endif
+
+// everything of a light the lighting depends on, compared bit exact frame to frame
+typedef struct sLightKey
+{
+	Light const*	pLight;
+	vec3_t				Position;
+	float					IntensityDiffuse,
+								IntensityAmbient,
+								FalloffMaxDistance,
+								InvFalloffMaxDistance,
+								InvRadiusSquared;
+} LightKey;
+
+static LightKey LastKeys[MAX_NUM_LIGHTS];
+static uint32_t LastNumKeys;
+
+static bool const UpdateLightKeys( ActiveLightSet const& __restrict Set )
+{
+	LightKey Keys[MAX_NUM_LIGHTS];
+	uint32_t const NumKeys( Set.getNumActiveLights() + Set.getNumEmittedLights() );
+	
+	memset(Keys, 0, sizeof(Keys));	// padding compares equal
+	for ( uint32_t iDx = 0 ; iDx < NumKeys ; ++iDx )
+	{
+		Light const* const __restrict pLight( iDx < Set.getNumActiveLights() ? Set.Lights[iDx] : &Set.Emitted[iDx - Set.getNumActiveLights()] );
+		
+		Keys[iDx].pLight = pLight;
+		Keys[iDx].Position = pLight->Position;
+		Keys[iDx].IntensityDiffuse = pLight->IntensityDiffuse;
+		Keys[iDx].IntensityAmbient = pLight->IntensityAmbient;
+		Keys[iDx].FalloffMaxDistance = pLight->FalloffMaxDistance;
+		Keys[iDx].InvFalloffMaxDistance = pLight->InvFalloffMaxDistance;
+		Keys[iDx].InvRadiusSquared = pLight->InvRadiusSquared;
+	}
+	
+	bool const bChanged( NumKeys != LastNumKeys || 0 != memcmp(Keys, LastKeys, NumKeys * sizeof(LightKey)) );
+	
+	memcpy(LastKeys, Keys, sizeof(Keys));
+	LastNumKeys = NumKeys;
+	
+	return(bChanged);
+}
+
+} // end namespace
+#endif /*SHADE_CACHE*/
+
 void ActiveLightSet::sLightState::Initialize( sLight* const __restrict pLight, uint32_t const tNow )
 {
 	Light = pLight;
@@ -156,7 +245,7 @@ bool const ActiveLightSet::ActivateLight(vec2_t Location, uint32_t const LightIn
 			// set position
 			pLightState->Light->Position = vec3_t(Location.x, pLightState->Light->Position.y, Location.y);
 			// add to the active lights array
-			Lights[++NumActive] = pLightState->Light;
+			Lights[NumActive++] = pLightState->Light;
 			
 			// must run:
 			UpdateLightPointers();
@@ -301,4 +390,57 @@ void ActiveLightSet::UpdateActiveLighting(uint32_t const tNow)
 	}
 }
 
+bool const ActiveLightSet::EmitLight(vec2_t const WorldLocation, float const fHeight, float const fDiffuse, float const fAmbient, float const fFalloff, float const fRadius)
+{
+	if ( NumEmitted < MAX_NUM_EMITTED_LIGHTS )
+	{
+		vec2_t const Location( world::v2_GridToScreen(WorldLocation) );
+		
+		Light* const __restrict pLight(&Emitted[NumEmitted]);
+		
+		*pLight = Light(fDiffuse, fAmbient, fFalloff, vec3_t(Location.x, fHeight, Location.y));
+		pLight->setRadius(fRadius);
+		
+		++NumEmitted;
+		return(true);
+	}
+	return(false);
+}
+void ActiveLightSet::ResetEmittedLights()
+{
+	NumEmitted = 0;
+}
+
+void ActiveLightSet::BuildClusters()
+{
+	memset(ClusterLights, 0, sizeof(ClusterLights));
+	
+	// world lights are unbounded and are always added by getClusterLightsMask, only emitted lights are binned
+	for ( uint32_t iDx = 0 ; iDx < NumEmitted ; ++iDx )
+	{
+		Light const& __restrict oLight(Emitted[iDx]);
+		uint32_t const uiLightBit(1U << (MAX_NUM_ACTIVE_LIGHTS + iDx));
+		
+		int32_t const iRadius( int32::__ceilf(oLight.Radius) );
+		int32_t const xPixel( int32::__roundf(oLight.Position.x) ),
+									yPixel( int32::__roundf(oLight.Position.z) );
+		
+		// depth levels are monotonic in screen y, so the slices covered are the slices of the extents
+		uint32_t const uiTileBegin(getClusterTile(xPixel - iRadius)), uiTileEnd(getClusterTile(xPixel + iRadius)),
+									 uiSliceBegin(getClusterSlice(yPixel - iRadius)), uiSliceEnd(getClusterSlice(yPixel + iRadius));
+		
+		for ( uint32_t uiSlice = uiSliceBegin ; uiSlice <= uiSliceEnd ; ++uiSlice ) {
+			for ( uint32_t uiTile = uiTileBegin ; uiTile <= uiTileEnd ; ++uiTile ) {
+				ClusterLights[uiSlice * NUM_CLUSTER_TILES + uiTile] |= uiLightBit;
+			}
+		}
+	}
+	
+#ifdef SHADE_CACHE
+	if ( ShadeCache::UpdateLightKeys(*this) ) {	// clusters are derived from the lights aswell
+		ShadeCache::Invalidate();
+	}
+#endif
+}
+
 } // end namespace
\ No newline at end of file
@@ -0,0 +1,515 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "OLEDBenchmark.h"
+
+#ifdef OLED_MICROBENCHMARK
+
+#include "oled.h"
+#include "isodepth.h"
+#include "rng.h"
+#include "DTCM_Reserve.h"
+#include "isoVoxel.h"
+#include "FLASH/imports.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+namespace OLEDBenchmark
+{
+static constexpr uint32_t const NUM_CALLS = 4096,
+																MIN_DURATION_US = 20000,	// per case
+																MAX_REPETITIONS = 1000,
+																SEED = 0xB3AC4;
+
+// depth buffer columns are runs of one level, short enough that most columns still fit in DepthSpans::MAX_SPANS
+static constexpr uint32_t const MIN_DEPTH_RUN = 2,
+																MAX_DEPTH_RUN = 10;
+
+#ifdef DEPTH_SPANS
+static constexpr char const* const DEPTH_MODE = "spans";
+#else
+static constexpr char const* const DEPTH_MODE = "pixels";
+#endif
+
+// adjacent buildings for the depth tie count, plots per side of a grid centred on screen (top rows are above the screen)
+static constexpr int32_t const TIE_GRID = 15,
+															 TIE_MAX_HEIGHT = 48;
+
+typedef struct sLengthBucket
+{
+	uint16_t	Min, Max, Weight;		// weight in percent
+} LengthBucket;
+
+// vertical spans: ground faces are a few pixels tall, building faces reach the screen height
+static constexpr LengthBucket const VLINE_LENGTHS[] = { {1, 3, 25}, {4, 12, 45}, {13, 32, 22}, {33, 64, 8} };
+// horizontal spans: mostly text, effects and fills
+static constexpr LengthBucket const HLINE_LENGTHS[] = { {1, 8, 40}, {9, 32, 35}, {33, 96, 20}, {97, 256, 5} };
+static constexpr LengthBucket const LINE_LENGTHS[] = { {2, 16, 50}, {17, 64, 35}, {65, 200, 15} };
+// masked spans are limited by the height of the ao mask
+static constexpr LengthBucket const MASKED_LENGTHS[] = { {1, 3, 30}, {4, 8, 50}, {9, top_ao_numoflines, 20} };
+
+typedef struct sCall
+{
+	uint16_t	x, y,
+						x1, y1,					// line end point
+						Length;
+	uint8_t		xMask, yMask;
+	int32_t		Depth;
+	uint32_t	AlphaLuma;
+} Call;
+
+typedef struct sCallList
+{
+	Call			Calls[NUM_CALLS];
+	uint32_t	Pixels;					// nominal
+} CallList;
+
+static struct sBenchmark
+{
+	CallList	VLines, HLines, Lines, Masked, Pixels;
+
+	// snapshot restored before every repetition
+	uint8_t		BackBuffer[OLED::SCREEN_HEIGHT][OLED::SCREEN_WIDTH];
+	uint32_t	FrontBuffer[OLED::SCREEN_HEIGHT][OLED::SCREEN_WIDTH];
+	depth_t		DepthBuffer[OLED::SCREEN_WIDTH][OLED::SCREEN_HEIGHT];
+	uint8_t		BloomBuffer[OLED::SCREEN_HEIGHT][OLED::SCREEN_WIDTH];
+
+	FILE*			fpCSV;
+	uint32_t	NumCases;
+} oBench;
+
+/// * call list generation * ///
+template<uint32_t const N>
+static uint32_t const getLength(LengthBucket const (&Buckets)[N])
+{
+	int32_t Roll(PsuedoRandomNumber(0, 100));
+
+	for ( uint32_t iDx = 0 ; iDx < N ; ++iDx ) {
+		if ( (Roll -= Buckets[iDx].Weight) < 0 )
+			return( PsuedoRandomNumber(Buckets[iDx].Min, Buckets[iDx].Max - Buckets[iDx].Min + 1) );
+	}
+	return(Buckets[N - 1].Max);
+}
+
+static void InitCall(Call& __restrict oCall)
+{
+	oCall.x = PsuedoRandomNumber(0, OLED::SCREEN_WIDTH);
+	oCall.y = PsuedoRandomNumber(0, OLED::SCREEN_HEIGHT);
+	oCall.x1 = oCall.x;
+	oCall.y1 = oCall.y;
+	oCall.Length = 1;
+	oCall.xMask = 0;
+	oCall.yMask = 0;
+	oCall.Depth = PsuedoRandomNumber(INT8_MIN, UINT8_MAX + 1) << IsoDepth::DEPTH_FRACTION_BITS;
+	oCall.AlphaLuma = xDMA2D::AlphaLuma( PsuedoRandomNumber(1, UINT8_MAX), PsuedoRandomNumber(1, UINT8_MAX) ).v;
+}
+
+template<uint32_t const N>
+static void GenerateSpans(CallList& __restrict List, LengthBucket const (&Buckets)[N], bool const bVertical)
+{
+	List.Pixels = 0;
+	for ( uint32_t iDx = 0 ; iDx < NUM_CALLS ; ++iDx ) {
+
+		Call& oCall(List.Calls[iDx]);
+		InitCall(oCall);
+
+		// callers in the renderer only pass spans that start onscreen, the primitives clamp the end
+		oCall.Length = getLength(Buckets);
+		List.Pixels += min((uint32_t)oCall.Length, bVertical ? OLED::SCREEN_HEIGHT - oCall.y : OLED::SCREEN_WIDTH - oCall.x);
+	}
+}
+
+static void GenerateLines(CallList& __restrict List)
+{
+	List.Pixels = 0;
+	for ( uint32_t iDx = 0 ; iDx < NUM_CALLS ; ++iDx ) {
+
+		Call& oCall(List.Calls[iDx]);
+		InitCall(oCall);
+
+		// any direction, end point kept onscreen
+		int32_t const Length(getLength(LINE_LENGTHS));
+		float const fAngle(PsuedoRandomFloat() * (2.0f * MathConstants::kPI));
+
+		oCall.x1 = __USAT( (int32_t)oCall.x + int32::__roundf(__cosf(fAngle) * (float)Length), OLED::Width_SATBITS );
+		oCall.y1 = __USAT( (int32_t)oCall.y + int32::__roundf(__sinf(fAngle) * (float)Length * 0.5f), OLED::Height_SATBITS );	// isometric, half height
+		oCall.Length = max(absolute((int32_t)oCall.x1 - (int32_t)oCall.x), absolute((int32_t)oCall.y1 - (int32_t)oCall.y)) + 1;
+
+		List.Pixels += oCall.Length;
+	}
+}
+
+static void GenerateMasked(CallList& __restrict List)
+{
+	List.Pixels = 0;
+	for ( uint32_t iDx = 0 ; iDx < NUM_CALLS ; ++iDx ) {
+
+		Call& oCall(List.Calls[iDx]);
+		InitCall(oCall);
+
+		oCall.Length = getLength(MASKED_LENGTHS);
+		oCall.xMask = PsuedoRandomNumber(0, top_ao_stride);
+		oCall.yMask = PsuedoRandomNumber(0, top_ao_numoflines - oCall.Length + 1);	// whole span stays inside the mask
+		List.Pixels += min((uint32_t)oCall.Length, OLED::SCREEN_HEIGHT - oCall.y);
+	}
+}
+
+static void GeneratePixels(CallList& __restrict List)
+{
+	for ( uint32_t iDx = 0 ; iDx < NUM_CALLS ; ++iDx ) {
+		InitCall(List.Calls[iDx]);
+	}
+	List.Pixels = NUM_CALLS;
+}
+
+static void GenerateBuffers()
+{
+	for ( uint32_t y = 0 ; y < OLED::SCREEN_HEIGHT ; ++y ) {
+		for ( uint32_t x = 0 ; x < OLED::SCREEN_WIDTH ; ++x ) {
+
+			oBench.BackBuffer[y][x] = PsuedoRandomNumber(0, UINT8_MAX + 1);
+			oBench.FrontBuffer[y][x] = (PsuedoRandom5050() ? 0 : xDMA2D::AlphaLuma( PsuedoRandomNumber(1, UINT8_MAX), PsuedoRandomNumber(0, UINT8_MAX + 1) ).v);
+			oBench.BloomBuffer[y][x] = 0;
+		}
+	}
+	// every voxel face is drawn at one depth level, so columns of the depth buffer are runs of a random level
+	for ( uint32_t x = 0 ; x < OLED::SCREEN_WIDTH ; ++x ) {
+		
+		uint32_t y(0);
+		while ( y < OLED::SCREEN_HEIGHT ) {
+			
+			uint32_t const yEnd( min(y + PsuedoRandomNumber(MIN_DEPTH_RUN, MAX_DEPTH_RUN - MIN_DEPTH_RUN + 1), OLED::SCREEN_HEIGHT) );
+			int32_t const Depth( PsuedoRandomNumber(INT8_MIN, UINT8_MAX + 1) << IsoDepth::DEPTH_FRACTION_BITS );
+			
+			for ( ; y < yEnd ; ++y ) {
+				oBench.DepthBuffer[x][y] = Depth;
+			}
+		}
+	}
+}
+
+static void RestoreBuffers()
+{
+	memcpy(DTCM::getBackBuffer(), oBench.BackBuffer, sizeof(oBench.BackBuffer));
+	memcpy(DTCM::getFrontBuffer(), oBench.FrontBuffer, sizeof(oBench.FrontBuffer));
+	memcpy(DTCM::getDepthBuffer(), oBench.DepthBuffer, sizeof(oBench.DepthBuffer));
+	OLED::InvalidateHiZ();
+#ifdef DEPTH_SPANS
+	OLED::RebuildDepthSpans();
+#endif
+	memcpy(BloomHDRTargetFrameBuffer, oBench.BloomBuffer, sizeof(oBench.BloomBuffer));
+}
+
+/// * primitives * ///
+// each is a NOINLINE loop over the whole call list, the depth level is selected per call as the renderer does per voxel / model
+
+STATIC_INLINE void SelectDepth(Call const& oCall)
+{
+	IsoDepth_Private.CurSelectedDepthLevel = oCall.Depth;
+}
+
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct VLine
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+			SelectDepth(oCall);
+			OLED::DrawVLine<TargetBuffer, RenderingFlags>(oCall.x, oCall.y, oCall.Length, oCall.AlphaLuma);
+		}
+	}
+};
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct VLine_Masked	// back buffer only
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+
+			// Origin / MaskOrigin are const, built per call like the renderer does per voxel
+			point2D_t const Start(oCall.x, oCall.y);
+			OLED::MaskDesc const descMask = { DTCM::_sram_top_ao_atlas[DTCM::AO_TOP_VARIANTS - 1], top_ao_stride, Start, point2D_t(oCall.xMask, oCall.yMask), 0 };
+
+			SelectDepth(oCall);
+			OLED::DrawVLine_Masked<RenderingFlags>(Start, oCall.Length, oCall.AlphaLuma, descMask);
+		}
+	}
+};
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct HLine
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+			SelectDepth(oCall);
+			OLED::DrawHLine<TargetBuffer, RenderingFlags>(oCall.x, oCall.y, oCall.Length, oCall.AlphaLuma);
+		}
+	}
+};
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct HLineBlendFast	// front buffer, no flags
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+			OLED::DrawHLineBlendFast(oCall.x, oCall.y, oCall.Length, oCall.AlphaLuma);
+		}
+	}
+};
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct Line
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+			// DrawLine selects the farthest depth level itself
+			OLED::DrawLine<TargetBuffer, RenderingFlags>(oCall.x, oCall.y, oCall.x1, oCall.y1, oCall.AlphaLuma);
+		}
+	}
+};
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct PixelAA
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+			SelectDepth(oCall);
+			if constexpr ( OLED::BACK_BUFFER == TargetBuffer )
+				OLED::DrawPixelAA_BackBuffer<RenderingFlags>(oCall.x, oCall.y, oCall.AlphaLuma);
+			else
+				OLED::DrawPixelAA_FrontBuffer<RenderingFlags>(oCall.x, oCall.y, oCall.AlphaLuma);
+		}
+	}
+};
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct Pixel
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+			SelectDepth(oCall);
+			(void)OLED::LL_DrawPixel<TargetBuffer, RenderingFlags>(oCall.x, oCall.y, oCall.AlphaLuma);
+		}
+	}
+};
+template<uint32_t const TargetBuffer, uint32_t const RenderingFlags>
+struct BloomHDRPixel	// no flags
+{
+	static NOINLINE void Run(CallList const& __restrict List)
+	{
+		for ( Call const& oCall : List.Calls ) {
+			OLED::LL_DrawBloomHDRPixel<TargetBuffer>(oCall.x, oCall.y, oCall.AlphaLuma);
+		}
+	}
+};
+
+/// * measurement * ///
+static void getFlagsString(char* const szFlags, uint32_t const RenderingFlags)
+{
+	static char const FLAG_CHAR[] = { 'S', 'Z', 'W', '-', 'N' };	// shade, z, zwrite, (retired), no bloom
+
+	for ( uint32_t iBit = 0 ; iBit < countof(FLAG_CHAR) ; ++iBit ) {
+		szFlags[iBit] = (RenderingFlags & (1 << iBit)) ? FLAG_CHAR[iBit] : '-';
+	}
+	szFlags[countof(FLAG_CHAR)] = 0;
+}
+
+static void Measure(char const* const szPrimitive, uint32_t const TargetBuffer, uint32_t const RenderingFlags,
+										CallList const& __restrict List, void (* const Run)(CallList const& __restrict))
+{
+	RestoreBuffers();
+	Run(List);	// warm up
+
+	uint32_t tTotal(0), Repetitions(0);
+	do {
+		RestoreBuffers();
+
+		uint32_t const tStart(micros());
+		Run(List);
+		tTotal += micros() - tStart;
+
+	} while ( ++Repetitions < MAX_REPETITIONS && tTotal < MIN_DURATION_US );
+
+	double const Seconds( (double)max(tTotal, 1U) * 1e-6 ),
+							 Calls( (double)Repetitions * (double)NUM_CALLS ),
+							 Pixels( (double)Repetitions * (double)List.Pixels );
+
+	char szFlags[8];
+	getFlagsString(szFlags, RenderingFlags);
+
+	char const* const szTarget( OLED::BACK_BUFFER == TargetBuffer ? "back" : "front" );
+
+	printf("%-20s %-5s %s %-6s %10.3f Mcalls/s %10.3f Mpix/s\n", szPrimitive, szTarget, szFlags, DEPTH_MODE, Calls / Seconds * 1e-6, Pixels / Seconds * 1e-6);
+	if ( nullptr != oBench.fpCSV ) {
+		fprintf(oBench.fpCSV, "%s,%s,%s,%u,%s,%.0f,%.0f,%u,%.0f,%.0f\n", szPrimitive, szTarget, szFlags, RenderingFlags, DEPTH_MODE,
+						Calls, Pixels, tTotal, Calls / Seconds, Pixels / Seconds);
+	}
+	++oBench.NumCases;
+}
+
+/// * depth precision * ///
+// a grid of plots with random heights, silhouettes as RenderBox_AO (base diamond + height) at one depth level each.
+// the grid is rendered into the depth buffer in grid order and again in reverse, each building writing its id
+// as luma. Pixels whose winner changes with the order are decided by a depth tie, those pixels fight as the camera moves
+typedef struct sTieBox
+{
+	int32_t		x, y,			// base diamond centre
+						Height;
+} TieBox;
+
+static void RenderTieBoxes( TieBox const (&Boxes)[TIE_GRID][TIE_GRID], bool const bReverse )
+{
+	static constexpr int32_t const RADII( Iso::GRID_RADII ), HALF_RADII( Iso::GRID_RADII >> 1 );
+	static constexpr uint32_t const NUM_BOXES( TIE_GRID * TIE_GRID );
+	
+	memset(DTCM::getBackBuffer(), 0, sizeof(oBench.BackBuffer));
+	OLED::FillDepth(&DTCM::getDepthBuffer()[0][0], IsoDepth::DEPTH_MIN, OLED::SCREEN_WIDTH * OLED::SCREEN_HEIGHT);
+#ifdef DEPTH_SPANS
+	OLED::ClearDepthSpans();
+#endif
+	
+	for ( uint32_t iBox = 0 ; iBox < NUM_BOXES ; ++iBox ) {
+		
+		uint32_t const Id( bReverse ? NUM_BOXES - 1 - iBox : iBox );
+		TieBox const& oBox( Boxes[Id / TIE_GRID][Id % TIE_GRID] );
+		xDMA2D::AlphaLuma const IdLuma( 0xFF, Id + 1 );	// 0 is uncovered
+		
+		OLED::setDepthLevel(oBox.y, oBox.x);
+		
+		for ( int32_t dx = -RADII ; dx <= RADII ; ++dx ) {
+			
+			int32_t const x( oBox.x + dx );
+			if ( x < 0 || x >= (int32_t)OLED::SCREEN_WIDTH )
+				continue;
+			
+			int32_t const Edge( abs(dx) >> 1 ),
+										yTop( max(oBox.y - HALF_RADII - oBox.Height + Edge, 0) ),
+										yBottom( min(oBox.y + HALF_RADII - Edge, (int32_t)OLED::SCREEN_HEIGHT - 1) );
+			
+			for ( int32_t y = yTop ; y <= yBottom ; ++y ) {
+				(void)OLED::LL_DrawPixel<OLED::BACK_BUFFER, (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>( x, y, IdLuma );
+			}
+		}
+	}
+}
+
+// returns the number of pixels whose winner depends on draw order
+static uint32_t const MeasureDepthTies()
+{
+	static_assert(TIE_GRID * TIE_GRID <= UINT8_MAX, "building id + 1 is the back buffer luma");
+	
+	static TieBox Boxes[TIE_GRID][TIE_GRID];
+	static uint8_t Forward[OLED::SCREEN_HEIGHT][OLED::SCREEN_WIDTH];
+	
+	// first "frame" tracks the depth range, levels are then selected against it as the next frame does
+	for ( int32_t gy = 0 ; gy < TIE_GRID ; ++gy ) {
+		for ( int32_t gx = 0 ; gx < TIE_GRID ; ++gx ) {
+			
+			TieBox& oBox(Boxes[gy][gx]);
+			oBox.x = (int32_t)OLED::HALF_WIDTH + (gx - gy) * (int32_t)Iso::GRID_RADII;
+			oBox.y = (int32_t)OLED::HALF_HEIGHT + (gx + gy - TIE_GRID) * (int32_t)(Iso::GRID_RADII >> 1);
+			oBox.Height = PsuedoRandomNumber(0, TIE_MAX_HEIGHT + 1);
+			
+			OLED::setDepthLevel(oBox.y, oBox.x);
+		}
+	}
+	IsoDepth::UpdateDynamicRange();
+	
+	RenderTieBoxes(Boxes, false);
+	memcpy(Forward, DTCM::getBackBuffer(), sizeof(Forward));
+	RenderTieBoxes(Boxes, true);
+	
+	uint32_t Pixels(0), OrderDependent(0);
+	
+	for ( uint32_t y = 0 ; y < OLED::SCREEN_HEIGHT ; ++y ) {
+		for ( uint32_t x = 0 ; x < OLED::SCREEN_WIDTH ; ++x ) {
+			
+			uint32_t const Winner( DTCM::getBackBuffer()[y][x] );
+			
+			Pixels += (0 != Winner);
+			OrderDependent += (Forward[y][x] != Winner);
+		}
+	}
+	OLED::InvalidateHiZ();
+	
+	printf("%-20s %-6s %u of %u covered pixels depend on draw order, %u bit depth, DepthBuffer %u bytes\n", "depth ties", DEPTH_MODE,
+				 OrderDependent, Pixels, IsoDepth::DEPTH_BITS, (uint32_t)sizeof(DTCM::DepthBuffer));
+	
+	return(OrderDependent);
+}
+
+template<template<uint32_t const, uint32_t const> class Primitive, uint32_t const TargetBuffer, uint32_t... RenderingFlags>
+static void MeasureAllFlags(char const* const szPrimitive, CallList const& __restrict List, std::integer_sequence<uint32_t, RenderingFlags...>)
+{
+	( Measure(szPrimitive, TargetBuffer, RenderingFlags, List, &Primitive<TargetBuffer, RenderingFlags>::Run), ... );
+}
+
+NOINLINE int const Run()
+{
+	// every combination of SHADE, Z, ZWRITE, BLOOM_DISABLE (bit 3 was per pixel fog)
+	static_assert(8 == (OLED::ZWRITE_ENABLE << 1) && 16 == OLED::BLOOM_DISABLE, "flag list below");
+	typedef std::integer_sequence<uint32_t,  0,  1,  2,  3,  4,  5,  6,  7,
+																					16, 17, 18, 19, 20, 21, 22, 23> AllFlags;
+	typedef std::integer_sequence<uint32_t, 0> NoFlags;
+
+	char const* szCSV = getenv("OLED_BENCH_CSV");
+	if ( nullptr == szCSV )
+		szCSV = "oled_bench.csv";
+
+	oBench.fpCSV = fopen(szCSV, "w");
+	if ( nullptr != oBench.fpCSV )
+		fprintf(oBench.fpCSV, "primitive,target,flags,flags_value,depth,calls,pixels,us,calls_per_s,pixels_per_s\n");
+
+	// deterministic, identical call lists every run
+	PsuedoSetSeed(SEED);
+	GenerateSpans(oBench.VLines, VLINE_LENGTHS, true);
+	GenerateSpans(oBench.HLines, HLINE_LENGTHS, false);
+	GenerateLines(oBench.Lines);
+	GenerateMasked(oBench.Masked);
+	GeneratePixels(oBench.Pixels);
+	GenerateBuffers();
+
+	MeasureAllFlags<VLine, OLED::BACK_BUFFER>("DrawVLine", oBench.VLines, AllFlags{});
+	MeasureAllFlags<VLine, OLED::FRONT_BUFFER>("DrawVLine", oBench.VLines, AllFlags{});
+	MeasureAllFlags<VLine_Masked, OLED::BACK_BUFFER>("DrawVLine_Masked", oBench.Masked, AllFlags{});
+	MeasureAllFlags<HLine, OLED::BACK_BUFFER>("DrawHLine", oBench.HLines, AllFlags{});
+	MeasureAllFlags<HLine, OLED::FRONT_BUFFER>("DrawHLine", oBench.HLines, AllFlags{});
+	MeasureAllFlags<HLineBlendFast, OLED::FRONT_BUFFER>("DrawHLineBlendFast", oBench.HLines, NoFlags{});
+	MeasureAllFlags<Line, OLED::BACK_BUFFER>("DrawLine", oBench.Lines, AllFlags{});
+	MeasureAllFlags<Line, OLED::FRONT_BUFFER>("DrawLine", oBench.Lines, AllFlags{});
+	MeasureAllFlags<PixelAA, OLED::BACK_BUFFER>("DrawPixelAA", oBench.Pixels, AllFlags{});
+	MeasureAllFlags<PixelAA, OLED::FRONT_BUFFER>("DrawPixelAA", oBench.Pixels, AllFlags{});
+	MeasureAllFlags<Pixel, OLED::BACK_BUFFER>("LL_DrawPixel", oBench.Pixels, AllFlags{});
+	MeasureAllFlags<Pixel, OLED::FRONT_BUFFER>("LL_DrawPixel", oBench.Pixels, AllFlags{});
+	MeasureAllFlags<BloomHDRPixel, OLED::BACK_BUFFER>("LL_DrawBloomHDRPixel", oBench.Pixels, NoFlags{});
+	MeasureAllFlags<BloomHDRPixel, OLED::FRONT_BUFFER>("LL_DrawBloomHDRPixel", oBench.Pixels, NoFlags{});
+
+	uint32_t const OrderDependent( MeasureDepthTies() );	// last, changes the depth range
+
+	if ( nullptr != oBench.fpCSV ) {
+		fclose(oBench.fpCSV);
+		printf("oled bench: %u cases written to %s\n", oBench.NumCases, szCSV);
+	}
+
+#ifdef DEPTH_16BIT
+	if ( 0 != OrderDependent ) {	// x in the fraction orders every pair of adjacent buildings
+		printf("oled bench: FAILED, 16 bit depth still ties\n");
+		return(1);
+	}
+#endif
+	return(0);
+}
+
+} // end namespace
+
+#endif /*OLED_MICROBENCHMARK*/
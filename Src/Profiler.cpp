@@ -0,0 +1,190 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "Profiler.h"
+
+#ifdef STAGE_PROFILING
+
+#include "Debug.cpp"
+
+#ifdef HOST_BUILD
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+namespace Profiler
+{
+static char const* const szStageName[NUM_STAGES] = { "grid", "ground", "structure", "hashplot", "destruction", "effect",
+																										 "shockwave", "explosion", "missile", "oled", "bloom", "sendfb", "update", "fog", "shadow" };
+
+// samples are stored as uint16_t us, anything longer than 65ms saturates
+static constexpr uint32_t const SAMPLE_MAX = UINT16_MAX;
+
+static struct sProfiler
+{
+	uint16_t				Ring[NUM_STAGES][NUM_SAMPLES];
+	uint32_t				Head[NUM_STAGES],							// next write position
+									Count[NUM_STAGES];						// valid samples, saturates at NUM_SAMPLES
+
+	uint32_t				FrameTotal[NUM_STAGES];				// us, accumulated this frame
+	uint32_t				FrameEntered;									// bit per stage, entered this frame
+
+	uint16_t				Sorted[NUM_SAMPLES];					// scratch for the percentiles
+
+	uint32_t				tLastReport,
+									ReportStage,
+									FramesSinceExport;
+
+	sProfiler()
+	: Head{}, Count{}, FrameTotal{}, FrameEntered(0), tLastReport(0), ReportStage(0), FramesSinceExport(0)
+	{}
+} oProfiler;
+
+static_assert( NUM_STAGES <= 32, "FrameEntered bitmask too small" );
+static_assert( 0 == (NUM_SAMPLES & (NUM_SAMPLES - 1)), "NUM_SAMPLES must be a power of 2" );
+
+// Stages sampled from the lp timer interrupt (SEND_FRAMEBUFFER) can be pushed while the main loop is reading the same ring
+// for a report, worst case one sample in the reported percentiles is torn. Rings are never shared between the interrupt and
+// the main loop for writing, so no critical section is taken here.
+STATIC_INLINE void Push(uint32_t const Stage, uint32_t const tDelta)
+{
+	uint32_t const Head(oProfiler.Head[Stage]);
+
+	oProfiler.Ring[Stage][Head] = (uint16_t)(tDelta < SAMPLE_MAX ? tDelta : SAMPLE_MAX);
+	oProfiler.Head[Stage] = (Head + 1) & (NUM_SAMPLES - 1);
+
+	if ( oProfiler.Count[Stage] < NUM_SAMPLES )
+		++oProfiler.Count[Stage];
+}
+
+void Accumulate(uint32_t const Stage, uint32_t const tDelta)
+{
+	oProfiler.FrameTotal[Stage] += tDelta;
+	oProfiler.FrameEntered |= (1 << Stage);
+}
+
+void Sample(uint32_t const Stage, uint32_t const tDelta)
+{
+	Push(Stage, tDelta);
+}
+
+char const* const getStageName(uint32_t const Stage)
+{
+	return(szStageName[Stage]);
+}
+
+NOINLINE void getStageStats(uint32_t const Stage, StageStats& __restrict Stats)
+{
+	uint32_t const Count(oProfiler.Count[Stage]);
+
+	Stats = StageStats{};
+	Stats.Samples = Count;
+
+	if ( 0 == Count )
+		return;
+
+	// the ring is filled from index 0 until it wraps, so the first Count entries are always the valid ones
+	// insertion sort, 128 entries at report time only
+	uint16_t* const __restrict Sorted(oProfiler.Sorted);
+	for ( uint32_t iDx = 0 ; iDx < Count ; ++iDx ) {
+
+		uint16_t const Value(oProfiler.Ring[Stage][iDx]);
+		int32_t iPos(iDx - 1);
+
+		while ( iPos >= 0 && Sorted[iPos] > Value ) {
+			Sorted[iPos + 1] = Sorted[iPos];
+			--iPos;
+		}
+		Sorted[iPos + 1] = Value;
+	}
+
+	// nearest rank
+	Stats.Min = Sorted[0];
+	Stats.P50 = Sorted[((Count * 50 + 99) / 100) - 1];
+	Stats.P99 = Sorted[((Count * 99 + 99) / 100) - 1];
+	Stats.Max = Sorted[Count - 1];
+}
+
+#ifdef HOST_BUILD
+NOINLINE bool const ExportCSV(char const* szPath)
+{
+	if ( nullptr == szPath ) {
+		szPath = getenv("PROFILE_CSV");
+		if ( nullptr == szPath )
+			szPath = "profile.csv";
+	}
+
+	FILE* const fp = fopen(szPath, "w");
+	if ( nullptr == fp )
+		return(false);
+
+	fprintf(fp, "stage,samples,min_us,p50_us,p99_us,max_us\n");
+	for ( uint32_t iStage = 0 ; iStage < NUM_STAGES ; ++iStage ) {
+
+		StageStats Stats;
+		getStageStats(iStage, Stats);
+
+		fprintf(fp, "%s,%u,%u,%u,%u,%u\n", szStageName[iStage], Stats.Samples, Stats.Min, Stats.P50, Stats.P99, Stats.Max);
+	}
+
+	fclose(fp);
+	return(true);
+}
+#endif
+
+static void Report(uint32_t const tNow)
+{
+	if ( tNow - oProfiler.tLastReport < REPORT_INTERVAL )
+		return;
+
+	// skip stages that have never been entered (ie. no explosion yet)
+	uint32_t iStage(oProfiler.ReportStage), iTries(NUM_STAGES);
+	while ( 0 == oProfiler.Count[iStage] && 0 != --iTries ) {
+		iStage = (iStage + 1) % NUM_STAGES;
+	}
+
+	if ( 0 != oProfiler.Count[iStage] ) {
+
+		StageStats Stats;
+		getStageStats(iStage, Stats);
+
+		DebugMessage("%s %d/%d/%d/%d", szStageName[iStage], Stats.Min, Stats.P50, Stats.P99, Stats.Max);
+	}
+
+	oProfiler.ReportStage = (iStage + 1) % NUM_STAGES;
+	oProfiler.tLastReport = tNow;
+}
+
+void EndFrame(uint32_t const tNow)
+{
+	uint32_t const FrameEntered(oProfiler.FrameEntered);
+
+	for ( uint32_t iStage = 0 ; iStage < NUM_STAGES ; ++iStage ) {
+
+		if ( FrameEntered & (1 << iStage) ) {
+			Push(iStage, oProfiler.FrameTotal[iStage]);
+			oProfiler.FrameTotal[iStage] = 0;
+		}
+	}
+	oProfiler.FrameEntered = 0;
+
+	Report(tNow);
+
+#ifdef HOST_BUILD
+	if ( ++oProfiler.FramesSinceExport >= CSV_INTERVAL ) {
+		ExportCSV();
+		oProfiler.FramesSinceExport = 0;
+	}
+#endif
+}
+
+} // end namespace
+
+#endif /*STAGE_PROFILING*/
@@ -12,9 +12,9 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #ifdef ENABLE_SKULL
 
-#include "skulleffect.h"
+#include "SkullEffect.h"
 #include "RenderSDF_DMA2D.h"
-//#include "FLASH\\SDF_SKULL_Header_JPEG.h"
+//#include "FLASH/SDF_SKULL_Header_JPEG.h"
 #include "oled.h"
 
 #include "externSDFMulti.h"
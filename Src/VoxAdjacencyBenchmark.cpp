@@ -0,0 +1,159 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "VoxAdjacencyBenchmark.h"
+
+#ifdef VOX_ADJACENCY_BENCHMARK
+
+#include "VoxBinary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace VoxAdjacencyBenchmark
+{
+static constexpr uint32_t const MIN_DURATION_US = 200000,	// per case
+																MAX_REPETITIONS = 1000;
+
+static char const* const szModels[] = { "f22lightning.vox", "f2a.vox", "harrier.vox", "mig.vox", "missile.vox", "sidewinder.vox", "sr71.vox" };
+static char const* const szBuilders[Volumetric::voxB::NUM_ADJACENCY_BUILDERS] = { "linear", "hashed", "bitmap" };
+
+static struct sBenchmark
+{
+	FILE*			fpCSV;
+	uint32_t	NumCases,
+						NumMismatches;
+} oBench;
+
+static uint8_t* const LoadFile(char const* const szPath)
+{
+	FILE* const fp = fopen(szPath, "rb");
+	if ( nullptr == fp )
+		return(nullptr);
+	
+	fseek(fp, 0, SEEK_END);
+	long const Size(ftell(fp));
+	fseek(fp, 0, SEEK_SET);
+	
+	uint8_t* pData(nullptr);
+	if ( Size > 0 ) {
+		pData = new uint8_t[Size];
+		if ( (size_t)Size != fread(pData, 1, Size, fp) ) {
+			delete [] pData;
+			pData = nullptr;
+		}
+	}
+	fclose(fp);
+	
+	return(pData);
+}
+
+// returns the number of voxels kept (not culled)
+static uint32_t const Compare(uint16_t const* const __restrict pReference, uint16_t const* const __restrict pResults, uint32_t const numVoxels, uint32_t& Mismatches)
+{
+	uint32_t numIn(0);
+	
+	Mismatches = 0;
+	for ( uint32_t iDx = 0 ; iDx < numVoxels ; ++iDx ) {
+		
+		if ( pReference[iDx] != pResults[iDx] )
+			++Mismatches;
+		if ( Volumetric::voxB::ADJACENCY_IN & pResults[iDx] )
+			++numIn;
+	}
+	return(numIn);
+}
+
+static void Measure(char const* const szModel, uint8_t const* const pModel, uint32_t const numVoxels, bool const isDynamic)
+{
+	uint16_t* const pReference( new uint16_t[numVoxels] );
+	uint16_t* const pResults( new uint16_t[numVoxels] );
+	
+	double ReferenceSeconds(0.0);
+	
+	for ( uint32_t Builder = 0 ; Builder < Volumetric::voxB::NUM_ADJACENCY_BUILDERS ; ++Builder ) {
+		
+		uint16_t* const pDest( Volumetric::voxB::ADJACENCY_LINEAR == Builder ? pReference : pResults );
+		
+		uint32_t tTotal(0), Repetitions(0);
+		do {
+			uint32_t const tStart(micros());
+			Volumetric::voxB::BuildAdjacency(Builder, isDynamic, pModel, pDest);
+			tTotal += micros() - tStart;
+			
+		} while ( ++Repetitions < MAX_REPETITIONS && tTotal < MIN_DURATION_US );
+		
+		double const Seconds( (double)max(tTotal, 1U) * 1e-6 / (double)Repetitions );	// per model build
+		
+		if ( Volumetric::voxB::ADJACENCY_LINEAR == Builder )
+			ReferenceSeconds = Seconds;
+		
+		uint32_t Mismatches;
+		uint32_t const numIn( Compare(pReference, pDest, numVoxels, Mismatches) );
+		
+		char const* const szRules( isDynamic ? "dynamic" : "static" );
+		
+		printf("%-16s %-7s %-6s %6u voxels %6u in %10.3f ms %10.3f Mvoxels/s %8.1fx %s\n", szModel, szRules, szBuilders[Builder], numVoxels, numIn,
+					 Seconds * 1e3, (double)numVoxels / Seconds * 1e-6, ReferenceSeconds / Seconds, 0 == Mismatches ? "ok" : "MISMATCH");
+		if ( nullptr != oBench.fpCSV ) {
+			fprintf(oBench.fpCSV, "%s,%s,%s,%u,%u,%u,%u,%.0f,%.2f,%u\n", szModel, szRules, szBuilders[Builder], numVoxels, numIn,
+							Repetitions, tTotal, (double)numVoxels / Seconds, ReferenceSeconds / Seconds, Mismatches);
+		}
+		oBench.NumMismatches += (0 != Mismatches);
+		++oBench.NumCases;
+	}
+	
+	delete [] pResults;
+	delete [] pReference;
+}
+
+NOINLINE int const Run()
+{
+	char const* szDir = getenv("VOX_BENCH_DIR");
+	if ( nullptr == szDir )
+		szDir = "Data/VOX";
+	char const* szCSV = getenv("VOX_BENCH_CSV");
+	if ( nullptr == szCSV )
+		szCSV = "vox_adjacency_bench.csv";
+	
+	oBench.fpCSV = fopen(szCSV, "w");
+	if ( nullptr != oBench.fpCSV )
+		fprintf(oBench.fpCSV, "model,rules,builder,voxels,voxels_in,repetitions,us,voxels_per_s,speedup,mismatches\n");
+	
+	for ( uint32_t iModel = 0 ; iModel < countof(szModels) ; ++iModel ) {
+		
+		char szPath[256];
+		snprintf(szPath, sizeof(szPath), "%s/%s", szDir, szModels[iModel]);
+		
+		uint8_t* const pModel( LoadFile(szPath) );
+		uint32_t const numVoxels( nullptr != pModel ? Volumetric::voxB::BuildAdjacency(Volumetric::voxB::ADJACENCY_LINEAR, true, pModel, nullptr) : 0 );
+		
+		if ( 0 == numVoxels ) {
+			printf("vox adjacency bench: %s not loaded\n", szPath);
+		}
+		else {
+			Measure(szModels[iModel], pModel, numVoxels, Volumetric::voxB::DYNAMIC);
+			Measure(szModels[iModel], pModel, numVoxels, Volumetric::voxB::STATIC);
+		}
+		delete [] pModel;
+	}
+	
+	if ( nullptr != oBench.fpCSV ) {
+		fclose(oBench.fpCSV);
+		printf("vox adjacency bench: %u cases written to %s\n", oBench.NumCases, szCSV);
+	}
+	
+	return( 0 == oBench.NumMismatches ? 0 : 1 );
+}
+
+} // end namespace
+
+#endif /*VOX_ADJACENCY_BENCHMARK*/
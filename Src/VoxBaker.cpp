@@ -0,0 +1,119 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "VoxBaker.h"
+
+#ifdef VOX_BAKE_MODELS
+
+#include "VoxBinary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace VoxBaker
+{
+static char const* const szModels[] = { "f22lightning", "f2a", "harrier", "mig", "missile", "sidewinder", "sr71" };
+
+static uint8_t* const LoadFile(char const* const szPath)
+{
+	FILE* const fp = fopen(szPath, "rb");
+	if ( nullptr == fp )
+		return(nullptr);
+	
+	fseek(fp, 0, SEEK_END);
+	long const Size(ftell(fp));
+	fseek(fp, 0, SEEK_SET);
+	
+	uint8_t* pData(nullptr);
+	if ( Size > 0 ) {
+		pData = new uint8_t[Size];
+		if ( (size_t)Size != fread(pData, 1, Size, fp) ) {
+			delete [] pData;
+			pData = nullptr;
+		}
+	}
+	fclose(fp);
+	
+	return(pData);
+}
+
+static bool const SaveFile(char const* const szPath, std::vector<uint8_t> const& Image)
+{
+	FILE* const fp = fopen(szPath, "wb");
+	if ( nullptr == fp )
+		return(false);
+	
+	bool const bWritten( Image.size() == fwrite(Image.data(), 1, Image.size(), fp) );
+	fclose(fp);
+	
+	return(bWritten);
+}
+
+static bool const Bake(char const* const szDir, char const* const szOut, char const* const szModel)
+{
+	char szPath[256];
+	snprintf(szPath, sizeof(szPath), "%s/%s.vox", szDir, szModel);
+	
+	uint8_t* const pSource( LoadFile(szPath) );
+	if ( nullptr == pSource ) {
+		printf("vox baker: %s not loaded\n", szPath);
+		return(false);
+	}
+	
+	std::vector<uint8_t> Image;
+	bool bBaked( Volumetric::voxB::Bake(Image, pSource, Volumetric::voxB::DYNAMIC) );
+	delete [] pSource;
+	
+	if ( bBaked ) { // validate by mapping it back, the same as LoadAllModels does from FRAM
+		Volumetric::voxB::voxelModel<Volumetric::voxB::DYNAMIC> Model;
+		bBaked = (Image.size() == Volumetric::voxB::Map(&Model, Image.data()));
+		
+		if ( bBaked ) {
+			printf("%-16s %6u bytes %2u levels", szModel, (uint32_t)Image.size(), Model.numLODs);
+			for ( uint32_t iLOD = 0 ; iLOD < Model.numLODs ; ++iLOD ) {
+				Volumetric::voxB::voxelModelLOD const Level( Model.getLOD(iLOD) );
+				printf(" %6u voxels (%ux%ux%u)", Level.numVoxels, (uint32_t)Level.maxDimensions.x + 1, (uint32_t)Level.maxDimensions.y + 1, (uint32_t)Level.maxDimensions.z + 1);
+			}
+			printf("\n");
+		}
+	}
+	
+	if ( bBaked ) {
+		snprintf(szPath, sizeof(szPath), "%s/%s.vxb", szOut, szModel);
+		bBaked = SaveFile(szPath, Image);
+	}
+	if ( !bBaked ) {
+		printf("vox baker: %s failed\n", szModel);
+	}
+	return(bBaked);
+}
+
+NOINLINE int const Run()
+{
+	char const* szDir = getenv("VOX_BAKE_DIR");
+	if ( nullptr == szDir )
+		szDir = "Data/VOX";
+	char const* szOut = getenv("VOX_BAKE_OUT");
+	if ( nullptr == szOut )
+		szOut = szDir;
+	
+	uint32_t numFailed(0);
+	for ( uint32_t iModel = 0 ; iModel < countof(szModels) ; ++iModel ) {
+		numFailed += !Bake(szDir, szOut, szModels[iModel]);
+	}
+	printf("vox baker: %u of %u models baked to %s\n", (uint32_t)countof(szModels) - numFailed, (uint32_t)countof(szModels), szOut);
+	
+	return( 0 == numFailed ? 0 : 1 );
+}
+
+} // end namespace
+
+#endif /*VOX_BAKE_MODELS*/
@@ -0,0 +1,149 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "VoxBatchBenchmark.h"
+
+#ifdef VOX_BATCH_BENCHMARK
+
+#include "VoxMissile.h"
+#include "world.h"
+#include "oled.h"
+#include "isodepth.h"
+#include "quadspi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace VoxBatchBenchmark
+{
+static constexpr uint32_t const MIN_DURATION_US = 200000,	// per case
+																MAX_REPETITIONS = 1000;
+
+static constexpr uint32_t const NUM_MISSILES[] = { 1, 2, 4, 8, 16 };	// 16 is split by RenderVoxelModels
+static constexpr uint32_t const MAX_MISSILES = 16;
+static constexpr float const RING_RADIUS = 4.0f,		// grid units from the screen centre, inside the finest level of detail
+														 FLIGHT_LENGTH = 64.0f;
+
+static struct sBenchmark
+{
+	VoxMissile*	Missiles[MAX_MISSILES];
+	
+	FILE*				fpCSV;
+	uint32_t		NumCases,
+							NumFailures;
+} oBench;
+
+static void ClearDepth()
+{
+	OLED::FillDepth(&DTCM::getDepthBuffer()[0][0], IsoDepth::DEPTH_MIN, OLED::SCREEN_WIDTH * OLED::SCREEN_HEIGHT);
+	OLED::ClearHiZ();
+#ifdef DEPTH_SPANS
+	OLED::ClearDepthSpans();
+#endif
+}
+
+// every missile by itself, as World renders its missile
+static void RenderEach(uint32_t const numMissiles, uint32_t const tNow)
+{
+	for ( uint32_t iDx = 0 ; iDx < numMissiles ; ++iDx ) {
+		if ( oBench.Missiles[iDx]->isVisible() ) {
+			oBench.Missiles[iDx]->Render(tNow);
+		}
+	}
+}
+static void RenderBatch(uint32_t const numMissiles, uint32_t const tNow)
+{
+	VoxMissile::RenderBatch(oBench.Missiles, numMissiles, tNow);
+}
+
+// returns the FRAM bytes read per frame
+static uint32_t const Measure(char const* const szMode, uint32_t const numMissiles, uint32_t const tNow, void (* const Render)(uint32_t const, uint32_t const))
+{
+	ClearDepth();
+	Render(numMissiles, tNow);	// warm up
+	
+	uint32_t tTotal(0), Repetitions(0);
+	uint32_t const BytesStart( QuadSPI_FRAM::Soft::getTotalStats().BytesRead );
+	do {
+		ClearDepth();
+		
+		uint32_t const tStart(micros());
+		Render(numMissiles, tNow);
+		tTotal += micros() - tStart;
+		
+	} while ( ++Repetitions < MAX_REPETITIONS && tTotal < MIN_DURATION_US );
+	
+	uint32_t const Bytes( (QuadSPI_FRAM::Soft::getTotalStats().BytesRead - BytesStart) / Repetitions );
+	double const us( (double)tTotal / (double)Repetitions );
+	
+	printf("%-6s %2u missiles %10.1f us/frame %8u FRAM bytes/frame\n", szMode, numMissiles, us, Bytes);
+	if ( nullptr != oBench.fpCSV ) {
+		fprintf(oBench.fpCSV, "%s,%u,%u,%u,%.1f,%u\n", szMode, numMissiles, Repetitions, tTotal, us, Bytes);
+	}
+	++oBench.NumCases;
+	
+	return(Bytes);
+}
+
+NOINLINE int const Run()
+{
+	char const* szCSV = getenv("VOX_BATCH_CSV");
+	if ( nullptr == szCSV )
+		szCSV = "vox_batch_bench.csv";
+	
+	// the missile model is loaded by the deferred init
+	world::Init(millis());
+	while ( !world::isDeferredInitComplete() ) {
+		world::DeferredInit(millis());
+	}
+	uint32_t const tNow(millis());
+	world::Update(tNow);	// lighting and depth range
+	
+	vec2_t const vCentre( world::getOrigin() );
+	for ( uint32_t iDx = 0 ; iDx < MAX_MISSILES ; ++iDx ) {
+		
+		float const fAngle( (float)iDx * (2.0f * MathConstants::kPI / (float)MAX_MISSILES) );	// every heading differs
+		vec2_t const vDir( __cosf(fAngle), __sinf(fAngle) );
+		vec2_t const vStart( v2_add(vCentre, v2_muls(vDir, RING_RADIUS)) );
+		
+		oBench.Missiles[iDx] = new VoxMissile(tNow, vStart, v2_add(vStart, v2_muls(vDir, FLIGHT_LENGTH)));
+	}
+	
+	oBench.fpCSV = fopen(szCSV, "w");
+	if ( nullptr != oBench.fpCSV )
+		fprintf(oBench.fpCSV, "mode,missiles,repetitions,us,us_per_frame,fram_bytes_per_frame\n");
+	
+	for ( uint32_t const numMissiles : NUM_MISSILES ) {
+		
+		uint32_t const EachBytes( Measure("each", numMissiles, tNow, &RenderEach) ),
+									 BatchBytes( Measure("batch", numMissiles, tNow, &RenderBatch) );
+		
+		// union of the visible slices of the finest level needed, never more than every missile reading its own
+		if ( BatchBytes > EachBytes ) {
+			printf("vox batch bench: %u missiles, batch reads %u bytes > %u\n", numMissiles, BatchBytes, EachBytes);
+			++oBench.NumFailures;
+		}
+	}
+	
+	for ( VoxMissile* const pMissile : oBench.Missiles ) {
+		delete pMissile;
+	}
+	
+	if ( nullptr != oBench.fpCSV ) {
+		fclose(oBench.fpCSV);
+		printf("vox batch bench: %u cases written to %s\n", oBench.NumCases, szCSV);
+	}
+	
+	return( 0 != oBench.NumFailures );
+}
+
+} // end namespace
+
+#endif /*VOX_BATCH_BENCHMARK*/
@@ -14,11 +14,11 @@ The VOX File format is Copyright to their respectful owners.
 #include "globals.h"
 #define VOX_IMPL
 #include "VoxBinary.h"
-#include "IsoVoxel.h"
+#include "isoVoxel.h"
 #include "voxelModelsFRAM.h"
 
 #ifdef VOX_DEBUG_ENABLED
-#include "debug.cpp"
+#include "Debug.cpp"
 #endif
 
 //std::vector<Volumetric::voxB::voxelDescPacked>	Volumetric::voxB::voxelModelBase::Voxels;
@@ -114,8 +114,267 @@ STATIC_INLINE bool const CompareTag( uint32_t const TagSz, uint8_t const * __res
 	return(true);
 }
 
-// simple (slow) linear search
-static bool const BuildAdjacency_ForDynamic( uint32_t numVoxels, VoxelData const& __restrict source, VoxelData const* __restrict pVoxels, uint8_t& __restrict Adjacency )
+// ### occupancy of the voxels of a model, built once per model so every neighbour test of the adjacency builders is O(1)
+// instead of a search of every voxel of the model (O(n²) per model). Coordinates outside the model are never occupied
+// the smaller of the two is used by Load (see getSizeInBytes)
+
+// dense bitmap over the bounds of the model (SIZE chunk), 1 bit per position, 64KB at the 128x64x64 maximum
+class OccupancyBitmap
+{
+public:
+	static uint32_t const getSizeInBytes( ChunkDimensions const& __restrict Size, uint32_t const numVoxels )
+	{
+		return( getNumWords(Size) * sizeof(uint32_t) );
+	}
+	
+	__attribute__((always_inline)) inline bool const operator()( int32_t const x, int32_t const y, int32_t const z ) const
+	{
+		if ( (uint32_t)x >= (uint32_t)Width || (uint32_t)y >= (uint32_t)Depth || (uint32_t)z >= (uint32_t)Height )
+			return(false);
+		
+		uint32_t const uiBit( getBit(x, y, z) );
+		return( 0 != (Bits[uiBit >> 5] & (1U << (uiBit & 31))) );
+	}
+	
+	OccupancyBitmap( ChunkDimensions const& __restrict Size, VoxelData const* __restrict pVoxels, uint32_t numVoxels )
+		: Bits(new uint32_t[getNumWords(Size)]), Width(Size.Width), Depth(Size.Depth), Height(Size.Height)
+	{
+		memset(Bits, 0, getNumWords(Size) * sizeof(uint32_t));
+		
+		do
+		{
+			VoxelData const oVoxel( *pVoxels++ );
+			
+			if ( oVoxel.x < Width && oVoxel.y < Depth && oVoxel.z < Height ) {
+				uint32_t const uiBit( getBit(oVoxel.x, oVoxel.y, oVoxel.z) );
+				Bits[uiBit >> 5] |= (1U << (uiBit & 31));
+			}
+			
+		} while ( 0 != --numVoxels );
+	}
+	~OccupancyBitmap() { delete [] Bits; }
+	
+private:
+	static uint32_t const getNumWords( ChunkDimensions const& __restrict Size )
+	{
+		return( ((uint32_t)(Size.Width * Size.Depth * Size.Height) + 31) >> 5 );
+	}
+	__attribute__((always_inline)) inline uint32_t const getBit( int32_t const x, int32_t const y, int32_t const z ) const
+	{
+		return( (z * Depth + y) * Width + x );
+	}
+	
+	uint32_t* const __restrict Bits;
+	int32_t const Width, Depth, Height;
+};
+
+// open addressing (linear probing) spatial hash of the voxel coordinates, sized to the number of voxels
+// better than the bitmap for sparse models in large bounds
+class OccupancyHash
+{
+public:
+	static uint32_t const getSizeInBytes( ChunkDimensions const& __restrict Size, uint32_t const numVoxels )
+	{
+		return( (1U << getSizeBits(numVoxels)) * sizeof(uint32_t) );
+	}
+	
+	__attribute__((always_inline)) inline bool const operator()( int32_t const x, int32_t const y, int32_t const z ) const
+	{
+		if ( (uint32_t)x >= MAX_DIMENSION_X || (uint32_t)y >= MAX_DIMENSION_YZ || (uint32_t)z >= MAX_DIMENSION_YZ )
+			return(false);
+		
+		uint32_t const Key( getKey(x, y, z) );
+		
+		for ( uint32_t uiSlot = getSlot(Key) ; EMPTY != Keys[uiSlot] ; uiSlot = (uiSlot + 1) & Mask ) {
+			
+			if ( Key == Keys[uiSlot] )
+				return(true);
+		}
+		return(false);
+	}
+	
+	OccupancyHash( ChunkDimensions const& __restrict Size, VoxelData const* __restrict pVoxels, uint32_t numVoxels )
+		: Keys(new uint32_t[1U << getSizeBits(numVoxels)]), Mask((1U << getSizeBits(numVoxels)) - 1), Shift(32 - getSizeBits(numVoxels))
+	{
+		memset(Keys, 0, (Mask + 1) * sizeof(uint32_t));
+		
+		do
+		{
+			VoxelData const oVoxel( *pVoxels++ );
+			
+			if ( oVoxel.x < MAX_DIMENSION_X && oVoxel.y < MAX_DIMENSION_YZ && oVoxel.z < MAX_DIMENSION_YZ ) {
+				
+				uint32_t const Key( getKey(oVoxel.x, oVoxel.y, oVoxel.z) );
+				uint32_t uiSlot( getSlot(Key) );
+				
+				while ( EMPTY != Keys[uiSlot] && Key != Keys[uiSlot] ) {
+					uiSlot = (uiSlot + 1) & Mask;
+				}
+				Keys[uiSlot] = Key;
+			}
+			
+		} while ( 0 != --numVoxels );
+	}
+	~OccupancyHash() { delete [] Keys; }
+	
+private:
+	static constexpr uint32_t const EMPTY = 0,
+																	MIN_SIZE_BITS = 4;
+	
+	static uint32_t const getSizeBits( uint32_t const numVoxels )	// power of 2, load factor 2/3 or less
+	{
+		uint32_t const uiMinSlots( numVoxels + (numVoxels >> 1) );
+		return( max(MIN_SIZE_BITS, 32 - __CLZ(uiMinSlots)) );
+	}
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getKey( uint32_t const x, uint32_t const y, uint32_t const z )
+	{
+		return( (x | (y << 7) | (z << 13)) + 1 );	// never EMPTY
+	}
+	__attribute__((always_inline)) inline uint32_t const getSlot( uint32_t const Key ) const
+	{
+		return( (Key * 2654435761U) >> Shift ); // fibonacci hash
+	}
+	
+	uint32_t* const __restrict Keys;
+	uint32_t const Mask, Shift;
+};
+
+// only remove voxels that are surrounded above and too the sides (don't care about below)
+// removed with 16 of the 17 neighbours (9 above, 8 sides), the count the linear search stopped at
+template<typename Occupancy>
+static bool const BuildAdjacency_ForDynamic( Occupancy const& __restrict isOccupied, VoxelData const& __restrict source, uint8_t& __restrict Adjacency )
+{
+	static constexpr uint32_t const uiMaxOcculusion( 9 + 8 ); // 9 above, 8 sides
+	// bit of a neighbour in the 3x3 same slice (bits 0 - 8, 4 is the source) and 3x3 above (bits 9 - 17)
+	static constexpr uint32_t const NBR_FRONT = 1, NBR_LEFT = 3, NBR_RIGHT = 5, NBR_BACK = 7, NBR_ABOVE = 13;
+	
+	int32_t const x(source.x), y(source.y), z(source.z);
+	uint32_t Neighbours(0);
+	
+	for ( int32_t iZ = 0 ; iZ <= 1 ; ++iZ ) {
+		for ( int32_t iY = -1 ; iY <= 1 ; ++iY ) {
+			for ( int32_t iX = -1 ; iX <= 1 ; ++iX ) {
+				
+				if ( isOccupied(x + iX, y + iY, z + iZ) ) {
+					Neighbours |= (1U << (iZ * 9 + (iY + 1) * 3 + (iX + 1)));
+				}
+			}
+		}
+	}
+	Neighbours &= ~(1U << 4);	// source
+	
+	Adjacency = ( ((Neighbours >> NBR_ABOVE) & 1) * BIT_ADJ_ABOVE ) | ( ((Neighbours >> NBR_BACK) & 1) * BIT_ADJ_BACK ) | 
+							( ((Neighbours >> NBR_FRONT) & 1) * BIT_ADJ_FRONT ) | ( ((Neighbours >> NBR_RIGHT) & 1) * BIT_ADJ_RIGHT ) |
+							( ((Neighbours >> NBR_LEFT) & 1) * BIT_ADJ_LEFT );	// face culling used for voxels that are not removed
+	
+	return( (uint32_t)__builtin_popcount(Neighbours) < uiMaxOcculusion - 1 );
+}
+
+template<typename Occupancy>
+static bool const BuildAdjacency_ForStatic( Occupancy const& __restrict isOccupied, VoxelData const& __restrict source, uint8_t& __restrict Adjacency )
+{
+	int32_t const x(source.x), y(source.y), z(source.z);
+	
+	Adjacency = 0;
+	
+	// skip if root voxel at 0,0,0 always visible
+	if ( 0 == (x | y | z) )
+		return(true);
+	
+	// BIT_ADJ_ABOVEFRONTLEFT = case where voxel would be completely occulded
+	if ( isOccupied(x + 1, y - 1, z - 1) )
+		return(false); // "out"
+	
+	uint32_t const pendingAdjacency( (isOccupied(x, y - 1, z - 1) ? BIT_ADJ_ABOVEFRONT : 0) |
+																	 (isOccupied(x + 1, y, z - 1) ? BIT_ADJ_ABOVELEFT : 0) |
+																	 (isOccupied(x + 1, y - 1, z) ? BIT_ADJ_FRONTLEFT : 0) |
+																	 (isOccupied(x, y, z - 1) ? BIT_ADJ_ABOVE : 0) |
+																	 (isOccupied(x, y - 1, z) ? BIT_ADJ_FRONT : 0) |
+																	 (isOccupied(x + 1, y, z) ? BIT_ADJ_LEFT : 0) );
+	
+	// cull whole voxel cases
+	uint32_t testCase = (BIT_ADJ_ABOVEFRONT | BIT_ADJ_ABOVELEFT | BIT_ADJ_FRONT | BIT_ADJ_LEFT);
+	if ( (testCase & pendingAdjacency) == testCase ) {
+		return(false);
+	}
+	
+	testCase = (BIT_ADJ_ABOVEFRONT | BIT_ADJ_ABOVELEFT | BIT_ADJ_FRONTLEFT);
+	if ( (testCase & pendingAdjacency) == testCase ) {
+		return(false);
+	}
+	
+	testCase = (BIT_ADJ_ABOVE | BIT_ADJ_FRONT | BIT_ADJ_LEFT);
+	if ( (testCase & pendingAdjacency) == testCase ) {
+		return(false);
+	}
+	
+	// Voxel is not completely occulded
+	Adjacency = pendingAdjacency;
+	
+	return(true);		// source voxel is still "in"
+}
+
+// culls and adds every voxel of the XYZI chunk to the model
+template<typename Occupancy>
+static void LoadVoxels( voxelModelBase* const __restrict pDestMem, ChunkDimensions const& __restrict sizeChunk, 
+												VoxelData const* __restrict pVoxels, uint32_t numVoxels )
+{
+	Occupancy const isOccupied(sizeChunk, pVoxels, numVoxels);
+	
+	do
+	{
+		VoxelData const curVoxel( *pVoxels++ );
+		
+		uint8_t pendingAdjacency;
+		bool const bIn( pDestMem->isDynamic_ ? BuildAdjacency_ForDynamic(isOccupied, curVoxel, pendingAdjacency)
+																				 : BuildAdjacency_ForStatic(isOccupied, curVoxel, pendingAdjacency) );
+		if ( bIn ) {
+
+			pDestMem->VoxelsTemp.push_back( voxelDescPacked( voxCoord(curVoxel.x, curVoxel.y, sizeChunk.Height - curVoxel.z), 
+																	    voxAdjacency(pendingAdjacency), curVoxel.shadeIndex) );
+		}
+		
+	} while ( 0 != --numVoxels );
+}
+
+#if defined(VOX_ADJACENCY_BENCHMARK) || defined(VOX_BAKE_MODELS)
+// the fixed chunk layout of a single model .vox, same as Load (MAIN, SIZE, XYZI, RGBA optional)
+// returns the voxels of the XYZI chunk, nullptr if not a supported model
+static VoxelData const* const ReadModel( uint8_t const* const pSourceVoxBinaryData, ChunkDimensions& __restrict sizeChunk, uint32_t& __restrict numVoxels )
+{
+	static constexpr uint32_t const  OFFSET_MAIN_CHUNK = 8;
+	static constexpr uint32_t const  TAG_LN = 4;
+	static constexpr char const      TAG_VOX[TAG_LN] 					= { 'V', 'O', 'X', ' ' },
+														       TAG_DIMENSIONS[TAG_LN] 	= { 'S', 'I', 'Z', 'E' },
+														       TAG_XYZI[TAG_LN] 				= { 'X', 'Y', 'Z', 'I' };
+	
+	if ( !CompareTag(countof(TAG_VOX), pSourceVoxBinaryData, TAG_VOX) )
+		return(nullptr);
+	
+	uint8_t const* pReadPointer( pSourceVoxBinaryData + OFFSET_MAIN_CHUNK + sizeof(ChunkHeader) );
+	
+	ReadData((void* const __restrict)&sizeChunk, pReadPointer, sizeof(sizeChunk));
+	pReadPointer += sizeof(sizeChunk);
+	
+	ChunkVoxels voxelsChunk;
+	ReadData((void* const __restrict)&voxelsChunk, pReadPointer, sizeof(voxelsChunk));
+	pReadPointer += sizeof(voxelsChunk);
+	
+	if ( !CompareTag(countof(TAG_DIMENSIONS), (uint8_t const* const)sizeChunk.id, TAG_DIMENSIONS) ||
+			 !CompareTag(countof(TAG_XYZI), (uint8_t const* const)voxelsChunk.id, TAG_XYZI) )
+		return(nullptr);
+	
+	if ( (sizeChunk.Width > MAX_DIMENSION_X) || (sizeChunk.Depth > MAX_DIMENSION_YZ) || (sizeChunk.Height > MAX_DIMENSION_YZ) || voxelsChunk.numVoxels <= 0 )
+		return(nullptr);
+	
+	numVoxels = voxelsChunk.numVoxels;
+	return( reinterpret_cast<VoxelData const* const>(pReadPointer) );
+}
+#endif
+
+#ifdef VOX_ADJACENCY_BENCHMARK
+// simple (slow) linear search, O(n²) per model - the reference the occupancy builders are compared to
+static bool const BuildAdjacency_ForDynamic_Linear( uint32_t numVoxels, VoxelData const& __restrict source, VoxelData const* __restrict pVoxels, uint8_t& __restrict Adjacency )
 {
 	static constexpr uint32_t const uiMaxOcculusion( 9 + 8 ); // 9 above, 8 sides
 	
@@ -180,8 +439,8 @@ static bool const BuildAdjacency_ForDynamic( uint32_t numVoxels, VoxelData const
 	
 	return(0 != uiOcculusion);
 }
-// simple (slow) linear search
-static bool const BuildAdjacency_ForStatic( uint32_t numVoxels, VoxelData const& __restrict source, VoxelData const* __restrict pVoxels, uint8_t& __restrict Adjacency )
+// simple (slow) linear search, O(n²) per model - the reference the occupancy builders are compared to
+static bool const BuildAdjacency_ForStatic_Linear( uint32_t numVoxels, VoxelData const& __restrict source, VoxelData const* __restrict pVoxels, uint8_t& __restrict Adjacency )
 {
 	uint8_t pendingAdjacency(0);
 	Adjacency = 0;
@@ -278,13 +537,62 @@ static bool const BuildAdjacency_ForStatic( uint32_t numVoxels, VoxelData const&
 	
 	return(true);		// source voxel is still "in"
 }
+template<typename Occupancy>
+static void BuildAdjacency_Occupancy( bool const isDynamic, ChunkDimensions const& __restrict sizeChunk, VoxelData const* const __restrict pVoxels, 
+																		  uint32_t const numVoxels, uint16_t* __restrict pResults )
+{
+	Occupancy const isOccupied(sizeChunk, pVoxels, numVoxels);
+	
+	for ( uint32_t iDx = 0 ; iDx < numVoxels ; ++iDx ) {
+		
+		uint8_t pendingAdjacency;
+		bool const bIn( isDynamic ? BuildAdjacency_ForDynamic(isOccupied, pVoxels[iDx], pendingAdjacency)
+															: BuildAdjacency_ForStatic(isOccupied, pVoxels[iDx], pendingAdjacency) );
+		*pResults++ = bIn ? (ADJACENCY_IN | pendingAdjacency) : 0;
+	}
+}
+
+uint32_t const BuildAdjacency( uint32_t const Builder, bool const isDynamic, uint8_t const* const pSourceVoxBinaryData, uint16_t* const __restrict pResults )
+{
+	ChunkDimensions sizeChunk;
+	uint32_t numVoxels;
+	VoxelData const* const pVoxels( ReadModel(pSourceVoxBinaryData, sizeChunk, numVoxels) );
+	
+	if ( nullptr == pVoxels )
+		return(0);
+	
+	if ( nullptr == pResults )
+		return(numVoxels);
+	
+	switch(Builder)
+	{
+		case ADJACENCY_LINEAR:
+			for ( uint32_t iDx = 0 ; iDx < numVoxels ; ++iDx ) {
+				
+				uint8_t pendingAdjacency;
+				bool const bIn( isDynamic ? BuildAdjacency_ForDynamic_Linear(numVoxels, pVoxels[iDx], pVoxels, pendingAdjacency)
+																	: BuildAdjacency_ForStatic_Linear(numVoxels, pVoxels[iDx], pVoxels, pendingAdjacency) );
+				pResults[iDx] = bIn ? (ADJACENCY_IN | pendingAdjacency) : 0;
+			}
+			break;
+		case ADJACENCY_HASHED:
+			BuildAdjacency_Occupancy<OccupancyHash>(isDynamic, sizeChunk, pVoxels, numVoxels, pResults);
+			break;
+		case ADJACENCY_BITMAP:
+			BuildAdjacency_Occupancy<OccupancyBitmap>(isDynamic, sizeChunk, pVoxels, numVoxels, pResults);
+			break;
+		default:
+			return(0);
+	}
+	
+	return(numVoxels);
+}
+#endif /*VOX_ADJACENCY_BENCHMARK*/
+
 // builds the voxel model, loading from magicavoxel .vox format, returning the model with the voxel traversal
 // supporting 128x64x64 size voxel model.
 NOINLINE bool const Load( voxelModelBase* const __restrict pDestMem, uint8_t const * const pSourceVoxBinaryData, uint8_t*& __restrict FRAMWritePointer )
 {
-	typedef bool const (* const adjacency_culling)(uint32_t, VoxelData const& __restrict, VoxelData const* __restrict, uint8_t& __restrict );
-	adjacency_culling CullVoxels( pDestMem->isDynamic_ ? &BuildAdjacency_ForDynamic : &BuildAdjacency_ForStatic );
-	
 	uint8_t const * pReadPointer(nullptr);
 	
 	// Check Header
@@ -341,20 +649,19 @@ NOINLINE bool const Load( voxelModelBase* const __restrict pDestMem, uint8_t con
 								pDestMem->VoxelsTemp.reserve( numVoxels );											// otherwise best effort load the large voxel model
 																																					  // hoping to allocate enough heap memory from actual voxels used
 							// load all voxels																					  // size = (numVoxels - voxelsCulled) * [sizeof(voxelDescPacked) (4bytes)]
-							do
-							{
-								VoxelData const curVoxel( *reinterpret_cast<VoxelData const* const>(pReadPointer) );
-								pReadPointer += sizeof(VoxelData);
-								
-								uint8_t pendingAdjacency;
-								if ( CullVoxels( numVoxels, curVoxel, pVoxelRoot, pendingAdjacency ) ) {
-
-									pDestMem->VoxelsTemp.push_back( voxelDescPacked( voxCoord(curVoxel.x, curVoxel.y, sizeChunk.Height - curVoxel.z), 
-																							    voxAdjacency(pendingAdjacency), curVoxel.shadeIndex) );
-								}
-								
-							} while ( 0 != --voxelsChunk.numVoxels );
-														
+							// adjacency by the occupancy selected, or by default the one needing the least (heap) memory for this model
+#if defined(VOX_ADJACENCY_BITMAP)
+							LoadVoxels<OccupancyBitmap>(pDestMem, sizeChunk, pVoxelRoot, numVoxels);
+#elif defined(VOX_ADJACENCY_HASHED)
+							LoadVoxels<OccupancyHash>(pDestMem, sizeChunk, pVoxelRoot, numVoxels);
+#else
+							if ( OccupancyBitmap::getSizeInBytes(sizeChunk, numVoxels) <= OccupancyHash::getSizeInBytes(sizeChunk, numVoxels) )
+								LoadVoxels<OccupancyBitmap>(pDestMem, sizeChunk, pVoxelRoot, numVoxels);
+							else
+								LoadVoxels<OccupancyHash>(pDestMem, sizeChunk, pVoxelRoot, numVoxels);
+#endif
+							pReadPointer += numVoxels * sizeof(VoxelData);
+							
 							// Sort the voxels by "slices" on .z (height offset) axis
 							std::sort(pDestMem->VoxelsTemp.begin(), pDestMem->VoxelsTemp.end());	
 							pDestMem->VoxelsTemp.shrink_to_fit(); // optimize memory usage after culling voxels
@@ -438,8 +745,261 @@ NOINLINE bool const Load( voxelModelBase* const __restrict pDestMem, uint8_t con
 	return(false);
 }
 
+// maps the model to a baked model image, see voxelModel.h. The voxels are used in place (FRAM) and
+// only the header is read, so nothing is parsed, culled or sorted at boot
+NOINLINE uint32_t const Map( voxelModelBase* const __restrict pDestMem, uint8_t const * const pBakedImage )
+{
+	voxelModelBakedHeader Header;
+	ReadData((void* const __restrict)&Header, pBakedImage, sizeof(Header));
+	QSPI_FRAM_ACCOUNT_READ(pBakedImage, sizeof(Header));
+	
+	if ( BAKED_MAGIC != Header.Magic || BAKED_VERSION != Header.Version ) {
+#ifdef VOX_DEBUG_ENABLED
+		DebugMessage("vxb header fail");
+#endif
+		return(0);
+	}
+	if ( (pDestMem->isDynamic_ ? 1 : 0) != Header.isDynamic || 0 == Header.numLODs || Header.numLODs > MAX_LODS || Header.SizeInBytes < sizeof(Header) ) {
+#ifdef VOX_DEBUG_ENABLED
+		DebugMessage("vxb not valid for model");
+#endif
+		return(0);
+	}
+	
+	// every level must be within the image and the supported dimensions
+	for ( uint32_t iLOD = 0 ; iLOD < Header.numLODs ; ++iLOD ) {
+		
+		voxelModelBakedLOD const& Level( Header.LOD[iLOD] );
+		
+		if ( (0 != (Level.Offset & 3)) | (Level.Offset < sizeof(Header)) | (Level.Offset > Header.SizeInBytes) | (0 == Level.numVoxels) ||
+				 Level.numVoxels > ((Header.SizeInBytes - Level.Offset) / sizeof(voxelDescPacked)) ||
+				 (Level.dimensionX >= MAX_DIMENSION_X) | (Level.dimensionY >= MAX_DIMENSION_YZ) | (Level.dimensionZ >= MAX_DIMENSION_YZ) ) {
+#ifdef VOX_DEBUG_ENABLED
+			DebugMessage("vxb level %d fail", iLOD);
+#endif
+			return(0);
+		}
+	}
+	
+	pDestMem->VoxelsFRAM = (voxelDescPacked const* const)(pBakedImage + Header.LOD[0].Offset);
+	pDestMem->numVoxels = Header.LOD[0].numVoxels;
+	pDestMem->maxDimensions = vec3_t(Header.LOD[0].dimensionX, Header.LOD[0].dimensionY, Header.LOD[0].dimensionZ);
+	pDestMem->maxDimensionsInv = v3_inverse( pDestMem->maxDimensions );
+	
+	for ( uint32_t iLOD = 1 ; iLOD < Header.numLODs ; ++iLOD ) {
+		
+		voxelModelBakedLOD const& Level( Header.LOD[iLOD] );
+		voxelModelLOD& __restrict Dest( pDestMem->LOD[iLOD - 1] );
+		
+		Dest.Voxels = (voxelDescPacked const* const)(pBakedImage + Level.Offset);
+		Dest.numVoxels = Level.numVoxels;
+		Dest.maxDimensions = vec3_t(Level.dimensionX, Level.dimensionY, Level.dimensionZ);
+		Dest.maxDimensionsInv = v3_inverse( Dest.maxDimensions );
+		Dest.Scalar = pDestMem->Scalar * (float)(1 << iLOD);	// cells of 2^n voxels
+		Dest.Slices = nullptr; Dest.numSlices = 0;
+	}
+	pDestMem->numLODs = Header.numLODs;
+	pDestMem->Slices = nullptr; pDestMem->numSlices = 0;	// voxels changed, see BuildSlices
+	
+#ifdef VOX_DEBUG_ENABLED
+	DebugMessage("vxb mapped %d voxels, %d levels", pDestMem->numVoxels, pDestMem->numLODs);
+#endif
+	return(Header.SizeInBytes);
+}
 
+// the voxels of every level are sorted by .z, so a slice is a run of the same .z
+void BuildSlices( voxelModelBase* const __restrict pDestMem )
+{
+	std::vector<voxelModelSlice>& __restrict SliceTable(pDestMem->SliceTable);
+	uint32_t LevelBegin[MAX_LODS + 1];
+	
+	SliceTable.clear();
+	
+	for ( uint32_t iLOD = 0 ; iLOD < pDestMem->numLODs ; ++iLOD ) {
+		
+		voxelModelLOD const Level( pDestMem->getLOD(iLOD) );
+		QSPI_FRAM_ACCOUNT_READ(Level.Voxels, Level.numVoxels * sizeof(voxelDescPacked));
+		
+		LevelBegin[iLOD] = SliceTable.size();
+		
+		for ( uint32_t iDx = 0 ; iDx < Level.numVoxels ; ++iDx ) {
+			
+			voxelDescPacked const Voxel( Level.Voxels[iDx] );
+			
+			if ( SliceTable.size() == LevelBegin[iLOD] || SliceTable.back().z != Voxel.z ) {
+				voxelModelSlice const NewSlice = { iDx, 0, (uint8_t)Voxel.x, (uint8_t)Voxel.y, (uint8_t)Voxel.x, (uint8_t)Voxel.y, (uint8_t)Voxel.z };
+				SliceTable.push_back(NewSlice);
+			}
+			voxelModelSlice& __restrict Slice(SliceTable.back());
+			
+			Slice.xMin = min(Slice.xMin, (uint8_t)Voxel.x); Slice.yMin = min(Slice.yMin, (uint8_t)Voxel.y);
+			Slice.xMax = max(Slice.xMax, (uint8_t)Voxel.x); Slice.yMax = max(Slice.yMax, (uint8_t)Voxel.y);
+			++Slice.numVoxels;
+		}
+	}
+	LevelBegin[pDestMem->numLODs] = SliceTable.size();
+	SliceTable.shrink_to_fit();	// pointers are only taken once the table is complete
+	
+	pDestMem->Slices = SliceTable.data();
+	pDestMem->numSlices = LevelBegin[1];
+	
+	for ( uint32_t iLOD = 1 ; iLOD < pDestMem->numLODs ; ++iLOD ) {
+		
+		pDestMem->LOD[iLOD - 1].Slices = SliceTable.data() + LevelBegin[iLOD];
+		pDestMem->LOD[iLOD - 1].numSlices = LevelBegin[iLOD + 1] - LevelBegin[iLOD];
+	}
+	
+#ifdef VOX_DEBUG_ENABLED
+	DebugMessage("vox %d slices", pDestMem->numSlices);
+#endif
+}
 
+#ifdef VOX_BAKE_MODELS
+// level of detail n: cells of 2^n voxels, a cell is occupied if any of its voxels is
+// shade of a cell is the average gray level of its voxels
+static void Decimate( ChunkDimensions& __restrict sizeLevel, std::vector<VoxelData>& __restrict Level, 
+											ChunkDimensions const& __restrict sizeChunk, std::vector<VoxelData> const& __restrict Voxels, uint32_t const Shift )
+{
+	sizeLevel.Width = ((sizeChunk.Width - 1) >> Shift) + 1;
+	sizeLevel.Depth = ((sizeChunk.Depth - 1) >> Shift) + 1;
+	sizeLevel.Height = ((sizeChunk.Height - 1) >> Shift) + 1;
+	
+	uint32_t const numCells( sizeLevel.Width * sizeLevel.Depth * sizeLevel.Height );
+	std::vector<uint32_t> Sum(numCells, 0), Count(numCells, 0);
+	
+	for ( VoxelData const& oVoxel : Voxels ) {
+		
+		if ( oVoxel.x < sizeChunk.Width && oVoxel.y < sizeChunk.Depth && oVoxel.z < sizeChunk.Height ) {
+			uint32_t const uiCell( ((oVoxel.z >> Shift) * sizeLevel.Depth + (oVoxel.y >> Shift)) * sizeLevel.Width + (oVoxel.x >> Shift) );
+			Sum[uiCell] += oVoxel.shadeIndex;
+			++Count[uiCell];
+		}
+	}
+	
+	Level.clear();
+	for ( int32_t z = 0 ; z < sizeLevel.Height ; ++z ) {
+		for ( int32_t y = 0 ; y < sizeLevel.Depth ; ++y ) {
+			for ( int32_t x = 0 ; x < sizeLevel.Width ; ++x ) {
+				
+				uint32_t const uiCell( (z * sizeLevel.Depth + y) * sizeLevel.Width + x );
+				if ( 0 != Count[uiCell] ) {
+					VoxelData const oCell = { (uint8_t)x, (uint8_t)y, (uint8_t)z, (uint8_t)((Sum[uiCell] + (Count[uiCell] >> 1)) / Count[uiCell]) };
+					Level.push_back(oCell);
+				}
+			}
+		}
+	}
+}
+
+// every level is culled, sorted and has the adjacency of Load (the shade is the gray level already, not a palette index)
+bool const Bake( std::vector<uint8_t>& __restrict Image, uint8_t const * const pSourceVoxBinaryData, bool const isDynamic )
+{
+	static constexpr uint32_t const  TAG_LN = 4;
+	static constexpr char const      TAG_PALETTE[TAG_LN]			= { 'R', 'G', 'B', 'A' };
+	
+	ChunkDimensions sizeChunk;
+	uint32_t numVoxels;
+	VoxelData const* const pVoxels( ReadModel(pSourceVoxBinaryData, sizeChunk, numVoxels) );
+	
+	if ( nullptr == pVoxels )
+		return(false);
+	
+	voxelModelBakedHeader Header;
+	memset(&Header, 0, sizeof(Header));
+	Header.Magic = BAKED_MAGIC;
+	Header.Version = BAKED_VERSION;
+	Header.isDynamic = isDynamic ? 1 : 0;
+	
+	{ // grayscale palette mapping, same as Load. If the "RGBA" chunk does not exist the shadeIndex = greyscale level
+		uint8_t const* pReadPointer( reinterpret_cast<uint8_t const*>(pVoxels + numVoxels) );
+		ChunkHeader paletteChunk;
+		ReadData((void* const __restrict)&paletteChunk, pReadPointer, sizeof(paletteChunk));
+		
+		if (CompareTag(countof(TAG_PALETTE), (uint8_t const* const)paletteChunk.id, TAG_PALETTE)) {
+			
+			pReadPointer += sizeof(paletteChunk);
+			Header.GrayLevels[0] = xDMA2D::AlphaLuma(0).getConvertColorToLinearGray();
+			for ( uint32_t iDx = 0 ; iDx < 255 ; ++iDx ) {
+				// swizzle RGBA to ARGB
+				xDMA2D::AlphaLuma const ARGB( (*(pReadPointer+3) << 24) | (*(pReadPointer) << 16) | (*(pReadPointer+1) << 8) | *(pReadPointer+2) );
+				Header.GrayLevels[iDx + 1] = ARGB.getConvertColorToLinearGray();
+				pReadPointer += sizeof(uint32_t);
+			}
+		}
+		else {
+			for ( uint32_t iDx = 0 ; iDx < 256 ; ++iDx ) {
+				Header.GrayLevels[iDx] = iDx;
+			}
+		}
+	}
+	
+	std::vector<VoxelData> Voxels(pVoxels, pVoxels + numVoxels), Level;
+	for ( VoxelData& oVoxel : Voxels ) {
+		oVoxel.shadeIndex = Header.GrayLevels[oVoxel.shadeIndex];
+	}
+	
+	std::vector<voxelDescPacked> Levels[MAX_LODS];
+	
+	for ( uint32_t iLOD = 0 ; iLOD < MAX_LODS ; ++iLOD ) {
+		
+		ChunkDimensions sizeLevel;
+		
+		if ( 0 == iLOD ) {
+			sizeLevel = sizeChunk;
+			Level = Voxels;
+		}
+		else {
+			Decimate(sizeLevel, Level, sizeChunk, Voxels, iLOD);
+			if ( sizeLevel.Width < 2 || sizeLevel.Depth < 2 || sizeLevel.Height < 2 )
+				break;	// nothing left to decimate
+		}
+		
+		voxelModelBase Model(isDynamic);
+		LoadVoxels<OccupancyBitmap>(&Model, sizeLevel, Level.data(), Level.size());
+		if ( Model.VoxelsTemp.empty() )
+			break;
+		
+		// Sort the voxels by "slices" on .z (height offset) axis
+		std::sort(Model.VoxelsTemp.begin(), Model.VoxelsTemp.end());
+		Levels[iLOD].swap(Model.VoxelsTemp);
+		
+		voxelModelBakedLOD& __restrict Desc( Header.LOD[iLOD] );
+		Desc.numVoxels = Levels[iLOD].size();
+		Desc.dimensionX = sizeLevel.Width - 1; Desc.dimensionY = sizeLevel.Depth - 1; Desc.dimensionZ = sizeLevel.Height - 1;
+		++Header.numLODs;
+	}
+	
+	if ( 0 == Header.numLODs )
+		return(false);
+	
+	// bounds of the full detail voxels
+	Header.BoundsMin[0] = Header.BoundsMin[1] = Header.BoundsMin[2] = UINT8_MAX;
+	for ( voxelDescPacked const& oVoxel : Levels[0] ) {
+		uint8_t const Coord[3] = { (uint8_t)oVoxel.x, (uint8_t)oVoxel.y, (uint8_t)oVoxel.z };
+		for ( uint32_t iAxis = 0 ; iAxis < 3 ; ++iAxis ) {
+			Header.BoundsMin[iAxis] = min(Header.BoundsMin[iAxis], Coord[iAxis]);
+			Header.BoundsMax[iAxis] = max(Header.BoundsMax[iAxis], Coord[iAxis]);
+		}
+	}
+	
+	// layout: header, then the voxels of each level (4 byte aligned, voxelDescPacked is 4 bytes)
+	uint32_t Offset( sizeof(Header) );
+	for ( uint32_t iLOD = 0 ; iLOD < Header.numLODs ; ++iLOD ) {
+		Header.LOD[iLOD].Offset = Offset;
+		Offset += Header.LOD[iLOD].numVoxels * sizeof(voxelDescPacked);
+	}
+	Header.SizeInBytes = Offset;
+	
+	size_t const Base( Image.size() );
+	Image.resize(Base + Header.SizeInBytes);
+	memcpy(&Image[Base], &Header, sizeof(Header));
+	for ( uint32_t iLOD = 0 ; iLOD < Header.numLODs ; ++iLOD ) {
+		memcpy(&Image[Base + Header.LOD[iLOD].Offset], Levels[iLOD].data(), Header.LOD[iLOD].numVoxels * sizeof(voxelDescPacked));
+	}
+	
+	return(true);
+}
+#endif /*VOX_BAKE_MODELS*/
 
 } // end namespace voxB
 } // end namespace Volumetric
@@ -0,0 +1,133 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "VoxImpostor.h"
+
+#ifdef VOX_IMPOSTOR_CACHE
+#include "oled.h"
+
+sImpostorCapture ImpostorCapture
+	__attribute__((section (".dtcm")));
+
+namespace VoxImpostor
+{
+static uint8_t Luma[NUM_SLOTS][HEIGHT * WIDTH]																		// 8bpp,     32KB      4x 128x64
+__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
+__attribute__((section (".ext_sram.impostorluma")));
+
+static depth_t Depth[NUM_SLOTS][HEIGHT * WIDTH]																		// depth_t,  32/64KB   4x 128x64
+__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
+__attribute__((section (".ext_sram.impostordepth")));
+
+static uint8_t Alpha[NUM_SLOTS][HEIGHT * WIDTH]																		// 8bpp,     32KB      4x 128x64, only valid where Depth is not EMPTY
+__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
+__attribute__((section (".ext_sram.impostoralpha")));
+
+static uint32_t AA[NUM_SLOTS][(HEIGHT * WIDTH) >> 5]															// 1bpp,     4KB       4x 128x64, only valid where Depth is not EMPTY
+__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
+__attribute__((section (".ext_sram.impostoraa")));
+
+static_assert(4 == NUM_SLOTS, "slots are initialized below");
+static Impostor Slots[NUM_SLOTS]{ Impostor(Luma[0], Depth[0], Alpha[0], AA[0]), Impostor(Luma[1], Depth[1], Alpha[1], AA[1]),
+																  Impostor(Luma[2], Depth[2], Alpha[2], AA[2]), Impostor(Luma[3], Depth[3], Alpha[3], AA[3]) };
+
+static Impostor* __restrict pCapturing(nullptr);
+
+Impostor const* const __restrict Find( void const* const Model, uint32_t const uiLOD, uint32_t const uiHeading, uint32_t const tNow )
+{
+	for ( uint32_t iDx = 0 ; iDx < NUM_SLOTS ; ++iDx )
+	{
+		Impostor& __restrict oSlot(Slots[iDx]);
+
+		if ( oSlot.Valid && Model == oSlot.Model && uiLOD == oSlot.LOD && uiHeading == oSlot.Heading ) {
+
+			if ( tNow - oSlot.tCaptured >= MAX_AGE )
+				return(nullptr);	// lighting is stale, captured again into the same slot
+
+			oSlot.tLastUsed = tNow;
+			return(&oSlot);
+		}
+	}
+	return(nullptr);
+}
+
+void BeginCapture( void const* const Model, uint32_t const uiLOD, uint32_t const uiHeading, uint32_t const tNow,
+									 point2D_t const Origin, int32_t const DepthOrigin )
+{
+	Impostor* __restrict pSlot(&Slots[0]);
+
+	for ( uint32_t iDx = 0 ; iDx < NUM_SLOTS ; ++iDx )
+	{
+		Impostor* const __restrict pCandidate(&Slots[iDx]);
+
+		if ( Model == pCandidate->Model && uiLOD == pCandidate->LOD && uiHeading == pCandidate->Heading ) {
+			pSlot = pCandidate;	// same key
+			break;
+		}
+		if ( (int32_t)(pCandidate->tLastUsed - pSlot->tLastUsed) < 0 ) {
+			pSlot = pCandidate;	// least recently used
+		}
+	}
+
+	uint8_t* const __restrict pLuma( Luma[pSlot - Slots] );
+	depth_t* const __restrict pDepth( Depth[pSlot - Slots] );
+
+	// only the bounds of the previous impostor were written
+	if ( pSlot->xMin <= pSlot->xMax ) {
+
+		for ( int32_t y = pSlot->yMin ; y <= pSlot->yMax ; ++y ) {
+			OLED::FillDepth(pDepth + (y << WIDTH_BITS) + pSlot->xMin, EMPTY, pSlot->xMax - pSlot->xMin + 1);
+		}
+	}
+
+	pSlot->Model = Model; pSlot->LOD = uiLOD; pSlot->Heading = uiHeading;
+	pSlot->tCaptured = pSlot->tLastUsed = tNow;
+	pSlot->Valid = false;
+
+	ImpostorCapture.Luma = pLuma;
+	ImpostorCapture.Depth = pDepth;
+	ImpostorCapture.Alpha = Alpha[pSlot - Slots];
+	ImpostorCapture.AA = AA[pSlot - Slots];
+	ImpostorCapture.Origin = p2D_sub(Origin, point2D_t(WIDTH >> 1, HEIGHT >> 1));
+	ImpostorCapture.DepthOrigin = DepthOrigin;
+	ImpostorCapture.xMin = ImpostorCapture.yMin = INT32_MAX;
+	ImpostorCapture.xMax = ImpostorCapture.yMax = INT32_MIN;
+	ImpostorCapture.Rejected = 0;
+
+	pCapturing = pSlot;
+}
+
+void EndCapture()
+{
+	Impostor* const __restrict pSlot(pCapturing);
+	pCapturing = nullptr;
+
+	if ( nullptr == pSlot )
+		return;
+
+	pSlot->xMin = ImpostorCapture.xMin; pSlot->yMin = ImpostorCapture.yMin;
+	pSlot->xMax = ImpostorCapture.xMax; pSlot->yMax = ImpostorCapture.yMax;	// nothing drawn leaves xMin > xMax
+
+	if ( 0 != ImpostorCapture.Rejected || pSlot->xMin > pSlot->xMax )
+		return;
+
+	// clipped by the screen edges, pixels outside of the screen are never drawn
+	point2D_t const vMin( p2D_add(ImpostorCapture.Origin, point2D_t(pSlot->xMin, pSlot->yMin)) ),
+									vMax( p2D_add(ImpostorCapture.Origin, point2D_t(pSlot->xMax, pSlot->yMax)) );
+
+	if ( vMin.pt.x <= 0 || vMin.pt.y <= 0 || vMax.pt.x >= (int32_t)(OLED::SCREEN_WIDTH - 1) || vMax.pt.y >= (int32_t)(OLED::SCREEN_HEIGHT - 1) )
+		return;
+
+	pSlot->Valid = true;
+}
+
+} // end namespace
+
+#endif /*VOX_IMPOSTOR_CACHE*/
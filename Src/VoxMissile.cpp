@@ -11,19 +11,22 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "globals.h"
 #include "VoxMissile.h"
 
-#include "IsoVoxel.h"
+#include "isoVoxel.h"
 #include "voxelModelsFRAM.h"
 #include "Lighting.h"
 #include "vector_rotation.h"
 
+#include <vector>
+
 #ifdef VOX_DEBUG_ENABLED
-#include "debug.cpp"
+#include "Debug.cpp"
 #endif
 
 static constexpr uint32_t const SNAP_TIME = 500; // ms
 static constexpr float const MISSILE_VELOCITY = 0.022f,
 														 MISSILE_ALTITUDE = 36.0F,
 														 BEGIN_DESCENT = 0.82f;		// Beginning [ 0.0f .... 1.0f ] End
+static constexpr float const LOD_DISTANCE = 6.0f;		// grid units from the center of the screen, each multiple is the next level of detail (baked models only)
 	
 VoxMissile::VoxMissile( uint32_t const tNow, vec2_t const worldCoord, vec2_t const worldCoordTarget )
 	: Volumetric::voxB::voxelModelInstance_Dynamic(Volumetric::voxFRAM::voxelModelBlackBird, worldCoord),
@@ -99,10 +102,61 @@ bool const VoxMissile::Update( uint32_t const tNow )
 
 	return(false);   // dead instance
 }
-void VoxMissile::Render() const
+void VoxMissile::Render( uint32_t const tNow ) const
 {
+	// distant missiles use the decimated levels of the model, the followed missile is always full detail
+	uint32_t const uiLOD( (uint32_t)(v2_length( v2_sub(vLoc, world::getOrigin()) ) * (1.0f / LOD_DISTANCE)) );
+	
+#ifdef VOX_IMPOSTOR_CACHE
+	// heading barely changes between frames, drawn from the impostor of the nearest cached heading
+	Volumetric::RenderVoxelModel_Impostor<Lighting::shade_op_defaultlighting, Lighting::shade_op_defaultlighting_normal, 
+																				OLED::FRONT_BUFFER, (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
+																			 (vLoc, vR, &model, fAltittude, uiLOD, tNow);
+#else
 	Volumetric::RenderVoxelModel<Lighting::shade_op_defaultlighting, Lighting::shade_op_defaultlighting_normal, 
 															 OLED::FRONT_BUFFER, (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
-									             (vLoc, vR, &model, fAltittude);
+									             (vLoc, vR, &model, fAltittude, uiLOD);
+#endif
 }
 
+// every missile shares the model, so the batch streams the model once from FRAM for all of them
+void VoxMissile::RenderBatch( VoxMissile const* const* const __restrict ppMissiles, uint32_t const numMissiles, uint32_t const tNow )
+{
+	// no limit on the missiles, RenderVoxelModels splits larger batches
+	static std::vector<Volumetric::voxB::voxelModelInstance_Dynamic const*> Visible;
+	static std::vector<float> Altitude;
+	
+	Visible.clear(); Altitude.clear();
+	uint32_t uiLOD(UINT32_MAX);
+	
+	for ( uint32_t iDx = 0 ; iDx < numMissiles ; ++iDx ) {
+		
+		VoxMissile const* const __restrict pMissile( ppMissiles[iDx] );
+		
+		if ( nullptr != pMissile && pMissile->isVisible() ) {
+			
+			Visible.push_back(pMissile);
+			Altitude.push_back(pMissile->fAltittude);
+			
+			// one level of detail for the batch, the finest any missile needs
+			uiLOD = min(uiLOD, (uint32_t)(v2_length( v2_sub(pMissile->vLoc, world::getOrigin()) ) * (1.0f / LOD_DISTANCE)));
+		}
+	}
+	
+	uint32_t const numVisible( Visible.size() );
+	if ( 0 == numVisible )
+		return;
+	
+#ifndef VOX_IMPOSTOR_CACHE
+	if ( numVisible > 1 ) {
+		Volumetric::RenderVoxelModels<Lighting::shade_op_defaultlighting, Lighting::shade_op_defaultlighting_normal, 
+																	OLED::FRONT_BUFFER, (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
+																 (Visible.data(), Altitude.data(), numVisible, uiLOD);
+		return;
+	}
+#endif
+	// impostors are not read from FRAM
+	for ( uint32_t iDx = 0 ; iDx < numVisible ; ++iDx ) {
+		static_cast<VoxMissile const*>(Visible[iDx])->Render(tNow);
+	}
+}
@@ -12,33 +12,35 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 //#define DEBUG_RENDER
 
-#include "World.h"
+#include "world.h"
 #include "oled.h"
 #include "rng.h"
-#include "lighting.h"
+#include "Lighting.h"
 
 #include "isoVoxel.h"
 #include "noise.h"
-#include "FLASH\imports.h"
+#include "FLASH/imports.h"
 #include "BuildingGeneration.h"
 #include "AIBot.h"
 
-#include "fireEffect.h"
+#include "FireEffect.h"
 #include "fractalboxesEffect.h"
-#include "fogEffect.h"
+#include "FogEffect.h"
 
 #include "voxelModelsFRAM.h"
 #define VOX_IMPL
 #include "VoxMissile.h"
-#include "Shockwave.h"
-#include "Explosion.h"
+#include "shockwave.h"
+#include "explosion.h"
+#include "Profiler.h"
+#include "InputReplay.h"
 
 
 #ifdef ENABLE_SKULL
 #include "effect_sdf_viewer.h"
 #endif
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
 using namespace world;
 
@@ -166,6 +168,47 @@ static struct WorldEntity
 Iso::Voxel WorldEntity::theGrid[Iso::WORLD_GRID_SIZE*Iso::WORLD_GRID_SIZE]
 					__attribute__((section (".ext_sram.thegrid")));		
 
+// Storage layout of theGrid, all access goes thru getGrid / getGridOffset with Grid Space (0,0) to (X,Y) coordinates
+// Row major, a neighbour on the y axis is a whole 576 byte row away. theGrid is in external SRAM on the 8bit FMC bus with
+// bursts disabled, every access outside the current row is a new transaction.
+// GRID_MORTON_CHUNKS stores the grid as 36x36 chunks of 8x8 voxels (128 bytes), chunks row major and the voxels
+// inside a chunk in morton (z-order) so all 8 neighbours and the isometric diagonal walk of the grid traversal mostly stay inside
+// the same 128 bytes
+#ifdef GRID_MORTON_CHUNKS
+namespace GridChunk
+{
+	static constexpr uint32_t const SIZE_SATBITS = 3,
+																	SIZE = (1 << SIZE_SATBITS),
+																	VOXELS = SIZE * SIZE,
+																	PER_ROW = Iso::WORLD_GRID_SIZE >> SIZE_SATBITS;
+	
+	static_assert( 0 == (Iso::WORLD_GRID_SIZE & (SIZE - 1)), "world grid must be a multiple of the chunk size" );
+	
+	// spreads the 3 bits of a chunk local coordinate to every other bit
+	__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const Spread(uint32_t const v)
+	{
+		return( (v & 1) | ((v & 2) << 1) | ((v & 4) << 2) );
+	}
+} // end namespace
+#endif
+
+__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getGridOffset( uint32_t const x, uint32_t const y )
+{
+#ifdef GRID_MORTON_CHUNKS
+	uint32_t const Chunk( ((y >> GridChunk::SIZE_SATBITS) * GridChunk::PER_ROW) + (x >> GridChunk::SIZE_SATBITS) ),
+								 Morton( GridChunk::Spread(x & (GridChunk::SIZE - 1)) | (GridChunk::Spread(y & (GridChunk::SIZE - 1)) << 1) );
+	
+	return( (Chunk * GridChunk::VOXELS) + Morton );
+#else
+	return( (y * Iso::WORLD_GRID_SIZE) + x );
+#endif
+}
+// no bounds checking
+__attribute__((always_inline)) STATIC_INLINE_PURE Iso::Voxel* const __restrict getGrid( uint32_t const x, uint32_t const y )
+{
+	return( oWorld.theGrid + getGridOffset(x, y) );
+}
+
 // ####### Private Init merthods
 
 // "voxelindices" are the (0,0) to (X,Y) integral representation of Grid Space
@@ -232,7 +275,7 @@ __attribute__((pure)) STATIC_INLINE Iso::Voxel const* const __restrict getNeighb
 		
 		if ( voxelNeighbour.pt.x < Iso::WORLD_GRID_SIZE && voxelNeighbour.pt.y < Iso::WORLD_GRID_SIZE ) {
 			
-			return( (oWorld.theGrid + ((voxelNeighbour.pt.y * Iso::WORLD_GRID_SIZE) + voxelNeighbour.pt.x)) );
+			return( getGrid(voxelNeighbour.pt.x, voxelNeighbour.pt.y) );
 		}
 	}
 	
@@ -289,6 +332,13 @@ __attribute__((pure)) STATIC_INLINE Iso::Voxel const* const __restrict FindRootV
 	return(nullptr);
 }
 
+// Height of a neighbour as seen by the ground occlusion, only ground voxels have height as ground
+// structures, destruction and effects all draw flat ground (RenderFlatForcedGround) beneath them
+__attribute__((always_inline)) STATIC_INLINE_PURE uint32_t const getGroundHeightStep( Iso::Voxel const oVoxel )
+{
+	return( isGround(oVoxel) ? Iso::getHeightStep(oVoxel) : Iso::DESC_HEIGHT_STEP_0 );
+}
+
 // Grid Space Coordinates (0,0) to (X,Y) Only		
 __attribute__((pure)) STATIC_INLINE bool const isCompletelyOcclulded( point2D_t const& __restrict voxelIndex, Iso::Voxel const& oVoxelTest )
 {
@@ -305,7 +355,7 @@ __attribute__((pure)) STATIC_INLINE bool const isCompletelyOcclulded( point2D_t
 		
 		if ( nullptr != pOccluder ) {
 			Iso::Voxel const oOcculder(*pOccluder);
-			if ( isVoxelVisible(oOcculder) ) {
+			if ( isGround(oOcculder) && isVoxelVisible(oOcculder) ) {	// visibility bits are only valid for ground
 				uint32_t const heightOccluder(Iso::getHeightStep(oOcculder));
 				
 				return( heightOccluder >= HEIGHT_THRESHOLD && heightOccluder > heightOccludee ); 
@@ -315,6 +365,106 @@ __attribute__((pure)) STATIC_INLINE bool const isCompletelyOcclulded( point2D_t
 	return(false);
 }
 
+// Grid Space Coordinates (0,0) to (X,Y) Only
+// Recomputes the occlusion bits of a single ground voxel from its current neighbours
+// returns true if the visibility of the voxel changed, the voxel NBR_TL of it depends on it (isCompletelyOcclulded)
+static bool const ComputeVoxelOcclusion( point2D_t const voxelIndex )
+{
+	Iso::Voxel* const theGrid = getGrid(voxelIndex.pt.x, voxelIndex.pt.y);
+	
+	// Get / Copy current voxel from external SRAM
+	Iso::Voxel oVoxel(*theGrid);
+	
+	if (!isGround(oVoxel))
+		return(false);
+	
+	bool const bWasVisible( isVoxelVisible(oVoxel) );
+	
+	if ( false == isCompletelyOcclulded(voxelIndex, oVoxel) ) {
+		
+		Iso::Voxel const* __restrict pNeighbour(nullptr);
+		uint32_t const curVoxelHeightStep(Iso::getHeightStep(oVoxel));
+		uint8_t OcclusionShading(0);
+		// Therefore the neighbours of a voxel, follow same isometric layout/order //
+		/*
+
+													NBR_TL
+									NBR_L						NBR_T
+				 NBR_BL						VOXEL						NBR_TR
+									NBR_B						NBR_R		
+													NBR_BR
+													
+		*/
+		// For top part of ground, check "corner" neighbours NBR_L & NBR_T to matched baked ao mask patterns
+		pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_L]);
+		if (nullptr != pNeighbour) {
+			Iso::Voxel const oNeighbour(*pNeighbour);
+			if ( getGroundHeightStep(oNeighbour) > curVoxelHeightStep ) {
+				OcclusionShading |= Iso::OCCLUSION_SHADING_TOP_LEFT;
+			}
+		}
+		pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_T]);
+		if (nullptr != pNeighbour) {
+			Iso::Voxel const oNeighbour(*pNeighbour);
+			if ( getGroundHeightStep(oNeighbour) > curVoxelHeightStep ) {
+				OcclusionShading |= Iso::OCCLUSION_SHADING_TOP_RIGHT;
+			}
+		}
+		
+		// further tests only apply to voxels of height greater than zero
+		if ( Iso::DESC_HEIGHT_STEP_0 != curVoxelHeightStep ) 
+		{
+			// Check if sides need to be rendered, neighbours NBR_B and NBR_R may occluded side of this voxel if same height or greater.
+			pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_B]);
+			if (nullptr != pNeighbour) {
+				Iso::Voxel const oNeighbourBottom(*pNeighbour);
+				if ( getGroundHeightStep(oNeighbourBottom) >= (curVoxelHeightStep) ) {
+					
+					pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_R]);
+					if (nullptr != pNeighbour) {
+						Iso::Voxel const oNeighbourRight(*pNeighbour);
+						if ( getGroundHeightStep(oNeighbourRight) >= (curVoxelHeightStep) ) {
+							OcclusionShading |= Iso::OCCLUSION_SIDES_NOT_VISIBILE;
+						}
+					}
+				}
+			}
+			
+			// For side parts of ground, check left/right neighbours NBR_BL & NBR_TR to match baked ao mask patterns
+			pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_BL]);
+			if (nullptr != pNeighbour) {
+				Iso::Voxel const oNeighbour(*pNeighbour);
+				if ( getGroundHeightStep(oNeighbour) >= (curVoxelHeightStep) ) {
+					OcclusionShading |= Iso::OCCLUSION_SHADING_SIDE_LEFT;
+				}
+			}
+			pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_TR]);
+			if (nullptr != pNeighbour) {
+				Iso::Voxel const oNeighbour(*pNeighbour);
+				if ( getGroundHeightStep(oNeighbour) >= (curVoxelHeightStep) ) {
+					OcclusionShading |= Iso::OCCLUSION_SHADING_SIDE_RIGHT;
+				}
+			}
+		}
+		
+		// finally, if no flags were set on occlusion, flag as such
+		if ( 0 == OcclusionShading ) {
+			Iso::setOcclusion(oVoxel, Iso::OCCLUSION_SHADING_NONE);
+		}
+		else {	// other wise save computed ao shading
+			Iso::setOcclusion(oVoxel, OcclusionShading);
+		}
+	}
+	else {
+		// mark this voxel as not visible
+		setNotVisible(oVoxel);
+	}
+	// Update current voxel in external SRAM
+	*theGrid = oVoxel;
+	
+	return( bWasVisible != isVoxelVisible(oVoxel) );
+}
+
 static void ComputeGroundOcclusion()
 {
 	point2D_t voxelIndex(Iso::WORLD_GRID_SIZE - 1, Iso::WORLD_GRID_SIZE - 1);
@@ -327,95 +477,7 @@ static void ComputeGroundOcclusion()
 
 		while ( voxelIndex.pt.x >= 0 ) 
 		{		
-			Iso::Voxel* const theGrid = (oWorld.theGrid + ((voxelIndex.pt.y * Iso::WORLD_GRID_SIZE) + voxelIndex.pt.x));
-			
-			// Get / Copy current voxel from external SRAM
-			Iso::Voxel oVoxel(*theGrid);
-			
-			if (isGround(oVoxel))
-			{
-				if ( false == isCompletelyOcclulded(voxelIndex, oVoxel) ) {
-					
-					Iso::Voxel const* __restrict pNeighbour(nullptr);
-					uint32_t const curVoxelHeightStep(Iso::getHeightStep(oVoxel));
-					uint8_t OcclusionShading(0);
-					// Therefore the neighbours of a voxel, follow same isometric layout/order //
-					/*
-
-																NBR_TL
-												NBR_L						NBR_T
-							 NBR_BL						VOXEL						NBR_TR
-												NBR_B						NBR_R		
-																NBR_BR
-																
-					*/
-					// For top part of ground, check "corner" neighbours NBR_L & NBR_T to matched baked ao mask patterns
-					pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_L]);
-					if (nullptr != pNeighbour) {
-						Iso::Voxel const oNeighbour(*pNeighbour);
-						if ( Iso::getHeightStep(oNeighbour) > curVoxelHeightStep ) {
-							OcclusionShading |= Iso::OCCLUSION_SHADING_TOP_LEFT;
-						}
-					}
-					pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_T]);
-					if (nullptr != pNeighbour) {
-						Iso::Voxel const oNeighbour(*pNeighbour);
-						if ( Iso::getHeightStep(oNeighbour) > curVoxelHeightStep ) {
-							OcclusionShading |= Iso::OCCLUSION_SHADING_TOP_RIGHT;
-						}
-					}
-					
-					// further tests only apply to voxels of height greater than zero
-					if ( Iso::DESC_HEIGHT_STEP_0 != curVoxelHeightStep ) 
-					{
-						// Check if sides need to be rendered, neighbours NBR_B and NBR_R may occluded side of this voxel if same height or greater.
-						pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_B]);
-						if (nullptr != pNeighbour) {
-							Iso::Voxel const oNeighbourBottom(*pNeighbour);
-							if ( Iso::getHeightStep(oNeighbourBottom) >= (curVoxelHeightStep) ) {
-								
-								pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_R]);
-								if (nullptr != pNeighbour) {
-									Iso::Voxel const oNeighbourRight(*pNeighbour);
-									if ( Iso::getHeightStep(oNeighbourRight) >= (curVoxelHeightStep) ) {
-										OcclusionShading |= Iso::OCCLUSION_SIDES_NOT_VISIBILE;
-									}
-								}
-							}
-						}
-						
-						// For side parts of ground, check left/right neighbours NBR_BL & NBR_TR to match baked ao mask patterns
-						pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_BL]);
-						if (nullptr != pNeighbour) {
-							Iso::Voxel const oNeighbour(*pNeighbour);
-							if ( Iso::getHeightStep(oNeighbour) >= (curVoxelHeightStep) ) {
-								OcclusionShading |= Iso::OCCLUSION_SHADING_SIDE_LEFT;
-							}
-						}
-						pNeighbour = ::getNeighbour(voxelIndex, ADJACENT[NBR_TR]);
-						if (nullptr != pNeighbour) {
-							Iso::Voxel const oNeighbour(*pNeighbour);
-							if ( Iso::getHeightStep(oNeighbour) >= (curVoxelHeightStep) ) {
-								OcclusionShading |= Iso::OCCLUSION_SHADING_SIDE_RIGHT;
-							}
-						}
-					}
-					
-					// finally, if no flags were set on occlusion, flag as such
-					if ( 0 == OcclusionShading ) {
-						Iso::setOcclusion(oVoxel, Iso::OCCLUSION_SHADING_NONE);
-					}
-					else {	// other wise save computed ao shading
-						Iso::setOcclusion(oVoxel, OcclusionShading);
-					}
-				}
-				else {
-					// mark this voxel as not visible
-					setNotVisible(oVoxel);
-				}
-				// Update current voxel in external SRAM
-				*theGrid = oVoxel;
-			}
+			ComputeVoxelOcclusion(voxelIndex);
 			
 			--voxelIndex.pt.x;
 		}
@@ -423,6 +485,71 @@ static void ComputeGroundOcclusion()
 	}
 }
 
+// Incremental ground occlusion
+// every setVoxelAt adds the voxel to a dirty set, once per frame (world::Update) FlushGroundOcclusion recomputes the 3x3
+// neighbourhood of each, all the neighbours that read the edited voxel. When the visibility of a voxel changes, the chain
+// of NBR_TL voxels it may be occluding is followed until visibility stops changing.
+// Duplicate edits of the same voxel in a frame are only recomputed once, if the set fills up it is flushed early.
+static struct sOcclusionDirtySet
+{
+	static constexpr uint32_t const MAX_DIRTY = 64;
+	
+	point2D_t	voxelIndex[MAX_DIRTY];
+	uint32_t	Count;
+	
+	sOcclusionDirtySet()
+	: Count(0)
+	{}
+} oOcclusionDirty;
+
+// Grid Space Coordinates (0,0) to (X,Y) Only
+static void UpdateGroundOcclusion( point2D_t const voxelIndex )
+{
+	// same order as the full pass, BR => TL
+	for ( int32_t iDy = 1 ; iDy >= -1 ; --iDy ) {
+		for ( int32_t iDx = 1 ; iDx >= -1 ; --iDx ) {
+			
+			point2D_t voxelUpdate( p2D_add(voxelIndex, point2D_t(iDx, iDy)) );
+			
+			// follow the visibility chain towards NBR_TL
+			while ( (voxelUpdate.pt.x | voxelUpdate.pt.y) >= 0 && voxelUpdate.pt.x < Iso::WORLD_GRID_SIZE && voxelUpdate.pt.y < Iso::WORLD_GRID_SIZE ) {
+				
+				if ( !ComputeVoxelOcclusion(voxelUpdate) )
+					break;
+				
+				voxelUpdate = p2D_add(voxelUpdate, ADJACENT[NBR_TL]);
+			}
+		}
+	}
+}
+
+static void FlushGroundOcclusion()
+{
+	uint32_t const Count(oOcclusionDirty.Count);
+	
+	for ( uint32_t iDx = 0 ; iDx < Count ; ++iDx ) {
+		UpdateGroundOcclusion(oOcclusionDirty.voxelIndex[iDx]);
+	}
+	oOcclusionDirty.Count = 0;
+}
+
+// Grid Space Coordinates (0,0) to (X,Y) Only
+static void MarkGroundOcclusionDirty( point2D_t const voxelIndex )
+{
+	uint32_t const Count(oOcclusionDirty.Count);
+	
+	for ( uint32_t iDx = 0 ; iDx < Count ; ++iDx ) {
+		if ( oOcclusionDirty.voxelIndex[iDx].v == voxelIndex.v )
+			return; // already pending
+	}
+	
+	if ( unlikely(sOcclusionDirtySet::MAX_DIRTY == Count) ) {
+		FlushGroundOcclusion();
+	}
+	
+	oOcclusionDirty.voxelIndex[oOcclusionDirty.Count++].v = voxelIndex.v;
+}
+
 static void GenerateGround(uint32_t const tNow)
 {
 	static constexpr float const NOISE_SCALAR_HEIGHT = 21.0f;
@@ -507,7 +634,7 @@ static void GenerateGround(uint32_t const tNow)
 			}
 	
 			// Save Voxel to Grid SRAM
-			*(oWorld.theGrid + ((yVoxel * Iso::WORLD_GRID_SIZE) + xVoxel)) = oVoxel;
+			*getGrid(xVoxel, yVoxel) = oVoxel;
 
 			--xVoxel;
 		}
@@ -534,6 +661,8 @@ namespace world
 // ####### Public Init merthods
 NOINLINE void Init( uint32_t const tNow )
 {
+	INPUT_RECORD(InputReplay::EVENT_INIT, tNow);
+	
 #ifdef ENABLE_SKULL
 	SDF_Viewer::Initialize();
 #endif
@@ -551,10 +680,11 @@ NOINLINE void Init( uint32_t const tNow )
 	GenerateGround(tNow);
 	
 	BuildingGen::Init(tNow);
+	FlushGroundOcclusion();	// plots placed
 	
 	IsoDepth::Init();
 	
-	oWorld.tStart = millis();
+	oWorld.tStart = INPUT_MILLIS();
 }
 
 NOINLINE void DeferredInit( uint32_t const tNow )
@@ -595,7 +725,26 @@ typedef struct sHashPlotDesc
 						PlotSize;
 	
 } HashPlotDesc;
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+
+// world positions (midpoint of each vertical line) of the N face columns starting at column iD
+// xColumn is the x of column 0, xStep is -1 for the left face, +1 for the front face
+// shadows are looked up at the voxel base Origin, the midpoints are raised half the face height on screen
+template<uint32_t const N>
+STATIC_INLINE void setFaceColumnBatch( Lighting::ShadeBatch<N>& __restrict Batch, int32_t const iD, int32_t const xColumn, int32_t const xStep,
+																			 point2D_t const yPoint, uint32_t const uiHeight, point2D_t const Origin )
+{
+	Batch.vOrigin = p2D_to_v2(Origin);
+	
+	for ( int32_t i = 0 ; i < (int32_t)N ; ++i )
+	{
+		int32_t const iColumn(iD + i);
+		point2D_t const curYPoints(p2D_sub(yPoint, point2D_t(iColumn >> 1, iColumn >> 1)));
+		
+		Batch.set(i, vec3_t(xColumn + xStep * iColumn, uiHeight >> 1, curYPoints.pt.y - ((curYPoints.pt.y - curYPoints.pt.x) >> 1)));
+	}
+}
+
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static bool const RenderHashFloorLevel(point2D_t const Origin, uint32_t const uiHeight, uint32_t const HeightRemaining,
 																			 FloorArgs const& descFloor)
 {
@@ -638,15 +787,18 @@ static bool const RenderHashFloorLevel(point2D_t const Origin, uint32_t const ui
 			// only calculate once for both diamonds if this is the case
 			if ( LumaExtra < 0 ) {
 				if ( HeightRemaining <= WorldEntity::FLOOR_HEIGHT_PIXELS ) {
-					LumaExtra = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vec3_t(Origin.pt.x, uiHeight, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mBuilding);
+					LumaExtra = Lighting::Shade_Cached(vec3_t(Origin.pt.x, uiHeight, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mBuilding);
 					bDoRoofTop = true;
 				}
 				else {
-					LumaExtra = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vec3_t(Origin.pt.x, uiHeight, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mBuildingWindow);
+					LumaExtra = Lighting::Shade_Cached(vec3_t(Origin.pt.x, uiHeight, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mBuildingWindow);
 				}
 			}
 		}
 			
+		Lighting::ShadeBatch<> batchLeft, batchFront;
+		int32_t iLitLeft(-1), iLitFront(-1);	// first column of the batch lit, a batch is lit by the first of its columns that passes the culls
+		
 		for (int iDx = (descFloor.diamondSize) - 1, iD = 0; iDx >= 0; iDx--, iD++)
 		{
 			point2D_t curXPoints, curYPoints;
@@ -654,6 +806,9 @@ static bool const RenderHashFloorLevel(point2D_t const Origin, uint32_t const ui
 			
 			curXPoints = p2D_add(xPoint, point2D_t(-iD, iD));
 			curYPoints = p2D_sub(yPoint, ptIncrement);
+			
+			uint32_t const iBatch(iD & (Lighting::SHADE_BATCH_SIZE - 1));
+			int32_t const iBatchStart(iD - iBatch);
 
 			{ // scope rooftop
 				// Draw Rooftop
@@ -702,14 +857,8 @@ static bool const RenderHashFloorLevel(point2D_t const Origin, uint32_t const ui
 
 			if ( OLED::CheckVLine_YAxis(curYPoints.pt.x, WorldEntity::FLOOR_HEIGHT_PIXELS) ) 
 			{
-				vec3_t vLineMidpoint;
 				uint32_t Luma;
 				
-				if ( OLED::SHADE_ENABLE & RenderingFlags ) {
-					// Get midpoint of line as world poistion for light incident ray
-					vLineMidpoint = vec3_t(0.0f, uiHeight >> 1, curYPoints.pt.y - ((curYPoints.pt.y - curYPoints.pt.x) >> 1));	
-				}
-				
 				// saturate y axis only to clip lines, x axis bounds are fully checked, y axis must be clipped to zero for line length calculation
 				curYPoints = p2D_saturate<OLED::Height_SATBITS>(curYPoints);
 				
@@ -717,8 +866,12 @@ static bool const RenderHashFloorLevel(point2D_t const Origin, uint32_t const ui
 					
 					if constexpr ( OLED::SHADE_ENABLE & RenderingFlags ) {
 							// Left Face
-							vLineMidpoint.x = curXPoints.pt.x;
-							Luma = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vLineMidpoint, Lighting::NORMAL_LEFTFACE, oWorld.mBuilding);
+							if ( iBatchStart != iLitLeft ) {
+								setFaceColumnBatch(batchLeft, iBatchStart, xPoint.pt.x, -1, yPoint, uiHeight, Origin);
+								Lighting::Shade_FullRange_Cached(batchLeft, Lighting::NORMAL_LEFTFACE, oWorld.mBuilding);
+								iLitLeft = iBatchStart;
+							}
+							Luma = Lighting::Shade(batchLeft, iBatch);
 					}
 					
 					OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(curXPoints.pt.x, curYPoints.pt.x, WorldEntity::FLOOR_HEIGHT_PIXELS, Luma);
@@ -729,8 +882,12 @@ static bool const RenderHashFloorLevel(point2D_t const Origin, uint32_t const ui
 					
 					if constexpr ( OLED::SHADE_ENABLE & RenderingFlags ) {
 						// Front Face
-						vLineMidpoint.x = curXPoints.pt.y;
-						Luma = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vLineMidpoint, Lighting::NORMAL_FRONTFACE, oWorld.mBuilding);
+						if ( iBatchStart != iLitFront ) {
+							setFaceColumnBatch(batchFront, iBatchStart, xPoint.pt.y, 1, yPoint, uiHeight, Origin);
+							Lighting::Shade_FullRange_Cached(batchFront, Lighting::NORMAL_FRONTFACE, oWorld.mBuilding);
+							iLitFront = iBatchStart;
+						}
+						Luma = Lighting::Shade(batchFront, iBatch);
 					}
 					
 					OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(curXPoints.pt.y, curYPoints.pt.x, WorldEntity::FLOOR_HEIGHT_PIXELS, Luma);
@@ -742,19 +899,8 @@ static bool const RenderHashFloorLevel(point2D_t const Origin, uint32_t const ui
 	return(true); 
 }
 
-static bool const SetupHashPlot( HashPlotDesc& descHashPlot, Iso::Voxel const oVoxel, point2D_t const Origin )
+STATIC_INLINE_PURE point2D_t const getPlotRadiiInPixels( uint32_t const uiPlotSize )
 {
-	uint32_t const uiHeight( oWorld.buildingHeightPixels[Iso::getHeightStep(oVoxel)] ), // in pixels
-								 uiPlotSize( Iso::getPlotSize(oVoxel) ); // in discreete units, 1,2,3,4 needs to be factor of grid radii to be pixels
-	
-	if (0 == uiHeight)
-		return(false); // vacant small plot
-	
-	if ( 1 == uiPlotSize ) {
-		if ( (PsuedoRandom5050()) ) // reduce the ugly 1 size plot building, too many and create some space
-			return(false);														 // improve performance as well (less ugly density)
-	}
-	
 	point2D_t plotRadiiInPixels;
 	
 	{
@@ -779,6 +925,30 @@ static bool const SetupHashPlot( HashPlotDesc& descHashPlot, Iso::Voxel const oV
 		}
 
 	}
+	return(plotRadiiInPixels);
+}
+// the root voxel origin passed in is offset from the actual plot origin, see SetupHashPlot
+STATIC_INLINE_PURE point2D_t const getPlotOrigin( point2D_t const Origin, point2D_t const plotRadiiInPixels )
+{
+	point2D_t const TRCorner( p2D_add( Origin, point2D_t((Iso::GRID_RADII), (Iso::GRID_RADII>>1)) ) );
+
+	return( p2D_sub( TRCorner, point2D_t( plotRadiiInPixels.pt.x, plotRadiiInPixels.pt.y >> 1 ) ) );
+}
+template<uint32_t const RenderingFlags>
+static bool const SetupHashPlot( HashPlotDesc& descHashPlot, Iso::Voxel const oVoxel, point2D_t const Origin )
+{
+	uint32_t const uiHeight( oWorld.buildingHeightPixels[Iso::getHeightStep(oVoxel)] ), // in pixels
+								 uiPlotSize( Iso::getPlotSize(oVoxel) ); // in discreete units, 1,2,3,4 needs to be factor of grid radii to be pixels
+	
+	if (0 == uiHeight)
+		return(false); // vacant small plot
+	
+	if ( 1 == uiPlotSize ) {
+		if ( (PsuedoRandom5050()) ) // reduce the ugly 1 size plot building, too many and create some space
+			return(false);														 // improve performance as well (less ugly density)
+	}
+	
+	point2D_t const plotRadiiInPixels( getPlotRadiiInPixels(uiPlotSize) );
 	
 	// Only the root "part" of the plot is called to render, siblings are ignored because this function renders their space
 	// The "root" part is always at the BR corner (max x, max y), so drawing must increase on the y axis, and decrease on the x axis
@@ -809,9 +979,7 @@ static bool const SetupHashPlot( HashPlotDesc& descHashPlot, Iso::Voxel const oV
 		// need to find origin of the plot, everything is based on it
 		// transform passed in "tile" origin  of root (BR corner (max x, max y)) to the actual BR corner of the plot
 
-		point2D_t const TRCorner( p2D_add( Origin, point2D_t((Iso::GRID_RADII), (Iso::GRID_RADII>>1)) ) );
-
-		point2D_t const plotOrigin( p2D_sub( TRCorner, point2D_t( plotRadiiInPixels.pt.x, plotRadiiInPixels.pt.y >> 1 ) ) );
+		point2D_t const plotOrigin( getPlotOrigin(Origin, plotRadiiInPixels) );
 		
 		{
 			point2D_t const ptExtents(plotRadiiInPixels.pt.x, 0);
@@ -835,7 +1003,14 @@ static bool const SetupHashPlot( HashPlotDesc& descHashPlot, Iso::Voxel const oV
 	// Set Depth Level per/object - being the minimum distance for the whole building to near origin
 	// the mid point(critical important) on the building object will represent the depth
 	// if not the midpoint adjacent buildings fight for order
-	OLED::setDepthLevel( p2D_sub(cornersB.pts.b, p2D_subh(cornersB.pts.b, cornersB.pts.t)).pt.y );
+	OLED::setDepthLevel( p2D_sub(cornersB.pts.b, p2D_subh(cornersB.pts.b, cornersB.pts.t)).pt.y, cornersB.pts.b.pt.x );
+	
+	if constexpr ( OLED::Z_ENABLE & RenderingFlags ) {
+		// whole plot bounds, bottom diamond extruded up by the building height + the floor offsets of RenderHashFloorLevel
+		if ( OLED::isOccluded_HiZ(cornersB.pts.l.pt.x - (int32_t)Iso::GRID_RADII, cornersB.pts.t.pt.y - (int32_t)uiHeight - (int32_t)Iso::GRID_RADII,
+															cornersB.pts.r.pt.x + (int32_t)Iso::GRID_RADII, cornersB.pts.b.pt.y + (int32_t)Iso::GRID_RADII, IsoDepth::getCurSelectedDepth()) )
+			return(false); // completely hidden
+	}
 	
 	FloorArgs descFloor;
 	
@@ -883,12 +1058,12 @@ static bool const SetupHashPlot( HashPlotDesc& descHashPlot, Iso::Voxel const oV
 }
 
 // dynamic width, height & depth - good for structures
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static void RenderHashPlot(Iso::Voxel const oVoxel, point2D_t const Origin, Lighting::Material const& mMaterial)
 {
 	HashPlotDesc descHashPlot;
 	
-	if ( SetupHashPlot(descHashPlot, oVoxel, Origin) )
+	if ( SetupHashPlot<RenderingFlags>(descHashPlot, oVoxel, Origin) )
 	{	
 		int32_t HeightRemaining(descHashPlot.Height);
 
@@ -896,29 +1071,21 @@ static void RenderHashPlot(Iso::Voxel const oVoxel, point2D_t const Origin, Ligh
 			
 			uint32_t const uiFloorLevel( oWorld.buildingHeightPixels[Iso::getHeightStep(oVoxel)] - HeightRemaining );
 			
-			if ( uiFloorLevel < (oWorld.FogHeight << 1) + 1 ) {  // allowing more "fade-out"
-				if ( !RenderHashFloorLevel<RenderingFlags>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
-					// Floor Not visible, stop drawing more floors
-					break;
-				}
-			}
-			else {
-				if ( !RenderHashFloorLevel<RenderingFlags & (~OLED::FOG_ENABLE)>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
-					// Floor Not visible, stop drawing more floors
-					break;
-				}
+			if ( !RenderHashFloorLevel<RenderingFlags>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
+				// Floor Not visible, stop drawing more floors
+				break;
 			}
 			HeightRemaining -= WorldEntity::FLOOR_HEIGHT_PIXELS;
 		}
 	}
 }
 
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static void RenderHashPlot_Collapsing(Iso::Voxel const oVoxel, point2D_t const Origin, Lighting::Material const& mMaterial)
 {
 	HashPlotDesc descHashPlot;
 	
-	if ( SetupHashPlot(descHashPlot, oVoxel, Origin) )
+	if ( SetupHashPlot<RenderingFlags>(descHashPlot, oVoxel, Origin) )
 	{	
 		int32_t HeightRemaining(descHashPlot.Height);
 
@@ -926,29 +1093,21 @@ static void RenderHashPlot_Collapsing(Iso::Voxel const oVoxel, point2D_t const O
 			
 			uint32_t const uiFloorLevel( oWorld.buildingHeightPixels[Iso::getHeightStep(oVoxel)] - HeightRemaining );
 			
-			if ( uiFloorLevel < (oWorld.FogHeight << 1) + 1 ) {  // allowing more "fade-out"
-				if ( !RenderHashFloorLevel<RenderingFlags>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
-					// Floor Not visible, stop drawing more floors
-					break;
-				}
-			}
-			else {
-				if ( !RenderHashFloorLevel<RenderingFlags & (~OLED::FOG_ENABLE)>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
-					// Floor Not visible, stop drawing more floors
-					break;
-				}
+			if ( !RenderHashFloorLevel<RenderingFlags>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
+				// Floor Not visible, stop drawing more floors
+				break;
 			}
 			HeightRemaining -= WorldEntity::FLOOR_HEIGHT_PIXELS;
 		}
 	}
 }
 
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static void RenderHashPlot_Collapsed(Iso::Voxel const oVoxel, point2D_t const Origin, Lighting::Material const& mMaterial)
 {
 	HashPlotDesc descHashPlot;
 	
-	if ( SetupHashPlot(descHashPlot, oVoxel, Origin) )
+	if ( SetupHashPlot<RenderingFlags>(descHashPlot, oVoxel, Origin) )
 	{	
 		int32_t HeightRemaining(descHashPlot.Height);
 
@@ -956,26 +1115,43 @@ static void RenderHashPlot_Collapsed(Iso::Voxel const oVoxel, point2D_t const Or
 			
 			uint32_t const uiFloorLevel( oWorld.buildingHeightPixels[Iso::getHeightStep(oVoxel)] - HeightRemaining );
 			
-			if ( uiFloorLevel < (oWorld.FogHeight << 1) + 1 ) {  // allowing more "fade-out"
-				if ( !RenderHashFloorLevel<RenderingFlags>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
-					// Floor Not visible, stop drawing more floors
-					break;
-				}
-			}
-			else {
-				if ( !RenderHashFloorLevel<RenderingFlags & (~OLED::FOG_ENABLE)>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
-					// Floor Not visible, stop drawing more floors
-					break;
-				}
+			if ( !RenderHashFloorLevel<RenderingFlags>(Origin, uiFloorLevel, HeightRemaining, descHashPlot.descFloor) ) {
+				// Floor Not visible, stop drawing more floors
+				break;
 			}
 			HeightRemaining -= WorldEntity::FLOOR_HEIGHT_PIXELS;
 		}
 	}
 }
+// Baked ground AO masks (see DTCM::ScatterLoad), selected by occlusion bits instead of branching on them
+// rooftop returns nullptr when not occluded, drawn without a mask
+STATIC_INLINE_PURE uint8_t const* const getTopAOMask(uint32_t const OcclusionBits)
+{
+	uint32_t const uiTop( (OcclusionBits & (Iso::OCCLUSION_SHADING_TOP_LEFT | Iso::OCCLUSION_SHADING_TOP_RIGHT)) >> 1 );
+	
+	return( 0 != uiTop ? DTCM::_sram_top_ao_atlas[uiTop] : nullptr );
+}
+// sides always have at least bottom AO
+STATIC_INLINE_PURE uint8_t const* const getSideAOMask(uint32_t const OcclusionBits, uint32_t const uiHeightStep)
+{
+	return( DTCM::_sram_side_ao_atlas[(OcclusionBits & (Iso::OCCLUSION_SHADING_SIDE_LEFT | Iso::OCCLUSION_SHADING_SIDE_RIGHT)) >> 3][uiHeightStep - 1] );
+}
+template<uint32_t const RenderingFlags>
+STATIC_INLINE void DrawVLine_AO(point2D_t const start, uint32_t const Height, uint32_t const Luma, OLED::MaskDesc const& descMask)
+{
+	if ( nullptr != descMask.Mask ) {
+		OLED::DrawVLine_Masked<RenderingFlags>(start, Height, Luma, descMask);
+	}
+	else {
+		OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(start.pt.x, start.pt.y, Height, Luma);
+	}
+}
 // static width/depth using single grid radii unit (good for ground, water etc)
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
-static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, uint32_t const uiHeight, Lighting::Material const& mMaterial)
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
+static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, uint32_t const uiHeightStep, Lighting::Material const& mMaterial)
 {
+	uint32_t const uiHeight( oWorld.groundHeightPixels[uiHeightStep] );
+	
 	// get plot corner extents (bottom/top diamond)
 	halfdiamond2D_t cornersB;
 		
@@ -989,7 +1165,14 @@ static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, u
 	// Set Depth Level per/object - being the minimum distance for the whole building to near origin
 	// the mid point(critical important) on the building object will represent the depth
 	// if not the midpoint adjacent buildings fight for order
-	OLED::setDepthLevel( p2D_sub(cornersB.pts.b, p2D_subh(cornersB.pts.b, cornersB.pts.t)).pt.y );
+	OLED::setDepthLevel( p2D_sub(cornersB.pts.b, p2D_subh(cornersB.pts.b, cornersB.pts.t)).pt.y, cornersB.pts.b.pt.x );
+	
+	if constexpr ( OLED::Z_ENABLE & RenderingFlags ) {
+		// +1 at the top, the anti-aliased first pixel of a vertical line also blends into the pixel above it
+		if ( OLED::isOccluded_HiZ(Origin.pt.x - (int32_t)Iso::GRID_RADII, cornersB.pts.t.pt.y - (int32_t)uiHeight - 1,
+															Origin.pt.x + (int32_t)Iso::GRID_RADII, cornersB.pts.b.pt.y, IsoDepth::getCurSelectedDepth()) )
+			return; // completely hidden
+	}
 		
 	// get corner extents (top diamond)
 	halfdiamond2D_t cornersT;
@@ -1009,9 +1192,14 @@ static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, u
 	uint32_t LumaRooftop(0);
 	
 	if constexpr ( OLED::SHADE_ENABLE & RenderingFlags )
-		LumaRooftop = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vec3_t(Origin.pt.x, uiHeight, Origin.pt.y), Lighting::NORMAL_TOPFACE, mMaterial);
+		LumaRooftop = Lighting::Shade_Cached(vec3_t(Origin.pt.x, uiHeight, Origin.pt.y), Lighting::NORMAL_TOPFACE, mMaterial);
 
 	OLED::MaskDesc descMask = { nullptr, 0, Origin, point2D_t(Iso::GRID_RADII - 1, Iso::GRID_RADII >> 1), 0 };
+	uint8_t const* const TopMask( getTopAOMask(OcclusionBits) ),
+							 * const SideMask( getSideAOMask(OcclusionBits, uiHeightStep) );
+	
+	Lighting::ShadeBatch<> batchLeft, batchFront;
+	int32_t iLitLeft(-1), iLitFront(-1);	// first column of the batch lit, a batch is lit by the first of its columns that passes the culls
 	
 	for (int iDx = Iso::GRID_RADII - 1, iD = 0; iDx >= 0; iDx--, iD++)
 	{
@@ -1020,6 +1208,9 @@ static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, u
 		
 		curXPoints = p2D_add(xPoint, point2D_t(-iD, iD));
 		curYPoints = p2D_sub(yPoint, point2D_t(ptIncrement));
+		
+		uint32_t const iBatch(iD & (Lighting::SHADE_BATCH_SIZE - 1));
+		int32_t const iBatchStart(iD - iBatch);
 
 		{
 			// Draw Rooftop
@@ -1033,71 +1224,20 @@ static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, u
 			int32_t const iLength = (curYPoints.pt.x - yPointTop.pt.x);
 			if (likely(iLength > 0)) {
 				
+				descMask.Mask = TopMask;
 				descMask.CurOffset = uiHeight;
 				descMask.Stride = top_ao_stride;
 
-				// both
-				if ( (Iso::OCCLUSION_SHADING_TOP_LEFT | Iso::OCCLUSION_SHADING_TOP_RIGHT) == 
-						 ((Iso::OCCLUSION_SHADING_TOP_LEFT | Iso::OCCLUSION_SHADING_TOP_RIGHT) & OcclusionBits) )
-				{
-					descMask.Mask = DTCM::_sram_top_ao_bothsides;
-					
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-					}
-					if ( 1 == iD  ) { // fill in middle line exception case - this works (hack)
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.x + 1) ) { 
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x + 1, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-						}
-					}
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-					}
-				}
-				else if ( Iso::OCCLUSION_SHADING_TOP_LEFT & OcclusionBits ) 
-				{
-					descMask.Mask = DTCM::_sram_top_ao_oneside;
-					
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-					}
-					if ( 1 == iD  ) { // fill in middle line exception case - this works (hack)
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.x + 1) ) { 
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x + 1, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-						}
-					}
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-					}
+				if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
+					DrawVLine_AO<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, LumaRooftop, descMask);
 				}
-				else if ( Iso::OCCLUSION_SHADING_TOP_RIGHT & OcclusionBits ) 
-				{
-					descMask.Mask = DTCM::_sram_top_ao_oneside_mirrored;
-	
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-					}
-					if ( 1 == iD  ) { // fill in middle line exception case - this works (hack)
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.x + 1) ) { 
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x + 1, yPointTop.pt.x), iLength, LumaRooftop, descMask);
-						}
-					}
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, LumaRooftop, descMask);
+				if ( 1 == iD  ) { // fill in middle line exception case - this works (hack)
+					if ( OLED::CheckVLine_XAxis(curXPoints.pt.x + 1) ) { 
+						DrawVLine_AO<RenderingFlags>(point2D_t(curXPoints.pt.x + 1, yPointTop.pt.x), iLength, LumaRooftop, descMask);
 					}
 				}
-				else { // Occlusion bits are not for the top
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-						OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(curXPoints.pt.x, yPointTop.pt.x, iLength, LumaRooftop);
-					}
-					if ( 1 == iD  ) { // fill in middle line exception case - this works (hack)
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.x + 1) ) { 
-							OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(curXPoints.pt.x + 1, yPointTop.pt.x, iLength, LumaRooftop);
-						}
-					}
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-						OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(curXPoints.pt.y, yPointTop.pt.x, iLength, LumaRooftop);
-					}
+				if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
+					DrawVLine_AO<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, LumaRooftop, descMask);
 				}
 			}
 		} // scope rooftop
@@ -1108,19 +1248,17 @@ static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, u
 		int32_t LumaLeft(-1), LumaFront(-1);
 		if ( OLED::CheckVLine_YAxis(curYPoints.pt.x, (curYPoints.pt.y - curYPoints.pt.x)) ) 
 		{
-			vec3_t vLineMidpoint;
-			if ( OLED::SHADE_ENABLE & RenderingFlags ) {
-				// Get midpoint of line as world poistion for light incident ray
-				vLineMidpoint = vec3_t(0.0f, uiHeight >> 1, curYPoints.pt.y - ((curYPoints.pt.y - curYPoints.pt.x) >> 1));
-			}
-			// Calculate lighting per vertical line
-			// incident light vector
+			// lighting per vertical line is calculated for the batch of columns by its first visible column, at the midpoint of each line
 			if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) { // only for single diamond, or left most diamond
 				
 				if ( OLED::SHADE_ENABLE & RenderingFlags ) {
 						// Left Face
-						vLineMidpoint.x = curXPoints.pt.x;
-						LumaLeft = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vLineMidpoint, Lighting::NORMAL_LEFTFACE, oWorld.mBuilding);
+						if ( iBatchStart != iLitLeft ) {
+							setFaceColumnBatch(batchLeft, iBatchStart, xPoint.pt.x, -1, yPoint, uiHeight, Origin);
+							Lighting::Shade_FullRange_Cached(batchLeft, Lighting::NORMAL_LEFTFACE, oWorld.mBuilding);
+							iLitLeft = iBatchStart;
+						}
+						LumaLeft = Lighting::Shade(batchLeft, iBatch);
 				}
 				else
 					LumaLeft = 0;
@@ -1130,8 +1268,12 @@ static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, u
 				
 				if ( OLED::SHADE_ENABLE & RenderingFlags ) {
 					// Front Face
-					vLineMidpoint.x = curXPoints.pt.y;
-					LumaFront = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vLineMidpoint, Lighting::NORMAL_FRONTFACE, oWorld.mBuilding);
+					if ( iBatchStart != iLitFront ) {
+						setFaceColumnBatch(batchFront, iBatchStart, xPoint.pt.y, 1, yPoint, uiHeight, Origin);
+						Lighting::Shade_FullRange_Cached(batchFront, Lighting::NORMAL_FRONTFACE, oWorld.mBuilding);
+						iLitFront = iBatchStart;
+					}
+					LumaFront = Lighting::Shade(batchFront, iBatch);
 				}
 				else
 					LumaFront = 0;
@@ -1147,60 +1289,22 @@ static void RenderBox_AO(uint32_t const OcclusionBits, point2D_t const Origin, u
 			
 			if (likely(iLength > 0))
 			{
-				descMask.CurOffset = uiHeight;// - (Iso::GRID_RADII >> 1) - 1;
-				descMask.Stride = side_ao_stride;
+				descMask.Mask = SideMask;
+				descMask.CurOffset = uiHeight;
+				descMask.Stride = DTCM::side_ao_atlas_stride;
 				
-				// both sides + bottom
-				if ( (Iso::OCCLUSION_SHADING_SIDE_LEFT | Iso::OCCLUSION_SHADING_SIDE_RIGHT) & OcclusionBits )
-				{	
-					if ( LumaLeft >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_both_ao;	
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, curYPoints.pt.x), iLength, LumaLeft, descMask);
-					}
-					if ( LumaFront >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_both_ao_mirrored;	
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, curYPoints.pt.x), iLength, LumaFront, descMask);
-					}
-				}
-				else if ( Iso::OCCLUSION_SHADING_SIDE_LEFT & OcclusionBits ) // one side + bottom
-				{
-					if ( LumaLeft >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_both_ao;
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, curYPoints.pt.x), iLength, LumaLeft, descMask);
-					}
-					if ( LumaFront >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_botom_ao_mirrored;
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, curYPoints.pt.x), iLength, LumaFront, descMask);
-					}
+				if ( LumaLeft >= 0 ) {
+					OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, curYPoints.pt.x), iLength, LumaLeft, descMask);
 				}
-				else if ( Iso::OCCLUSION_SHADING_SIDE_RIGHT & OcclusionBits ) // one side + bottom
-				{
-					if ( LumaLeft >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_botom_ao;
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, curYPoints.pt.x), iLength, LumaLeft, descMask);
-					}
-					if ( LumaFront >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_both_ao_mirrored;
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, curYPoints.pt.x), iLength, LumaFront, descMask);
-					}
-				}
-				else { // bottom only, always at least bottom AO
-					
-					if ( LumaLeft >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_botom_ao;
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, curYPoints.pt.x), iLength, LumaLeft, descMask);
-					}
-					if ( LumaFront >= 0 ) {
-						descMask.Mask = DTCM::_sram_side_7_botom_ao_mirrored;
-						OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, curYPoints.pt.x), iLength, LumaFront, descMask);
-					}
+				if ( LumaFront >= 0 ) {
+					OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, curYPoints.pt.x), iLength, LumaFront, descMask);
 				}
 			} //if length
 		} // if valid graylevels
 	} // for
 }
 
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static void RenderFlatForcedGround( point2D_t const Origin )
 {
 	// get corner extents (bottom diamond)
@@ -1225,7 +1329,7 @@ static void RenderFlatForcedGround( point2D_t const Origin )
 	uint32_t Luma(0);
 	
 	if constexpr ( OLED::SHADE_ENABLE & RenderingFlags )
-		Luma = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vec3_t(Origin.pt.x, 0.0f, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mGround);
+		Luma = Lighting::Shade_Cached(vec3_t(Origin.pt.x, 0.0f, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mGround);
 	
 	for (int iDx = Iso::GRID_RADII - 1, iD = 0; iDx >= 0; iDx--, iD++)
 	{
@@ -1254,7 +1358,7 @@ static void RenderFlatForcedGround( point2D_t const Origin )
 		}
 	}
 }
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static void RenderGround( Iso::Voxel const oVoxel, point2D_t const Origin )
 {
 	uint32_t const uiHeightStep( Iso::getHeightStep(oVoxel) );
@@ -1274,7 +1378,7 @@ static void RenderGround( Iso::Voxel const oVoxel, point2D_t const Origin )
 		// Set Depth Level per/object - being the minimum distance for the whole building to near origin
 		// the mid point(critical important) on the building object will represent the depth
 		// if not the midpoint adjacent buildings fight for order
-		OLED::setDepthLevel( p2D_sub(corners.pts.b, p2D_subh(corners.pts.b, corners.pts.t)).pt.y );
+		OLED::setDepthLevel( p2D_sub(corners.pts.b, p2D_subh(corners.pts.b, corners.pts.t)).pt.y, corners.pts.b.pt.x );
 		
 		// Draw Vertical Lines Filling diamond
 		
@@ -1284,10 +1388,9 @@ static void RenderGround( Iso::Voxel const oVoxel, point2D_t const Origin )
 		uint32_t Luma(0);
 		
 		if constexpr ( OLED::SHADE_ENABLE & RenderingFlags )
-			Luma = Lighting::Shade<ISFOGENABLED(RenderingFlags)>(vec3_t(Origin.pt.x, 0.0f, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mGround);
+			Luma = Lighting::Shade_Cached(vec3_t(Origin.pt.x, 0.0f, Origin.pt.y), Lighting::NORMAL_TOPFACE, oWorld.mGround);
 
-		OLED::MaskDesc descMask = { nullptr, 0, Origin, point2D_t(Iso::GRID_RADII - 1, Iso::GRID_RADII >> 1), 0 };
-		uint32_t const OcclusionBits(Iso::getOcclusion(oVoxel));
+		OLED::MaskDesc const descMask = { getTopAOMask(Iso::getOcclusion(oVoxel)), top_ao_stride, Origin, point2D_t(Iso::GRID_RADII - 1, Iso::GRID_RADII >> 1), 0 };
 		
 		for (int iDx = Iso::GRID_RADII - 1, iD = 0; iDx >= 0; iDx--, iD++)
 		{
@@ -1308,73 +1411,25 @@ static void RenderGround( Iso::Voxel const oVoxel, point2D_t const Origin )
 			if (likely(iLength > 0)) {
 				// Draws Ground Symmetrically on both sides at the same time
 				
-				if ( Iso::OCCLUSION_SHADING_NONE == OcclusionBits ) {
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-						OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(curXPoints.pt.x, yPointTop.pt.x, iLength, Luma);
-					}
-					if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-						OLED::DrawVLine<OLED::BACK_BUFFER, RenderingFlags>(curXPoints.pt.y, yPointTop.pt.x, iLength, Luma);
-					}
+				if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
+					DrawVLine_AO<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, Luma, descMask);
 				}
-				else {
-					
-					descMask.CurOffset = 0;
-					descMask.Stride = top_ao_stride;
-					
-					// both
-					if ( (Iso::OCCLUSION_SHADING_TOP_LEFT | Iso::OCCLUSION_SHADING_TOP_RIGHT) == 
-						   ((Iso::OCCLUSION_SHADING_TOP_LEFT | Iso::OCCLUSION_SHADING_TOP_RIGHT) & OcclusionBits) )
-					{
-						descMask.Mask = DTCM::_sram_top_ao_bothsides;
-
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, Luma, descMask);
-						}
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, Luma, descMask);
-						}
-					}
-					else if ( Iso::OCCLUSION_SHADING_TOP_LEFT & OcclusionBits ) 
-					{
-						descMask.Mask = DTCM::_sram_top_ao_oneside;
-
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, Luma, descMask);
-						}
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, Luma, descMask);
-						}
-					}
-					else if ( Iso::OCCLUSION_SHADING_TOP_RIGHT & OcclusionBits ) 
-					{
-						descMask.Mask = DTCM::_sram_top_ao_oneside_mirrored;
-
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.x) ) {
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.x, yPointTop.pt.x), iLength, Luma, descMask);
-						}
-						if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
-							OLED::DrawVLine_Masked<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, Luma, descMask);
-						}
-					}
-					
+				if ( OLED::CheckVLine_XAxis(curXPoints.pt.y) ) {
+					DrawVLine_AO<RenderingFlags>(point2D_t(curXPoints.pt.y, yPointTop.pt.x), iLength, Luma, descMask);
 				}
 			}
 		}
 	}
 	else // render complete voxel
 	{
-		uint32_t const uiHeightPixels =  oWorld.groundHeightPixels[uiHeightStep];
-		if ( uiHeightPixels < oWorld.FogHeight )
-			RenderBox_AO<RenderingFlags>(Iso::getOcclusion(oVoxel), Origin, uiHeightPixels, oWorld.mGround);
-		else
-			RenderBox_AO<RenderingFlags & (~OLED::FOG_ENABLE)>(Iso::getOcclusion(oVoxel), Origin, uiHeightPixels, oWorld.mGround);
+		RenderBox_AO<RenderingFlags>(Iso::getOcclusion(oVoxel), Origin, uiHeightStep, oWorld.mGround);
 		
 		// Iso::OCCLUSION_SHADING_NONE does not apply here
 		// instead of using an extra bit
 		// because the bottom will always have occlusion
 	}
 }
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static void RenderStructure( Iso::Voxel const oVoxel, point2D_t const voxelIndex, point2D_t const Origin )
 {
 	// Set hash seed specific to structures
@@ -1385,9 +1440,10 @@ static void RenderStructure( Iso::Voxel const oVoxel, point2D_t const voxelIndex
 	// Set the psuedo rng seed to our deterministic seed
 	PsuedoSetSeed( /*DeterministicSeed = */ Hash( voxelIndex.pt.x ^ Hash( voxelIndex.pt.x ) )  );
 	
+	PROFILE_STAGE(Profiler::GRID_HASHPLOT);
 	RenderHashPlot<RenderingFlags>(oVoxel, Origin, oWorld.mBuilding);
 }
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
 static void RenderDestruction( Iso::Voxel const oVoxel, point2D_t const voxelIndex, point2D_t const Origin )
 {
 	if ( isCollapsed(oVoxel) ) {	
@@ -1421,15 +1477,46 @@ static void RenderEffect( Iso::Voxel const oVoxel, point2D_t const Origin )
 }
 
 //#define DEBUG_RENDER
-template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE)>
-static void RenderGrid()
+// draws a single voxel of the grid, the visibility test (isVoxelVisible, TestPoint_Not_OnScreen) has already passed
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
+STATIC_INLINE void RenderVoxel( Iso::Voxel const oVoxel, point2D_t const voxelIndex, point2D_t const voxelOrigin )
+{
+	if ( isGround(oVoxel) ) {
+		
+		PROFILE_STAGE(Profiler::GRID_GROUND);
+		RenderGround<RenderingFlags>( oVoxel, voxelOrigin );
+	}
+	else if ( isStructure(oVoxel) ) {
+		PROFILE_STAGE(Profiler::GRID_STRUCTURE);	// inclusive of hashplot and the background ground
+#ifndef DEBUG_NORENDER_STRUCTURES												
+		if ( isRootPlotPart(oVoxel) ) {
+			RenderStructure<RenderingFlags>( oVoxel, voxelIndex, voxelOrigin );
+		}
+#endif
+		// always render background ground for root + siblings
+		// rendering after to leverage z-buffer, drawing only pixels to fill in background (speedup)
+#ifndef DEBUG_RENDER
+		RenderFlatForcedGround<RenderingFlags>(voxelOrigin);
+#endif
+	}
+	else if ( isDestruction(oVoxel) ) {
+		PROFILE_STAGE(Profiler::GRID_DESTRUCTION);
+		RenderDestruction<RenderingFlags>( oVoxel, voxelIndex, voxelOrigin );
+	}
+	else if ( isEffect(oVoxel) ) {
+		PROFILE_STAGE(Profiler::GRID_EFFECT);
+		RenderEffect<RenderingFlags>( oVoxel, voxelOrigin );
+	}
+}
+
+// Traverses the visible grid TL => BR calling Visitor::Visit for every voxel that passes the visibility test, in painters order
+template<typename Visitor>
+STATIC_INLINE void TraverseVisibleGrid()
 {
 	point2D_t const voxelStart(oWorld.oCamera.voxelIndex_TopLeft);
 	point2D_t voxelIndex( voxelStart );	
 	
 	// Traverse Grid
-	Iso::Voxel const* theGrid;	
-
 	uint32_t yCount(WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_Y);
 	while ( 0 != yCount )
 	{
@@ -1447,12 +1534,9 @@ static void RenderGrid()
 		voxelIndex.pt.x = voxelStart.pt.x;
 		
 		// draw order to TL => BR //
-		theGrid = oWorld.theGrid + ((voxelIndex.pt.y * Iso::WORLD_GRID_SIZE) + voxelIndex.pt.x);
-		
 		while ( 0 != xCount ) 
 		{
 			if ( unlikely(voxelIndex.pt.x < 0) ) {
-				++theGrid; // the only place we traverse the grid like this
 				++voxelIndex.pt.x;
 				--xCount;
 				continue; // skip over
@@ -1460,7 +1544,7 @@ static void RenderGrid()
 			else if ( unlikely(voxelIndex.pt.x >= Iso::WORLD_GRID_SIZE) )
 				break; // donem past end of world grid
 		
-			Iso::Voxel const oVoxel(*theGrid);
+			Iso::Voxel const oVoxel(*getGrid(voxelIndex.pt.x, voxelIndex.pt.y));	// layout independent, see getGridOffset
 			
 			// Make index (row,col)relative to starting index voxel
 			// calculate origin from relative row,col
@@ -1475,7 +1559,7 @@ static void RenderGrid()
 					// Early rejection test
 					if ( false == TestPoint_Not_OnScreen(voxelOrigin) ) {
 
-						RenderGround<RenderingFlags>( oVoxel, voxelOrigin );
+						Visitor::Visit( oVoxel, voxelIndex, voxelOrigin );
 					} // onscreen visibility
 				} // isvisible
 			} // isground
@@ -1484,29 +1568,10 @@ static void RenderGrid()
 				// Early rejection test
 				if ( false == TestPoint_Not_OnScreen(voxelOrigin, oWorld.buildingHeightPixels[BuildingGen::NUM_DISTINCT_BUILDING_HEIGHTS]) ) {
 					
-					if ( isStructure(oVoxel) ) {
-#ifndef DEBUG_NORENDER_STRUCTURES												
-						if ( isRootPlotPart(oVoxel) ) {
-							RenderStructure<RenderingFlags>( oVoxel, voxelIndex, voxelOrigin );
-						}
-#endif
-						// always render background ground for root + siblings
-						// rendering after to leverage z-buffer, drawing only pixels to fill in background (speedup)
-#ifndef DEBUG_RENDER
-						RenderFlatForcedGround<RenderingFlags>(voxelOrigin);
-#endif
-					}
-					else if ( isDestruction(oVoxel) ) {
-						RenderDestruction<RenderingFlags>( oVoxel, voxelIndex, voxelOrigin );
-					}
-					else if ( isEffect(oVoxel) ) {
-						RenderEffect<RenderingFlags>( oVoxel, voxelOrigin );
-					}
-					
+					Visitor::Visit( oVoxel, voxelIndex, voxelOrigin );
 				} // onscreen visibility
 			} // else not ground
 			
-			++theGrid; // the only place we traverse the grid like this
 			++voxelIndex.pt.x;
 			--xCount;
 		}
@@ -1525,77 +1590,317 @@ static void RenderGrid()
 #endif
 }
 
-/* Proof of concept simplex 3d noise blended with fog on frontbuffer - works but damn is it not practical
-__ramfunc static void PostProcess_Fog( uint32_t const tNow )
+#ifdef RENDERGRID_BINNED
+// Binned front to back traversal
+// The pre-pass gathers every visible voxel with a conservative screen bounding box. The voxels are then drawn in reverse
+// painters order (front to back) and before drawing a voxel, its bounds are tested against the hierarchical depth tiles
+// (OLED::isOccluded_HiZ): if every pixel is already nearer than the one depth level the voxel draws with, no pixel of the
+// voxel can pass the depth test and the voxel is skipped entirely. The bounds of every voxel drawn are marked (OLED::MarkHiZ)
+// so only those tiles are rescanned, and only when a test actually needs them.
+//
+// Pixels that tie in depth keep the first voxel drawn instead of the last, otherwise output matches the painters order.
+namespace GridBins
 {
-	static constexpr float const NOISE_SCALAR_HEIGHT = 60.0f;
+	static constexpr uint32_t const MAX_VISIBLE = WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_X * WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_Y;
+
+	static constexpr int32_t const NEVER_OCCLUDED = IsoDepth::DEPTH_MAX;	// depth level that always passes (ties pass)
 	
-	// Find the min/max in [0.0..1.0] space
-	vec2_t vBeginPt, vEndPt;
+	typedef struct sBinnedVoxel
+	{
+		point2D_t		voxelIndex,
+								voxelOrigin,
+								vMin, vMax;		// screen bounds (inclusive)
+		int32_t			DepthLevel,		// nearest depth level any draw of this voxel uses
+								DepthY;				// screen space depth passed to setDepthLevel, kept for the frame range tracking of skipped voxels
+		Iso::Voxel	oVoxel;
+		bool				bFarthest;		// also draws at the farthest level (forced flat ground)
+	} BinnedVoxel;
+	
+	static struct sGridBins
+	{
+		BinnedVoxel	Voxels[MAX_VISIBLE];
+		uint32_t		NumVoxels;
+		
+	} oGridBins;
 	
+	STATIC_INLINE bool const isOccluded( BinnedVoxel const& __restrict Binned )
 	{
-		// convert grid to isometric coordinates
-		point2D_t const voxelMinOrigin( ( oWorld.oCamera.voxelCurVisibilityMin ) ),  // these have already been pushed to (0,09) => (WORLD_GRID_SIZE,WORLD_GRID_SIZE)
-										voxelMaxOrigin( ( oWorld.oCamera.voxelCurVisibilityMax ) );
+		if ( NEVER_OCCLUDED == Binned.DepthLevel )
+			return(false);
+		
+		return( OLED::isOccluded_HiZ(Binned.vMin.pt.x, Binned.vMin.pt.y, Binned.vMax.pt.x, Binned.vMax.pt.y, Binned.DepthLevel) );
+	}
+	
+	// conservative screen space bounds and nearest depth level of everything RenderVoxel draws for this voxel
+	static void Bin( BinnedVoxel& __restrict Binned )
+	{
+		static constexpr int32_t const MARGIN = 1;
+		
+		Iso::Voxel const oVoxel(Binned.oVoxel);
+		point2D_t const Origin(Binned.voxelOrigin);
 		
-		vBeginPt.x = (float)voxelMinOrigin.pt.x * Iso::INVERSE_WORLD_GRID_FSIZE;
-		vBeginPt.y = (float)voxelMinOrigin.pt.y * Iso::INVERSE_WORLD_GRID_FSIZE;
+		// footprint of a single voxel diamond, the forced flat ground of structures and flat / boxed ground
+		int32_t xMin( Origin.pt.x - (int32_t)Iso::GRID_RADII - MARGIN ), xMax( Origin.pt.x + (int32_t)Iso::GRID_RADII + MARGIN ),
+						yMin( Origin.pt.y - (int32_t)(Iso::GRID_RADII >> 1) - MARGIN ), yMax( Origin.pt.y + (int32_t)(Iso::GRID_RADII >> 1) + MARGIN );
 		
-		vEndPt.x = (float)voxelMaxOrigin.pt.x * Iso::INVERSE_WORLD_GRID_FSIZE;
-		vEndPt.y = (float)voxelMaxOrigin.pt.y * Iso::INVERSE_WORLD_GRID_FSIZE;
+		Binned.DepthY = Origin.pt.y;
+		Binned.bFarthest = false;
+		
+		if ( isGround(oVoxel) ) {
+			
+			yMin -= oWorld.groundHeightPixels[Iso::getHeightStep(oVoxel)];
+			Binned.DepthLevel = IsoDepth::getDepthLevel(Binned.DepthY, Origin.pt.x);
+		}
+		else if ( isStructure(oVoxel) ) {
+			
+			Binned.bFarthest = true;
+			Binned.DepthLevel = IsoDepth::getDepthLevel(IsoDepth::getDynamicRangeMin());
+			
+#ifndef DEBUG_NORENDER_STRUCTURES
+			if ( isRootPlotPart(oVoxel) ) {
+				
+				// whole plot, same extents as SetupHashPlot + the floor offsets of RenderHashFloorLevel
+				point2D_t const plotRadiiInPixels( getPlotRadiiInPixels(Iso::getPlotSize(oVoxel)) ),
+												plotOrigin( getPlotOrigin(Origin, plotRadiiInPixels) );
+				
+				xMin = min(xMin, plotOrigin.pt.x - plotRadiiInPixels.pt.x - (int32_t)Iso::GRID_RADII);
+				xMax = max(xMax, plotOrigin.pt.x + plotRadiiInPixels.pt.x + (int32_t)Iso::GRID_RADII);
+				yMin = min(yMin, plotOrigin.pt.y - plotRadiiInPixels.pt.y - (int32_t)oWorld.buildingHeightPixels[Iso::getHeightStep(oVoxel)] - (int32_t)Iso::GRID_RADII);
+				yMax = max(yMax, plotOrigin.pt.y + plotRadiiInPixels.pt.y + (int32_t)Iso::GRID_RADII);
+				
+				Binned.DepthY = plotOrigin.pt.y;
+				Binned.DepthLevel = max(Binned.DepthLevel, IsoDepth::getDepthLevel(Binned.DepthY, plotOrigin.pt.x));
+			}
+#endif
+		}
+		else {
+			// destruction / effects are dynamic, always drawn, may touch any tile
+			Binned.DepthLevel = NEVER_OCCLUDED;
+			xMin = yMin = 0;
+			xMax = OLED::SCREEN_WIDTH - 1; yMax = OLED::SCREEN_HEIGHT - 1;
+		}
+		
+		Binned.vMin = point2D_t(xMin, yMin);
+		Binned.vMax = point2D_t(xMax, yMax);
 	}
 	
-	OLED::RenderScreenLayer_DownSampleBy2<uint32_t>(OLED::getEffectFrameBuffer32bit_0_HalfSize(), DTCM::getFrontBuffer());
+	struct BinVoxel
+	{
+		STATIC_INLINE void Visit( Iso::Voxel const oVoxel, point2D_t const voxelIndex, point2D_t const voxelOrigin )
+		{
+			BinnedVoxel& __restrict Binned( oGridBins.Voxels[oGridBins.NumVoxels++] );
+		
+			Binned.oVoxel = oVoxel;
+			Binned.voxelIndex = voxelIndex;
+			Binned.voxelOrigin = voxelOrigin;
+		
+			Bin(Binned);
+		}
+	};
+	
+} // end namespace
 
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
+static void RenderGrid()
+{
+	using namespace GridBins;
+	
+	PROFILE_STAGE(Profiler::GRID);
 	
-	float const fTNow( (float)tNow * 0.001f );
-	int32_t yPixel(OLED::HALF_HEIGHT-1); // inverted y-axis
+	// pre-pass, bin visible voxels in painters order
+	oGridBins.NumVoxels = 0;
+	TraverseVisibleGrid<BinVoxel>();
+	
+	// front to back, the depth tiles were cleared with the depth buffer at the start of the frame
+	for ( int32_t iDx = oGridBins.NumVoxels - 1 ; iDx >= 0 ; --iDx ) {
+		
+		BinnedVoxel const& Binned( oGridBins.Voxels[iDx] );
+		
+		if ( isOccluded(Binned) ) {
+			
+			// dynamic depth range for the next frame is tracked as if drawn
+			if ( isGround(Binned.oVoxel) || isRootPlotPart(Binned.oVoxel) ) {
+				OLED::setDepthLevel(Binned.DepthY);
+			}
+			if ( Binned.bFarthest ) {
+				OLED::setDepthLevel_ToFarthest();
+			}
+			continue;
+		}
+		
+		RenderVoxel<RenderingFlags>( Binned.oVoxel, Binned.voxelIndex, Binned.voxelOrigin );
+		OLED::MarkHiZ(Binned.vMin.pt.x, Binned.vMin.pt.y, Binned.vMax.pt.x, Binned.vMax.pt.y);
+	}
+}
+
+#else
 
-	vec2_t uv;
-	while (yPixel >= 0)
+template<uint32_t const RenderingFlags>
+struct DrawVoxel
+{
+	STATIC_INLINE void Visit( Iso::Voxel const oVoxel, point2D_t const voxelIndex, point2D_t const voxelOrigin )
 	{
-		int32_t xPixel(OLED::HALF_WIDTH-1);
+		RenderVoxel<RenderingFlags>( oVoxel, voxelIndex, voxelOrigin );
+	}
+};
 
-		uint32_t * __restrict UserFrameBuffer = OLED::getEffectFrameBuffer32bit_0_HalfSize() + (yPixel << OLED::HalfWidth_SATBITS);
+template<uint32_t const RenderingFlags = (OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE)>
+static void RenderGrid()
+{
+	PROFILE_STAGE(Profiler::GRID);
+	
+	TraverseVisibleGrid< DrawVoxel<RenderingFlags> >();
+	
+	OLED::InvalidateHiZ();	// depth tiles are rescanned when first tested after the grid (voxel models)
+}
 
-		uv.y = lerp(vBeginPt.y, vEndPt.y, static_cast<float>(yPixel) * OLED::INV_HALF_HEIGHT_MINUS1);
+#endif /*RENDERGRID_BINNED*/
 
-		while (xPixel >= 0)
+// Deferred fog, a single pass over the depth buffer once the grid is drawn - every pixel is fogged once instead of once per overdraw
+// the fog of a pixel is the fog of its depth level (see IsoDepth BuildFogLUT) over the lighting shade drawn at the pixel
+// the height of a pixel above the base of its object (screen y of the depth level - y) fades the fog out above FogHeight
+// over the next FogHeight pixels, the height is jittered by blue noise so the top of the fog is not a hard line
+__ramfunc static void PostProcess_Fog( uint32_t const tNow )
+{
+	static constexpr int32_t const JITTER_SHIFT = 4,											// blue noise [0, 255] => [-8, 7] pixels of height
+																 JITTER = (128 >> JITTER_SHIFT);
+	static constexpr float const INV_NOISE_DIMENSION = 1.0f / (float)NOISE_TEXTURE_DIMENSION;
+	
+	PROFILE_STAGE(Profiler::FOG);
+	
+	int32_t const FogHeight( oWorld.FogHeight ),
+								FadeScale( (256 << 16) / (FogHeight + 1) );
+	float const fNoiseOffset( (float)(tNow >> 5) * INV_NOISE_DIMENSION );	// jitter drifts over time
+	
+	for ( uint32_t x = 0 ; x < OLED::SCREEN_WIDTH ; ++x )
+	{
+		depth_t const* const __restrict DepthColumn( DTCM::getDepthBuffer()[x] );	// rotated, column is contiguous
+		
+		int32_t CurDepth(IsoDepth::DEPTH_MIN), BaseY(0);
+		uint32_t uiLevel(0), Density(0);
+		
+		for ( uint32_t y = 0 ; y < OLED::SCREEN_HEIGHT ; ++y )
 		{
-			uv.x = lerp(vBeginPt.x, vEndPt.x, static_cast<float>(xPixel) * OLED::INV_HALF_WIDTH_MINUS1);
+			int32_t const Depth( DepthColumn[y] );
+			
+			if ( IsoDepth::DEPTH_MIN == Depth )	// nothing drawn
+				continue;
+			
+			if ( Depth != CurDepth ) {	// runs of the same depth level are the common case (one object)
+				CurDepth = Depth;
+				uiLevel = IsoDepth::getLevelIndex(Depth);
+				Density = IsoDepth::getFogDensity(uiLevel);
+				BaseY = FogLUT.ScreenY[uiLevel];
+			}
+			
+			if ( 0 == Density )
+				continue;
+			
+			int32_t Height( BaseY - (int32_t)y );
+			
+			if ( Height > FogHeight - JITTER ) {	// only the fade out needs the jitter
+				
+				if ( Height - JITTER > (FogHeight << 1) )	// above the fog
+					continue;
+				
+				Height += ((int32_t)Noise::getBlueNoiseSample<uint8_t>( vec2_t(__fma((float)x, INV_NOISE_DIMENSION, fNoiseOffset), (float)y * INV_NOISE_DIMENSION) ) >> JITTER_SHIFT) - JITTER;
+			}
+			
+			uint32_t const Fade( __USAT(256 - ((max(0, Height - FogHeight) * FadeScale) >> 16), Constants::SATBIT_512) ),	// 256 at or below FogHeight
+										 Alpha( (Density * Fade) >> 8 );
+			
+			if ( 0 != Alpha ) {
+				DTCM::getFrontBuffer()[y][x] = xDMA2D::AlphaLuma(Alpha, IsoDepth::getFogLuma(uiLevel, DTCM::getBackBuffer()[y][x])).v;
+			}
+		}
+	}
+}
+
 
-			uint32_t const uiARGB = *UserFrameBuffer;
+// Shadow map of the primary light (see Lighting ShadowMap), the light is treated as a sun: its direction on the grid
+// follows lPrimary, its elevation is fixed so the tallest building casts a shadow at most MAX_STEPS voxels long
+// every frame a budget of cells of the visible window is rebuilt round robin by marching a few voxels towards the light
+__ramfunc static void UpdateShadowMap()
+{
+	static constexpr uint32_t const CELLS_PER_FRAME = 60,		// 360 cells of the window, rebuilt every 6 frames
+																	MAX_STEPS = 6,
+																	MAX_VISIBLE = WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_X * WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_Y;
+	static constexpr float const SLOPE = (float)(BuildingGen::getBuildingHeight_InPixels<BuildingGen::NUM_DISTINCT_BUILDING_HEIGHTS>() 
+																							 + BuildingGen::NUM_DISTINCT_BUILDING_HEIGHTS * WorldEntity::FLOOR_WINDOW_HEIGHT_PIXELS) / (float)MAX_STEPS; // pixels per voxel
+	
+	static_assert( WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_X + MAX_STEPS <= Lighting::ShadowMap::SIZE &&
+								 WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_Y + MAX_STEPS <= Lighting::ShadowMap::SIZE, "shadow map must cover the visible window" );
+	
+	static uint32_t uiCursor;
+	
+	PROFILE_STAGE(Profiler::SHADOW);
+	
+	point2D_t const voxelStart(oWorld.oCamera.voxelIndex_TopLeft);
+	
+	vec2_t const vScreenOrigin( p2D_to_v2( p2D_sub(oWorld.oCamera.voxelOffset, Iso::p2D_GridToIso(voxelStart)) ) );
+#ifdef SHADE_CACHE
+	bool bChanged( vScreenOrigin.x != Lighting::ShadowMap::vScreenOrigin.x || vScreenOrigin.y != Lighting::ShadowMap::vScreenOrigin.y ); // camera scrolled
+#endif
+	
+	Lighting::ShadowMap::Caster = &oWorld.lPrimary;
+	Lighting::ShadowMap::vScreenOrigin = vScreenOrigin;
+	
+	// light in grid space
+	vec2_t const vLight( Lighting::ShadowMap::v2_ScreenToGrid( vec2_t(oWorld.lPrimary.Position.x - Lighting::ShadowMap::vScreenOrigin.x,
+																																			oWorld.lPrimary.Position.z - Lighting::ShadowMap::vScreenOrigin.y) ) );
+	
+	for ( uint32_t uiCell = CELLS_PER_FRAME ; 0 != uiCell ; --uiCell )
+	{
+		uint32_t const uiIndex(uiCursor);
+		if ( ++uiCursor >= MAX_VISIBLE )
+			uiCursor = 0;
+		
+		point2D_t const voxelIndex( voxelStart.pt.x + (int32_t)(uiIndex % WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_X),
+															  voxelStart.pt.y + (int32_t)(uiIndex / WorldEntity::CameraEntity::GRID_VOXELS_MAXVISIBLE_X) );
+		
+		if ( (uint32_t)voxelIndex.pt.x >= Iso::WORLD_GRID_SIZE || (uint32_t)voxelIndex.pt.y >= Iso::WORLD_GRID_SIZE )	// outside world grid
+			continue;
+		
+		vec2_t vDir( v2_sub(vLight, p2D_to_v2(voxelIndex)) );
+		float fDistance(0.0f);
+		vDir = v2_normalize(vDir, &fDistance);
+		
+		int32_t ShadowHeight(0);
+		
+		uint32_t const uiSteps( min(MAX_STEPS, (uint32_t)fDistance) );	// not past the light
+		vec2_t vStep( p2D_to_v2(voxelIndex) );
+		for ( uint32_t iStep = 1 ; iStep <= uiSteps ; ++iStep )
+		{
+			vStep = v2_add(vStep, vDir);
 			
-			// Get current Alpha and Shade of fog on front buffer [0.0=>255.0]
-			uint32_t const Alpha = (0xFF000000 & uiARGB);
+			point2D_t const voxelOccluder( int32::__roundf(vStep.x), int32::__roundf(vStep.y) );
 			
-			float const fShade = (0x000000FF & uiARGB);
-						
-			// Get local noise [0.0=>1.0]
-			float const fNoiseHeight = Noise::getSimplexNoise3D( NOISE_SCALAR_HEIGHT * uv.x, NOISE_SCALAR_HEIGHT * uv.y, fTNow );
-			//float const fNoiseHeight = Noise::getBlueNoiseSample<float>( vec2_t(uv.x, uv.y) );//, fTNow );
+			if ( (uint32_t)voxelOccluder.pt.x >= Iso::WORLD_GRID_SIZE || (uint32_t)voxelOccluder.pt.y >= Iso::WORLD_GRID_SIZE )
+				break;
 			
-			// Change fog....
+			Iso::Voxel const oOccluder(*getGrid(voxelOccluder.pt.x, voxelOccluder.pt.y));
 			
-			uint32_t const uiNewShade = __USAT( int32::__roundf( fNoiseHeight * fShade ), Constants::SATBIT_256 ); 
-			*UserFrameBuffer = Alpha | (uiNewShade << 16) | (uiNewShade << 8) | (uiNewShade);
-			++UserFrameBuffer;
+			int32_t const OccluderHeight( isGround(oOccluder) ? oWorld.groundHeightPixels[Iso::getHeightStep(oOccluder)]
+																												: oWorld.buildingHeightPixels[Iso::getHeightStep(oOccluder)] );
 			
-			--xPixel;
+			ShadowHeight = max(ShadowHeight, OccluderHeight - int32::__roundf(SLOPE * (float)iStep));
 		}
 		
-		--yPixel;
+		uint32_t const Cell( __USAT(ShadowHeight, Lighting::ShadowMap::HEIGHT_BITS) | Lighting::ShadowMap::getTag(voxelIndex.pt.x, voxelIndex.pt.y) );
+		uint32_t& __restrict Dest( Lighting::ShadowMap::Cells[Lighting::ShadowMap::getIndex(voxelIndex.pt.x, voxelIndex.pt.y)] );
+		
+#ifdef SHADE_CACHE
+		bChanged |= (Cell != Dest);
+#endif
+		Dest = Cell;
 	}
 	
-	// Noise is generated equal in size of the grid dimensions,
-	// however we only care about the noise from the voxels that are currently onscreen and visible
-	// this localized visibilty of the world fog noise
-	// is whhat we blend into the fog render target
-	
-	OLED::RenderScreenLayer_UpSampleBy2<uint32_t>(DTCM::getFrontBuffer(), OLED::getEffectFrameBuffer32bit_0_HalfSize());
+#ifdef SHADE_CACHE
+	if ( bChanged ) { // cached lighting looked up the old shadows
+		Lighting::ShadeCache::Invalidate();
+	}
+#endif
 }
-*/
-
 
 //#define DEBUG_RENDER
 
@@ -1610,7 +1915,20 @@ static void UpdateLighting( uint32_t const tNow )
 		// Rotate light around
 		
 		{
-		point2D_t const posLight = p2D_rotate(oWorld.lPrimary.Angle, v3_to_p2D_iso(vec3_t(129.0f, 90.0f, 90.0f)), point2D_t(128,32));
+#ifdef SHADE_CACHE
+		// light only moves in steps so cached lighting (Lighting ShadeCache) stays valid in between, 128 steps per turn (~5 pixels)
+		// step is in the units of vec2_rotation_t Angle, which are converted to radians with TO_RADIANS
+		static constexpr float const ANGLE_STEP = TO_DEGREES(2.0f * MathConstants::kPI / 128.0f);
+		static vec2_rotation_t vAngle;
+		
+		float const fQuantized( (float)int32::__floorf(oWorld.lPrimary.Angle.Angle * (1.0f / ANGLE_STEP)) * ANGLE_STEP );
+		if ( fQuantized != vAngle.Angle || 0.0f == vAngle.c ) {
+			vAngle = vec2_rotation_t(fQuantized);
+		}
+#else
+		vec2_rotation_t const& vAngle(oWorld.lPrimary.Angle);
+#endif
+		point2D_t const posLight = p2D_rotate(vAngle, v3_to_p2D_iso(vec3_t(129.0f, 90.0f, 90.0f)), point2D_t(128,32));
 		oWorld.lPrimary.Position = vec3_t(posLight.pt.x, oWorld.lPrimary.Position.y, posLight.pt.y);
 		/*if (nullptr != oWorld.m_pCurMissile ) {
 			vec2_t vGridToScreen = oWorld.m_pCurMissile->vLoc;
@@ -1622,11 +1940,6 @@ static void UpdateLighting( uint32_t const tNow )
 		{
 		//point2D_t const posLight = p2D_rotate(oWorld.lSecondary.Angle, v3_to_p2D_iso(vec3_t(128.0f, 90.0f, 64.0f)), point2D_t(128,32));
 		//oWorld.lSecondary.Position = vec3_t(posLight.pt.x, oWorld.lSecondary.Position.y, posLight.pt.y);
-		if (nullptr != oWorld.m_pCurExplosion ) { // must maintain light position if explosion active (eg.) camera pans)
-			vec2_t vGridToScreen = oWorld.m_pCurExplosion->getOrigin();
-			vGridToScreen = world::v2_GridToScreen(vGridToScreen);
-			oWorld.lSecondary.Position = vec3_t(vGridToScreen.x, oWorld.lPrimary.Position.y, vGridToScreen.y);
-		}
 		}
 
 #ifdef DEBUG_RENDER			
@@ -1849,6 +2162,9 @@ Volumetric::voxB::voxelModelInstance_Dynamic* const __restrict CreateMissile( ui
 			delete oWorld.m_pCurMissile; oWorld.m_pCurMissile = nullptr;
 		}
 		
+		INPUT_CHECKPOINT(InputReplay::CHECK_MISSILE, InputReplay::FloatBits(WorldCoord.x), InputReplay::FloatBits(WorldCoord.y),
+																								 InputReplay::FloatBits(WorldCoordTarget.x), InputReplay::FloatBits(WorldCoordTarget.y));
+		
 		oWorld.m_pCurMissile = new VoxMissile(tNow, WorldCoord, WorldCoordTarget);
 		return(oWorld.m_pCurMissile);
 	}
@@ -1879,23 +2195,19 @@ void CreateExplosion( uint32_t const tNow, vec2_t const WorldCoord, bool const b
 	}
 	oWorld.m_pCurExplosion = new ExplosionInstance(WorldCoord, RandomNumber(3, 4));
 	
-	static constexpr uint32_t const LightActivateDuration(2500), LightActivateEaseOutDuration(LightActivateDuration-250);
-	Lighting::ActiveLighting.ActivateLight(WorldCoord, 1, tNow, LightActivateDuration, LightActivateEaseOutDuration);
-	//Lighting::ActiveLighting.DeActivateLight(0, tNow, (LightActivateDuration) - Lighting::ActiveLighting.REACTIVATION_DURATION - Lighting::ActiveLighting.LIGHTING_UPDATE_RATE - 1);
-	
-	// the radius here corresponds to the maximum height could be used for normalization
+	// lit by its emitted light while alive (EmitEffectLights), not by activating a world light
 }
-__attribute__((pure)) Iso::Voxel const * const __restrict getVoxelAt( point2D_t voxelIndex )
+__attribute__((pure)) Iso::Voxel const * const __restrict getVoxelAt( point2D_t const voxelIndexGridSpace )
 {
 	// Change from(-x,-y) => (x,y)  to (0,0) => (x,y)
-	voxelIndex = p2D_add(voxelIndex, point2D_t(Iso::WORLD_GRID_HALFSIZE, Iso::WORLD_GRID_HALFSIZE));
+	point2D_t const voxelIndex( p2D_add(voxelIndexGridSpace, point2D_t(Iso::WORLD_GRID_HALFSIZE, Iso::WORLD_GRID_HALFSIZE)) );	// not the parameter, a pure function must not write memory (point2D_t is passed by reference)
 	
 	// Check bounds
 	if ( (voxelIndex.pt.x | voxelIndex.pt.y) >= 0 ) {
 		
 		if ( voxelIndex.pt.x < Iso::WORLD_GRID_SIZE && voxelIndex.pt.y < Iso::WORLD_GRID_SIZE ) {
 			
-			return( (oWorld.theGrid + ((voxelIndex.pt.y * Iso::WORLD_GRID_SIZE) + voxelIndex.pt.x)) );
+			return( getGrid(voxelIndex.pt.x, voxelIndex.pt.y) );
 		}
 	}
 	
@@ -1920,7 +2232,10 @@ bool const setVoxelAt( point2D_t voxelIndex, Iso::Voxel const newData )
 		if ( voxelIndex.pt.x < Iso::WORLD_GRID_SIZE && voxelIndex.pt.y < Iso::WORLD_GRID_SIZE ) {
 			
 			// Update Voxel
-			*(oWorld.theGrid + ((voxelIndex.pt.y * Iso::WORLD_GRID_SIZE) + voxelIndex.pt.x)) = newData;
+			*getGrid(voxelIndex.pt.x, voxelIndex.pt.y) = newData;
+			
+			// occlusion of the voxel and its neighbours is recomputed at the end of the frame
+			MarkGroundOcclusionDirty(voxelIndex);
 			return(true);
 		}
 	}
@@ -1935,10 +2250,10 @@ bool const setVoxelAt( vec2_t const Location, Iso::Voxel const newData )
 	return( setVoxelAt(voxelIndex, newData) );
 }
 
-__attribute__((pure)) Iso::Voxel const* const __restrict getNeighbour(point2D_t voxelIndex, point2D_t const relativeOffset)
+__attribute__((pure)) Iso::Voxel const* const __restrict getNeighbour(point2D_t const voxelIndexGridSpace, point2D_t const relativeOffset)
 {
 	// Change from(-x,-y) => (x,y)  to (0,0) => (x,y)
-	voxelIndex = p2D_add(voxelIndex, point2D_t(Iso::WORLD_GRID_HALFSIZE, Iso::WORLD_GRID_HALFSIZE));
+	point2D_t const voxelIndex( p2D_add(voxelIndexGridSpace, point2D_t(Iso::WORLD_GRID_HALFSIZE, Iso::WORLD_GRID_HALFSIZE)) );
 	
 	return( ::getNeighbour(voxelIndex, relativeOffset) );
 }
@@ -1946,10 +2261,10 @@ __attribute__((pure)) uint32_t const& __restrict getCameraState()
 {
 	return(oWorld.oCamera.State);
 }
-__attribute__((pure)) point2D_t const p2D_GridToScreen(point2D_t thePt)
+__attribute__((pure)) point2D_t const p2D_GridToScreen(point2D_t const thePtGridSpace)
 {
 	// Change from(-x,-y) => (x,y)  to (0,0) => (x,y)
-	thePt = p2D_add(thePt, point2D_t(Iso::WORLD_GRID_HALFSIZE, Iso::WORLD_GRID_HALFSIZE));
+	point2D_t const thePt( p2D_add(thePtGridSpace, point2D_t(Iso::WORLD_GRID_HALFSIZE, Iso::WORLD_GRID_HALFSIZE)) );
 	
 	return( p2D_add( Iso::p2D_GridToIso( p2D_sub(thePt, oWorld.oCamera.voxelIndex_TopLeft) ), oWorld.oCamera.voxelOffset ) );			
 }
@@ -1971,7 +2286,7 @@ __attribute__((pure)) bool const isPointNotInVisibleVoxel( vec2_t const Location
 }
 
 // Grid Space (-x,-y) to (X, Y) Coordinates Only
-__attribute__((pure)) bool const getVoxelDepth( vec2_t const Location, 			// this function has not been fully tested but should work
+bool const getVoxelDepth( vec2_t const Location, 			// this function has not been fully tested but should work
 																								Iso::Voxel const* __restrict& __restrict pVoxelOut, int32_t& __restrict Depth )
 {
 	point2D_t const voxelIndex( v2_to_p2D(Location) );		// Whole part in (-x,-y)=>(x,y) GridSpace
@@ -2026,7 +2341,7 @@ bool const moveTo( vec2_t const Dest, uint32_t const tMove )
 		oWorld.oCamera.PrevPosition = oWorld.oCamera.Origin;
 		
 		// Save start time
-		oWorld.oCamera.tMovePositionStart = millis();
+		oWorld.oCamera.tMovePositionStart = INPUT_MILLIS();
 		
 		// Save new target position 
 		oWorld.oCamera.TargetPosition = Dest;
@@ -2034,6 +2349,8 @@ bool const moveTo( vec2_t const Dest, uint32_t const tMove )
 		// Save amount of time for movement to transition
 		oWorld.oCamera.tMoveTotalPosition = tMove;
 		
+		INPUT_CHECKPOINT(InputReplay::CHECK_CAMERA, InputReplay::FloatBits(Dest.x), InputReplay::FloatBits(Dest.y), tMove);
+		
 		// Save pre-calculated (inverse) of total time
 		oWorld.oCamera.tInvMoveTotalPosition = 1.0f / (float)oWorld.oCamera.tMoveTotalPosition;
 		
@@ -2073,6 +2390,29 @@ void setFogLevel(uint32_t const uiFogHeightInPixels)
 	oWorld.FogHeight = uiFogHeightInPixels;
 }
 
+// effects emit a bounded light every frame they are alive (world lights lPrimary.. are activated separately)
+static void EmitEffectLights()
+{
+	static constexpr float const MISSILE_LIGHT_HEIGHT = 16.0f, MISSILE_LIGHT_RADIUS = 48.0f,
+															 EXPLOSION_LIGHT_HEIGHT = 24.0f,
+															 SHOCKWAVE_LIGHT_HEIGHT = 8.0f,
+															 GRID_TO_PIXELS = (float)(Iso::GRID_RADII << 1);	// radial grid radius is in voxels
+	
+	Lighting::ActiveLighting.ResetEmittedLights();
+	
+	if (nullptr != oWorld.m_pCurMissile) {
+		Lighting::ActiveLighting.EmitLight(oWorld.m_pCurMissile->vLoc, MISSILE_LIGHT_HEIGHT, 0.5f, 0.25f, 16.0f, MISSILE_LIGHT_RADIUS);
+	}
+	if (nullptr != oWorld.m_pCurExplosion) {
+		float const fRadius(oWorld.m_pCurExplosion->getRadius() * GRID_TO_PIXELS);
+		Lighting::ActiveLighting.EmitLight(oWorld.m_pCurExplosion->getOrigin(), EXPLOSION_LIGHT_HEIGHT, 0.6f, 0.3f, fRadius, fRadius * 2.0f);
+	}
+	if (nullptr != oWorld.m_pCurShockwave) {
+		float const fRadius(oWorld.m_pCurShockwave->getRadius() * GRID_TO_PIXELS);
+		Lighting::ActiveLighting.EmitLight(oWorld.m_pCurShockwave->getOrigin(), SHOCKWAVE_LIGHT_HEIGHT, 0.3f, 0.2f, fRadius, fRadius);
+	}
+}
+
 void Update( uint32_t const tNow )
 {
 	UpdateCamera(tNow);
@@ -2117,6 +2457,11 @@ void Update( uint32_t const tNow )
 #ifdef ENABLE_SKULL
 	SDF_Viewer::Update(tNow);
 #endif
+	
+	EmitEffectLights();
+	
+	// after everything that may have edited the grid this frame
+	FlushGroundOcclusion();
 }
 
 static void RenderFullScreenFire( uint32_t const tNow )
@@ -2229,7 +2574,11 @@ void Render( uint32_t const tNow )
 	
 #ifndef ENABLE_SKULL
 
-	RenderGrid<OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE|OLED::FOG_ENABLE>();
+	Lighting::ActiveLighting.BuildClusters();
+	UpdateShadowMap();
+	
+	RenderGrid<OLED::SHADE_ENABLE|OLED::Z_ENABLE|OLED::ZWRITE_ENABLE>();
+	PostProcess_Fog(tNow);	// before effects that draw to the front buffer
 
 	if (nullptr != oWorld.m_pCurExplosion) {
 		
@@ -2237,10 +2586,12 @@ void Render( uint32_t const tNow )
 		if (nullptr != oWorld.m_pCurShockwave) {
 			
 			if ( isShockwaveVisible( oWorld.m_pCurShockwave ) ) {
+				PROFILE_STAGE(Profiler::SHOCKWAVE);
 				RenderShockwave( oWorld.m_pCurShockwave );
 			}
 		}
 		if ( isExplosionVisible( oWorld.m_pCurExplosion ) ) {
+			PROFILE_STAGE(Profiler::EXPLOSION);
 			RenderExplosion( oWorld.m_pCurExplosion );
 		}
 		
@@ -2250,7 +2601,8 @@ void Render( uint32_t const tNow )
 	if (nullptr != oWorld.m_pCurMissile) {
 		
 		if ( oWorld.m_pCurMissile->isVisible() ) {
-			oWorld.m_pCurMissile->Render();
+			PROFILE_STAGE(Profiler::MISSILE);
+			VoxMissile::RenderBatch(&oWorld.m_pCurMissile, 1, tNow);	// every active missile shares the model
 		}
 	}
 	
@@ -21,9 +21,9 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #ifdef ENABLE_SKULL
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
-#include "FRAM\FRAM_SDF_MemoryLayout.h"
+#include "FRAM/FRAM_SDF_MemoryLayout.h"
 #if defined(VERIFY_SDF_FRAM_SPECIFIC) || defined(PROGRAM_SDF_TO_FRAM)
 #include "sdf_fram.h"
 #endif
@@ -11,14 +11,14 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "globals.h"
 #include "explosion.h"
 #include "volumetricradialgrid.h"
-#include "lighting.h"
+#include "Lighting.h"
 #include "noise.h"
 #include "rng.h"
 
 #include <vector>
 
 #ifdef DEBUG_RANGE
-#include "debug.cpp"
+#include "Debug.cpp"
 #endif
 
 static constexpr uint32_t const LIFETIME_ANIMATION = 6000;//ms
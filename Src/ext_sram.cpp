@@ -18,8 +18,8 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_hal_dma.h"
 #include "stm32f7xx_hal_sram.h"
 
-#include "FRAM\FRAM_SDF_MemoryLayout.h"
-#include "FLASH\Imports.h"
+#include "FRAM/FRAM_SDF_MemoryLayout.h"
+#include "FLASH/imports.h"
 
 #include "rng.h"
 
@@ -8,7 +8,7 @@ To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-
 or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
  */
 
-#include "Globals.h"
+#include "globals.h"
 #include "stm32f7xx_ll_gpio.h"
 #include "stm32f7xx_ll_utils.h"
 
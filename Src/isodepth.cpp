@@ -11,10 +11,11 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "isodepth.h"
 #include "noise.h"
 #include "world.h"
-#include "debug.cpp"
+#include "Debug.cpp"
 
 sIsoDepth_Private IsoDepth_Private
 	__attribute__((section (".dtcm")));
+sFogLUT FogLUT;
 
 static constexpr float const EYE_X = 0.64f,   // Values tweaked, don't change
 														 EYE_Y = 0.36f;
@@ -31,6 +32,61 @@ __attribute__((section (".dtcm_const")))(0.612375, 0.612375, -0.50000);
 
 namespace IsoDepth
 {
+
+#ifdef DEPTH_16BIT
+static void UpdateLevelScale16()
+{
+	int32_t const Range( max(IsoDepth_Private.DynamicRangeMax - IsoDepth_Private.DynamicRangeMin, 0) + 1 );	// whole pixels, inclusive
+	
+	IsoDepth_Private.LevelScale16 = (float)(DEPTH_MAX - DEPTH_MIN) / (float)(Range << DEPTH_FRACTION_BITS);
+}
+#endif
+
+// fog of every depth level, evaluated at a representative point of the level (center of screen, ground height)
+// a depth level maps back to screen y by the inverse of getDepthLevel (16bit: every 8bit index is the top of a range of levels)
+// the fog luma also depends on the lighting shade, it is tabled for the back buffer luma every 1 << SHADE_BITS
+static void BuildFogLUT()
+{
+	static constexpr float const C = 0.55f,	// Found with stepping valu debugly
+															 B = -0.38f; // importanmt to negate
+	
+	float const fEyeFogAlpha( C * ARM__expf(IsoDepth_Private.vEyePt.y*B) );
+#ifndef DEPTH_16BIT
+	float const fLevelToScreenY( (float)IsoDepth_Private.DynamicRangeMax / Constants::nf127 );
+#endif
+	
+	for ( int32_t iLevel = INT8_MIN ; iLevel <= INT8_MAX ; ++iLevel )
+	{
+#ifdef DEPTH_16BIT
+		int32_t const DepthLevel( iLevel << DEPTH_FRACTION_BITS );
+		vec3_t const vPoint( OLED::HALF_WIDTH, 0.0f, getLevelDistance(DepthLevel) * (float)IsoDepth_Private.DynamicRangeMax );
+#else
+		int32_t const DepthLevel( iLevel );
+		vec3_t const vPoint( OLED::HALF_WIDTH, 0.0f, (float)iLevel * fLevelToScreenY );
+#endif
+		
+		float fogDistance(0.0f);   // fog distance is accurate do not scale
+		vec3_t const vViewRay = v3_normalize(v3_sub(vPoint, IsoDepth_Private.vEyePt), &fogDistance);
+		fogDistance = __fma(getLevelDistance(DepthLevel), 0.5f, fogDistance);
+		
+		float const fInScattering = (1.0f - ARM__expf(fogDistance*vViewRay.y*B)/vViewRay.y);
+		float const fFogAlpha = clampf( fEyeFogAlpha * fInScattering );
+		float const fExtinction = fInScattering * fFogAlpha;
+		
+		uint32_t const uiLevel( iLevel - INT8_MIN );
+		
+		FogLUT.ScreenY[uiLevel] = __SSAT( int32::__roundf(vPoint.z), 16 );
+		FogLUT.Density[uiLevel] = __USAT( int32::__roundf(fFogAlpha * Constants::nf255), Constants::SATBIT_256 );
+		
+		for ( uint32_t uiShade = 0 ; uiShade < sFogLUT::NUM_SHADES ; ++uiShade ) {
+			
+			float const fLightingShade( (float)(uiShade << sFogLUT::SHADE_BITS) * Constants::inverseUINT8 );
+			float const FogLighting = getFogExtinction(fLightingShade * fExtinction) + 0.8f;
+			
+			FogLUT.Shade[uiLevel][uiShade] = __USAT( int32::__roundf(mix(fLightingShade, FogLighting, fFogAlpha) * Constants::nf255), Constants::SATBIT_256 );
+		}
+	}
+}
 	
 NOINLINE void Init()
 {
@@ -41,6 +97,9 @@ NOINLINE void Init()
 	IsoDepth_Private.DynamicRangeMax = INT8_MAX;
 	IsoDepth_Private.DynamicRangeMin = INT8_MIN;
 	IsoDepth_Private.InvDynamicRangeDepthLength = 1.0f / (float)(IsoDepth_Private.DynamicRangeMax);
+#ifdef DEPTH_16BIT
+	UpdateLevelScale16();
+#endif
 	// Reset for next frame calculation
 	IsoDepth_Private.CurFrameRangeMin = INT8_MAX;
 	IsoDepth_Private.CurFrameRangeMax = INT8_MIN;
@@ -52,6 +111,12 @@ NOINLINE void Init()
 	// Reset for next frame calculation
 	IsoDepth_Private.CurFogDensityRangeMin = INT32_MAX;
 	IsoDepth_Private.CurFogDensityRangeMax = INT32_MIN;
+	
+	// FOG LUT //
+	for ( uint32_t iDx = 0 ; iDx <= sFogLUT::NUM_EXTINCTION ; ++iDx ) {
+		FogLUT.Exp[iDx] = ARM__expf( -((float)iDx * (sFogLUT::EXTINCTION_MAX / (float)sFogLUT::NUM_EXTINCTION)) );
+	}
+	BuildFogLUT();
 }
 
 NOINLINE void UpdateDynamicRange()
@@ -74,11 +139,16 @@ NOINLINE void UpdateDynamicRange()
 	if ( bDelta ) 
 	{
 		IsoDepth_Private.InvDynamicRangeDepthLength = 1.0f / (float)IsoDepth_Private.DynamicRangeMax;
+#ifdef DEPTH_16BIT
+		UpdateLevelScale16();
+#endif
 		
 		// Calculate Eye Point //
 		float const EyeDistance = EYE_DISTANCE - ((float)(IsoDepth_Private.DynamicRangeMax - IsoDepth_Private.DynamicRangeMin)) * 0.5f;
 		
 		IsoDepth_Private.vEyePt = vec3_t( EyeDistance * 3.0f * fEyeSinAngleX * fEyeSinAngleY, EyeDistance * 2.0f * fEyeCosAngleX * fEyeSinAngleY, EyeDistance * fEyeSinAngleY );
+		
+		BuildFogLUT();	// only when the range shifts
 	}
 	// Reset for next frame calculation
 	IsoDepth_Private.CurFrameRangeMin = INT8_MAX;
@@ -105,8 +175,6 @@ NOINLINE void UpdateDynamicRange()
 	// fog as well reset for next frame calculation 
 	IsoDepth_Private.CurFogDensityRangeMin = INT32_MAX;
 	IsoDepth_Private.CurFogDensityRangeMax = INT32_MIN;
-	
-	ResetActiveFogShade();
 }
 
 xDMA2D::AlphaLuma const getFogShadeAtPixel( uint32_t const pixelCoordX, uint32_t const pixelCoordY ) 
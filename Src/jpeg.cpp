@@ -16,13 +16,17 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_hal_msp.h"
 #include "stm32f7xx_hal_jpeg.h"
 
-#include "JPEG\jpeg_utils.h"
-#include "JPEG\decode_dma.h"
+#include "JPEG/jpeg_utils.h"
+#ifndef JPEG_SOFTWARE_DECODER
+#include "JPEG/decode_dma.h"
+#else
+#include "JPEG/decode_soft.h"
+#endif
 #include "quadspi.h"
 #include "rng.h"
 #include "DTCM_Reserve.h"
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
 #if (JPEG_RGB_FORMAT == JPEG_ARGB8888)
   #define BYTES_PER_PIXEL 4  /* Number of bytes in a pixel */
@@ -36,9 +40,11 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
   #error "unknown JPEG_RGB_FORMAT "
 #endif /* JPEG_RGB_FORMAT */
 
+#ifndef JPEG_SOFTWARE_DECODER
 JPEG_HandleTypeDef    JPEG_Handle;
 DMA_HandleTypeDef   	hdmaIn;
 DMA_HandleTypeDef   	hdmaOut;
+#endif
 	
 static struct sJPEGCurrent
 {
@@ -49,8 +55,11 @@ static struct sJPEGCurrent
 	
 	uint32_t								ID;
 	
+	uint32_t								tDecodeDuration,		// micros, accumulated across IsReady polls
+													tLastDecodeDuration;
+	
 	sJPEGCurrent()
-	: ID(0)
+	: ID(0), tDecodeDuration(0), tLastDecodeDuration(0)
 	{}
 		
 } oJPEGCurrent;
@@ -64,6 +73,7 @@ uint8_t _DecompressedBuffer[SDFConstants::SDF_DIMENSION*SDFConstants::SDF_DIMENS
 	__attribute__((section (".bss")));
 }
 
+#ifndef JPEG_SOFTWARE_DECODER
 namespace JPEGDecoder
 {
 NOINLINE void Init()
@@ -191,5 +201,110 @@ uint32_t const GetError()
 	return(HAL_JPEG_GetError(&JPEG_Handle));
 }
 
+uint32_t const getLastDecodeDuration()
+{
+	return(0); // hw codec runs in parallel, cpu cost is only the mcu conversion in IsReady
+}
+
 } // end namespace
 
+#else /* JPEG_SOFTWARE_DECODER */
+
+// Host build, the hardware codec is replaced by decode_soft.c
+// Start_Decode only parses the header, each IsReady poll decodes and converts the next chunk of MCUs,
+// so the owners state machines (RenderSDF_DMA2D, SDF_Viewer) see the same NOT_READY => READY sequence as on target
+namespace JPEGDecoder
+{
+NOINLINE void Init()
+{
+	// no color tables needed for grayscale, nothing to do
+}
+
+uint32_t const Start_Decode(uint8_t const* const srcJPEG_MemoryBuffer, 
+														uint32_t const sizeInBytesOfJPEG,
+														bool const bOnFRAM)
+{
+	// same ownership rule as the hardware path, see above
+	if ( 0 == oJPEGCurrent.ID && !getSoft_IsBusy() ) {
+		
+		if ( bOnFRAM ) {
+
+			uint32_t const uiStatus = QuadSPI_FRAM::MemoryMappedMode();
+		
+			if ( QuadSPI_FRAM::QSPI_OP_OK != uiStatus ) {
+#ifdef _DEBUG_OUT_OLED
+				DebugMessage( "FRAM MemorxMapped Fail  =%d", QuadSPI_FRAM::GetHALQSPIErrorCode());
+#endif
+				return(false);
+			}
+			QSPI_FRAM_ACCOUNT_READ(srcJPEG_MemoryBuffer, sizeInBytesOfJPEG);
+		}
+		
+		uint32_t const tStart = micros();
+		
+		if ( HAL_OK != JPEG_Decode_Soft(srcJPEG_MemoryBuffer, sizeInBytesOfJPEG, JPEGDecoder::getDecompressionBuffer()) ) {
+#ifdef _DEBUG_OUT_OLED
+			DebugMessage( "JPEG soft decode hdr err =%d", getSoft_Error());
+#endif
+			return(0);
+		}
+		
+		uint32_t const tNow = millis();
+		oJPEGCurrent.ID = RandomNumber(1, UINT32_MAX >> 4) + tNow;
+		oJPEGCurrent.tStartDecode = tNow;
+		oJPEGCurrent.tDecodeDuration = micros() - tStart;
+		
+		return(oJPEGCurrent.ID);
+	}
+	return(0);
+}
+int32_t const IsReady( uint32_t const idJPEG)
+{
+	if (idJPEG != oJPEGCurrent.ID)
+		return(NOT_READY);
+	
+	uint32_t const tStart = micros();
+	uint32_t const JpegProcessing_End = JPEG_OutputHandler_Soft();
+	oJPEGCurrent.tDecodeDuration += micros() - tStart;
+	
+	if ( READY == JpegProcessing_End ) {
+		oJPEGCurrent.tLastDecodeDuration = oJPEGCurrent.tDecodeDuration;
+		oJPEGCurrent.ID = 0; // Reset
+		return(READY);
+	}
+	
+	// a corrupt stream never completes, report it the same way the hw path reports a stall
+	if ( JPEG_SOFT_ERROR_NONE != getSoft_Error() || millis() - oJPEGCurrent.tStartDecode > oJPEGCurrent.TIMEOUT ) {
+		oJPEGCurrent.ID = 0;
+		return(TIMED_OUT);
+	}
+	return(NOT_READY);
+}
+uint32_t const getCurrentMCUBlockIndex()
+{
+	return(getSoft_MCUBlockIndex());
+}
+uint32_t const getCurrentMCUTotalNb()
+{
+	return(getSoft_MCUTotalNb());
+}
+
+uint32_t const GetState()
+{
+	return( getSoft_IsBusy() ? HAL_JPEG_STATE_BUSY_DECODING : HAL_JPEG_STATE_READY );
+}
+
+uint32_t const GetError()
+{
+	return(getSoft_Error());
+}
+
+uint32_t const getLastDecodeDuration()
+{
+	return(oJPEGCurrent.tLastDecodeDuration);
+}
+
+} // end namespace
+
+#endif /* JPEG_SOFTWARE_DECODER */
+
@@ -33,8 +33,26 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #endif
 
 #include "VoxMissile.h"
+#include "Profiler.h"
+#include "InputReplay.h"
 
-#include "debug.cpp"
+#ifdef GOLDEN_FRAME_HARNESS
+#include "GoldenFrame.h"
+#endif
+#ifdef OLED_MICROBENCHMARK
+#include "OLEDBenchmark.h"
+#endif
+#ifdef VOX_ADJACENCY_BENCHMARK
+#include "VoxAdjacencyBenchmark.h"
+#endif
+#ifdef VOX_BAKE_MODELS
+#include "VoxBaker.h"
+#endif
+#ifdef VOX_BATCH_BENCHMARK
+#include "VoxBatchBenchmark.h"
+#endif
+
+#include "Debug.cpp"
 
 NOINLINE static void LL_Init(void);
 NOINLINE void SystemClock_Config(void);
@@ -56,6 +74,12 @@ NOINLINE void SystemClock_Config(void);
 STATIC_INLINE void RenderScene( uint32_t const tNow );
 STATIC_INLINE void UpdateScene( uint32_t const tNow );
 NOINLINE void PrepareScene(uint32_t const tNow);
+#ifdef GOLDEN_FRAME_HARNESS
+NOINLINE static int RunGoldenFrames();
+#endif
+#ifdef INPUT_RECORD_REPLAY
+NOINLINE static int RunReplay();
+#endif
 
 
 NOINLINE static void MPU_Config_ReadOnly(void); // has to be done in main (after c runtime init)
@@ -117,6 +141,26 @@ int main(void) // imported by reset handler asm startup 2001db28
 	DTCM::ScatterLoad();
 	LED_On(Blue_OnBoard);
 
+#ifdef OLED_MICROBENCHMARK
+	return( OLEDBenchmark::Run() ); // replaces the realtime loop
+#endif
+#ifdef VOX_ADJACENCY_BENCHMARK
+	return( VoxAdjacencyBenchmark::Run() ); // replaces the realtime loop
+#endif
+#ifdef VOX_BAKE_MODELS
+	return( VoxBaker::Run() ); // replaces the realtime loop
+#endif
+#ifdef VOX_BATCH_BENCHMARK
+	return( VoxBatchBenchmark::Run() ); // replaces the realtime loop
+#endif
+#ifdef INPUT_RECORD_REPLAY
+	if ( InputReplay::Init() )
+		return( RunReplay() ); // replaces the realtime loop, see InputReplay.h
+#endif
+#ifdef GOLDEN_FRAME_HARNESS
+	return( RunGoldenFrames() ); // replaces the realtime loop
+#endif
+	
 	world::Init(millis());
 		
 	PrepareScene(millis()); // important
@@ -174,6 +218,8 @@ int main(void) // imported by reset handler asm startup 2001db28
 
 STATIC_INLINE void RenderScene( uint32_t const tNow )
 {
+	INPUT_RECORD(InputReplay::EVENT_RENDER, tNow);
+	
 	OLED::ClearFrameBuffers(tNow); // the ONLY place this should be called
 
 	world::Render(tNow);
@@ -183,6 +229,13 @@ STATIC_INLINE void RenderScene( uint32_t const tNow )
 	// LAST //
 	OLED::Render(tNow);
 	
+#ifdef QSPI_FRAM_SOFTWARE_EMULATOR
+	QuadSPI_FRAM::Soft::EndFrame();	// FRAM bus traffic of this frame, see quadspi.h
+#endif
+#ifdef STAGE_PROFILING
+	Profiler::EndFrame(tNow);
+#endif
+	
 	// leveraging parallel dma2d op ongoing begins //
 }
 
@@ -216,6 +269,10 @@ STATIC_INLINE void UpdateScene( uint32_t const tNow )
 
 	static bool bFirstMoveOnly(true);
 	
+	PROFILE_STAGE_SAMPLE(Profiler::UPDATE_SCENE);	// not once per frame, every call is a sample
+	
+	INPUT_RECORD(InputReplay::EVENT_UPDATE, tNow);
+	
 	if ( !world::isDeferredInitComplete() ) {
 		world::DeferredInit(tNow);
 		
@@ -236,7 +293,7 @@ STATIC_INLINE void UpdateScene( uint32_t const tNow )
 				//DebugMessage(szTurnText);
 				if ( !world::moveTo(p2D_to_v2(ptMoveToBotHome), tMoveTime) ) {
 					if ( 0 == tStartCheckCantMove )
-						tStartCheckCantMove = millis();
+						tStartCheckCantMove = INPUT_MILLIS();
 				}
 				else {
 					tStartCheckCantMove = 0;
@@ -388,12 +445,86 @@ NOINLINE void PrepareScene(uint32_t const tNow) {
 	
 	StartLPTimer();
 }
+#ifdef GOLDEN_FRAME_HARNESS
+// Same init => update => render order as the realtime loop, but driven by a fixed frame clock,
+// the dithered output is captured directly (see GoldenFrame.h)
+NOINLINE static int RunGoldenFrames()
+{
+	GoldenFrame::Init(); // pins the rng state, millis() is the frame clock from here on
+	
+	world::Init(GoldenFrame::getFrameTime(0));
+	PrepareScene(GoldenFrame::getFrameTime(0));
+	NVIC_DisableIRQ(LPTIM1_IRQn);	// frames are captured directly, no spi send racing the capture
+	
+	for ( uint32_t iFrame = 0 ; iFrame < GoldenFrame::FRAME_COUNT ; ++iFrame )
+	{
+		uint32_t const tNow = GoldenFrame::getFrameTime(iFrame),
+									 tUpdate = tNow + (GoldenFrame::FRAME_STEP >> 1); // update lands between render passes
+		
+		GoldenFrame::SetClock(tNow);
+		RenderScene(tNow);
+		GoldenFrame::Capture(iFrame);
+		
+		GoldenFrame::SetClock(tUpdate);
+		UpdateScene(tUpdate);
+		QuadSPI_FRAM::Update(tUpdate);
+	}
+	
+#ifdef STAGE_PROFILING
+	Profiler::ExportCSV();
+#ifdef SHADE_CACHE
+	Lighting::ShadeCache::Report();
+#endif
+#endif
+#ifdef INPUT_RECORD_REPLAY
+	InputReplay::Finish();
+#endif
+	
+	return( GoldenFrame::Report() );
+}
+#endif
+#ifdef INPUT_RECORD_REPLAY
+// Feeds the logged world::Init / UpdateScene / RenderScene calls in their original order and with their original tNow,
+// the lp timer is not used, the main dma2d blend of every frame completes before the next call
+NOINLINE static int RunReplay()
+{
+	uint32_t Event(0), tNow(0);
+	
+	while ( InputReplay::Next(Event, tNow) )
+	{
+		switch(Event)
+		{
+			case InputReplay::EVENT_INIT:
+				world::Init(tNow);
+				break;
+			case InputReplay::EVENT_UPDATE:
+				UpdateScene(tNow);
+				break;
+			case InputReplay::EVENT_RENDER:
+				RenderScene(tNow);
+				xDMA2D::Wait_DMA2D<true>();
+				break;
+		}
+		
+		QuadSPI_FRAM::Update(tNow);
+	}
+	
+#ifdef STAGE_PROFILING
+	Profiler::ExportCSV();
+#ifdef SHADE_CACHE
+	Lighting::ShadeCache::Report();
+#endif
+#endif
+	
+	return( InputReplay::Finish() );
+}
+#endif
 /// * Interrupts *//
 void LPTimer_Callback()
 {
 	if ( bRenderSync.State > 0 ) {	//  = work pending, PENDING = interuppt is working, UNLOADED = default state (rendering), MAIN_DMA_COMPLETED = signal rendering to continue
 		
-		if ( bRenderSync.tLastRenderCompleted > bRenderSync.tLastSendCompleted )
+		if ( bRenderSync.tLastRenderCompleted >= bRenderSync.tLastSendCompleted )	// >= a frame can finish rendering in the same ms its previous frame was sent in
 		{				
 			if ( !xDMA2D::IsBusy_DMA2D() ) {
 				
@@ -607,6 +738,7 @@ NOINLINE static void InitCriticalRegisters() // imported by reset handler asm st
 	__ISB();
 		
 	// DTCM tweaks
+#ifndef HOST_BUILD	// core registers, not mapped on the host
 	__IO uint32_t * CM7_DTCMCR = (uint32_t*)(0xE000EF94);
 	*CM7_DTCMCR &= 0xFFFFFFFD; /* Disable read-modify-write, performance tweak good */
 	__DSB();
@@ -617,6 +749,7 @@ NOINLINE static void InitCriticalRegisters() // imported by reset handler asm st
 	*CM7_AHBSCR &= 0xFFFFFFFD; /* Software aCESS DEMOTED (arithmetically larger numbers to represent lower priority. SO DEMOTED = HIGHER PRIORITY)*/
 	__DSB();
 	__ISB();
+#endif
 	
 	__FLASH_ART_ENABLE();
 	__DSB();
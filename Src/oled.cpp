@@ -15,7 +15,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_ll_dma2d.h"
 #include "dma.h"
 #include "spi.h"
-#include "Commonmath.h"
+#include "commonmath.h"
 #include "rng.h"
 #include "Point2D.h"
 #include <cctype>
@@ -28,7 +28,8 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #include "stm32f7xx_ll_rcc.h"
 #include "ext_sram.h"
-#include "debug.cpp"
+#include "Debug.cpp"
+#include "Profiler.h"
 
 #if( 0 != USART_ENABLE )
 #include "usart.h"
@@ -66,10 +67,27 @@ uint32_t	FrontBuffer[OLED::SCREEN_HEIGHT][OLED::SCREEN_WIDTH] 	// used a lot, eg
   __attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
 	__attribute__((section (".dtcm.FrontBuffer")));
 
+#ifdef DEPTH_16BIT
+// 16bpp	(16bit signed src buffer for zbuffer, SRAM1    					// 32KB
+depth_t	DepthBuffer[OLED::SCREEN_WIDTH][OLED::SCREEN_HEIGHT] 	  // used a lot, eg.) compositing alpha+luma buffers
+  __attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
+	__attribute__((section (".bss.DepthBuffer")));	
+#else
 // 8bpp	(8bit signed src buffer for zbuffer,    								// 16KB
-int8_t	DepthBuffer[OLED::SCREEN_WIDTH][OLED::SCREEN_HEIGHT] 	  // used a lot, eg.) compositing alpha+luma buffers
+depth_t	DepthBuffer[OLED::SCREEN_WIDTH][OLED::SCREEN_HEIGHT] 	  // used a lot, eg.) compositing alpha+luma buffers
   __attribute__((aligned(ARMV7M_DCACHE_LINESIZE)))
 	__attribute__((section (".dtcm.DepthBuffer")));	
+#endif
+
+// hierarchical depth of DepthBuffer																// 288 bytes (16bit 560 bytes)
+sDepthHiZ DepthHiZ
+	__attribute__((section (".dtcm")));
+
+#ifdef DEPTH_SPANS
+// span encoded depth of DepthBuffer, SRAM1														// 8.5KB (16bit 12.5KB)
+sDepthSpans DepthSpans
+	__attribute__((aligned(ARMV7M_DCACHE_LINESIZE)));
+#endif
 	
 } //end namespace;
 
@@ -329,8 +347,13 @@ static void Configure_DMA2D_MainStatic(void) // mostly for preloading CLUT
 	LL_DMA2D_ConfigLayer(DMA2D, &backgroundLayer, 0);
 	LL_DMA2D_ConfigLayer(DMA2D, &foregroundLayer, 1);
 	
+#ifndef DMA2D_SOFTWARE_ENGINE
 	LL_DMA2D_BGND_EnableCLUTLoad(DMA2D);
 	LL_DMA2D_FGND_EnableCLUTLoad(DMA2D);
+#else
+	xDMA2D::Soft::LoadCLUT(xDMA2D::BGND);
+	xDMA2D::Soft::LoadCLUT(xDMA2D::FGND);
+#endif
 
 	__WFI(); // beware: puts mcu in lowe power-mode, used here to delay a small amount to alow automatic CLUT loading
 }
@@ -719,8 +742,9 @@ NOINLINE void Init()
 
 	// Initialize DMA2D
 	xDMA2D::Init(&Configure_DMA2D_MainStatic);
-	ClearBuffer_8bit(oOLED::DoubleBuffer::_FrameBuffer0);
-	ClearBuffer_8bit(oOLED::DoubleBuffer::_FrameBuffer1);
+	// spi framebuffers are FrameBufferWidth wide, a screen sized clear runs past their end
+	xDMA2D::ClearBuffer_8bit<false, true, false, oOLED::FrameBufferWidth, oOLED::Height>(oOLED::DoubleBuffer::_FrameBuffer0);
+	xDMA2D::ClearBuffer_8bit<false, true, false, oOLED::FrameBufferWidth, oOLED::Height>(oOLED::DoubleBuffer::_FrameBuffer1);
 	ClearBuffer_8bit((uint8_t* const __restrict)oOLED::DoubleBufferBloomHDR::_FrameBuffer0);
 	ClearBuffer_8bit((uint8_t* const __restrict)oOLED::DoubleBufferBloomHDR::_FrameBuffer1);
 	
@@ -822,8 +846,12 @@ void ClearFrameBuffers(uint32_t const tNow) // called from main() renderscene
 	// Clear FrameBuffers //
 	xDMA2D::ClearBuffer_8bit<true>((uint8_t* const __restrict)DTCM::getBackBuffer());
 	xDMA2D::ClearBuffer_32bit<true, false>((uint32_t* const __restrict)DTCM::getFrontBuffer());
-	// while dma2d is clearing frontbuffer, use cpu to clear depth buffer must be cleared to INT8_MIN
-	memset(DTCM::getDepthBuffer(), INT8_MIN, oOLED::Width*oOLED::Height*sizeof(int8_t));
+	// while dma2d is clearing frontbuffer, use cpu to clear depth buffer must be cleared to IsoDepth::DEPTH_MIN
+	FillDepth(&DTCM::getDepthBuffer()[0][0], IsoDepth::DEPTH_MIN, oOLED::Width*oOLED::Height);
+	ClearHiZ();
+#ifdef DEPTH_SPANS
+	ClearDepthSpans();
+#endif
 	
 	xDMA2D::Wait_DMA2D<true>();	
 	
@@ -923,6 +951,49 @@ NOINLINE static void DitherBlit()
 		} while (--yy >= 0);
 }
 */
+#ifdef HOST_BUILD
+// C port of asmDitherBlit (critical.s) for the host build, bit exact with the assembler version
+// the 90 cw rotation is undone by reading the DMA2D framebuffer forwards while writing rows bottom up
+// dither lane order follows the packing of the assembler (pkhbt), pixel pairs are swapped within each dither word
+STATIC_INLINE uint32_t const DitherPixel(uint32_t const ARGB, uint32_t const Dither)
+{
+	uint32_t const Pixel = ARGB & 0xFF;
+	uint32_t const Threshold = ((Dither - (Pixel & 0x0F) * 17) >> 4) & 16;
+	uint32_t const Result = (Pixel & 0xF0) + Threshold;
+	
+	return( (Result > UINT8_MAX ? UINT8_MAX : Result) >> 4 ); // uqadd8
+}
+extern "C" void asmDitherBlit(void)
+{
+	uint32_t const * __restrict pi((uint32_t const* __restrict)_DMA2DFrameBuffer);
+	
+	int32_t yy(oOLED::Height - 1);
+	do {
+		// the assembler reads the 8 bytes starting one before the row of the dither table,
+		// for (yy&7) == 0 that is the byte preceding _dithertable which has no equivalent here (0)
+		int32_t const iDitherRow = ((yy & 7) << 3) - 1;
+		uint8_t Dither[8];
+		for ( int32_t iDx = 0 ; iDx < 8 ; ++iDx ) {
+			Dither[iDx] = (iDitherRow + iDx) >= 0 ? _dithertable[iDitherRow + iDx] : 0;
+		}
+		
+		uint8_t * __restrict po0 = _DitherTargetFrameBuffer + (yy * oOLED::FrameBufferWidth + oOLED::StartXOffset);
+		
+		for ( uint32_t xxx = 0 ; xxx < oOLED::Width ; xxx += 8 ) {
+			
+			for ( uint32_t iPixel = 0 ; iPixel < 8 ; iPixel += 2 ) {
+				
+				uint32_t const Hi = DitherPixel(pi[iPixel], Dither[(iPixel & 4) | ((iPixel & 3) ^ 1)]),
+											 Lo = DitherPixel(pi[iPixel + 1], Dither[(iPixel & 4) | (((iPixel + 1) & 3) ^ 1)]);
+				
+				*po0++ = (Hi << 4) | Lo;
+			}
+			pi += 8;
+		}
+	} while (--yy >= 0);
+}
+#endif
+
 NOINLINE static void DrawTextLayer(uint32_t const& tNow);
 static void DrawScreenSavingScanline(uint32_t const& tNow);
 
@@ -950,13 +1021,20 @@ static void SwapBloomHDRBuffers()
 }
 void Render(uint32_t const tNow)
 {
+	PROFILE_STAGE(Profiler::OLED_RENDER);	// inclusive of bloom
+	
 	// need to allow any previous dma2d operation to finish before entry into oled finalization Render func
 	/* Wait until transfer is over */
   xDMA2D::Wait_DMA2D<true>();
 
-	xDMA2D::DualFilterBlur_EndAsync();  // wait for dual filter blur to finish, blend result into frontbuffer
+	{
+		PROFILE_STAGE(Profiler::BLOOM);
+		xDMA2D::DualFilterBlur_EndAsync();  // wait for dual filter blur to finish, blend result into frontbuffer
+	}
 
-	DrawTextLayer(tNow);
+#ifndef GOLDEN_FRAME_HARNESS
+	DrawTextLayer(tNow);	// debug text is wall clock timing, not part of the golden frames
+#endif
 	
 	DrawScreenSavingScanline(tNow);
 	
@@ -981,6 +1059,8 @@ void Render(uint32_t const tNow)
 // anything not requiring dma2d
 void SendFrameBuffer(uint32_t const tNow) // called from LP Timer 60hz interrupt
 {	
+	PROFILE_STAGE_SAMPLE(Profiler::SEND_FRAMEBUFFER);	// interrupt, every call is a sample
+	
 	// Exploiting parellism of dma2d, both the lp timer interrupt and the first calls to modify
 	// the back or front buffers must wait until the main dma2d blending operation is complete
 	// from the *previous* frame before starting a new frame. Any other dma2d usage before completion is also prohibited.
@@ -1740,7 +1820,7 @@ void RenderDepthBuffer()
 		while( 0 != wlen ) 
 		{
 			// Calculate scaled depth value 
-			*UserFrameBuffer = __USAT( uint32::__roundf( lerp(0.0f, 255.0f, IsoDepth::getDistance(DTCM::getDepthBuffer()[xPixel][yPixel]))), Constants::SATBIT_256 );
+			*UserFrameBuffer = __USAT( uint32::__roundf( lerp(0.0f, 255.0f, IsoDepth::getLevelDistance(DTCM::getDepthBuffer()[xPixel][yPixel]))), Constants::SATBIT_256 );
 
 			++UserFrameBuffer;
 			++xPixel;
@@ -1752,6 +1832,283 @@ void RenderDepthBuffer()
 	}
 }
 
+void FillDepth( depth_t* const __restrict pDepth, int32_t const DepthLevel, uint32_t const Count )
+{
+	if constexpr ( 1 == sizeof(depth_t) ) {
+		memset(pDepth, DepthLevel, Count);
+	}
+	else {
+		for ( uint32_t iDx = 0 ; iDx < Count ; ++iDx ) {
+			pDepth[iDx] = DepthLevel;
+		}
+	}
+}
+
+/// * Hierarchical depth * ///
+void ClearHiZ()
+{
+	FillDepth(&DTCM::DepthHiZ.Farthest8[0][0], IsoDepth::DEPTH_MIN, sizeof(DTCM::DepthHiZ.Farthest8) / sizeof(depth_t));
+	FillDepth(&DTCM::DepthHiZ.Farthest32[0][0], IsoDepth::DEPTH_MIN, sizeof(DTCM::DepthHiZ.Farthest32) / sizeof(depth_t));
+	memset(DTCM::DepthHiZ.Dirty8, 0, sizeof(DTCM::DepthHiZ.Dirty8));
+}
+void InvalidateHiZ()
+{
+	memset(DTCM::DepthHiZ.Dirty8, 0xFF, sizeof(DTCM::DepthHiZ.Dirty8));
+}
+void MarkHiZ( int32_t const xMin, int32_t const yMin, int32_t const xMax, int32_t const yMax )
+{
+	using DTCM::sDepthHiZ;
+	
+	if ( xMax < 0 || yMax < 0 || xMin >= (int32_t)OLED::SCREEN_WIDTH || yMin >= (int32_t)OLED::SCREEN_HEIGHT )
+		return;	// nothing on screen
+	
+	uint32_t const xFine0( __USAT(xMin, OLED::Width_SATBITS) >> sDepthHiZ::FINE_BITS ), xFine1( __USAT(xMax, OLED::Width_SATBITS) >> sDepthHiZ::FINE_BITS ),
+								 yFine0( __USAT(yMin, OLED::Height_SATBITS) >> sDepthHiZ::FINE_BITS ), yFine1( __USAT(yMax, OLED::Height_SATBITS) >> sDepthHiZ::FINE_BITS );
+	
+	uint32_t const Column( (UINT32_MAX >> (31 - (yFine1 - yFine0))) << yFine0 );	// fine tiles yFine0..yFine1 of one fine column
+	
+	for ( uint32_t xFine = xFine0 ; xFine <= xFine1 ; ++xFine ) {
+		DTCM::DepthHiZ.Dirty8[xFine / sDepthHiZ::FINE_PER_COARSE] |= Column << ((xFine & (sDepthHiZ::FINE_PER_COARSE - 1)) * sDepthHiZ::FINE_Y);
+	}
+}
+
+STATIC_INLINE_PURE uint32_t const getCoarseDirtyMask( uint32_t const yCoarse )	// the 16 8x8 tiles of a 32x32 tile in its Dirty8 word
+{
+	static constexpr uint32_t const COLUMN = (1 << DTCM::sDepthHiZ::FINE_PER_COARSE) - 1;
+	static constexpr uint32_t const ALL_COLUMNS = COLUMN | (COLUMN << DTCM::sDepthHiZ::FINE_Y) | (COLUMN << (DTCM::sDepthHiZ::FINE_Y * 2)) | (COLUMN << (DTCM::sDepthHiZ::FINE_Y * 3));
+	
+	return( ALL_COLUMNS << (yCoarse * DTCM::sDepthHiZ::FINE_PER_COARSE) );
+}
+
+// rescan a dirty 8x8 tile, and its 32x32 tile once all of its 8x8 tiles are clean
+static void RefreshHiZ( uint32_t const xFine, uint32_t const yFine )
+{
+	using DTCM::sDepthHiZ;
+	sDepthHiZ& __restrict HiZ(DTCM::DepthHiZ);
+	
+	int32_t Farthest(IsoDepth::DEPTH_MAX);
+	
+	for ( uint32_t x = xFine << sDepthHiZ::FINE_BITS ; x < ((xFine + 1) << sDepthHiZ::FINE_BITS) ; ++x ) {
+		
+		depth_t const* const __restrict pDepth( &DTCM::getDepthBuffer()[x][yFine << sDepthHiZ::FINE_BITS] );	// column is contiguous
+		
+		for ( uint32_t y = 0 ; y < (1 << sDepthHiZ::FINE_BITS) ; ++y ) {
+			Farthest = min(Farthest, (int32_t)pDepth[y]);
+		}
+	}
+	HiZ.Farthest8[xFine][yFine] = Farthest;
+	
+	uint32_t const xCoarse(xFine / sDepthHiZ::FINE_PER_COARSE), yCoarse(yFine / sDepthHiZ::FINE_PER_COARSE);
+	
+	HiZ.Dirty8[xCoarse] &= ~(1U << ((xFine & (sDepthHiZ::FINE_PER_COARSE - 1)) * sDepthHiZ::FINE_Y + yFine));
+	
+	if ( 0 == (HiZ.Dirty8[xCoarse] & getCoarseDirtyMask(yCoarse)) ) {
+		
+		Farthest = IsoDepth::DEPTH_MAX;
+		for ( uint32_t x = xCoarse * sDepthHiZ::FINE_PER_COARSE ; x < (xCoarse + 1) * sDepthHiZ::FINE_PER_COARSE ; ++x ) {
+			for ( uint32_t y = yCoarse * sDepthHiZ::FINE_PER_COARSE ; y < (yCoarse + 1) * sDepthHiZ::FINE_PER_COARSE ; ++y ) {
+				Farthest = min(Farthest, (int32_t)HiZ.Farthest8[x][y]);
+			}
+		}
+		HiZ.Farthest32[xCoarse][yCoarse] = Farthest;
+	}
+}
+
+// a pixel passes the depth test if DepthLevel >= stored, so a rectangle is occluded only if DepthLevel < the farthest of every tile it touches
+bool const isOccluded_HiZ( int32_t const xMin, int32_t const yMin, int32_t const xMax, int32_t const yMax, int32_t const DepthLevel )
+{
+	using DTCM::sDepthHiZ;
+	sDepthHiZ const& __restrict HiZ(DTCM::DepthHiZ);
+	
+	if ( xMax < 0 || yMax < 0 || xMin >= (int32_t)OLED::SCREEN_WIDTH || yMin >= (int32_t)OLED::SCREEN_HEIGHT )
+		return(true);	// nothing on screen
+	
+	uint32_t const x0( __USAT(xMin, OLED::Width_SATBITS) ), x1( __USAT(xMax, OLED::Width_SATBITS) ),
+								 y0( __USAT(yMin, OLED::Height_SATBITS) ), y1( __USAT(yMax, OLED::Height_SATBITS) );
+	
+	for ( uint32_t xCoarse = x0 >> sDepthHiZ::COARSE_BITS ; xCoarse <= (x1 >> sDepthHiZ::COARSE_BITS) ; ++xCoarse ) {
+		for ( uint32_t yCoarse = y0 >> sDepthHiZ::COARSE_BITS ; yCoarse <= (y1 >> sDepthHiZ::COARSE_BITS) ; ++yCoarse ) {
+			
+			if ( 0 == (HiZ.Dirty8[xCoarse] & getCoarseDirtyMask(yCoarse)) && HiZ.Farthest32[xCoarse][yCoarse] > DepthLevel )
+				continue;	// whole 32x32 tile occludes
+			
+			// descend to the 8x8 tiles of this 32x32 tile inside the rectangle
+			uint32_t const xFineBegin( max(x0 >> sDepthHiZ::FINE_BITS, xCoarse * sDepthHiZ::FINE_PER_COARSE) ),
+										 xFineEnd( min(x1 >> sDepthHiZ::FINE_BITS, (xCoarse + 1) * sDepthHiZ::FINE_PER_COARSE - 1) ),
+										 yFineBegin( max(y0 >> sDepthHiZ::FINE_BITS, yCoarse * sDepthHiZ::FINE_PER_COARSE) ),
+										 yFineEnd( min(y1 >> sDepthHiZ::FINE_BITS, (yCoarse + 1) * sDepthHiZ::FINE_PER_COARSE - 1) );
+			
+			for ( uint32_t xFine = xFineBegin ; xFine <= xFineEnd ; ++xFine ) {
+				for ( uint32_t yFine = yFineBegin ; yFine <= yFineEnd ; ++yFine ) {
+					
+					if ( HiZ.Dirty8[xCoarse] & (1U << ((xFine & (sDepthHiZ::FINE_PER_COARSE - 1)) * sDepthHiZ::FINE_Y + yFine)) ) {
+						RefreshHiZ(xFine, yFine);
+					}
+					if ( HiZ.Farthest8[xFine][yFine] <= DepthLevel )
+						return(false);
+				}
+			}
+		}
+	}
+	
+	return(true);
+}
+
+#ifdef DEPTH_SPANS
+/// * Span encoded depth * ///
+void ClearDepthSpans()
+{
+	memset(DTCM::DepthSpans.End, OLED::SCREEN_HEIGHT, sizeof(DTCM::DepthSpans.End));
+	FillDepth(&DTCM::DepthSpans.Depth[0][0], IsoDepth::DEPTH_MIN, sizeof(DTCM::DepthSpans.Depth) / sizeof(depth_t));
+	memset(DTCM::DepthSpans.Count, 1, sizeof(DTCM::DepthSpans.Count));
+	memset(DTCM::DepthSpans.Stale, 0, sizeof(DTCM::DepthSpans.Stale));
+}
+
+// column spans from DepthBuffer
+static void RebuildDepthSpanColumn( uint32_t const x )
+{
+	using DTCM::sDepthSpans;
+	sDepthSpans& __restrict Spans(DTCM::DepthSpans);
+	
+	depth_t const* const __restrict pDepth( DTCM::getDepthBuffer()[x] );	// column is contiguous
+	uint32_t Count(0);
+	
+	for ( uint32_t y = 0 ; y < OLED::SCREEN_HEIGHT ; ++y ) {
+		
+		if ( 0 != Count && Spans.Depth[x][Count - 1] == pDepth[y] ) {
+			Spans.End[x][Count - 1] = y + 1;
+		}
+		else if ( Count < sDepthSpans::MAX_SPANS ) {
+			Spans.End[x][Count] = y + 1;
+			Spans.Depth[x][Count] = pDepth[y];
+			++Count;
+		}
+		else {
+			Count = 0;	// overflowed
+			break;
+		}
+	}
+	Spans.Count[x] = Count;
+}
+
+void RebuildDepthSpans()
+{
+	for ( uint32_t x = 0 ; x < OLED::SCREEN_WIDTH ; ++x ) {
+		RebuildDepthSpanColumn(x);
+	}
+	memset(DTCM::DepthSpans.Stale, 0, sizeof(DTCM::DepthSpans.Stale));
+}
+
+// every single pixel raise of the column since the last line test, in one pass of the column
+void RefreshDepthSpans( uint32_t const x )
+{
+	DTCM::DepthSpans.Stale[x] = 0;
+	if ( 0 != DTCM::DepthSpans.Count[x] ) {	// overflowed stays DepthBuffer only until cleared
+		RebuildDepthSpanColumn(x);
+	}
+}
+
+// column being rebuilt, adjacent runs of equal depth are merged
+typedef struct sSpanList
+{
+	uint8_t		End[DTCM::sDepthSpans::MAX_SPANS + 2];	// raising a range of one span splits it in 3
+	depth_t		Depth[DTCM::sDepthSpans::MAX_SPANS + 2];
+	uint32_t	Count;
+	
+	__attribute__((always_inline)) inline void Append( uint32_t const yBegin, uint32_t const yEnd, int32_t const DepthLevel )
+	{
+		if ( yBegin < yEnd ) {
+			if ( 0 != Count && Depth[Count - 1] == DepthLevel ) {
+				End[Count - 1] = yEnd;
+			}
+			else {
+				End[Count] = yEnd;
+				Depth[Count] = DepthLevel;
+				++Count;
+			}
+		}
+	}
+	
+	sSpanList()
+		: Count(0)
+	{}
+		
+} SpanList;
+
+// depth = max(depth, DepthLevel) for rows [yBegin, yEnd) of the spans only
+static void RaiseDepthSpanRange( uint32_t const x, uint32_t const yBegin, uint32_t const yEnd, int32_t const DepthLevel )
+{
+	using DTCM::sDepthSpans;
+	sDepthSpans& __restrict Spans(DTCM::DepthSpans);
+	
+	uint32_t const Count(Spans.Count[x]);
+	SpanList oNew;
+	uint32_t Begin(0);
+	
+	for ( uint32_t iSpan = 0 ; iSpan < Count ; ++iSpan ) {
+		
+		uint32_t const End(Spans.End[x][iSpan]);
+		int32_t const Depth(Spans.Depth[x][iSpan]);
+		
+		oNew.Append(Begin, min(End, yBegin), Depth);
+		oNew.Append(max(Begin, yBegin), min(End, yEnd), max(Depth, DepthLevel));
+		oNew.Append(max(Begin, yEnd), End, Depth);
+		
+		Begin = End;
+	}
+	
+	if ( oNew.Count > sDepthSpans::MAX_SPANS ) {
+		Spans.Count[x] = 0;	// overflowed, DepthBuffer only for this column until cleared
+		return;
+	}
+	
+	memcpy(Spans.End[x], oNew.End, oNew.Count * sizeof(oNew.End[0]));
+	memcpy(Spans.Depth[x], oNew.Depth, oNew.Count * sizeof(oNew.Depth[0]));
+	Spans.Count[x] = oNew.Count;
+}
+
+STATIC_INLINE_PURE uint64_t const getRowMask( uint32_t const yBegin, uint32_t const yEnd )	// [yBegin, yEnd), yEnd > yBegin
+{
+	return( (UINT64_MAX >> (OLED::SCREEN_HEIGHT - (yEnd - yBegin))) << yBegin );
+}
+
+__ramfunc uint64_t const TestDepthSpans( uint32_t const x, uint32_t const yBegin, uint32_t const yEnd, int32_t const DepthLevel, bool const bWrite )
+{
+	using DTCM::sDepthSpans;
+	sDepthSpans const& __restrict Spans(DTCM::DepthSpans);
+	
+	uint32_t const Count(Spans.Count[x]);
+	uint64_t Rows(0);
+	uint32_t Begin(0);
+	bool bRaised(false);
+	
+	for ( uint32_t iSpan = 0 ; iSpan < Count && Begin < yEnd ; ++iSpan ) {
+		
+		uint32_t const End(Spans.End[x][iSpan]);
+		int32_t const Depth(Spans.Depth[x][iSpan]);
+		
+		uint32_t const yRunBegin(max(Begin, yBegin)), yRunEnd(min(End, yEnd));
+		
+		if ( yRunBegin < yRunEnd && DepthLevel >= Depth ) {	// same test as LL_DrawPixel, for the whole run
+			
+			Rows |= getRowMask(yRunBegin, yRunEnd);
+			
+			if ( bWrite && DepthLevel != Depth ) {
+				FillDepth(&DTCM::getDepthBuffer()[x][yRunBegin], DepthLevel, yRunEnd - yRunBegin);
+				bRaised = true;
+			}
+		}
+		Begin = End;
+	}
+	
+	if ( bRaised ) {
+		RaiseDepthSpanRange(x, yBegin, yEnd, DepthLevel);
+	}
+	
+	return(Rows);
+}
+#endif /*DEPTH_SPANS*/
+
 void RenderCopy32bitScreenLayerAsync(uint32_t* const __restrict p32bitLayerDst, uint32_t const* const __restrict p32bitLayerSrc)
 {
 	LL_DMA2D_LayerCfgTypeDef foregroundLayer;
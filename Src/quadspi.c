@@ -12,6 +12,8 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "quadspi.h"
 #include "globals.h"
 
+#ifndef QSPI_FRAM_SOFTWARE_EMULATOR	// host build uses quadspi_soft.cpp
+
 #include "stm32f7xx_ll_bus.h"
 #include "stm32f7xx_ll_gpio.h"
 
@@ -20,7 +22,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_hal_qspi.h"
 
 #include "commonmath.h"
-#include "debug.cpp"
+#include "Debug.cpp"
 
 #include "dma.h"
 
@@ -965,3 +967,4 @@ void HAL_QSPI_ErrorCallback(QSPI_HandleTypeDef *hqspi)
 
 }
 
+#endif /*QSPI_FRAM_SOFTWARE_EMULATOR*/
@@ -0,0 +1,596 @@
+/* Copyright (C) 20xx Jason Tully - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License
+ * http://www.supersinfulsilicon.com/
+ *
+This work is licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+To view a copy of this license, visit http://creativecommons.org/licenses/by-nc-sa/4.0/
+or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+ */
+
+#include "quadspi.h"
+#include "globals.h"
+
+#ifdef QSPI_FRAM_SOFTWARE_EMULATOR
+
+#include "stm32f7xx_hal.h"
+#include "stm32f7xx_hal_qspi.h"
+
+#include "Debug.cpp"
+
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace QuadSPI_FRAM
+{
+uint8_t const* const QSPI_Address __attribute__((section (".dtcm_const"))) = (uint8_t const* const)(QUADSPI_ADDRESS);
+}
+
+QSPI_HandleTypeDef hqspi;	// unused, QUADSPI_IRQHandler still references it
+
+namespace QuadSPI_FRAM
+{
+
+static struct sQuadSPI
+{
+	static constexpr bool const QSPI_OP_COMPLETE = false,
+															QSPI_OP_PENDING = true;
+
+	static constexpr uint32_t const SLEEP_TIME = 5000; // 5s
+	static constexpr uint32_t const WAKEUP_TIME = 1000; // us, CS low pulse in WakeUp() (LL_mDelay(1))
+	static constexpr uint32_t const COMMAND_CLOCKS = 8 + 24; // opcode + 24bit address, every READMEM / WRITEMEM
+	static constexpr uint32_t const BURST_BYTES = 32; // memory mapped reads are dcache line fills
+
+	uint8_t*					Image;			// writable view of the image file, the readonly view is at QSPI_Address
+
+	uint32_t 					ProgrammingState,
+										ProgrammingError,
+										VerifyProgrammingState;
+
+	uint32_t					tAlive,
+										tWriteComplete,	// micros() when the pending write has been clocked out
+										HALErrorCode;
+
+	uint32_t					BusClockHz,
+										DataLines;
+
+	Soft::BusStats		Frame,
+										LastFrame,
+										Total;
+
+	bool							IsSleeping,
+										IsWritesDisabled;
+
+	uint32_t					tLastTimeout;
+
+	bool							txComplete,
+										rxComplete,
+										bMemoryMappedMode;
+
+	sQuadSPI()
+	: Image(nullptr),
+	  ProgrammingState(QSPI_PROGRAMMINGSTATE_IDLE), ProgrammingError(QSPI_PROGRAMMINGERROR_NONE),
+	  VerifyProgrammingState(QSPI_VERIFY_PROGRAMMINGSTATE_IDLE), tAlive(0), tWriteComplete(0), HALErrorCode(HAL_QSPI_ERROR_NONE),
+		BusClockHz(Soft::DEFAULT_BUS_CLOCK), DataLines(Soft::DEFAULT_DATA_LINES),
+		Frame{}, LastFrame{}, Total{},
+		IsSleeping(false), IsWritesDisabled(false), tLastTimeout(0),
+		txComplete(QSPI_OP_COMPLETE), rxComplete(QSPI_OP_COMPLETE), bMemoryMappedMode(false)
+	{}
+} oQuadSPI;
+
+} // end namespace
+using namespace QuadSPI_FRAM;
+
+// time in us the bus is occupied for NbBursts commands moving NbBytes total
+STATIC_INLINE uint32_t const BusTime(uint32_t const NbBursts, uint32_t const NbBytes)
+{
+	uint64_t const Clocks = (uint64_t)NbBursts * sQuadSPI::COMMAND_CLOCKS + ((uint64_t)NbBytes << 3) / oQuadSPI.DataLines;
+
+	return( (uint32_t)((Clocks * 1000000ULL) / oQuadSPI.BusClockHz) );
+}
+
+STATIC_INLINE void Account(uint32_t const BytesRead, uint32_t const BytesWritten, uint32_t const NbBursts, uint32_t const tBus)
+{
+	Soft::BusStats* const Stats[2] = { &oQuadSPI.Frame, &oQuadSPI.Total };
+
+	for ( uint32_t iDx = 0 ; iDx < 2 ; ++iDx ) {
+		Stats[iDx]->BytesRead += BytesRead;
+		Stats[iDx]->BytesWritten += BytesWritten;
+		Stats[iDx]->Bursts += NbBursts;
+		Stats[iDx]->BusTime_us += tBus;
+	}
+}
+
+namespace QuadSPI_FRAM
+{
+uint32_t const WriteEnable()
+{
+	if ( nullptr == oQuadSPI.Image )
+		return(QSPI_OP_ERROR);
+
+	if (oQuadSPI.bMemoryMappedMode)
+		Abort();
+
+	oQuadSPI.IsWritesDisabled = false;
+	return(QSPI_OP_OK);
+}
+
+uint32_t const WriteDisable()
+{
+	if ( nullptr == oQuadSPI.Image )
+		return(QSPI_OP_ERROR);
+
+	oQuadSPI.IsWritesDisabled = true;
+	return(QSPI_OP_OK);
+}
+
+// the "interrupt", a write completes once the modelled bus time has passed
+bool const IsWriteMemoryComplete()
+{
+	if ( sQuadSPI::QSPI_OP_PENDING == oQuadSPI.txComplete &&
+		   (int32_t)(micros() - oQuadSPI.tWriteComplete) >= 0 ) {
+
+		oQuadSPI.txComplete = sQuadSPI::QSPI_OP_COMPLETE;
+		oQuadSPI.tLastTimeout = millis(); // Sleep uses this to know when to gotoSleep
+	}
+	return(sQuadSPI::QSPI_OP_COMPLETE == oQuadSPI.txComplete);
+}
+} // end namespace
+
+static uint32_t const Sleep()
+{
+	if ( !oQuadSPI.IsSleeping &&
+		   QSPI_PROGRAMMINGSTATE_IDLE == oQuadSPI.ProgrammingState &&
+		   QSPI_VERIFY_PROGRAMMINGSTATE_IDLE == oQuadSPI.VerifyProgrammingState &&
+			 sQuadSPI::QSPI_OP_COMPLETE == oQuadSPI.rxComplete &&
+			 IsWriteMemoryComplete() )	// don't goto sleep if busy!!
+	{
+		if (oQuadSPI.bMemoryMappedMode)
+			Abort();
+
+		oQuadSPI.IsSleeping = true;
+		return(QSPI_OP_OK);
+	}
+
+	return(QSPI_OP_BUSY);
+}
+
+static uint32_t const WakeUp(bool const bWriteDisable = true)
+{
+	if (oQuadSPI.IsSleeping) {
+
+		if ( sQuadSPI::QSPI_OP_COMPLETE == oQuadSPI.rxComplete && IsWriteMemoryComplete() )
+		{
+			oQuadSPI.IsSleeping = false;
+			Account(0, 0, 0, sQuadSPI::WAKEUP_TIME);
+
+#if defined(_DEBUG_OUT_OLED) && defined(QSPI_AUTOSLEEP_SLEEPWAKE_STATE_OLED)
+			DebugMessage( "FRAM Wake Up %d", millis());
+#endif
+			if ( bWriteDisable ) {
+				if ( QSPI_OP_OK != WriteDisable() )
+					return(QSPI_OP_ERROR);
+			}
+		}
+		else
+			return(QSPI_OP_BUSY);
+	}
+
+	oQuadSPI.tAlive = millis();
+
+	return(QSPI_OP_OK);
+}
+
+// Non-blocking call, data is copied into the image immediately, completion follows the bus model //
+static uint32_t const WriteMemory(uint8_t const* const pDataOut, uint32_t const Address, uint32_t const NbBytes)
+{
+	if ( !oQuadSPI.IsWritesDisabled && IsWriteMemoryComplete() )
+	{
+		if ( nullptr == oQuadSPI.Image || (Address + NbBytes) > FRAM_SIZE_BYTES ) {
+			oQuadSPI.HALErrorCode = HAL_QSPI_ERROR_INVALID_PARAM;
+			return(QSPI_OP_ERROR);
+		}
+
+		if (oQuadSPI.bMemoryMappedMode)
+			Abort();
+
+		memcpy(oQuadSPI.Image + Address, pDataOut, NbBytes);
+
+		uint32_t const tBus = BusTime(1, NbBytes);
+		Account(0, NbBytes, 1, tBus);
+
+		oQuadSPI.tWriteComplete = micros() + tBus;
+		oQuadSPI.txComplete = sQuadSPI::QSPI_OP_PENDING;
+		return(QSPI_OP_OK);
+	}
+
+	return(QSPI_OP_BUSY);
+}
+
+namespace QuadSPI_FRAM
+{
+uint32_t const WriteMemory(uint8_t const* const pDataOut, uint32_t const Address, uint32_t const NbBytes)
+{
+	if ( !oQuadSPI.IsWritesDisabled )
+		WriteEnable(); // required for every new write memory
+
+	return( ::WriteMemory(pDataOut, Address, NbBytes) );
+}
+} // end namespace
+
+// Non-blocking call, completes immediately //
+static uint32_t const ReadMemory(uint32_t const Address, uint8_t* const& pDataInBuffer, uint32_t const NbBytes)
+{
+	if ( sQuadSPI::QSPI_OP_COMPLETE == oQuadSPI.rxComplete )
+	{
+		if ( nullptr == oQuadSPI.Image || (Address + NbBytes) > FRAM_SIZE_BYTES ) {
+			oQuadSPI.HALErrorCode = HAL_QSPI_ERROR_INVALID_PARAM;
+			return(QSPI_OP_ERROR);
+		}
+
+		if (oQuadSPI.bMemoryMappedMode)
+			Abort();
+
+		memcpy(pDataInBuffer, oQuadSPI.Image + Address, NbBytes);
+		Account(NbBytes, 0, 1, BusTime(1, NbBytes));
+
+		oQuadSPI.tLastTimeout = millis();
+		return(QSPI_OP_OK);
+	}
+
+	return(QSPI_OP_BUSY);
+}
+
+static uint32_t const MemoryMappedMode_Internal()
+{
+	if ( QSPI_PROGRAMMINGSTATE_IDLE == oQuadSPI.ProgrammingState &&
+			 sQuadSPI::QSPI_OP_COMPLETE == oQuadSPI.rxComplete &&
+			 IsWriteMemoryComplete() )	// Finish any current write first
+	{
+		if ( nullptr == oQuadSPI.Image )
+			return(QSPI_OP_ERROR);
+
+		oQuadSPI.tLastTimeout = millis();
+		oQuadSPI.bMemoryMappedMode = true;
+		return(QSPI_OP_OK);
+	}
+
+	return(QSPI_OP_BUSY);
+}
+
+namespace QuadSPI_FRAM
+{
+void Abort()
+{
+	oQuadSPI.bMemoryMappedMode = false;
+}
+
+void ResetVerifyFRAMState()
+{
+	oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_IDLE;	// reset is done here for verify
+}
+
+NOINLINE uint32_t const MemoryMappedMode()
+{
+	uint32_t const uiWakeUpResult(WakeUp());
+
+	if ( QSPI_OP_OK != uiWakeUpResult )
+		return(uiWakeUpResult);
+
+	if (!oQuadSPI.bMemoryMappedMode) {	// Not running
+		return( ::MemoryMappedMode_Internal() );
+	}
+	return(QSPI_OP_OK);
+}
+
+// Maps the image file, readonly at QUADSPI_ADDRESS and writable anywhere, both shared so they stay coherent
+NOINLINE void Init(void)
+{
+	char const* szImage = getenv("QSPI_FRAM_IMAGE");
+	if ( nullptr == szImage )
+		szImage = QSPI_FRAM_IMAGE_DEFAULT;
+
+	oQuadSPI.HALErrorCode = HAL_QSPI_ERROR_TRANSFER; // until mapped
+
+	int const fd = open(szImage, O_RDWR | O_CREAT, 0644);
+	if ( fd < 0 )
+		return;
+
+	struct stat st;
+	if ( 0 == fstat(fd, &st) && st.st_size < (off_t)FRAM_SIZE_BYTES ) {	// new image reads as erased (zero)
+		if ( 0 != ftruncate(fd, FRAM_SIZE_BYTES) ) {
+			close(fd);
+			return;
+		}
+	}
+
+	void* const pRead = mmap((void*)QUADSPI_ADDRESS, FRAM_SIZE_BYTES, PROT_READ, MAP_SHARED, fd, 0);
+	void* const pWrite = mmap(nullptr, FRAM_SIZE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	// the address is only a hint, the fixed FRAM addresses are compile time constants so anywhere else is a failure
+	if ( (void*)QUADSPI_ADDRESS != pRead || MAP_FAILED == pWrite ) {
+		if ( MAP_FAILED != pRead )
+			munmap(pRead, FRAM_SIZE_BYTES);
+		if ( MAP_FAILED != pWrite )
+			munmap(pWrite, FRAM_SIZE_BYTES);
+		return;
+	}
+
+	oQuadSPI.Image = (uint8_t*)pWrite;
+	oQuadSPI.HALErrorCode = HAL_QSPI_ERROR_NONE;
+
+	WriteDisable();
+}
+
+NOINLINE void Update(uint32_t const tNow)
+{
+	IsWriteMemoryComplete(); // services a finished write, like the tx complete interrupt would
+
+#if QSPI_AUTOSLEEP_FRAM
+	static constexpr uint32_t const UPDATE_INTERVAL = sQuadSPI::SLEEP_TIME >> 1; // ms
+	static uint32_t tLastUpdate;
+	static bool bInitTime(true);
+
+	if ( tNow - tLastUpdate > UPDATE_INTERVAL )  // only poll sleep infrequently
+	{
+		if ( likely(!bInitTime) )
+		{
+			if ( !oQuadSPI.IsSleeping )
+			{
+				uint32_t const tLastActivity = (oQuadSPI.tAlive > oQuadSPI.tLastTimeout ? oQuadSPI.tAlive : oQuadSPI.tLastTimeout);
+
+				if ( millis() - tLastActivity > sQuadSPI::SLEEP_TIME )
+				{
+					if ( QSPI_OP_OK == Sleep() )
+					{
+#if defined(_DEBUG_OUT_OLED) && defined(QSPI_AUTOSLEEP_SLEEPWAKE_STATE_OLED)
+						DebugMessage( "FRAM Sleeping %d", tLastActivity);
+#endif
+					}
+					// else busy, not going to sleep
+				}
+			}
+		}
+		else {
+			oQuadSPI.tLastTimeout = tNow;
+			oQuadSPI.tAlive = tNow;
+
+			bInitTime = false;
+		}
+
+		tLastUpdate = tNow;
+	}
+#else
+	UNUSED(tNow);
+#endif
+}
+
+uint32_t const AckComplete_ResetProgrammingState()
+{
+	if ( QSPI_PROGRAMMINGSTATE_COMPLETE == oQuadSPI.ProgrammingState )
+	{
+		if ( QSPI_OP_OK == WriteDisable() ) {
+			oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_IDLE;
+			oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_NONE;
+		}
+		else {
+			oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_ERROR;
+			oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_WRITEDISABLEFAIL;
+		}
+	}
+
+	return(oQuadSPI.ProgrammingState);
+}
+
+// same state machine as the hardware, polled once per main loop pass until the modelled write completes
+uint32_t const ProgramFRAM(uint32_t& NbBytesProgrammed, ProgrammingDesc const programmingDesc)
+{
+	static uint32_t PendingNbBytes(0);
+
+	if ( QSPI_PROGRAMMINGSTATE_IDLE == oQuadSPI.ProgrammingState )
+	{
+		oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_IDLE;	// reset is also done here for verif
+		oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_PENDING;
+
+		NbBytesProgrammed = 0;
+		PendingNbBytes = 0;
+	}
+	else if ( QSPI_PROGRAMMINGSTATE_PENDING != oQuadSPI.ProgrammingState )
+		return(oQuadSPI.ProgrammingState);
+
+	switch( WakeUp(false) )  // Prevent sleeping, keep alive
+	{
+		case QSPI_OP_BUSY:
+			return(oQuadSPI.ProgrammingState);
+		case QSPI_OP_ERROR:
+			oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_ERROR;
+			oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_SLEEPFAIL;
+			return(oQuadSPI.ProgrammingState);
+		case QSPI_OP_OK:
+		default:
+			break;
+	}
+
+	if ( !IsWriteMemoryComplete() ) {
+
+		if ( 0 == PendingNbBytes ) {
+			oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_ERROR;
+			oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_WRITEFAIL;
+		}
+		return(oQuadSPI.ProgrammingState); // else still PENDING
+	}
+
+	NbBytesProgrammed += PendingNbBytes;
+	PendingNbBytes = 0;
+
+	if ( 0 != NbBytesProgrammed ) {
+
+		if (HAL_QSPI_ERROR_NONE == GetHALQSPIErrorCode() && programmingDesc.SrcNbBytes == NbBytesProgrammed) {
+			oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_COMPLETE;
+		}
+		else {
+			oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_ERROR;
+			oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_WRITEINCOMPLETE;
+		}
+		return(oQuadSPI.ProgrammingState);
+	}
+
+	if ((programmingDesc.SrcNbBytes) >= FRAM_SIZE_BYTES) {
+		oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_ERROR;
+		oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_SIZEFAIL;
+		return(oQuadSPI.ProgrammingState);
+	}
+
+	if ( QSPI_OP_OK != WriteEnable() ) {
+		oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_ERROR;
+		oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_WRITEENABLEFAIL;
+		return(oQuadSPI.ProgrammingState);
+	}
+
+	switch ( ::WriteMemory(programmingDesc.SrcMemory, 0, programmingDesc.SrcNbBytes) )
+	{
+		case QSPI_OP_OK:
+			PendingNbBytes = programmingDesc.SrcNbBytes;
+			break;
+		case QSPI_OP_ERROR:
+			oQuadSPI.ProgrammingState = QSPI_PROGRAMMINGSTATE_ERROR;
+			oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_WRITEFAIL;
+			break;
+		case QSPI_OP_BUSY:
+		default:
+			break; // ignore, try on next pass
+	}
+
+	return(oQuadSPI.ProgrammingState);
+}
+
+uint32_t const VerifyFRAM(uint32_t& NbBytesVerified, uint32_t const& NbBytesExpectedProgrammed, uint8_t const* Address, ProgrammingDesc const programmedList)
+{
+	if ( QSPI_PROGRAMMINGSTATE_IDLE != oQuadSPI.ProgrammingState )
+		return(oQuadSPI.VerifyProgrammingState);
+
+	if (QSPI_VERIFY_PROGRAMMINGSTATE_IDLE == oQuadSPI.VerifyProgrammingState)
+	{
+		switch( MemoryMappedMode() )
+		{
+			case QSPI_OP_BUSY:
+				return(oQuadSPI.VerifyProgrammingState);
+			case QSPI_OP_ERROR:
+				oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_ERROR;
+				oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_SLEEPFAIL;
+				return(oQuadSPI.VerifyProgrammingState);
+			case QSPI_OP_OK:
+			default:
+				break;
+		}
+
+		oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_PENDING;
+		oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_NONE;
+	}
+	else if (QSPI_VERIFY_PROGRAMMINGSTATE_PENDING != oQuadSPI.VerifyProgrammingState)
+		return(oQuadSPI.VerifyProgrammingState);
+
+	if ( ((((uint32_t const)Address) + programmedList.SrcNbBytes) - ((uint32_t const)QSPI_Address)) >= FRAM_SIZE_BYTES) {
+		oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_ERROR;
+		oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_SIZEFAIL;
+		return(oQuadSPI.VerifyProgrammingState);
+	}
+
+	Soft::AccountRead(Address, programmedList.SrcNbBytes);
+
+	uint8_t const* SrcMemory(programmedList.SrcMemory);
+	for ( uint32_t iDx = 0 ; iDx < programmedList.SrcNbBytes ; ++iDx )
+	{
+		if (*Address != *SrcMemory) {
+			oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_ERROR;
+			oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_NOTEQUAL;
+			return(oQuadSPI.VerifyProgrammingState);
+		}
+
+		++Address;
+		++SrcMemory;
+
+		++NbBytesVerified;
+	}
+
+	if (HAL_QSPI_ERROR_NONE == GetHALQSPIErrorCode() && NbBytesExpectedProgrammed == NbBytesVerified) {
+		oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_COMPLETE;
+	}
+	else {
+		oQuadSPI.VerifyProgrammingState = QSPI_VERIFY_PROGRAMMINGSTATE_ERROR;
+		oQuadSPI.ProgrammingError = QSPI_PROGRAMMINGERROR_VERIFYINCOMPLETE;
+	}
+
+	return(oQuadSPI.VerifyProgrammingState);
+}
+
+uint32_t const GetProgrammingState()
+{
+	return(oQuadSPI.ProgrammingState);
+}
+
+uint32_t const GetLastProgrammingError()
+{
+	return(oQuadSPI.ProgrammingError);
+}
+
+uint32_t const GetHALQSPIErrorCode()
+{
+	return(oQuadSPI.HALErrorCode);
+}
+
+namespace Soft
+{
+// each read is costed as line fills of the touched cache lines, one READMEM command each
+void AccountRead(uint8_t const* const Address, uint32_t const NbBytes)
+{
+	static constexpr uint32_t const LINE_MASK = sQuadSPI::BURST_BYTES - 1;
+
+	if ( 0 == NbBytes )
+		return;
+
+	uint32_t const uiStart = ((uint32_t const)Address) & ~LINE_MASK,
+								 uiEnd = (((uint32_t const)Address) + NbBytes + LINE_MASK) & ~LINE_MASK;
+	uint32_t const NbBursts = (uiEnd - uiStart) / sQuadSPI::BURST_BYTES;
+
+	if ( oQuadSPI.IsSleeping ) {
+		++oQuadSPI.Frame.AccessWhileAsleep;
+		++oQuadSPI.Total.AccessWhileAsleep;
+	}
+
+	Account(NbBytes, 0, NbBursts, BusTime(NbBursts, NbBursts * sQuadSPI::BURST_BYTES));
+}
+
+void SetBusModel(uint32_t const BusClockHz, uint32_t const DataLines)
+{
+	oQuadSPI.BusClockHz = (0 != BusClockHz ? BusClockHz : DEFAULT_BUS_CLOCK);
+	oQuadSPI.DataLines = (0 != DataLines ? DataLines : DEFAULT_DATA_LINES);
+}
+
+BusStats const& EndFrame()
+{
+	oQuadSPI.LastFrame = oQuadSPI.Frame;
+	oQuadSPI.Frame = BusStats{};
+
+	return(oQuadSPI.LastFrame);
+}
+
+BusStats const& getLastFrameStats()
+{
+	return(oQuadSPI.LastFrame);
+}
+
+BusStats const& getTotalStats()
+{
+	return(oQuadSPI.Total);
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*QSPI_FRAM_SOFTWARE_EMULATOR*/
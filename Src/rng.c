@@ -17,7 +17,18 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_ll_utils.h"
 
 #define DETERMINISTIC_KEY_SEED 0xC00C1001
-#include "..\..\superrandom\superrandom.h"
+#if defined(GOLDEN_FRAME_HARNESS) && defined(INPUT_RECORD_REPLAY)
+#include "GoldenFrame.h"
+#include "InputReplay.h"
+#define TRUE_RANDOM_FILTER(x) InputReplay::TrueRandom(GoldenFrame::TrueRandom(x))	// the fixed sequence is what is recorded
+#elif defined(GOLDEN_FRAME_HARNESS)
+#include "GoldenFrame.h"
+#define TRUE_RANDOM_FILTER(x) GoldenFrame::TrueRandom(x)	// fixed sequence, golden frames do not depend on the hardware rng
+#elif defined(INPUT_RECORD_REPLAY)
+#include "InputReplay.h"
+#define TRUE_RANDOM_FILTER(x) InputReplay::TrueRandom(x)	// every true random number consumed is recorded / played back
+#endif
+#include "../SuperRandom/superrandom.h"
 
 /* RNG init function */
 NOINLINE void MX_RNG_Init(void)
@@ -14,7 +14,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "quadspi.h"
 #include "effect_sdf_viewer.h"
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
 //////
 #if defined(VERIFY_SDF_FRAM_SPECIFIC) || defined(PROGRAM_SDF_TO_FRAM)
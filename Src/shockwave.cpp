@@ -11,11 +11,11 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "globals.h"
 #include "shockwave.h"
 #include "volumetricradialgrid.h"
-#include "lighting.h"
+#include "Lighting.h"
 #include <vector>
 
 #ifdef DEBUG_RANGE
-#include "debug.cpp"
+#include "Debug.cpp"
 #endif
 
 static constexpr uint32_t const LIFETIME_ANIMATION = 6000;//ms
@@ -40,7 +40,7 @@ __attribute__((always_inline)) STATIC_INLINE __attribute__((pure)) uint32_t cons
 	vec3_t const vScreenSpacePoint( vPoint.x, vPoint.y * Volumetric::MAXIMUM_HEIGHT_FPIXELS, vPoint.z );
 	vec3_t const vNormal(0.0f, -1.0f, 0.0f);
 	
-	float lighting = Lighting::Shade_FullRange<false>(vScreenSpacePoint, Lighting::NORMAL_TOPFACE, 1.0f);
+	float lighting = Lighting::Shade_FullRange(vScreenSpacePoint, Lighting::NORMAL_TOPFACE, 1.0f);
 	lighting = __fminf(lighting, 0.333f) * (vPoint.y * 2.0f) * 1.333f;
 
 	int32_t const Shading = int32::__roundf( lighting * Constants::nf255 );
@@ -44,6 +44,9 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_it.h"
 #include "globals.h"
 #include "stm32f7xx_ll_dma2d.h"
+#ifdef GOLDEN_FRAME_HARNESS
+#include "GoldenFrame.h"
+#endif
 
 /* USER CODE BEGIN 0 */
 extern void TransferComplete_Callback_DMA2D();
@@ -73,7 +76,11 @@ static atomic_strict_uint32_t g_Ticks
 
 extern uint32_t const millis()
 {
+#ifdef GOLDEN_FRAME_HARNESS
+	return(GoldenFrame::Millis(g_Ticks));	// fixed frame clock, see GoldenFrame.h
+#else
 	return(g_Ticks);
+#endif
 }
 
 /**
@@ -10,7 +10,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #include "globals.h"
 #include "fractalboxesEffect.h"
-#include "FLASH\imports.h"
+#include "FLASH/imports.h"
 #include "oled.h"
 #include "math_3d.h"
 
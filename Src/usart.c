@@ -18,7 +18,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 #include "stm32f7xx_ll_gpio.h"
 #include "rng.h"
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
 //extern "C" void asmConv_L8L8L8L8_To_L8(uint8_t* __restrict outputL8, uint32_t const* __restrict inputLumaReplicated, uint32_t length);
 
@@ -9,7 +9,7 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
  */
 
 #include "globals.h"
-#include "VOLUMETRICRADIALGRID.h"
+#include "volumetricradialgrid.h"
 
 namespace Volumetric
 {
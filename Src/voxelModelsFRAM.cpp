@@ -10,11 +10,11 @@ or send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
 
 #include "globals.h"
 #include "voxelModelsFRAM.h"
-#include "FLASH\imports.h"
+#include "FLASH/imports.h"
 #include "VoxBinary.h"
 #include "quadspi.h"
 
-#include "debug.cpp"
+#include "Debug.cpp"
 
 typedef struct __attribute__((packed)) voxelModelsHeader
 {
@@ -39,6 +39,19 @@ namespace Volumetric
 																																														 &voxelModelSidewinder
 																																													 };
 		static constexpr uint32_t NUM_MODELS = countof(voxelModels);
+		
+#ifdef VOX_BAKED_MODELS
+		// baked model images (see VoxBaker.h), same order as voxelModels
+		static uint8_t const* const voxelModelImages[] = { _vxb_sr71, 
+																											 _vxb_f2a,
+																											 _vxb_sidewinder
+																										 };
+		static_assert( countof(voxelModelImages) == NUM_MODELS, "a baked image is required for every model" );
+		
+		static constexpr uint32_t MODELS_BAKED = (1 << 7);	// FRAM header number of models marks the baked format, a change of format reprograms
+#else
+		static constexpr uint32_t MODELS_BAKED = 0;
+#endif
 	} // end namespace
 	
 	/*
@@ -100,13 +113,63 @@ namespace Volumetric
 	
 		return(pVoxelsInFRAM);
 	}
+	
+#ifdef VOX_BAKED_MODELS
+	// baked images are kept 4 byte aligned in FRAM
+	STATIC_INLINE_PURE uint32_t const AlignBakedModel(uint32_t const Address) { return( (Address + 3) & ~3 ); }
+	
+	// copies a baked model image as is from flash to FRAM, validated first
+	static bool const ProgramBakedModel(uint8_t*& FRAMWritePointer, voxB::voxelModelBase* const pModel, uint8_t const* const pImage)
+	{
+		uint32_t const SizeInBytes( voxB::Map(pModel, pImage) );
+		
+		if ( 0 != SizeInBytes ) {
+			
+			FRAMWritePointer = (uint8_t*)AlignBakedModel((uint32_t)FRAMWritePointer);
+			
+			if ( QuadSPI_FRAM::QSPI_OP_OK == QuadSPI_FRAM::WriteMemory((uint8_t* const)pImage, 
+																															 ((uint32_t)FRAMWritePointer) - ((uint32_t)QuadSPI_FRAM::QSPI_Address), 
+																															 SizeInBytes) ) {
+				while( !QuadSPI_FRAM::IsWriteMemoryComplete() ) { __WFI(); }
+				
+				FRAMWritePointer += SizeInBytes;
+				return(true);
+			}
+			else
+				DebugMessage("Write baked model for Voxel Load FAIL");
+		}
+		else
+			DebugMessage("Baked model not valid for Voxel Load FAIL");
+		
+		return(false);
+	}
+	
+	// maps every model to its baked image in FRAM, nothing is parsed
+	static bool const MapBakedModels(uint8_t const* FRAMReadPointer)
+	{
+		for (int32_t iDx = 0 ; iDx < Volumetric::voxFRAM::NUM_MODELS ; ++iDx)
+		{
+			FRAMReadPointer = (uint8_t const*)AlignBakedModel((uint32_t)FRAMReadPointer);
+			
+			uint32_t const SizeInBytes( voxB::Map(voxFRAM::voxelModels[iDx], FRAMReadPointer) );
+			if ( 0 == SizeInBytes ) {
+				DebugMessage("Map baked model for Voxel Load FAIL");
+				return(false);
+			}
+			
+			//advance to next model image
+			FRAMReadPointer += SizeInBytes;
+		}
+		return(true);
+	}
+#endif
 } // end namespace
 
 // ###### private functions:
 static bool const WriteHeader(uint8_t*& __restrict FRAMWritePointer)
 {
 	voxelModelsHeader header;
-	header.numModels = Volumetric::voxFRAM::NUM_MODELS;
+	header.numModels = Volumetric::voxFRAM::NUM_MODELS | Volumetric::voxFRAM::MODELS_BAKED;
 	
 	if ( QuadSPI_FRAM::QSPI_OP_OK == QuadSPI_FRAM::WriteMemory((uint8_t* const)&header, 
 																														 ((uint32_t)FRAMWritePointer) - ((uint32_t)QuadSPI_FRAM::QSPI_Address), 
@@ -144,6 +207,7 @@ namespace Volumetric
 		
 		voxelModelsHeader mainHeader;
 		memcpy(&mainHeader, FRAMReadPointer, sizeof(voxelModelsHeader));
+		QSPI_FRAM_ACCOUNT_READ(FRAMReadPointer, sizeof(voxelModelsHeader));
 		uint32_t const numModelsInFRAM = mainHeader.numModels;
 		
 		// ReProgramming is required if number of models being loaded is different than the number
@@ -156,7 +220,7 @@ namespace Volumetric
 		bool const bForce = false;
 #endif
 		
-		bFRAMReProgramming = ((numModelsInFRAM != Volumetric::voxFRAM::NUM_MODELS) | (0 == numModelsInFRAM) | bForce);
+		bFRAMReProgramming = ((numModelsInFRAM != (Volumetric::voxFRAM::NUM_MODELS | Volumetric::voxFRAM::MODELS_BAKED)) | (0 == numModelsInFRAM) | bForce);
 		
 		if ( bFRAMReProgramming ) { // Rewrite header
 			DebugMessage("FRAM Reprogramming...");
@@ -172,6 +236,14 @@ namespace Volumetric
 			{
 				// at this point FRAMWritePointer is at the correct position for Model #1 's data to be written
 			
+#ifdef VOX_BAKED_MODELS
+				// baked images are programmed as is, mapped once back in memory mapped mode
+				for (int32_t iDx = 0 ; iDx < Volumetric::voxFRAM::NUM_MODELS ; ++iDx)
+				{
+					if (!ProgramBakedModel(FRAMWritePointer, voxFRAM::voxelModels[iDx], voxFRAM::voxelModelImages[iDx]))
+						return(false);
+				}
+#else
 				// Begin load of all models into SRAM one by one, then program relevant data to FRAM
 				// the WritePointer is passed in by reference and passes thru to programming function once model is loaded
 				if (!Volumetric::voxB::Load( &voxFRAM::voxelModelBlackBird, _vox_sr71, FRAMWritePointer))
@@ -182,6 +254,7 @@ namespace Volumetric
 				
 				if (!Volumetric::voxB::Load( &voxFRAM::voxelModelSidewinder, _vox_sidewinder, FRAMWritePointer))
 					return(false);
+#endif
 				
 				// Disable Writes
 				if ( QuadSPI_FRAM::QSPI_OP_OK != QuadSPI_FRAM::WriteDisable() ) {
@@ -194,6 +267,10 @@ namespace Volumetric
 					DebugMessage("BackTo MMAP Mode for Voxel Load FAIL");
 					return(false);
 				}
+#ifdef VOX_BAKED_MODELS
+				if ( !MapBakedModels(QuadSPI_FRAM::QSPI_Address + sizeof(voxelModelsHeader)) )
+					return(false);
+#endif
 				/*
 				if ( VerifyData(voxFRAM::voxelModelBlackBird) ) {
 					DebugMessage("FRAM Model Good");
@@ -208,11 +285,16 @@ namespace Volumetric
 			
 			FRAMReadPointer += sizeof(voxelModelsHeader); // Advance from main header
 			
+#ifdef VOX_BAKED_MODELS
+			if ( !MapBakedModels(FRAMReadPointer) )
+				return(false);
+#else
 			for (int32_t iDx = 0 ; iDx < Volumetric::voxFRAM::NUM_MODELS ; ++iDx)
 			{
 				// read model header
 				Volumetric::voxB::voxelModelDescHeader descModel;
 				memcpy(&descModel, FRAMReadPointer, sizeof(Volumetric::voxB::voxelModelDescHeader));
+				QSPI_FRAM_ACCOUNT_READ(FRAMReadPointer, sizeof(Volumetric::voxB::voxelModelDescHeader));
 				
 				// advance
 				FRAMReadPointer += sizeof(Volumetric::voxB::voxelModelDescHeader);
@@ -230,8 +312,14 @@ namespace Volumetric
 				//advance to next model header
 				FRAMReadPointer += (descModel.numVoxels * sizeof(voxB::voxelDescPacked));
 			}
+#endif
 		}
 		
+		// every model is in FRAM and memory mapped now
+		for (int32_t iDx = 0 ; iDx < Volumetric::voxFRAM::NUM_MODELS ; ++iDx)
+		{
+			voxB::BuildSlices(voxFRAM::voxelModels[iDx]);
+		}
 		
 		return(true);
 	}
@@ -29,6 +29,18 @@ eg.) in rng.c file:
 	#include "superrandom.h"
 */
 
+// define TRUE_RANDOM_FILTER(x) to observe or replace every true random number consumed
+// eg.) record / replay of a run, all other randomness is derived from the seeds (see GetRandomState)
+/*
+eg.) in rng.c file:
+	#define TRUE_RANDOM_FILTER(x) Replay(x)
+	#include "superrandom.h"
+*/
+
+#ifndef TRUE_RANDOM_FILTER
+#define TRUE_RANDOM_FILTER(x) (x)
+#endif
+
 #ifndef DETERMINISTIC_KEY_SEED
 #define RANDOM_KEY_SEED 1
 #define DETERMINISTIC_KEY_SEED 0
@@ -110,7 +122,7 @@ STATIC_INLINE uint32_t const GetNextTrueRandomNumber(void)
 	
 	/* ReEnable RNG IT generation */
   LL_RNG_EnableIT(RNG);
-	return(uiReturn);
+	return(TRUE_RANDOM_FILTER(uiReturn));
 }
 
 __ramfunc float const RandomFloat(/* Range is 0.0f to 1.0f*/void)
@@ -198,6 +210,21 @@ __ramfunc void PsuedoResetSeed()
 	PsuedoSetSeed(oRandom.reservedSeed);
 }
 
+void GetRandomState( RandomState* const pState )
+{
+	pState->reservedSeed = oRandom.reservedSeed;
+	pState->hashSeed = oRandom.hashSeed;
+	for ( uint32_t i = 0 ; i < 4 ; ++i )
+		pState->xorshift[i] = xorshift_state[i];
+}
+void SetRandomState( RandomState const* const pState )
+{
+	oRandom.reservedSeed = pState->reservedSeed;
+	oRandom.hashSeed = pState->hashSeed;
+	for ( uint32_t i = 0 ; i < 4 ; ++i )
+		xorshift_state[i] = pState->xorshift[i];
+}
+
 __ramfunc float const PsuedoRandomFloat(/* Range is 0.0f to 1.0f*/void)
 {
 	union
@@ -38,6 +38,16 @@ __ramfunc int32_t const PsuedoRandomNumber16(int32_t const iMin, int32_t const i
 __ramfunc bool const PsuedoRandom5050(void);
 
 void HashSetSeed( int32_t const Seed );
+
+// Complete deterministic state, snapshot / restore of a run (true random numbers are not part of it)
+typedef struct sRandomState
+{
+	uint32_t reservedSeed, hashSeed;
+	uint32_t xorshift[4];
+} RandomState;
+
+void GetRandomState( RandomState* const pState );
+void SetRandomState( RandomState const* const pState );
 __ramfunc uint32_t const Hash( int32_t const data );
 
 __ramfunc extern void RNG_DataReady_Callback(void);